@@ -3,6 +3,7 @@ let requestCounter = 0;
 
 world.onenter = () => {
   matrix.listen();
+  matrix.addEventFilter({ type: "m.room.message" });
 
   matrix.send({
     api: "fromWidget",
@@ -14,9 +15,7 @@ world.onenter = () => {
 };
 
 world.onupdate = (dt) => {
-  let event;
-
-  while ((event = matrix.receive())) {
+  for (const event of matrix.receiveAll()) {
     const { api, action, data } = event;
 
     if (api === "toWidget" && action === "send_event") {
@@ -140,6 +140,31 @@ declare namespace WebSG {
      * The mesh representing the shape of the Collider (required for hull and trimesh types).
      */
     mesh?: Mesh;
+    /**
+     * Snaps hull and trimesh vertices to a grid with cells of this size and merges the vertices in each cell before
+     * building the shape, which speeds up collision detection against detailed meshes. Vertices that are close but
+     * fall in neighbouring cells are kept apart. Defaults to 0, which uses the mesh as is.
+     */
+    simplify?: number;
+  }
+
+  /**
+   * Options for {@link WebSG.World.createColliderFromMesh | world.createColliderFromMesh()}.
+   */
+  interface MeshColliderOptions {
+    /**
+     * A convex hull around each of the mesh's primitives or a triangle mesh. Defaults to hull.
+     */
+    type?: "hull" | "trimesh";
+    /**
+     * Determines if the Collider acts as a trigger.
+     */
+    isTrigger?: boolean;
+    /**
+     * Snaps vertices to a grid with cells of this size and merges the vertices in each cell before building the shape.
+     * Defaults to 0.
+     */
+    simplify?: number;
   }
 
   /**
@@ -205,6 +230,94 @@ declare namespace WebSG {
     get released(): boolean;
   }
 
+  /**
+   * InterpolationBufferProps is an interface that defines the properties for creating an InterpolationBuffer.
+   */
+  interface InterpolationBufferProps {
+    /**
+     * The number of floats in each sample. Default is 3, or 4 when `quaternion` is set. Max 16.
+     */
+    size?: number;
+    /**
+     * Whether samples are quaternions that should be spherically interpolated. Default is `false`.
+     */
+    quaternion?: boolean;
+    /**
+     * The maximum number of samples held in the buffer. Default is 32. Max 1024.
+     */
+    capacity?: number;
+    /**
+     * How far behind the sampled time the buffer is rendered, in the same units as the sample times.
+     * Default is 0.1.
+     */
+    delay?: number;
+  }
+
+  /**
+   * The InterpolationBuffer class stores timestamped vectors or quaternions, such as state received from
+   * network messages, and smoothly samples them a short delay behind the current time.
+   *
+   * @example
+   * const positions = new WebSG.InterpolationBuffer({ delay: 0.1 });
+   *
+   * world.onupdate = (dt, time) => {
+   *   for (const message of networkListener.receive()) {
+   *     positions.push(time, new Float32Array(message.data));
+   *   }
+   *
+   *   positions.sample(time, node.translation);
+   * };
+   */
+  class InterpolationBuffer {
+    /**
+     * Creates a new InterpolationBuffer.
+     * @param props The properties of the buffer.
+     */
+    constructor(props?: InterpolationBufferProps);
+
+    /**
+     * Inserts a sample into the buffer, keeping samples sorted by time. When the buffer is full the
+     * oldest sample is dropped.
+     * @param time The time of the sample.
+     * @param value An array-like object with `size` components.
+     */
+    push(time: number, value: ArrayLike<number>): this;
+
+    /**
+     * Writes the value at `time - delay` into `out`, linearly or spherically interpolating between the
+     * two samples around it. Holds the oldest or newest sample outside of the buffered range and leaves
+     * `out` unchanged when the buffer is empty. Samples older than the render time are discarded.
+     * @param time The current time.
+     * @param out A Vector3, Quaternion, or array to write the result into.
+     */
+    sample<T extends ArrayLike<number>>(time: number, out: T): T;
+
+    /**
+     * Removes all samples from the buffer.
+     */
+    clear(): undefined;
+
+    /**
+     * The number of samples currently in the buffer.
+     */
+    get count(): number;
+
+    /**
+     * The number of floats in each sample.
+     */
+    get size(): number;
+
+    /**
+     * The maximum number of samples held in the buffer.
+     */
+    get capacity(): number;
+
+    /**
+     * How far behind the sampled time the buffer is rendered.
+     */
+    delay: number;
+  }
+
   /**
    * LightType is a union type representing the available types of lights.
    * @typedef {"directional" | "point" | "spot"} LightType
@@ -743,6 +856,12 @@ declare namespace WebSG {
      */
     get parent(): Node | undefined;
 
+    /**
+     * Gets the id of this node. Queries that write node ids into a Uint32Array, like
+     * {@link World.overlapSphere}, write this id.
+     */
+    get id(): number;
+
     /**
      * Gets or sets whether this node is static.
      */
@@ -843,6 +962,22 @@ declare namespace WebSG {
      */
     removePhysicsBody(): undefined;
 
+    /**
+     * Gets the character controller associated with this node.
+     */
+    get characterController(): CharacterController | undefined;
+
+    /**
+     * Adds a character controller to this node. The node must have a kinematic physics body with a collider.
+     * @param {CharacterControllerProps | undefined} props Optional character controller properties.
+     */
+    addCharacterController(props?: CharacterControllerProps): CharacterController;
+
+    /**
+     * Removes the character controller from this node.
+     */
+    removeCharacterController(): undefined;
+
     /**
      * Enables orbit camera control mode for this node.
      * @param options Optional orbit options.
@@ -885,6 +1020,67 @@ declare namespace WebSG {
     Static: "static";
   };
 
+  /**
+   * Interface representing the properties for creating a CharacterController. The defaults match the player's
+   * controller.
+   */
+  interface CharacterControllerProps {
+    /**
+     * The gap kept between the character's collider and the world. Defaults to 0.01.
+     */
+    offset?: number;
+    /**
+     * The steepest slope in radians the character can walk up. Defaults to 45 degrees.
+     */
+    maxSlopeClimbAngle?: number;
+    /**
+     * The shallowest slope in radians the character slides down. Defaults to 30 degrees.
+     */
+    minSlopeSlideAngle?: number;
+    /**
+     * The tallest step the character climbs automatically, 0 disables stepping. Defaults to 0.1.
+     */
+    maxStepHeight?: number;
+    /**
+     * The minimum width of free space needed on top of a step. Defaults to 0.1.
+     */
+    minStepWidth?: number;
+    /**
+     * How far the character is pulled down to stay on the ground when walking down slopes and steps, 0 disables
+     * snapping. Defaults to 0.1.
+     */
+    snapToGround?: number;
+    /**
+     * Whether the character slides along obstacles instead of stopping. Defaults to true.
+     */
+    slide?: boolean;
+  }
+
+  /**
+   * Moves a node with a kinematic physics body through the world, resolving collisions, slopes and steps in the
+   * physics engine.
+   */
+  class CharacterController {
+    /**
+     * Whether the character was on the ground after the last move.
+     */
+    readonly grounded: boolean;
+    /**
+     * The number of colliders the character hit during the last move.
+     */
+    readonly collisionCount: number;
+    /**
+     * The world space translation applied by the last move after resolving collisions.
+     */
+    readonly movement: Vector3;
+    /**
+     * Moves the character by up to translation, which should include gravity, and returns whether it ended up on
+     * the ground.
+     * @param translation The desired world space translation for this frame.
+     */
+    move(translation: ArrayLike<number>): boolean;
+  }
+
   /**
    * Interface representing the properties for creating a PhysicsBody.
    */
@@ -926,6 +1122,47 @@ declare namespace WebSG {
      * @param impulse The impulse to apply.
      */
     applyImpulse(impulse: ArrayLike<number>): undefined;
+    /**
+     * Whether the physics engine has put this body to sleep because it stopped moving. Sleeping bodies wake up
+     * when something touches them.
+     */
+    readonly isSleeping: boolean;
+    /**
+     * Puts this body to sleep until something wakes it up.
+     */
+    sleep(): undefined;
+    /**
+     * Wakes this body up so it is simulated again.
+     */
+    wakeUp(): undefined;
+  }
+
+  /**
+   * A fixed list of physics bodies that can be read and written in a single call, for crowds, debris or anything
+   * else that drives many bodies every frame. Values are packed into Float32Arrays in the order of the nodes the
+   * batch was created with. Nodes without a physics body are skipped and their velocities read as zero.
+   * Create one with {@link WebSG.World.createPhysicsBodyBatch | world.createPhysicsBodyBatch()}.
+   */
+  class PhysicsBodyBatch {
+    /**
+     * The number of bodies in the batch.
+     */
+    readonly length: number;
+    /**
+     * Applies an impulse at the center of mass of each body.
+     * @param impulses 3 floats per body.
+     */
+    applyImpulses(impulses: Float32Array): undefined;
+    /**
+     * Writes the linear velocity xyz followed by the angular velocity xyz of each body into out and returns it.
+     * @param out 6 floats per body.
+     */
+    getVelocities(out: Float32Array): Float32Array;
+    /**
+     * Sets the linear velocity xyz and angular velocity xyz of each body.
+     * @param velocities 6 floats per body.
+     */
+    setVelocities(velocities: Float32Array): undefined;
   }
 
   class Collision {
@@ -958,11 +1195,16 @@ declare namespace WebSG {
    * A Collision Listener provides an interface for listening to collisions events between nodes with colliders.
    * Collision events are recorded for both the start and end of a collision.
    * {@link WebSG.CollisionListener.collisions | .collisions()} should be called each frame to iterate through
-   * the collisions that occurred since the last call to .collisions(). Failing to regularly call .collisions()
-   * will result in a memory leak. If you are done listening to collisions, you should call .dispose() to free
-   * up the memory used by the collision listener and stop listening to collisions.
+   * the collisions that occurred since the last call to .collisions(). Collisions are stored in a fixed size
+   * buffer, events that arrive while it is full are dropped and counted in
+   * {@link WebSG.CollisionListener.droppedCount | .droppedCount}. If you are done listening to collisions, you
+   * should call .dispose() to free up the memory used by the collision listener and stop listening to collisions.
    */
   class CollisionListener {
+    /**
+     * The total number of collisions dropped because the buffer was full.
+     */
+    readonly droppedCount: number;
     /**
      * Returns an iterator for the collisions that occurred since the last call to .collisions().
      */
@@ -973,6 +1215,106 @@ declare namespace WebSG {
     dispose(): void;
   }
 
+  /**
+   * Options for creating a collision listener.
+   */
+  interface CollisionListenerProps {
+    /**
+     * Only record collisions involving at least one of these nodes. Collisions between any nodes are recorded
+     * by default.
+     */
+    nodes?: Node[];
+    /**
+     * The number of collisions that can be buffered between calls to .collisions(). Defaults to 256. Max 65536.
+     * Rounded up to the next power of two.
+     */
+    capacity?: number;
+  }
+
+  /**
+   * Options for filtering which colliders a ray or shape cast can hit.
+   */
+  interface PhysicsQueryOptions {
+    /**
+     * Colliders attached to this node's physics body are ignored. Useful for casting from inside your own body.
+     */
+    excludeNode?: Node;
+    /**
+     * Ignore colliders on static physics bodies.
+     */
+    excludeStatic?: boolean;
+    /**
+     * Ignore colliders on kinematic physics bodies.
+     */
+    excludeKinematic?: boolean;
+    /**
+     * Ignore colliders on rigid physics bodies.
+     */
+    excludeRigid?: boolean;
+    /**
+     * Ignore trigger colliders.
+     */
+    excludeTriggers?: boolean;
+  }
+
+  /**
+   * Options for a single ray or shape cast.
+   */
+  interface PhysicsCastOptions extends PhysicsQueryOptions {
+    /**
+     * The maximum distance to cast. Defaults to Infinity.
+     */
+    maxDistance?: number;
+  }
+
+  /**
+   * The shape swept through the world by a shape cast.
+   */
+  interface PhysicsShapeProps {
+    /**
+     * The type of the shape. Hull and trimesh shapes are not supported.
+     */
+    type: Exclude<ColliderType, "hull" | "trimesh">;
+    /**
+     * The size of the shape (required for box type).
+     */
+    size?: ArrayLike<number>;
+    /**
+     * The radius of the shape (required for sphere, capsule, and cylinder types).
+     */
+    radius?: number;
+    /**
+     * The height of the shape (required for capsule and cylinder types).
+     */
+    height?: number;
+    /**
+     * The rotation of the shape while it is cast. Defaults to the identity rotation.
+     */
+    rotation?: ArrayLike<number>;
+  }
+
+  /**
+   * The result of a ray or shape cast that hit a collider.
+   */
+  class PhysicsHit {
+    /**
+     * The node the hit collider is attached to, undefined if the script doesn't have access to it.
+     */
+    readonly node: Node | undefined;
+    /**
+     * The distance along the normalized cast direction to the hit.
+     */
+    readonly distance: number;
+    /**
+     * The world space position of the hit.
+     */
+    readonly position: Vector3;
+    /**
+     * The world space surface normal of the hit collider at the hit position.
+     */
+    readonly normal: Vector3;
+  }
+
   /**
    * A Quaternion class with x, y, z, and w components. The class provides methods to set the components of the quaternion using an array-like syntax.
    */
@@ -1154,6 +1496,37 @@ declare namespace WebSG {
     label?: string;
   }
 
+  /**
+   * Describes a UI element and its children for {@link World.createUITree}. Takes the same properties as
+   * createUIElement, createUIText and createUIButton; text and label properties only apply to text and button
+   * elements.
+   */
+  interface UITreeDescription extends UIButtonProps {
+    /**
+     * The type of element to create. Defaults to "flex".
+     */
+    type?: ElementType;
+    /**
+     * The child elements, in order.
+     */
+    children?: UITreeDescription[];
+  }
+
+  /**
+   * The elements created by {@link World.createUITree}.
+   */
+  interface UITree {
+    /**
+     * The root element of the tree.
+     */
+    root: UIElement;
+    /**
+     * Every element of the tree in depth first order, starting with the root. This is the same order the elements
+     * appear in the description.
+     */
+    elements: UIElement[];
+  }
+
   /**
    * Class representing a UIButton element.
    */
@@ -1253,6 +1626,15 @@ declare namespace WebSG {
      */
     redraw(): undefined;
 
+    /**
+     * Runs callback with UI property changes recorded instead of applied, then applies them all at once and redraws
+     * the canvas. Reading a property inside the callback applies the changes recorded so far first. If callback throws,
+     * the changes that haven't been applied are discarded.
+     * @param callback The function that changes UI element properties.
+     * @returns The value returned by callback.
+     */
+    batch<T>(callback: () => T): T;
+
     /**
      * Gets the canvas size as a Vector2 in meters.
      */
@@ -2297,6 +2679,18 @@ declare namespace WebSG {
      */
     createCollider(props: ColliderProps): Collider;
 
+    /**
+     * Creates a hull or trimesh {@link WebSG.Collider | Collider } from a mesh. The shape is built from the mesh's
+     * accessors when the collider's node gets a physics body, so vertex data never passes through the script.
+     * @param mesh The mesh to build the collider from.
+     * @param options Optional collider type, trigger and simplification options.
+     *
+     * @example
+     * const terrain = world.createNode({ mesh: terrainMesh });
+     * terrain.collider = world.createColliderFromMesh(terrainMesh, { type: "trimesh", simplify: 0.25 });
+     */
+    createColliderFromMesh(mesh: Mesh, options?: MeshColliderOptions): Collider;
+
     /**
      * Finds a {@link WebSG.Collider | Collider } by its name. Returns undefined if not found.
      * @param name The name of the Collider to find.
@@ -2418,6 +2812,14 @@ declare namespace WebSG {
      */
     createUIButton(props?: UIButtonProps): UIButton;
 
+    /**
+     * Creates a whole tree of UI elements in a single call.
+     * Use this instead of creating and adding elements one at a time for large menus and panels.
+     * @param description The root element description, or an ArrayBuffer holding a CBOR encoded description.
+     * @returns The root element and all created elements in depth first order.
+     */
+    createUITree(description: UITreeDescription | ArrayBuffer): UITree;
+
     /**
      * Finds a UIElement by its name. Returns undefined if not found.
      * @param name The name of the UIElement to find.
@@ -2427,8 +2829,162 @@ declare namespace WebSG {
     /**
      * Creates a new {@link WebSG.CollisionListener | CollisionListener } for listening to
      * collisions between nodes with colliders set on them.
+     * @param props Optional node filter and buffer capacity.
      */
-    createCollisionListener(): CollisionListener;
+    createCollisionListener(props?: CollisionListenerProps): CollisionListener;
+
+    /**
+     * Casts a ray and returns the closest hit, or undefined if nothing was hit.
+     * @param origin The world space origin of the ray.
+     * @param direction The world space direction of the ray. Doesn't need to be normalized.
+     * @param options Optional max distance and filters.
+     */
+    castRay(
+      origin: ArrayLike<number>,
+      direction: ArrayLike<number>,
+      options?: PhysicsCastOptions
+    ): PhysicsHit | undefined;
+
+    /**
+     * Casts many rays in a single call. Each ray is 7 consecutive floats: origin xyz, direction xyz and max
+     * distance. Returns the closest hit for each ray in the same order, undefined for rays that hit nothing.
+     * The rays are read in place, so reusing the same Float32Array every frame avoids copying them.
+     * @param rays The packed rays.
+     * @param options Optional filters applied to every ray.
+     *
+     * @example
+     * const rays = new Float32Array(7 * 2);
+     * rays.set([0, 1, 0, 0, -1, 0, 10], 0); // down
+     * rays.set([0, 1, 0, 0, 0, -1, 20], 7); // forward
+     * const [ground, wall] = world.castRays(rays, { excludeNode: player });
+     */
+    castRays(rays: Float32Array, options?: PhysicsQueryOptions): (PhysicsHit | undefined)[];
+
+    /**
+     * Creates a {@link WebSG.PhysicsBodyBatch | PhysicsBodyBatch} for applying impulses to and reading or writing
+     * the velocities of many physics bodies at once.
+     * @param nodes The nodes whose physics bodies are in the batch.
+     *
+     * @example
+     * const batch = world.createPhysicsBodyBatch(debris);
+     * const velocities = new Float32Array(batch.length * 6);
+     *
+     * world.onupdate = () => {
+     *   batch.getVelocities(velocities);
+     *   // ...damp or steer the velocities
+     *   batch.setVelocities(velocities);
+     * };
+     */
+    createPhysicsBodyBatch(nodes: Node[]): PhysicsBodyBatch;
+
+    /**
+     * Returns the nodes whose physics bodies are awake. Settled bodies are skipped without being visited, so
+     * scripts can update only what moved.
+     *
+     * @example
+     * world.onupdate = () => {
+     *   for (const node of world.getActiveBodies()) {
+     *     // ...
+     *   }
+     * };
+     */
+    getActiveBodies(): Node[];
+    /**
+     * Writes the ids of the nodes whose physics bodies are awake into out, without allocating. Returns the number of
+     * awake bodies, which can be more than out.length, in which case only the first out.length ids are written.
+     * @param out The array the node ids are written to.
+     */
+    getActiveBodies(out: Uint32Array): number;
+
+    /**
+     * Returns every node with a collider that overlaps a sphere, using the physics broadphase instead of checking
+     * each node. Each node is returned once even if several of its colliders overlap.
+     * @param center The world space center of the sphere.
+     * @param radius The radius of the sphere.
+     * @param options Optional filters.
+     *
+     * @example
+     * const nearby = world.overlapSphere(player.translation, 5, { excludeNode: player });
+     */
+    overlapSphere(center: ArrayLike<number>, radius: number, options?: PhysicsQueryOptions): Node[];
+    /**
+     * Writes the ids of the nodes with a collider that overlaps a sphere into out, without allocating. Returns the
+     * number of overlapping nodes, which can be more than out.length, in which case only the first out.length ids
+     * are written.
+     * @param center The world space center of the sphere.
+     * @param radius The radius of the sphere.
+     * @param options Optional filters.
+     * @param out The array the node ids are written to.
+     *
+     * @example
+     * const nearbyIds = new Uint32Array(32);
+     *
+     * world.onupdate = () => {
+     *   const count = Math.min(world.overlapSphere(player.translation, 5, undefined, nearbyIds), nearbyIds.length);
+     *
+     *   for (let i = 0; i < count; i++) {
+     *     const node = interactablesById.get(nearbyIds[i]);
+     *     // ...
+     *   }
+     * };
+     */
+    overlapSphere(
+      center: ArrayLike<number>,
+      radius: number,
+      options: PhysicsQueryOptions | undefined,
+      out: Uint32Array
+    ): number;
+
+    /**
+     * Returns every node with a collider that overlaps an axis aligned box. Each node is returned once even if
+     * several of its colliders overlap.
+     * @param center The world space center of the box.
+     * @param size The width, height and depth of the box.
+     * @param options Optional filters.
+     */
+    overlapBox(center: ArrayLike<number>, size: ArrayLike<number>, options?: PhysicsQueryOptions): Node[];
+    /**
+     * Writes the ids of the nodes with a collider that overlaps an axis aligned box into out, without allocating.
+     * Returns the number of overlapping nodes, which can be more than out.length.
+     * @param center The world space center of the box.
+     * @param size The width, height and depth of the box.
+     * @param options Optional filters.
+     * @param out The array the node ids are written to.
+     */
+    overlapBox(
+      center: ArrayLike<number>,
+      size: ArrayLike<number>,
+      options: PhysicsQueryOptions | undefined,
+      out: Uint32Array
+    ): number;
+
+    /**
+     * Sweeps a shape through the world and returns the first hit, or undefined if nothing was hit.
+     * @param shape The shape to cast.
+     * @param origin The world space position the shape starts at.
+     * @param direction The world space direction to sweep the shape in. Doesn't need to be normalized.
+     * @param options Optional max distance and filters.
+     */
+    castShape(
+      shape: PhysicsShapeProps,
+      origin: ArrayLike<number>,
+      direction: ArrayLike<number>,
+      options?: PhysicsCastOptions
+    ): PhysicsHit | undefined;
+
+    /**
+     * Sweeps the same shape along many paths in a single call. Each cast is 7 consecutive floats: origin xyz,
+     * direction xyz and max distance. Returns the first hit for each cast in the same order, undefined for casts
+     * that hit nothing.
+     * @param shape The shape to cast.
+     * @param casts The packed casts.
+     * @param options Optional filters applied to every cast.
+     */
+    castShapes(
+      shape: PhysicsShapeProps,
+      casts: Float32Array,
+      options?: PhysicsQueryOptions
+    ): (PhysicsHit | undefined)[];
 
     /**
      * Returns the maximum number of components per type that can be stored in the world.
@@ -2496,9 +3052,37 @@ declare namespace WebSGNetworking {
     get isLocal(): boolean;
     get translation(): WebSG.Vector3;
     get rotation(): WebSG.Quaternion;
+    /**
+     * Traffic exchanged with this peer by the whole engine as well as the estimated
+     * round trip time and packet loss to the peer.
+     */
+    get stats(): NetworkStats;
     send(message: string | ArrayBuffer, reliable: boolean): undefined;
   }
 
+  /**
+   * A snapshot of network traffic counters. Counters are cumulative since the script was loaded.
+   */
+  class NetworkStats {
+    bytesSent: number;
+    messagesSent: number;
+    bytesReceived: number;
+    messagesReceived: number;
+    /**
+     * Smoothed round trip time in milliseconds. Averaged across all connected peers for
+     * {@link WebSGNetworking.Network.stats | network.stats}. Always 0 for listener stats.
+     */
+    rtt: number;
+    /**
+     * Estimated fraction of packets lost, between 0 and 1. Averaged like rtt.
+     */
+    packetLoss: number;
+    /**
+     * Messages that weren't sent because the outgoing queue was full. Always 0 for listener stats.
+     */
+    messagesDropped: number;
+  }
+
   class NetworkMessage {
     peer: Peer;
     data: ArrayBuffer | string;
@@ -2532,6 +3116,11 @@ declare namespace WebSGNetworking {
      */
     receive(buffer?: ArrayBuffer): NetworkMessageIterator;
 
+    /**
+     * The messages received by this listener.
+     */
+    get stats(): NetworkStats;
+
     /**
      * Closes the listener and frees its resources.
      */
@@ -2615,6 +3204,11 @@ declare namespace WebSGNetworking {
      */
     listen(): NetworkListener;
 
+    /**
+     * The messages sent and received by this script. rtt and packetLoss are averaged across all connected peers.
+     */
+    get stats(): NetworkStats;
+
     /**
      * Broadcasts data to all connected clients.
      * @param data - The data to be broadcasted.
@@ -2640,6 +3234,15 @@ declare namespace WebSGNetworking {
      * @param factory - A function called whenever a new node is spawned.
      */
     defineReplicator(factory: () => WebSG.Node): Replicator;
+
+    /**
+     * Sets how important a networked node's updates are relative to other networked nodes.
+     * Each tick the most important updates are sent first until the peer's bandwidth budget is used up.
+     * Priority is also scaled up by the node's velocity and down by its distance to each peer.
+     * @param node - The networked node.
+     * @param priority - Priority multiplier, defaults to 1. Must be greater than or equal to 0.
+     */
+    setPriority(node: WebSG.Node, priority: number): undefined;
   }
 }
 
@@ -2789,6 +3392,24 @@ declare namespace Matrix {
 
   type MatrixAPIMessage = MatrixWidgetAPIRequest | MatrixWidgetAPIResponse | MatrixWidgetAPIErrorResponse;
 
+  /**
+   * MatrixEventFilter interface describes which room events a script wants to receive. Unset fields match any value.
+   */
+  interface MatrixEventFilter {
+    /**
+     * The event type to match, for example "m.room.message".
+     */
+    type?: string;
+    /**
+     * The state key to match. An empty string only matches state events with an empty state key.
+     */
+    stateKey?: string;
+    /**
+     * The user ID of the event sender to match.
+     */
+    sender?: string;
+  }
+
   /**
    * MatrixWidgetAPI interface represents the Matrix widget API methods for sending and receiving messages.
    */
@@ -2811,12 +3432,34 @@ declare namespace Matrix {
      */
     receive(): MatrixAPIMessage | undefined;
 
+    /**
+     * Receives every pending Matrix API message in the order they arrived with a single call to the host.
+     * Prefer this over calling receive() in a loop.
+     * @returns {MatrixAPIMessage[]} - The received Matrix API messages, empty if no messages are available.
+     */
+    receiveAll(): MatrixAPIMessage[];
+
     /**
      * Sends a Matrix API message.
      * @param {MatrixAPIMessage} event - The Matrix API message to send.
      * @returns {undefined}
      */
     send(event: MatrixAPIMessage): undefined;
+
+    /**
+     * Registers a room event filter. Once any filter is registered, only room events matching at least one filter
+     * are delivered to the script; events that don't match are never copied into script memory. Other Matrix API
+     * messages, such as responses to the script's own requests, are always delivered.
+     * @param {MatrixEventFilter} filter - The filter to add.
+     * @returns {undefined}
+     */
+    addEventFilter(filter: MatrixEventFilter): undefined;
+
+    /**
+     * Removes all room event filters so that every room event is delivered again.
+     * @returns {undefined}
+     */
+    clearEventFilters(): undefined;
   }
 }
 
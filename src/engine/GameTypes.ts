@@ -4,9 +4,12 @@ import { GLTFComponentDefinition } from "./gltf/GLTF";
 import { GLTFResource } from "./gltf/gltf.game";
 import { BaseThreadContext } from "./module/module.common";
 import { ComponentStore } from "./resource/ComponentStore";
+import { ResourceOwnership } from "./resource/ResourceOwnership";
 import { RemoteResource } from "./resource/RemoteResourceClass";
 import { RemoteWorld } from "./resource/RemoteResources";
 import { Replicator } from "./network/Replicator";
+import { NetworkTrafficStats } from "./network/NetworkStats";
+import { MatrixEventFilter } from "./matrix/matrix.common";
 
 export type World = IWorld;
 
@@ -23,7 +26,12 @@ export interface Collision {
 
 export interface CollisionListener {
   id: number;
-  collisions: Collision[];
+  // only collisions involving one of these nodes are recorded
+  nodes?: Set<number>;
+  // pointer to the CollisionRing in script memory
+  ringPtr?: number;
+  // queued collisions for listeners created by runtimes built before collision rings
+  collisions?: Collision[];
 }
 
 export interface ActionBarListener {
@@ -34,12 +42,13 @@ export interface ActionBarListener {
 export interface NetworkListener {
   id: number;
   inbound: [string, ArrayBuffer, boolean][];
+  stats: NetworkTrafficStats;
 }
 
 export interface RemoteResourceManager {
   id: string;
   ctx: GameContext;
-  resourceIds: Set<number>;
+  ownership: ResourceOwnership;
   resourceMap: Map<number, string | ArrayBuffer | RemoteResource>;
   gltfCache: Map<string, ResourceManagerGLTFCacheEntry>;
   nextQueryId: number;
@@ -60,8 +69,10 @@ export interface RemoteResourceManager {
   nextReplicatorId: number;
   matrixListening: boolean;
   inboundMatrixWidgetMessages: Uint8Array[];
+  matrixEventFilters: MatrixEventFilter[];
   networkListeners: NetworkListener[];
   nextNetworkListenerId: number;
+  networkStats: NetworkTrafficStats;
 }
 
 export interface GameContext extends BaseThreadContext {
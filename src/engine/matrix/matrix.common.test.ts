@@ -0,0 +1,38 @@
+import { strictEqual } from "assert";
+
+import { matchesMatrixEventFilters, WidgetAPI, WidgetAction, WidgetAPIRequest } from "./matrix.common";
+
+const roomEvent = (data: {}): WidgetAPIRequest => ({
+  api: WidgetAPI.ToWidget,
+  requestId: "1",
+  action: WidgetAction.SendEvent,
+  widgetId: "test",
+  data,
+});
+
+const message = roomEvent({ type: "m.room.message", sender: "@alice:example.org", content: {} });
+const stateEvent = roomEvent({ type: "m.room.topic", state_key: "", sender: "@bob:example.org", content: {} });
+
+describe("matchesMatrixEventFilters", () => {
+  test("deliver everything without filters", () => {
+    strictEqual(matchesMatrixEventFilters([], message), true);
+  });
+
+  test("match any filter", () => {
+    strictEqual(matchesMatrixEventFilters([{ type: "m.room.message" }], message), true);
+    strictEqual(matchesMatrixEventFilters([{ type: "m.room.message" }], stateEvent), false);
+    const filters = [{ type: "m.room.message" }, { sender: "@bob:example.org" }];
+    strictEqual(matchesMatrixEventFilters(filters, stateEvent), true);
+  });
+
+  test("require every field of a filter", () => {
+    strictEqual(matchesMatrixEventFilters([{ type: "m.room.message", sender: "@bob:example.org" }], message), false);
+    strictEqual(matchesMatrixEventFilters([{ type: "m.room.topic", stateKey: "" }], stateEvent), true);
+    strictEqual(matchesMatrixEventFilters([{ stateKey: "" }], message), false);
+  });
+
+  test("always deliver other widget messages", () => {
+    const response = { ...message, api: WidgetAPI.FromWidget, action: WidgetAction.ReadEvents, response: {} };
+    strictEqual(matchesMatrixEventFilters([{ type: "m.room.topic" }], response), true);
+  });
+});
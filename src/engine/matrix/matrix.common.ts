@@ -39,6 +39,39 @@ export interface WidgetAPIErrorResponse extends WidgetAPIResponse {
   };
 }
 
+// Registered by scripts to only receive the room events they care about. Unset fields match any value.
+export interface MatrixEventFilter {
+  type?: string;
+  stateKey?: string;
+  sender?: string;
+}
+
+/**
+ * Returns true if the widget message should be delivered to a script with the given filters. Only room events sent
+ * to the widget are filtered, every other widget API message is always delivered.
+ */
+export function matchesMatrixEventFilters(filters: MatrixEventFilter[], message: WidgetMessage["message"]) {
+  if (filters.length === 0 || message.api !== WidgetAPI.ToWidget || message.action !== WidgetAction.SendEvent) {
+    return true;
+  }
+
+  const event = message.data as Partial<ClientEvent>;
+
+  for (let i = 0; i < filters.length; i++) {
+    const { type, stateKey, sender } = filters[i];
+
+    if (
+      (type === undefined || type === event.type) &&
+      (stateKey === undefined || stateKey === event.state_key) &&
+      (sender === undefined || sender === event.sender)
+    ) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 // https://spec.matrix.org/v1.5/client-server-api/#types-of-room-events
 export interface ClientEvent<Content = {}> {
   content: Content;
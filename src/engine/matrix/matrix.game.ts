@@ -1,20 +1,23 @@
 import { GameContext } from "../GameTypes";
-import { defineModule, getModule, registerMessageHandler, Thread } from "../module/module.common";
+import { defineModule, registerMessageHandler, Thread } from "../module/module.common";
 import { ScriptComponent, scriptQuery } from "../scripting/scripting.game";
-import { readString, WASMModuleContext, writeEncodedString } from "../scripting/WASMModuleContext";
+import {
+  readString,
+  readUint8Array,
+  WASMModuleContext,
+  writeEncodedString,
+  writeUint8Array,
+} from "../scripting/WASMModuleContext";
 import { createDisposables } from "../utils/createDisposables";
-import { MatrixMessageType, WidgetMessage } from "./matrix.common";
+import { CBORMajorType, decodeCBOR, encodeCBOR, getCBORHeadByteLength, writeCBORHead } from "../utils/cbor";
+import { matchesMatrixEventFilters, MatrixMessageType, WidgetMessage } from "./matrix.common";
 
-interface MatrixModuleState {
-  textEncoder: TextEncoder;
-}
+interface MatrixModuleState {}
 
 export const MatrixModule = defineModule<GameContext, MatrixModuleState>({
   name: "matrix",
   create: () => {
-    return {
-      textEncoder: new TextEncoder(),
-    };
+    return {};
   },
   init(ctx: GameContext) {
     return createDisposables([registerMessageHandler(ctx, MatrixMessageType.WidgetMessage, onWidgetMessage)]);
@@ -22,28 +25,57 @@ export const MatrixModule = defineModule<GameContext, MatrixModuleState>({
 });
 
 function onWidgetMessage(ctx: GameContext, message: WidgetMessage) {
-  const { textEncoder } = getModule(ctx, MatrixModule);
-
   const scripts = scriptQuery(ctx.world);
 
+  // encoded once and shared by every listening script, events filtered out by every script are never encoded
+  let encodedMessage: Uint8Array | undefined;
+
   for (let i = 0; i < scripts.length; i++) {
     const script = ScriptComponent.get(scripts[i]);
 
     if (!script) {
-      return;
+      continue;
     }
 
     const resourceManager = script.wasmCtx.resourceManager;
 
-    if (resourceManager.matrixListening) {
-      const json = JSON.stringify(message.message);
-      const encodedMessage = textEncoder.encode(json);
+    if (
+      resourceManager.matrixListening &&
+      matchesMatrixEventFilters(resourceManager.matrixEventFilters, message.message)
+    ) {
+      if (!encodedMessage) {
+        encodedMessage = encodeCBOR(message.message);
+      }
+
       resourceManager.inboundMatrixWidgetMessages.push(encodedMessage);
     }
   }
 }
 
+function getEventsByteLength(messages: Uint8Array[]) {
+  let byteLength = getCBORHeadByteLength(messages.length);
+
+  for (let i = 0; i < messages.length; i++) {
+    byteLength += messages[i].byteLength;
+  }
+
+  return byteLength;
+}
+
 export function createMatrixWASMModule(ctx: GameContext, wasmCtx: WASMModuleContext) {
+  // get_event_size and receive are called back to back for the same event
+  let lastCBOREvent: Uint8Array | undefined;
+  let lastJSONEvent: Uint8Array | undefined;
+
+  function getJSONEvent(cborEvent: Uint8Array) {
+    if (cborEvent !== lastCBOREvent || !lastJSONEvent) {
+      lastCBOREvent = cborEvent;
+      lastJSONEvent = wasmCtx.textEncoder.encode(JSON.stringify(decodeCBOR(cborEvent)));
+    }
+
+    return lastJSONEvent;
+  }
+
   const matrixWASMModule = {
     listen() {
       const resourceManager = wasmCtx.resourceManager;
@@ -66,11 +98,34 @@ export function createMatrixWASMModule(ctx: GameContext, wasmCtx: WASMModuleCont
       resourceManager.matrixListening = false;
       return 0;
     },
-    send(eventPtr: number, byteLength: number) {
+    add_event_filter(
+      typePtr: number,
+      typeByteLength: number,
+      stateKeyPtr: number,
+      stateKeyByteLength: number,
+      senderPtr: number,
+      senderByteLength: number
+    ) {
       try {
-        const eventStr = readString(wasmCtx, eventPtr, byteLength);
-
-        const event = JSON.parse(eventStr);
+        // a null pointer matches any value, an empty string only matches an empty value
+        wasmCtx.resourceManager.matrixEventFilters.push({
+          type: typePtr ? readString(wasmCtx, typePtr, typeByteLength) : undefined,
+          stateKey: stateKeyPtr ? readString(wasmCtx, stateKeyPtr, stateKeyByteLength) : undefined,
+          sender: senderPtr ? readString(wasmCtx, senderPtr, senderByteLength) : undefined,
+        });
+        return 0;
+      } catch (error) {
+        console.error("Matrix: Error adding event filter: ", error);
+        return -1;
+      }
+    },
+    clear_event_filters() {
+      wasmCtx.resourceManager.matrixEventFilters.length = 0;
+      return 0;
+    },
+    send_cbor(eventPtr: number, byteLength: number) {
+      try {
+        const event = decodeCBOR(readUint8Array(wasmCtx, eventPtr, byteLength));
 
         ctx.sendMessage<WidgetMessage>(Thread.Main, {
           type: MatrixMessageType.WidgetMessage,
@@ -83,12 +138,12 @@ export function createMatrixWASMModule(ctx: GameContext, wasmCtx: WASMModuleCont
         return -1;
       }
     },
-    get_event_size() {
+    get_event_size_cbor() {
       const resourceManager = wasmCtx.resourceManager;
       const messages = resourceManager.inboundMatrixWidgetMessages;
-      return messages.length === 0 ? 0 : messages[messages.length - 1].byteLength + 1;
+      return messages.length === 0 ? 0 : messages[messages.length - 1].byteLength;
     },
-    receive(eventBufPtr: number, maxBufLength: number) {
+    receive_cbor(eventBufPtr: number, maxBufLength: number) {
       const resourceManager = wasmCtx.resourceManager;
       try {
         if (!resourceManager.matrixListening) {
@@ -107,18 +162,110 @@ export function createMatrixWASMModule(ctx: GameContext, wasmCtx: WASMModuleCont
           return -1;
         }
 
-        return writeEncodedString(wasmCtx, eventBufPtr, message);
+        return writeUint8Array(wasmCtx, eventBufPtr, message);
       } catch (error) {
         console.error("Matrix: Error receiving event: ", error);
         return -1;
       }
     },
+    // JSON string versions of send_cbor, get_event_size_cbor and receive_cbor used by runtimes built before events
+    // were CBOR encoded. Events are queued CBOR encoded, so they're converted to JSON on receive.
+    send(eventPtr: number, byteLength: number) {
+      try {
+        const event = JSON.parse(readString(wasmCtx, eventPtr, byteLength));
+
+        ctx.sendMessage<WidgetMessage>(Thread.Main, {
+          type: MatrixMessageType.WidgetMessage,
+          message: event,
+        });
+
+        return 0;
+      } catch (error) {
+        console.error("Matrix: Error sending event", error);
+        return -1;
+      }
+    },
+    get_event_size() {
+      const messages = wasmCtx.resourceManager.inboundMatrixWidgetMessages;
+      // includes the null terminator
+      return messages.length === 0 ? 0 : getJSONEvent(messages[messages.length - 1]).byteLength + 1;
+    },
+    receive(eventBufPtr: number, maxBufLength: number) {
+      const resourceManager = wasmCtx.resourceManager;
+      try {
+        if (!resourceManager.matrixListening) {
+          console.error("Matrix: Cannot receive events in a closed state.");
+          return -1;
+        }
+
+        const message = resourceManager.inboundMatrixWidgetMessages.pop();
+
+        if (!message) {
+          return 0;
+        }
+
+        const jsonMessage = getJSONEvent(message);
+
+        if (jsonMessage.byteLength + 1 > maxBufLength) {
+          console.error("Matrix: Error receiving event: Packet is larger than target buffer.");
+          return -1;
+        }
+
+        return writeEncodedString(wasmCtx, eventBufPtr, jsonMessage);
+      } catch (error) {
+        console.error("Matrix: Error receiving event: ", error);
+        return -1;
+      }
+    },
+    get_events_size() {
+      const messages = wasmCtx.resourceManager.inboundMatrixWidgetMessages;
+      return messages.length === 0 ? 0 : getEventsByteLength(messages);
+    },
+    receive_events(eventsBufPtr: number, maxBufLength: number) {
+      const resourceManager = wasmCtx.resourceManager;
+      try {
+        if (!resourceManager.matrixListening) {
+          console.error("Matrix: Cannot receive events in a closed state.");
+          return -1;
+        }
+
+        const messages = resourceManager.inboundMatrixWidgetMessages;
+
+        if (messages.length === 0) {
+          return 0;
+        }
+
+        if (getEventsByteLength(messages) > maxBufLength) {
+          console.error("Matrix: Error receiving events: Events are larger than target buffer.");
+          return -1;
+        }
+
+        // the queued events are already CBOR encoded, so the batch is just an array head followed by each event
+        const heap = wasmCtx.U8Heap;
+        let ptr = eventsBufPtr + writeCBORHead(heap, eventsBufPtr, CBORMajorType.Array, messages.length);
+
+        for (let i = 0; i < messages.length; i++) {
+          heap.set(messages[i], ptr);
+          ptr += messages[i].byteLength;
+        }
+
+        messages.length = 0;
+
+        return ptr - eventsBufPtr;
+      } catch (error) {
+        console.error("Matrix: Error receiving events: ", error);
+        return -1;
+      }
+    },
   };
 
   const disposeMatrixWASMModule = () => {
     const resourceManager = wasmCtx.resourceManager;
     resourceManager.matrixListening = false;
     resourceManager.inboundMatrixWidgetMessages.length = 0;
+    resourceManager.matrixEventFilters.length = 0;
+    lastCBOREvent = undefined;
+    lastJSONEvent = undefined;
   };
 
   return [matrixWASMModule, disposeMatrixWASMModule] as const;
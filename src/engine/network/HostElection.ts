@@ -5,7 +5,7 @@ const GATHERING_PEERS_PERIOD = 5 * 1000;
 const HOST_CONNECTION_TIMEOUT = 30 * 1000;
 const LAST_RECEIVED_MESSAGE_TIMEOUT = 5 * 1000;
 
-interface Member {
+export interface Member {
   userId: string;
   deviceId: string;
   displayName: string;
@@ -25,9 +25,9 @@ interface Peer {
   connected: boolean;
 }
 
-const getPeerId = (userId: string, deviceId: string) => `${userId},${deviceId}`;
+export const getPeerId = (userId: string, deviceId: string) => `${userId},${deviceId}`;
 
-enum HostConnectionState {
+export enum HostConnectionState {
   Disconnected, // We are not currently connected to a room.
   GatheringPeers, // We're waiting for the initial WebRTC connections to be established.
   Connecting, // We've picked a host but we're not connected yet.
@@ -35,7 +35,7 @@ enum HostConnectionState {
   Error, // Connection to a host could not be established.
 }
 
-interface NetworkModuleState {
+export interface NetworkModuleState {
   hostConnectionState: HostConnectionState;
   localPeerId?: string;
   currentRoomId?: string;
@@ -170,11 +170,13 @@ export function updateConnectionStates(ctx: GameContext, network: NetworkModuleS
   }
 
   const gatheringPeersFinished =
-    network.hostConnectionState === HostConnectionState.GatheringPeers && network.gatheringPeersTimeout > ctx.elapsed;
+    network.hostConnectionState === HostConnectionState.GatheringPeers && ctx.elapsed >= network.gatheringPeersTimeout;
   const hostTimeout = network.hostConnectionState === HostConnectionState.Connected && !network.currentHost?.connected;
   const peersChanged = network.hostConnectionState === HostConnectionState.Connected && network.hostNeedsUpdate;
 
   if (gatheringPeersFinished || hostTimeout || peersChanged) {
+    network.hostNeedsUpdate = false;
+
     // If we just finished gathering peers we can allow picking a host that's not yet connected.
     // If we lost connection to the host or we're connected to a host and may be reelecting. Use the connected peers.
     const hostCandidates = gatheringPeersFinished ? [...network.peers] : network.peers.filter((peer) => peer.connected);
@@ -187,6 +189,7 @@ export function updateConnectionStates(ctx: GameContext, network: NetworkModuleS
         type: "host-connection-error",
         error: "Couldn't find new host.",
       });
+      return;
     }
 
     const nextHost = sortedHostCandidates[0];
@@ -0,0 +1,76 @@
+import { bench, describe } from "vitest";
+import { availableRead } from "@thirdroom/ringbuffer";
+
+import {
+  createLoopbackSimulation,
+  getLoopbackSimulationReport,
+  LoopbackPeerUpdate,
+  LoopbackSimulation,
+  stepLoopbackSimulation,
+} from "./LoopbackTransport";
+import { dequeueNetworkRingBuffer, enqueueNetworkRingBuffer } from "./RingBuffer";
+
+// Run with `yarn bench`. Each iteration is one frame of every peer running the same workload, so the reported
+// time per iteration is the transport's per-frame cost as the room grows. Throughput is logged after each run.
+// Script execution isn't included, the workload only generates a script's traffic pattern.
+
+const PEER_COUNTS = [2, 4, 8, 16, 32];
+const STATE_MESSAGE_BYTES = 64;
+const RELIABLE_MESSAGE_INTERVAL = 10;
+
+const ringOut = { packet: new ArrayBuffer(0), peerId: "", broadcast: false };
+const statePacket = new ArrayBuffer(STATE_MESSAGE_BYTES);
+const statePacketView = new Float32Array(statePacket);
+
+// The traffic of a typical networked script: read every message received this frame, then broadcast its own
+// state unreliably each frame and an event reliably every few frames.
+const broadcastStateWorkload = (): LoopbackPeerUpdate => {
+  let frame = 0;
+
+  return (peer, loopback, dt, time) => {
+    let checksum = 0;
+
+    while (availableRead(peer.incomingReliableRingBuffer)) {
+      dequeueNetworkRingBuffer(peer.incomingReliableRingBuffer, ringOut);
+      checksum += ringOut.packet.byteLength;
+    }
+
+    while (availableRead(peer.incomingUnreliableRingBuffer)) {
+      dequeueNetworkRingBuffer(peer.incomingUnreliableRingBuffer, ringOut);
+      checksum += new Float32Array(ringOut.packet)[0];
+    }
+
+    statePacketView[0] = time;
+    statePacketView[1] = checksum;
+    enqueueNetworkRingBuffer(peer.outgoingUnreliableRingBuffer, "", statePacket, true);
+
+    if (frame++ % RELIABLE_MESSAGE_INTERVAL === 0) {
+      enqueueNetworkRingBuffer(peer.outgoingReliableRingBuffer, "", statePacket, true);
+    }
+  };
+};
+
+describe("LoopbackTransport", () => {
+  for (const peerCount of PEER_COUNTS) {
+    let simulation: LoopbackSimulation;
+
+    bench(
+      `${peerCount} peers`,
+      () => {
+        stepLoopbackSimulation(simulation);
+      },
+      {
+        setup() {
+          simulation = createLoopbackSimulation(peerCount, broadcastStateWorkload(), {
+            latency: 50,
+            jitter: 20,
+            loss: 0.01,
+          });
+        },
+        teardown() {
+          console.table([getLoopbackSimulationReport(simulation)]);
+        },
+      }
+    );
+  }
+});
@@ -0,0 +1,94 @@
+import { strictEqual, ok } from "assert";
+import { availableRead } from "@thirdroom/ringbuffer";
+
+import { addLoopbackPeer, createLoopbackTransport, stepLoopbackTransport } from "./LoopbackTransport";
+import { dequeueNetworkRingBuffer, enqueueNetworkRingBuffer, NetworkRingBuffer } from "./RingBuffer";
+
+const packetOf = (value: number) => new Uint8Array([value]).buffer;
+
+const receiveAll = (rb: NetworkRingBuffer) => {
+  const out = { packet: new ArrayBuffer(0), peerId: "", broadcast: false };
+  const received: [string, number][] = [];
+
+  while (availableRead(rb)) {
+    dequeueNetworkRingBuffer(rb, out);
+    received.push([out.peerId, new Uint8Array(out.packet)[0]]);
+  }
+
+  return received;
+};
+
+describe("LoopbackTransport", () => {
+  test("broadcast to every other peer", () => {
+    const loopback = createLoopbackTransport();
+    const a = addLoopbackPeer(loopback, "a");
+    const b = addLoopbackPeer(loopback, "b");
+    const c = addLoopbackPeer(loopback, "c");
+
+    enqueueNetworkRingBuffer(a.outgoingReliableRingBuffer, "", packetOf(1), true);
+    enqueueNetworkRingBuffer(b.outgoingUnreliableRingBuffer, "c", packetOf(2));
+    stepLoopbackTransport(loopback, 0);
+
+    strictEqual(receiveAll(a.incomingReliableRingBuffer).length, 0);
+    strictEqual(receiveAll(b.incomingReliableRingBuffer)[0][0], "a");
+    strictEqual(receiveAll(c.incomingReliableRingBuffer)[0][1], 1);
+    strictEqual(receiveAll(c.incomingUnreliableRingBuffer)[0][0], "b");
+
+    strictEqual(a.stats.messagesSent, 2);
+    strictEqual(c.stats.messagesReceived, 2);
+    strictEqual(loopback.delivered, 3);
+  });
+
+  test("delay delivery by latency", () => {
+    const loopback = createLoopbackTransport({ latency: 50 });
+    const a = addLoopbackPeer(loopback, "a");
+    const b = addLoopbackPeer(loopback, "b");
+
+    enqueueNetworkRingBuffer(a.outgoingReliableRingBuffer, "b", packetOf(1));
+    stepLoopbackTransport(loopback, 0);
+    strictEqual(availableRead(b.incomingReliableRingBuffer), 0);
+
+    stepLoopbackTransport(loopback, 49);
+    strictEqual(availableRead(b.incomingReliableRingBuffer), 0);
+
+    stepLoopbackTransport(loopback, 50);
+    strictEqual(receiveAll(b.incomingReliableRingBuffer).length, 1);
+  });
+
+  test("keep reliable packets in order under jitter", () => {
+    const loopback = createLoopbackTransport({ latency: 20, jitter: 100 });
+    const a = addLoopbackPeer(loopback, "a");
+    const b = addLoopbackPeer(loopback, "b");
+
+    for (let i = 0; i < 20; i++) {
+      enqueueNetworkRingBuffer(a.outgoingReliableRingBuffer, "b", packetOf(i));
+      stepLoopbackTransport(loopback, i);
+    }
+
+    stepLoopbackTransport(loopback, 1000);
+
+    const received = receiveAll(b.incomingReliableRingBuffer).map(([, value]) => value);
+    strictEqual(received.length, 20);
+
+    for (let i = 0; i < received.length; i++) {
+      strictEqual(received[i], i);
+    }
+  });
+
+  test("drop unreliable packets", () => {
+    const loopback = createLoopbackTransport({ loss: 0.5 });
+    const a = addLoopbackPeer(loopback, "a");
+    const b = addLoopbackPeer(loopback, "b");
+
+    for (let i = 0; i < 40; i++) {
+      enqueueNetworkRingBuffer(a.outgoingUnreliableRingBuffer, "b", packetOf(i));
+      enqueueNetworkRingBuffer(a.outgoingReliableRingBuffer, "b", packetOf(i));
+      stepLoopbackTransport(loopback, i);
+    }
+
+    const unreliable = receiveAll(b.incomingUnreliableRingBuffer).length;
+    ok(unreliable > 0 && unreliable < 40);
+    strictEqual(loopback.dropped, 40 - unreliable);
+    strictEqual(receiveAll(b.incomingReliableRingBuffer).length, 40);
+  });
+});
@@ -0,0 +1,327 @@
+import { availableRead } from "@thirdroom/ringbuffer";
+
+import {
+  createNetworkRingBuffer,
+  dequeueNetworkRingBuffer,
+  enqueueNetworkRingBuffer,
+  NetworkRingBuffer,
+} from "./RingBuffer";
+import { createNetworkTrafficStats, NetworkTrafficStats, recordReceived, recordSent } from "./NetworkStats";
+
+/**
+ * A headless transport that connects any number of simulated peers in a single process. Each peer owns the
+ * same four ring buffers the main thread shares with the game thread and the transport moves packets between
+ * them with simulated latency, jitter and loss. It only models the transport: peers are driven by a
+ * LoopbackPeerUpdate callback. test/engine/network/LoopbackGame.ts runs a game context and a script instance
+ * for each peer on top of it.
+ */
+
+export interface LoopbackTransportOptions {
+  // one way delay in milliseconds
+  latency: number;
+  // extra random delay in milliseconds, uniformly distributed between 0 and jitter
+  jitter: number;
+  // probability (0 - 1) that an unreliable packet is dropped
+  loss: number;
+  // seeds the random number generator so runs are reproducible
+  seed: number;
+  // slots in each of a peer's ring buffers, 16KB each
+  ringBufferCapacity: number;
+}
+
+export interface LoopbackPeer {
+  peerId: string;
+  incomingReliableRingBuffer: NetworkRingBuffer;
+  incomingUnreliableRingBuffer: NetworkRingBuffer;
+  outgoingReliableRingBuffer: NetworkRingBuffer;
+  outgoingUnreliableRingBuffer: NetworkRingBuffer;
+  stats: NetworkTrafficStats;
+}
+
+interface InFlightPacket {
+  from: string;
+  to: string;
+  packet: ArrayBuffer;
+  reliable: boolean;
+  deliverAt: number;
+}
+
+export interface LoopbackTransport {
+  options: LoopbackTransportOptions;
+  peers: LoopbackPeer[];
+  peerIdToPeer: Map<string, LoopbackPeer>;
+  inFlight: InFlightPacket[];
+  // "from->to" -> delivery time of the last reliable packet, reliable packets are never reordered
+  lastReliableDelivery: Map<string, number>;
+  random: () => number;
+  delivered: number;
+  dropped: number;
+  // called for every packet delivered into a peer's incoming ring buffers
+  onDelivered?: (from: string, to: string) => void;
+}
+
+const DEFAULT_OPTIONS: LoopbackTransportOptions = {
+  latency: 0,
+  jitter: 0,
+  loss: 0,
+  seed: 1,
+  ringBufferCapacity: 64,
+};
+
+// mulberry32
+const createRandom = (seed: number) => () => {
+  seed = (seed + 0x6d2b79f5) | 0;
+  let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+  t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+  return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+};
+
+export function createLoopbackTransport(options: Partial<LoopbackTransportOptions> = {}): LoopbackTransport {
+  const resolvedOptions = { ...DEFAULT_OPTIONS, ...options };
+
+  return {
+    options: resolvedOptions,
+    peers: [],
+    peerIdToPeer: new Map(),
+    inFlight: [],
+    lastReliableDelivery: new Map(),
+    random: createRandom(resolvedOptions.seed),
+    delivered: 0,
+    dropped: 0,
+  };
+}
+
+export function addLoopbackPeer(loopback: LoopbackTransport, peerId: string): LoopbackPeer {
+  const capacity = loopback.options.ringBufferCapacity;
+
+  const peer: LoopbackPeer = {
+    peerId,
+    incomingReliableRingBuffer: createNetworkRingBuffer(capacity),
+    incomingUnreliableRingBuffer: createNetworkRingBuffer(capacity),
+    outgoingReliableRingBuffer: createNetworkRingBuffer(capacity),
+    outgoingUnreliableRingBuffer: createNetworkRingBuffer(capacity),
+    stats: createNetworkTrafficStats(),
+  };
+
+  loopback.peers.push(peer);
+  loopback.peerIdToPeer.set(peerId, peer);
+
+  return peer;
+}
+
+export function removeLoopbackPeer(loopback: LoopbackTransport, peerId: string) {
+  const peer = loopback.peerIdToPeer.get(peerId);
+
+  if (!peer) {
+    return;
+  }
+
+  loopback.peers.splice(loopback.peers.indexOf(peer), 1);
+  loopback.peerIdToPeer.delete(peerId);
+  loopback.inFlight = loopback.inFlight.filter((p) => p.from !== peerId && p.to !== peerId);
+
+  for (const key of loopback.lastReliableDelivery.keys()) {
+    if (key.startsWith(`${peerId}->`) || key.endsWith(`->${peerId}`)) {
+      loopback.lastReliableDelivery.delete(key);
+    }
+  }
+}
+
+function schedulePacket(
+  loopback: LoopbackTransport,
+  from: string,
+  to: string,
+  packet: ArrayBuffer,
+  reliable: boolean,
+  now: number
+) {
+  const { latency, jitter, loss } = loopback.options;
+
+  if (!reliable && loss > 0 && loopback.random() < loss) {
+    loopback.dropped++;
+    return;
+  }
+
+  let deliverAt = now + latency + jitter * loopback.random();
+
+  if (reliable) {
+    const key = `${from}->${to}`;
+    deliverAt = Math.max(deliverAt, loopback.lastReliableDelivery.get(key) || 0);
+    loopback.lastReliableDelivery.set(key, deliverAt);
+  }
+
+  loopback.inFlight.push({ from, to, packet, reliable, deliverAt });
+}
+
+const ringOut = { packet: new ArrayBuffer(0), peerId: "", broadcast: false };
+
+function drainOutgoing(loopback: LoopbackTransport, peer: LoopbackPeer, reliable: boolean, now: number) {
+  const ringBuffer = reliable ? peer.outgoingReliableRingBuffer : peer.outgoingUnreliableRingBuffer;
+
+  while (availableRead(ringBuffer)) {
+    dequeueNetworkRingBuffer(ringBuffer, ringOut);
+
+    const { packet } = ringOut;
+
+    if (ringOut.broadcast) {
+      for (let i = 0; i < loopback.peers.length; i++) {
+        const to = loopback.peers[i];
+
+        if (to !== peer) {
+          recordSent(peer.stats, packet.byteLength);
+          schedulePacket(loopback, peer.peerId, to.peerId, packet, reliable, now);
+        }
+      }
+    } else if (loopback.peerIdToPeer.has(ringOut.peerId)) {
+      recordSent(peer.stats, packet.byteLength);
+      schedulePacket(loopback, peer.peerId, ringOut.peerId, packet, reliable, now);
+    } else {
+      loopback.dropped++;
+    }
+  }
+}
+
+/**
+ * Moves packets from each peer's outgoing ring buffers onto the simulated wire and delivers every packet whose
+ * latency has elapsed into the receiving peer's incoming ring buffers. `now` is in milliseconds.
+ */
+export function stepLoopbackTransport(loopback: LoopbackTransport, now: number) {
+  for (let i = 0; i < loopback.peers.length; i++) {
+    const peer = loopback.peers[i];
+    drainOutgoing(loopback, peer, true, now);
+    drainOutgoing(loopback, peer, false, now);
+  }
+
+  // stable sort so that packets scheduled for the same time keep their send order
+  loopback.inFlight.sort((a, b) => a.deliverAt - b.deliverAt);
+
+  let delivered = 0;
+
+  for (; delivered < loopback.inFlight.length; delivered++) {
+    const { from, to, packet, reliable, deliverAt } = loopback.inFlight[delivered];
+
+    if (deliverAt > now) {
+      break;
+    }
+
+    const peer = loopback.peerIdToPeer.get(to)!;
+    const ringBuffer = reliable ? peer.incomingReliableRingBuffer : peer.incomingUnreliableRingBuffer;
+
+    if (!enqueueNetworkRingBuffer(ringBuffer, from, packet)) {
+      if (reliable) {
+        // the receiver hasn't drained its ring buffer yet, keep this and everything after it for the next step
+        break;
+      }
+
+      loopback.dropped++;
+      continue;
+    }
+
+    recordReceived(peer.stats, packet.byteLength);
+    loopback.delivered++;
+    loopback.onDelivered?.(from, to);
+  }
+
+  loopback.inFlight.splice(0, delivered);
+}
+
+/**************
+ * Simulation *
+ *************/
+
+/**
+ * Runs once per peer per frame in place of that peer's game thread. It should drain the peer's incoming ring
+ * buffers and enqueue any outgoing messages.
+ */
+export type LoopbackPeerUpdate = (peer: LoopbackPeer, loopback: LoopbackTransport, dt: number, time: number) => void;
+
+export interface LoopbackSimulation {
+  loopback: LoopbackTransport;
+  update: LoopbackPeerUpdate;
+  frameRate: number;
+  frame: number;
+  // simulated time in milliseconds
+  time: number;
+  // wall clock time spent in update across all frames and peers, in milliseconds
+  updateTime: number;
+  maxFrameUpdateTime: number;
+}
+
+export interface LoopbackSimulationReport {
+  peers: number;
+  frames: number;
+  messagesPerSecond: number;
+  bytesSentPerPeerPerSecond: number;
+  bytesReceivedPerPeerPerSecond: number;
+  droppedPerSecond: number;
+  // mean and worst wall clock time to run every peer's update for one frame, in milliseconds
+  meanFrameUpdateTime: number;
+  maxFrameUpdateTime: number;
+}
+
+export function createLoopbackSimulation(
+  peerCount: number,
+  update: LoopbackPeerUpdate,
+  options: Partial<LoopbackTransportOptions> & { frameRate?: number } = {}
+): LoopbackSimulation {
+  const loopback = createLoopbackTransport(options);
+
+  for (let i = 0; i < peerCount; i++) {
+    addLoopbackPeer(loopback, `@peer${i}:loopback`);
+  }
+
+  return {
+    loopback,
+    update,
+    frameRate: options.frameRate || 60,
+    frame: 0,
+    time: 0,
+    updateTime: 0,
+    maxFrameUpdateTime: 0,
+  };
+}
+
+export function stepLoopbackSimulation(simulation: LoopbackSimulation) {
+  const { loopback, update } = simulation;
+  const dt = 1 / simulation.frameRate;
+
+  simulation.frame++;
+  simulation.time += dt * 1000;
+
+  stepLoopbackTransport(loopback, simulation.time);
+
+  const start = performance.now();
+
+  for (let i = 0; i < loopback.peers.length; i++) {
+    update(loopback.peers[i], loopback, dt, simulation.time / 1000);
+  }
+
+  const frameUpdateTime = performance.now() - start;
+  simulation.updateTime += frameUpdateTime;
+  simulation.maxFrameUpdateTime = Math.max(simulation.maxFrameUpdateTime, frameUpdateTime);
+}
+
+export function getLoopbackSimulationReport(simulation: LoopbackSimulation): LoopbackSimulationReport {
+  const { loopback, frame } = simulation;
+  const seconds = simulation.time / 1000 || 1;
+  const peerCount = loopback.peers.length || 1;
+
+  let bytesSent = 0;
+  let bytesReceived = 0;
+
+  for (let i = 0; i < loopback.peers.length; i++) {
+    bytesSent += loopback.peers[i].stats.bytesSent;
+    bytesReceived += loopback.peers[i].stats.bytesReceived;
+  }
+
+  return {
+    peers: loopback.peers.length,
+    frames: frame,
+    messagesPerSecond: loopback.delivered / seconds,
+    bytesSentPerPeerPerSecond: bytesSent / peerCount / seconds,
+    bytesReceivedPerPeerPerSecond: bytesReceived / peerCount / seconds,
+    droppedPerSecond: loopback.dropped / seconds,
+    meanFrameUpdateTime: frame ? simulation.updateTime / frame : 0,
+    maxFrameUpdateTime: simulation.maxFrameUpdateTime,
+  };
+}
@@ -13,6 +13,14 @@ export enum NetworkAction {
   BinaryScriptMessage,
   StringScriptMessage,
   InformXRMode,
+  Ping,
+  Pong,
+  InformScriptMessageVersion,
 }
 
-export const UnreliableNetworkActions = [NetworkAction.UpdateChanged, NetworkAction.UpdateSnapshot];
+export const UnreliableNetworkActions = [
+  NetworkAction.UpdateChanged,
+  NetworkAction.UpdateSnapshot,
+  NetworkAction.Ping,
+  NetworkAction.Pong,
+];
@@ -0,0 +1,109 @@
+import { deepStrictEqual, ok, strictEqual } from "assert";
+
+import { mockGameState } from "../../../test/engine/mocks";
+import { CursorView, scrollCursorView } from "../allocator/CursorView";
+import { GameContext } from "../GameTypes";
+import { getModule } from "../module/module.common";
+import { RemoteNode } from "../resource/RemoteResources";
+import { GameNetworkState, NetworkModule } from "./network.game";
+import {
+  createPeerUpdateScheduler,
+  getPeerUpdateScheduler,
+  MAX_ENTITY_UPDATE_BYTES,
+  PeerUpdateScheduler,
+  serializePrioritizedUpdates,
+  setNetworkPriority,
+} from "./NetworkPriority";
+
+// message type + elapsed + input tick + update count
+const UPDATE_HEADER_BYTES = 17;
+
+const ctx = { dt: 1 } as GameContext;
+const network = {} as GameNetworkState;
+
+function sendTick(scheduler: PeerUpdateScheduler, priorities: { [eid: number]: number }, entitiesPerTick: number) {
+  const sent: number[] = [];
+  scheduler.budget = UPDATE_HEADER_BYTES + entitiesPerTick * MAX_ENTITY_UPDATE_BYTES;
+
+  serializePrioritizedUpdates(
+    ctx,
+    network,
+    scheduler,
+    undefined,
+    Object.keys(priorities).map(Number),
+    (_ctx, _network, eid) => priorities[eid],
+    (_ctx, v: CursorView, eid) => {
+      sent.push(eid);
+      scrollCursorView(v, MAX_ENTITY_UPDATE_BYTES);
+      return true;
+    }
+  );
+
+  return sent;
+}
+
+describe("NetworkPriority", () => {
+  test("send the highest accumulated priorities that fit in the budget", () => {
+    const scheduler = createPeerUpdateScheduler();
+
+    deepStrictEqual(sendTick(scheduler, { 1: 1, 2: 4, 3: 2, 4: 3 }, 2), [2, 4]);
+
+    // skipped entities keep their accumulated priority
+    strictEqual(scheduler.accumulators.get(1), 1);
+    strictEqual(scheduler.accumulators.get(2), 0);
+    strictEqual(scheduler.accumulators.get(3), 2);
+    strictEqual(scheduler.accumulators.get(4), 0);
+  });
+
+  test("send nothing when the budget doesn't fit an update", () => {
+    const scheduler = createPeerUpdateScheduler();
+
+    deepStrictEqual(sendTick(scheduler, { 1: 1, 2: 1 }, 0), []);
+    strictEqual(scheduler.accumulators.get(1), 1);
+    strictEqual(scheduler.accumulators.get(2), 1);
+  });
+
+  test("take turns between entities of equal priority", () => {
+    const scheduler = createPeerUpdateScheduler();
+    const priorities = { 1: 1, 2: 1, 3: 1 };
+    const sent: number[] = [];
+
+    for (let tick = 0; tick < 6; tick++) {
+      sent.push(...sendTick(scheduler, priorities, 1));
+    }
+
+    deepStrictEqual(sent, [1, 2, 3, 1, 2, 3]);
+  });
+
+  test("don't starve low priority entities", () => {
+    const scheduler = createPeerUpdateScheduler();
+    const priorities = { 1: 10, 2: 1, 3: 1 };
+    const sendCounts = new Map<number, number>();
+
+    for (let tick = 0; tick < 24; tick++) {
+      for (const eid of sendTick(scheduler, priorities, 1)) {
+        sendCounts.set(eid, (sendCounts.get(eid) || 0) + 1);
+      }
+    }
+
+    ok(sendCounts.get(2)! > 0);
+    ok(sendCounts.get(3)! > 0);
+    ok(sendCounts.get(1)! > sendCounts.get(2)!);
+  });
+
+  test("forget a node's priority when the node is removed", () => {
+    const ctx = mockGameState();
+    const network = getModule(ctx, NetworkModule);
+    const node = new RemoteNode(ctx.resourceManager);
+    node.addRef();
+
+    // the node was never networked, so the Networked exit query won't see it
+    setNetworkPriority(network, node.eid, 2);
+    getPeerUpdateScheduler(network, "a").accumulators.set(node.eid, 1);
+
+    node.removeRef();
+
+    ok(!network.entityPriority.has(node.eid));
+    ok(!getPeerUpdateScheduler(network, "a").accumulators.has(node.eid));
+  });
+});
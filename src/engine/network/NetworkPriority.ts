@@ -0,0 +1,221 @@
+import { hasComponent } from "bitecs";
+import { vec3 } from "gl-matrix";
+
+import {
+  createCursorView,
+  CursorView,
+  moveCursorView,
+  rewindCursorView,
+  sliceCursorView,
+  spaceUint32,
+} from "../allocator/CursorView";
+import { GameContext } from "../GameTypes";
+import { Player } from "../player/Player";
+import { RemoteNode } from "../resource/RemoteResources";
+import { getRemoteResource, tryGetRemoteResource } from "../resource/resource.game";
+import { GameNetworkState, ownedNetworkedQuery } from "./network.game";
+import { NetworkAction } from "./NetworkAction";
+import { Networked } from "./NetworkComponents";
+import { sendUnreliable } from "./outbound.game";
+import { serializeTransformChanged, writeMetadata } from "./serialization.game";
+
+// default upstream budget for entity updates to each peer
+export const DEFAULT_PEER_BYTES_PER_SECOND = 64 * 1024;
+// unspent budget carries over, but never more than this many seconds worth
+const MAX_BUDGET_CARRY_SECONDS = 0.25;
+// must fit in a single network ring buffer slot
+const MAX_UPDATE_MESSAGE_BYTES = 15000;
+// nid + change mask + 10 floats + skipLerp
+export const MAX_ENTITY_UPDATE_BYTES =
+  Uint32Array.BYTES_PER_ELEMENT +
+  Uint16Array.BYTES_PER_ELEMENT +
+  Float32Array.BYTES_PER_ELEMENT * 10 +
+  Uint32Array.BYTES_PER_ELEMENT;
+
+// player avatars are always the most important thing to keep in sync
+const PLAYER_PRIORITY = 10;
+// distance in meters at which an entity's priority is halved
+const DISTANCE_FALLOFF = 10;
+// added priority per m/s of velocity
+const VELOCITY_WEIGHT = 0.5;
+
+export interface PeerUpdateScheduler {
+  // each peer gets its own view so that the delta shadow state only advances
+  // for entities that were actually sent to that peer
+  cursorView: CursorView;
+  // eid -> accumulated priority since the entity was last sent to this peer
+  accumulators: Map<number, number>;
+  // bytes that may still be sent this tick
+  budget: number;
+}
+
+export const createPeerUpdateScheduler = (): PeerUpdateScheduler => ({
+  cursorView: createCursorView(new ArrayBuffer(MAX_UPDATE_MESSAGE_BYTES)),
+  accumulators: new Map(),
+  budget: 0,
+});
+
+export const getPeerUpdateScheduler = (network: GameNetworkState, peerId: string) => {
+  let scheduler = network.peerIdToUpdateScheduler.get(peerId);
+
+  if (!scheduler) {
+    scheduler = createPeerUpdateScheduler();
+    network.peerIdToUpdateScheduler.set(peerId, scheduler);
+  }
+
+  return scheduler;
+};
+
+/**
+ * Sets the script-assigned priority multiplier for a networked entity. 1 is the default priority.
+ */
+export const setNetworkPriority = (network: GameNetworkState, eid: number, priority: number) => {
+  network.entityPriority.set(eid, priority);
+};
+
+export const getNetworkPriority = (
+  ctx: GameContext,
+  network: GameNetworkState,
+  node: RemoteNode,
+  peerPosition: vec3 | undefined
+) => {
+  const eid = node.eid;
+
+  let priority = network.entityPriority.get(eid);
+
+  if (priority === undefined) {
+    priority = hasComponent(ctx.world, Player, eid) ? PLAYER_PRIORITY : 1;
+  }
+
+  if (node.physicsBody) {
+    priority *= 1 + vec3.length(node.physicsBody.velocity) * VELOCITY_WEIGHT;
+  }
+
+  if (peerPosition) {
+    priority /= 1 + vec3.distance(node.position, peerPosition) / DISTANCE_FALLOFF;
+  }
+
+  return priority;
+};
+
+export type EntityPriorityGetter = (
+  ctx: GameContext,
+  network: GameNetworkState,
+  eid: number,
+  peerPosition: vec3 | undefined
+) => number;
+
+// writes the entity's update into v and returns true, or returns false without writing anything if it's unchanged
+export type EntityUpdateWriter = (ctx: GameContext, v: CursorView, eid: number) => boolean;
+
+const getEntityNetworkPriority: EntityPriorityGetter = (ctx, network, eid, peerPosition) =>
+  getNetworkPriority(ctx, network, tryGetRemoteResource<RemoteNode>(ctx, eid), peerPosition);
+
+const writeEntityTransformUpdate: EntityUpdateWriter = (ctx, v, eid) => {
+  const node = tryGetRemoteResource<RemoteNode>(ctx, eid);
+  const rewind = rewindCursorView(v);
+  const writeNid = spaceUint32(v);
+
+  if (serializeTransformChanged(v, node)) {
+    writeNid(Networked.networkId[eid]);
+    return true;
+  }
+
+  rewind();
+  return false;
+};
+
+const sortedEntities: number[] = [];
+
+/**
+ * Writes the updates of the entities with the highest accumulated priority that fit in the scheduler's budget into
+ * an UpdateChanged message, or returns undefined if no update was written. Skipped entities keep accumulating
+ * priority, so every entity is eventually sent no matter how low its priority is.
+ */
+export function serializePrioritizedUpdates(
+  ctx: GameContext,
+  network: GameNetworkState,
+  scheduler: PeerUpdateScheduler,
+  peerPosition: vec3 | undefined,
+  entities: readonly number[],
+  getPriority: EntityPriorityGetter = getEntityNetworkPriority,
+  writeUpdate: EntityUpdateWriter = writeEntityTransformUpdate
+) {
+  const { accumulators, cursorView: v } = scheduler;
+
+  sortedEntities.length = 0;
+
+  for (let i = 0; i < entities.length; i++) {
+    const eid = entities[i];
+    const priority = getPriority(ctx, network, eid, peerPosition);
+    accumulators.set(eid, (accumulators.get(eid) || 0) + priority * ctx.dt);
+    sortedEntities.push(eid);
+  }
+
+  // the sort is stable, so entities with equal priority take turns in query order
+  sortedEntities.sort((a, b) => accumulators.get(b)! - accumulators.get(a)!);
+
+  writeMetadata(v, NetworkAction.UpdateChanged);
+  const writeCount = spaceUint32(v);
+  const maxBytes = Math.min(scheduler.budget, MAX_UPDATE_MESSAGE_BYTES);
+  let count = 0;
+
+  for (let i = 0; i < sortedEntities.length; i++) {
+    // entities that don't fit keep their accumulated priority and unsent changes for the next tick
+    if (v.cursor + MAX_ENTITY_UPDATE_BYTES > maxBytes) {
+      break;
+    }
+
+    const eid = sortedEntities[i];
+
+    if (writeUpdate(ctx, v, eid)) {
+      count += 1;
+    }
+
+    accumulators.set(eid, 0);
+  }
+
+  writeCount(count);
+
+  if (count === 0) {
+    moveCursorView(v, 0);
+    return undefined;
+  }
+
+  return sliceCursorView(v);
+}
+
+/**
+ * Sends owned entity updates to each peer individually, most important entities first,
+ * while keeping each peer's upstream traffic within its bandwidth budget.
+ */
+export function sendPrioritizedUpdates(ctx: GameContext, network: GameNetworkState) {
+  const entities = ownedNetworkedQuery(ctx.world);
+  const bytesPerTick = network.peerBytesPerSecond * ctx.dt;
+  const maxBudget = Math.max(network.peerBytesPerSecond * MAX_BUDGET_CARRY_SECONDS, bytesPerTick);
+
+  for (let i = 0; i < network.peers.length; i++) {
+    const peerId = network.peers[i];
+    const scheduler = getPeerUpdateScheduler(network, peerId);
+
+    scheduler.budget = Math.min(scheduler.budget + bytesPerTick, maxBudget);
+
+    const peerEid = network.peerIdToEntityId.get(peerId);
+    const peerNode = peerEid ? getRemoteResource<RemoteNode>(ctx, peerEid) : undefined;
+
+    const msg = serializePrioritizedUpdates(ctx, network, scheduler, peerNode?.position, entities);
+
+    if (msg) {
+      scheduler.budget -= msg.byteLength;
+      sendUnreliable(ctx, network, peerId, msg);
+    }
+  }
+}
+
+export function disposeNetworkPriority(network: GameNetworkState, eid: number) {
+  network.entityPriority.delete(eid);
+
+  for (const scheduler of network.peerIdToUpdateScheduler.values()) {
+    scheduler.accumulators.delete(eid);
+  }
+}
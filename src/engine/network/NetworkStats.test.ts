@@ -0,0 +1,102 @@
+import { strictEqual, ok } from "assert";
+
+import { GameNetworkState } from "./network.game";
+import {
+  createNetworkTrafficStats,
+  createPeerNetworkStats,
+  getPeerNetworkStats,
+  recordBroadcastDropped,
+  recordPeerDropped,
+  recordPeerReceived,
+  recordPeerSent,
+  recordReceived,
+  recordSent,
+  trackPingSent,
+  trackPongReceived,
+} from "./NetworkStats";
+
+describe("NetworkStats", () => {
+  test("record traffic", () => {
+    const stats = createNetworkTrafficStats();
+    recordSent(stats, 10);
+    recordSent(stats, 5);
+    recordReceived(stats, 7);
+
+    strictEqual(stats.bytesSent, 15);
+    strictEqual(stats.messagesSent, 2);
+    strictEqual(stats.bytesReceived, 7);
+    strictEqual(stats.messagesReceived, 1);
+  });
+
+  test("estimate rtt from pongs", () => {
+    const stats = createPeerNetworkStats();
+    trackPingSent(stats, 1, 1000);
+    trackPongReceived(stats, 1, 1100);
+
+    strictEqual(stats.rtt, 100);
+    strictEqual(stats.pendingPings.size, 0);
+
+    trackPingSent(stats, 2, 2000);
+    trackPongReceived(stats, 2, 2200);
+
+    ok(stats.rtt > 100 && stats.rtt < 200);
+
+    // duplicate pongs are ignored
+    const rtt = stats.rtt;
+    trackPongReceived(stats, 2, 3000);
+    strictEqual(stats.rtt, rtt);
+  });
+
+  test("estimate packet loss from unanswered pings", () => {
+    const stats = createPeerNetworkStats();
+
+    for (let i = 1; i <= 20; i++) {
+      trackPingSent(stats, i, i * 1000);
+    }
+
+    ok(stats.packetLoss > 0);
+    ok(stats.pendingPings.size < 20);
+
+    const loss = stats.packetLoss;
+    trackPongReceived(stats, 20, 20050);
+    ok(stats.packetLoss < loss);
+  });
+
+  test("only track connected peers", () => {
+    const network = {
+      peers: ["a"],
+      peerIdToStats: new Map(),
+      stats: createNetworkTrafficStats(),
+    } as unknown as GameNetworkState;
+
+    recordPeerReceived(network, "a", 10);
+    strictEqual(getPeerNetworkStats(network, "a")?.bytesReceived, 10);
+
+    // a late message from a removed peer only counts towards the totals
+    network.peers = [];
+    network.peerIdToStats.delete("a");
+    recordPeerReceived(network, "a", 10);
+
+    strictEqual(getPeerNetworkStats(network, "a"), undefined);
+    strictEqual(network.peerIdToStats.size, 0);
+    strictEqual(network.stats.bytesReceived, 20);
+  });
+
+  test("count dropped messages separately", () => {
+    const network = {
+      peers: ["a", "b"],
+      peerIdToStats: new Map(),
+      stats: createNetworkTrafficStats(),
+    } as unknown as GameNetworkState;
+
+    recordPeerSent(network, "a", 10);
+    recordPeerDropped(network, "a");
+    recordBroadcastDropped(network);
+
+    strictEqual(network.stats.messagesSent, 1);
+    strictEqual(network.stats.messagesDropped, 2);
+    strictEqual(getPeerNetworkStats(network, "a")?.messagesSent, 1);
+    strictEqual(getPeerNetworkStats(network, "a")?.messagesDropped, 2);
+    strictEqual(getPeerNetworkStats(network, "b")?.messagesDropped, 1);
+  });
+});
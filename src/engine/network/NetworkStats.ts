@@ -0,0 +1,241 @@
+import { createCursorView, CursorView, readUint32, sliceCursorView, writeUint32 } from "../allocator/CursorView";
+import { GameContext } from "../GameTypes";
+import { GameNetworkState } from "./network.game";
+import { NetworkAction } from "./NetworkAction";
+import { sendUnreliable } from "./outbound.game";
+import { writeMetadata } from "./serialization.game";
+
+// how often each peer is pinged to update its rtt / packet loss estimates
+export const PING_INTERVAL_MS = 1000;
+// pings still unanswered after this many newer pings have been sent are considered lost
+const PING_WINDOW = 10;
+// smoothing factors for the rtt and packet loss moving averages
+const RTT_ALPHA = 0.125;
+const LOSS_ALPHA = 0.1;
+
+export interface NetworkTrafficStats {
+  bytesSent: number;
+  messagesSent: number;
+  bytesReceived: number;
+  messagesReceived: number;
+  // messages that weren't sent because the outgoing ring buffer was full
+  messagesDropped: number;
+}
+
+export interface PeerNetworkStats extends NetworkTrafficStats {
+  // smoothed round trip time in milliseconds
+  rtt: number;
+  // smoothed fraction of pings that went unanswered (0 - 1)
+  packetLoss: number;
+  nextPingSequence: number;
+  lastPingTime: number;
+  // ping sequence number -> time sent
+  pendingPings: Map<number, number>;
+}
+
+export const createNetworkTrafficStats = (): NetworkTrafficStats => ({
+  bytesSent: 0,
+  messagesSent: 0,
+  bytesReceived: 0,
+  messagesReceived: 0,
+  messagesDropped: 0,
+});
+
+export const createPeerNetworkStats = (): PeerNetworkStats => ({
+  ...createNetworkTrafficStats(),
+  rtt: 0,
+  packetLoss: 0,
+  nextPingSequence: 1,
+  lastPingTime: 0,
+  pendingPings: new Map(),
+});
+
+export const resetNetworkTrafficStats = (stats: NetworkTrafficStats) => {
+  stats.bytesSent = 0;
+  stats.messagesSent = 0;
+  stats.bytesReceived = 0;
+  stats.messagesReceived = 0;
+  stats.messagesDropped = 0;
+};
+
+export const recordSent = (stats: NetworkTrafficStats, byteLength: number) => {
+  stats.bytesSent += byteLength;
+  stats.messagesSent++;
+};
+
+export const recordReceived = (stats: NetworkTrafficStats, byteLength: number) => {
+  stats.bytesReceived += byteLength;
+  stats.messagesReceived++;
+};
+
+export const recordDropped = (stats: NetworkTrafficStats) => {
+  stats.messagesDropped++;
+};
+
+/**
+ * Returns the stats of a connected peer, or undefined once the peer has been removed so that late messages don't
+ * recreate its entry. Entries are created in addPeerId and deleted in removePeerId.
+ */
+export const getPeerNetworkStats = (network: GameNetworkState, peerId: string): PeerNetworkStats | undefined => {
+  let stats = network.peerIdToStats.get(peerId);
+
+  if (!stats && network.peers.includes(peerId)) {
+    stats = createPeerNetworkStats();
+    network.peerIdToStats.set(peerId, stats);
+  }
+
+  return stats;
+};
+
+export const recordPeerSent = (network: GameNetworkState, peerId: string, byteLength: number) => {
+  recordSent(network.stats, byteLength);
+
+  const stats = getPeerNetworkStats(network, peerId);
+
+  if (stats) {
+    recordSent(stats, byteLength);
+  }
+};
+
+export const recordBroadcastSent = (network: GameNetworkState, byteLength: number) => {
+  recordSent(network.stats, byteLength);
+
+  for (let i = 0; i < network.peers.length; i++) {
+    const stats = getPeerNetworkStats(network, network.peers[i]);
+
+    if (stats) {
+      recordSent(stats, byteLength);
+    }
+  }
+};
+
+export const recordPeerDropped = (network: GameNetworkState, peerId: string) => {
+  recordDropped(network.stats);
+
+  const stats = getPeerNetworkStats(network, peerId);
+
+  if (stats) {
+    recordDropped(stats);
+  }
+};
+
+export const recordBroadcastDropped = (network: GameNetworkState) => {
+  recordDropped(network.stats);
+
+  for (let i = 0; i < network.peers.length; i++) {
+    const stats = getPeerNetworkStats(network, network.peers[i]);
+
+    if (stats) {
+      recordDropped(stats);
+    }
+  }
+};
+
+export const recordPeerReceived = (network: GameNetworkState, peerId: string, byteLength: number) => {
+  recordReceived(network.stats, byteLength);
+
+  const stats = getPeerNetworkStats(network, peerId);
+
+  if (stats) {
+    recordReceived(stats, byteLength);
+  }
+};
+
+/**
+ * Returns the mean rtt and packet loss across all connected peers.
+ */
+export const getAveragePeerLatency = (network: GameNetworkState, out = { rtt: 0, packetLoss: 0 }) => {
+  out.rtt = 0;
+  out.packetLoss = 0;
+
+  const peerCount = network.peers.length;
+
+  if (peerCount === 0) {
+    return out;
+  }
+
+  for (let i = 0; i < peerCount; i++) {
+    const stats = network.peerIdToStats.get(network.peers[i]);
+
+    if (stats) {
+      out.rtt += stats.rtt;
+      out.packetLoss += stats.packetLoss;
+    }
+  }
+
+  out.rtt /= peerCount;
+  out.packetLoss /= peerCount;
+
+  return out;
+};
+
+/* Ping / Pong */
+
+const pingView = createCursorView(new ArrayBuffer(100));
+
+export const createPingMessage = (action: NetworkAction.Ping | NetworkAction.Pong, sequence: number) => {
+  writeMetadata(pingView, action);
+  writeUint32(pingView, sequence);
+  return sliceCursorView(pingView);
+};
+
+export const trackPingSent = (stats: PeerNetworkStats, sequence: number, now: number) => {
+  stats.pendingPings.set(sequence, now);
+  stats.lastPingTime = now;
+
+  // Maps iterate in insertion order so the first pending entries are the oldest pings
+  for (const [pendingSequence] of stats.pendingPings) {
+    if (pendingSequence > sequence - PING_WINDOW) {
+      break;
+    }
+
+    stats.pendingPings.delete(pendingSequence);
+    stats.packetLoss += (1 - stats.packetLoss) * LOSS_ALPHA;
+  }
+};
+
+export const trackPongReceived = (stats: PeerNetworkStats, sequence: number, now: number) => {
+  const sentTime = stats.pendingPings.get(sequence);
+
+  if (sentTime === undefined) {
+    // duplicate or already counted as lost
+    return;
+  }
+
+  stats.pendingPings.delete(sequence);
+
+  const sample = now - sentTime;
+  stats.rtt = stats.rtt === 0 ? sample : stats.rtt + (sample - stats.rtt) * RTT_ALPHA;
+  stats.packetLoss -= stats.packetLoss * LOSS_ALPHA;
+};
+
+export function sendPeerPings(ctx: GameContext, network: GameNetworkState) {
+  const now = performance.now();
+
+  for (let i = 0; i < network.peers.length; i++) {
+    const peerId = network.peers[i];
+    const stats = getPeerNetworkStats(network, peerId);
+
+    if (!stats || now - stats.lastPingTime < PING_INTERVAL_MS) {
+      continue;
+    }
+
+    const sequence = stats.nextPingSequence++;
+    trackPingSent(stats, sequence, now);
+    sendUnreliable(ctx, network, peerId, createPingMessage(NetworkAction.Ping, sequence));
+  }
+}
+
+export const deserializePing = (network: GameNetworkState) => (ctx: GameContext, v: CursorView, peerId: string) => {
+  const sequence = readUint32(v);
+  sendUnreliable(ctx, network, peerId, createPingMessage(NetworkAction.Pong, sequence));
+};
+
+export const deserializePong = (network: GameNetworkState) => (ctx: GameContext, v: CursorView, peerId: string) => {
+  const sequence = readUint32(v);
+  const stats = getPeerNetworkStats(network, peerId);
+
+  if (stats) {
+    trackPongReceived(stats, sequence, performance.now());
+  }
+};
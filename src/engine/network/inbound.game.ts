@@ -7,10 +7,13 @@ import { GameNetworkState, NetworkModule, ownedPlayerQuery } from "./network.gam
 import { NetworkAction } from "./NetworkAction";
 import { dequeueNetworkRingBuffer } from "./RingBuffer";
 import { readMetadata } from "./serialization.game";
+import { recordPeerReceived } from "./NetworkStats";
 
 const processNetworkMessage = (ctx: GameContext, peerId: string, msg: ArrayBuffer) => {
   const network = getModule(ctx, NetworkModule);
 
+  recordPeerReceived(network, peerId, msg.byteLength);
+
   const cursorView = createCursorView(msg);
 
   const { type: messageType, elapsed, inputTick } = readMetadata(cursorView);
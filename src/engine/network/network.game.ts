@@ -38,6 +38,15 @@ import { RemoteNode, removeObjectFromWorld } from "../resource/RemoteResources";
 import { Networked, Owned } from "./NetworkComponents";
 import { XRMode } from "../renderer/renderer.common";
 import { Replicator } from "./Replicator";
+import {
+  createNetworkTrafficStats,
+  createPeerNetworkStats,
+  deserializePing,
+  deserializePong,
+  NetworkTrafficStats,
+  PeerNetworkStats,
+} from "./NetworkStats";
+import { DEFAULT_PEER_BYTES_PER_SECOND, PeerUpdateScheduler } from "./NetworkPriority";
 
 /*********
  * Types *
@@ -65,6 +74,8 @@ export interface GameNetworkState {
   peerIdToHistorian: Map<string, Historian>;
   peerIdToEntityId: Map<string, number>;
   peerIdToXRMode: Map<string, XRMode>;
+  // script message framing version each peer announced, peers that never announced one are on the old framing
+  peerIdToScriptMessageVersion: Map<string, number>;
   entityIdToPeerId: Map<number, string>;
   networkIdToEntityId: Map<number, number>;
   localIdCount: number;
@@ -76,8 +87,18 @@ export interface GameNetworkState {
   tickRate: number;
   prefabToReplicator: Map<string, Replicator>;
   deferredUpdates: Map<number, DeferredUpdate[]>;
+  // traffic totals across all peers
+  stats: NetworkTrafficStats;
+  peerIdToStats: Map<string, PeerNetworkStats>;
+  peerIdToUpdateScheduler: Map<string, PeerUpdateScheduler>;
+  // script-assigned update priority multipliers
+  entityPriority: Map<number, number>;
+  // upstream budget for entity updates to each peer when prioritizeUpdates is enabled
+  peerBytesPerSecond: number;
   // feature flags
   interpolate: boolean;
+  prioritizeUpdates: boolean;
+  compressScriptMessages: boolean;
 }
 
 /******************
@@ -110,6 +131,7 @@ export const NetworkModule = defineModule<GameContext, GameNetworkState>({
       networkIdToEntityId: new Map(),
       peerIdToEntityId: new Map(),
       peerIdToXRMode: new Map(),
+      peerIdToScriptMessageVersion: new Map(),
       entityIdToPeerId: new Map(),
       indexToPeerId: new Map(),
       peerIdCount: 0,
@@ -119,8 +141,15 @@ export const NetworkModule = defineModule<GameContext, GameNetworkState>({
       cursorView: createCursorView(),
       prefabToReplicator: new Map(),
       deferredUpdates: new Map(),
+      stats: createNetworkTrafficStats(),
+      peerIdToStats: new Map(),
+      peerIdToUpdateScheduler: new Map(),
+      entityPriority: new Map(),
+      peerBytesPerSecond: DEFAULT_PEER_BYTES_PER_SECOND,
       tickRate: 10,
       interpolate: false,
+      prioritizeUpdates: true,
+      compressScriptMessages: true,
     };
   },
   init(ctx: GameContext) {
@@ -138,6 +167,8 @@ export const NetworkModule = defineModule<GameContext, GameNetworkState>({
     registerInboundMessageHandler(network, NetworkAction.NewPeerSnapshot, deserializeNewPeerSnapshot);
     registerInboundMessageHandler(network, NetworkAction.RemoveOwnershipMessage, deserializeRemoveOwnership);
     registerInboundMessageHandler(network, NetworkAction.InformXRMode, deserializeInformXRMode);
+    registerInboundMessageHandler(network, NetworkAction.Ping, deserializePing(network));
+    registerInboundMessageHandler(network, NetworkAction.Pong, deserializePong(network));
 
     const disposables = [
       registerMessageHandler(ctx, NetworkMessageType.SetHost, onSetHost),
@@ -168,6 +199,7 @@ export const addPeerId = (ctx: GameContext, peerId: string) => {
   network.newPeers.push(peerId);
 
   network.peerIdToHistorian.set(peerId, createHistorian());
+  network.peerIdToStats.set(peerId, createPeerNetworkStats());
 
   mapPeerIdAndIndex(network, peerId);
 
@@ -201,6 +233,9 @@ export const removePeerId = (ctx: GameContext, peerId: string) => {
     }
 
     network.peers.splice(peerArrIndex, 1);
+    network.peerIdToStats.delete(peerId);
+    network.peerIdToUpdateScheduler.delete(peerId);
+    network.peerIdToScriptMessageVersion.delete(peerId);
 
     ctx.sendMessage<PeerExitedMessage>(Thread.Game, { type: NetworkMessageType.PeerExited, peerIndex });
   } else {
@@ -227,6 +262,10 @@ export function NetworkExitWorldQueueSystem(ctx: GameContext) {
     network.peerIdToEntityId.clear();
     network.entityIdToPeerId.clear();
     network.networkIdToEntityId.clear();
+    network.peerIdToStats.clear();
+    network.peerIdToUpdateScheduler.clear();
+    network.peerIdToScriptMessageVersion.clear();
+    network.entityPriority.clear();
     network.localIdCount = 1;
     network.removedLocalIds = [];
     network.commands = [];
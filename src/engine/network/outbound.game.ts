@@ -22,33 +22,61 @@ import {
   createUpdateChangedMessage,
   createInformXRModeMessage,
 } from "./serialization.game";
-
+import {
+  recordBroadcastDropped,
+  recordBroadcastSent,
+  recordPeerDropped,
+  recordPeerSent,
+  sendPeerPings,
+} from "./NetworkStats";
+import { disposeNetworkPriority, sendPrioritizedUpdates } from "./NetworkPriority";
+
+// Returns false if the packet was empty or dropped because the ring buffer is full
 export const broadcastReliable = (ctx: GameContext, network: GameNetworkState, packet: ArrayBuffer) => {
-  if (!packet.byteLength) return;
+  if (!packet.byteLength) return false;
   if (!enqueueNetworkRingBuffer(network.outgoingReliableRingBuffer, "", packet, true)) {
     console.warn("outgoing reliable network ring buffer full");
+    recordBroadcastDropped(network);
+    return false;
   }
+  recordBroadcastSent(network, packet.byteLength);
+  return true;
 };
 
+// Returns false if the packet was empty or dropped because the ring buffer is full
 export const broadcastUnreliable = (ctx: GameContext, network: GameNetworkState, packet: ArrayBuffer) => {
-  if (!packet.byteLength) return;
+  if (!packet.byteLength) return false;
   if (!enqueueNetworkRingBuffer(network.outgoingUnreliableRingBuffer, "", packet, true)) {
     console.warn("outgoing unreliable network ring buffer full");
+    recordBroadcastDropped(network);
+    return false;
   }
+  recordBroadcastSent(network, packet.byteLength);
+  return true;
 };
 
+// Returns false if the packet was empty or dropped because the ring buffer is full
 export const sendReliable = (ctx: GameContext, network: GameNetworkState, peerId: string, packet: ArrayBuffer) => {
-  if (!packet.byteLength) return;
+  if (!packet.byteLength) return false;
   if (!enqueueNetworkRingBuffer(network.outgoingReliableRingBuffer, peerId, packet)) {
     console.warn("outgoing reliable network ring buffer full");
+    recordPeerDropped(network, peerId);
+    return false;
   }
+  recordPeerSent(network, peerId, packet.byteLength);
+  return true;
 };
 
+// Returns false if the packet was empty or dropped because the ring buffer is full
 export const sendUnreliable = (ctx: GameContext, network: GameNetworkState, peerId: string, packet: ArrayBuffer) => {
-  if (!packet.byteLength) return;
+  if (!packet.byteLength) return false;
   if (!enqueueNetworkRingBuffer(network.outgoingUnreliableRingBuffer, peerId, packet)) {
     console.warn("outgoing unreliable network ring buffer full");
+    recordPeerDropped(network, peerId);
+    return false;
   }
+  recordPeerSent(network, peerId, packet.byteLength);
+  return true;
 };
 
 const assignNetworkIds = (ctx: GameContext) => {
@@ -83,6 +111,7 @@ function disposeNetworkedEntities(ctx: GameContext) {
   for (let i = 0; i < exited.length; i++) {
     const eid = exited[i];
     network.networkIdToEntityId.delete(Networked.networkId[eid]);
+    disposeNetworkPriority(network, eid);
   }
 }
 
@@ -125,8 +154,12 @@ const sendUpdatesPeerToPeer = (ctx: GameContext) => {
       broadcastReliable(ctx, network, deleteMsg);
 
       // send unreliable updates
-      const updateMsg = createUpdateChangedMessage(ctx, network.cursorView);
-      broadcastUnreliable(ctx, network, updateMsg);
+      if (network.prioritizeUpdates) {
+        sendPrioritizedUpdates(ctx, network);
+      } else {
+        const updateMsg = createUpdateChangedMessage(ctx, network.cursorView);
+        broadcastUnreliable(ctx, network, updateMsg);
+      }
     }
   }
 
@@ -145,6 +178,8 @@ export function OutboundNetworkSystem(ctx: GameContext) {
   // serialize and send all outgoing updates
   try {
     sendUpdatesPeerToPeer(ctx);
+    // keep rtt / packet loss estimates up to date
+    sendPeerPings(ctx, network);
   } catch (e) {
     console.error(e);
   }
@@ -0,0 +1,111 @@
+import { deepStrictEqual, ok, strictEqual, throws } from "assert";
+
+import { createCursorView, moveCursorView, readUint32 } from "../allocator/CursorView";
+import { GameNetworkState } from "./network.game";
+import {
+  peersAcceptCompressedScriptMessages,
+  readScriptMessagePacket,
+  SCRIPT_MESSAGE_VERSION,
+  serializeScriptMessage,
+} from "./scripting.game";
+
+const COMPRESSED_FLAG = 0x8000_0000;
+
+function createRepetitivePacket(byteLength: number) {
+  const packet = new Uint8Array(byteLength);
+
+  for (let i = 0; i < byteLength; i++) {
+    packet[i] = i % 16;
+  }
+
+  return packet;
+}
+
+// xorshift noise, which LZ4 can't shrink
+function createNoisePacket(byteLength: number) {
+  const packet = new Uint8Array(byteLength);
+  let x = 2463534242;
+
+  for (let i = 0; i < byteLength; i++) {
+    x ^= x << 13;
+    x ^= x >>> 17;
+    x ^= x << 5;
+    packet[i] = x & 0xff;
+  }
+
+  return packet;
+}
+
+function roundTrip(packet: Uint8Array, compress = true) {
+  const v = createCursorView(new ArrayBuffer(packet.byteLength + 64));
+  serializeScriptMessage(v, packet, compress);
+  const byteLength = v.cursor;
+
+  moveCursorView(v, 0);
+  const header = readUint32(v);
+
+  moveCursorView(v, 0);
+  const result = new Uint8Array(readScriptMessagePacket(v));
+
+  strictEqual(v.cursor, byteLength);
+  deepStrictEqual(result, packet);
+
+  return { compressed: (header & COMPRESSED_FLAG) !== 0, byteLength };
+}
+
+function createNetworkState(versions: [string, number][]) {
+  return { peerIdToScriptMessageVersion: new Map(versions) } as unknown as GameNetworkState;
+}
+
+describe("script message framing", () => {
+  test("send payloads below the threshold as is", () => {
+    const { compressed, byteLength } = roundTrip(createRepetitivePacket(1023));
+
+    strictEqual(compressed, false);
+    strictEqual(byteLength, 4 + 1023);
+  });
+
+  test("compress payloads at and above the threshold", () => {
+    for (const packetLength of [1024, 1025, 8000]) {
+      const { compressed, byteLength } = roundTrip(createRepetitivePacket(packetLength));
+
+      ok(compressed, `${packetLength} bytes`);
+      ok(byteLength < packetLength, `${packetLength} bytes`);
+    }
+  });
+
+  test("send payloads that don't shrink as is", () => {
+    for (const packetLength of [1024, 4096]) {
+      const { compressed, byteLength } = roundTrip(createNoisePacket(packetLength));
+
+      strictEqual(compressed, false, `${packetLength} bytes`);
+      strictEqual(byteLength, 4 + packetLength);
+    }
+  });
+
+  test("send payloads as is when compression is off", () => {
+    strictEqual(roundTrip(createRepetitivePacket(4096), false).compressed, false);
+  });
+
+  test("reject compressed payloads claiming more than LZ4 can expand to", () => {
+    const v = createCursorView(new ArrayBuffer(64));
+    v.setUint32(0, (1_000_000 | COMPRESSED_FLAG) >>> 0);
+    v.setUint32(4, 10);
+
+    throws(() => readScriptMessagePacket(v), /Invalid compressed script message length/);
+  });
+
+  test("only compress for peers that announced the compressed framing", () => {
+    const network = createNetworkState([
+      ["@new:server", SCRIPT_MESSAGE_VERSION],
+      ["@future:server", SCRIPT_MESSAGE_VERSION + 1],
+      ["@old:server", 0],
+    ]);
+
+    strictEqual(peersAcceptCompressedScriptMessages(network, ["@new:server", "@future:server"]), true);
+    strictEqual(peersAcceptCompressedScriptMessages(network, ["@new:server", "@old:server"]), false);
+    // peers on builds before the version was announced never send one
+    strictEqual(peersAcceptCompressedScriptMessages(network, ["@new:server", "@unknown:server"]), false);
+    strictEqual(peersAcceptCompressedScriptMessages(network, []), true);
+  });
+});
@@ -7,6 +7,9 @@ import {
   sliceCursorView,
   writeArrayBuffer as cursorWriteArrayBuffer,
   writeInt32,
+  writeFloat32,
+  writeUint8,
+  readUint8,
   CursorView,
 } from "../allocator/CursorView";
 import { GameContext } from "../GameTypes";
@@ -19,6 +22,7 @@ import { writeUint32, readUint32 } from "../allocator/CursorView";
 import { registerInboundMessageHandler } from "./inbound.game";
 import {
   getScriptResource,
+  getStringByteLength,
   readExtensionsAndExtras,
   readUint8Array,
   WASMModuleContext,
@@ -34,6 +38,17 @@ import { ScriptComponent, scriptQuery } from "../scripting/scripting.game";
 import { Replication, createReplicator } from "./Replicator";
 import { Networked, Owned } from "./NetworkComponents";
 import { addPrefabComponent } from "../prefab/prefab.game";
+import {
+  createNetworkTrafficStats,
+  getAveragePeerLatency,
+  NetworkTrafficStats,
+  recordReceived,
+  recordDropped,
+  recordSent,
+  resetNetworkTrafficStats,
+} from "./NetworkStats";
+import { setNetworkPriority } from "./NetworkPriority";
+import { lz4Compress, lz4Decompress } from "../utils/lz4";
 
 export const WebSGNetworkModule = defineModule<GameContext, {}>({
   name: "WebSGNetwork",
@@ -46,8 +61,9 @@ export const WebSGNetworkModule = defineModule<GameContext, {}>({
       deserializeScriptMessage(ctx, v, peerId, true)
     );
     registerInboundMessageHandler(network, NetworkAction.StringScriptMessage, (ctx, v, peerId) =>
-      deserializeScriptMessage(ctx, v, peerId, true)
+      deserializeScriptMessage(ctx, v, peerId, false)
     );
+    registerInboundMessageHandler(network, NetworkAction.InformScriptMessageVersion, deserializeScriptMessageVersion);
 
     return createDisposables([
       registerMessageHandler(ctx, NetworkMessageType.PeerEntered, onPeerEntered),
@@ -57,6 +73,13 @@ export const WebSGNetworkModule = defineModule<GameContext, {}>({
 });
 
 function onPeerEntered(ctx: GameContext, msg: PeerEnteredMessage) {
+  const network = getModule(ctx, NetworkModule);
+  const peerId = network.indexToPeerId.get(msg.peerIndex);
+
+  if (peerId) {
+    sendReliable(ctx, network, peerId, createScriptMessageVersionMessage());
+  }
+
   const entities = scriptQuery(ctx.world);
 
   for (const eid of entities) {
@@ -100,10 +123,16 @@ export function createWebSGNetworkModule(ctx: GameContext, wasmCtx: WASMModuleCo
       try {
         const scriptPacket = readUint8Array(wasmCtx, packetPtr, byteLength);
 
-        const msg = createScriptMessage(ctx, scriptPacket, !!binary);
+        const compress = network.compressScriptMessages && peersAcceptCompressedScriptMessages(network, network.peers);
+        const msg = createScriptMessage(scriptPacket, !!binary, compress);
 
         if (reliable) {
-          broadcastReliable(ctx, network, msg);
+          if (broadcastReliable(ctx, network, msg)) {
+            recordSent(wasmCtx.resourceManager.networkStats, byteLength);
+          } else {
+            recordDropped(wasmCtx.resourceManager.networkStats);
+          }
+
           return 0;
         } else {
           console.error("WebSGNetworking: Unreliable broadcast currently not supported.");
@@ -120,6 +149,7 @@ export function createWebSGNetworkModule(ctx: GameContext, wasmCtx: WASMModuleCo
       wasmCtx.resourceManager.networkListeners.push({
         id,
         inbound: [],
+        stats: createNetworkTrafficStats(),
       });
 
       return id;
@@ -221,6 +251,43 @@ export function createWebSGNetworkModule(ctx: GameContext, wasmCtx: WASMModuleCo
         return -1;
       }
     },
+    network_get_stats(statsPtr: number) {
+      const { rtt, packetLoss } = getAveragePeerLatency(network);
+      writeNetworkStats(wasmCtx, statsPtr, wasmCtx.resourceManager.networkStats, rtt, packetLoss);
+      return 0;
+    },
+    network_listener_get_stats(listenerId: number, statsPtr: number) {
+      const listener = wasmCtx.resourceManager.networkListeners.find((l) => l.id === listenerId);
+
+      if (!listener) {
+        console.error(`WebSGNetworking: Listener ${listenerId} does not exist.`);
+        return -1;
+      }
+
+      writeNetworkStats(wasmCtx, statsPtr, listener.stats, 0, 0);
+
+      return 0;
+    },
+    peer_get_stats(peerIndex: number, statsPtr: number) {
+      const peerId = network.indexToPeerId.get(peerIndex);
+
+      if (!peerId) {
+        console.error(`WebSGNetworking: Peer ${peerIndex} does not exist.`);
+        return -1;
+      }
+
+      const stats = network.peerIdToStats.get(peerId);
+
+      if (!stats) {
+        // The local peer has no connection stats
+        writeNetworkStats(wasmCtx, statsPtr, emptyStats, 0, 0);
+        return 0;
+      }
+
+      writeNetworkStats(wasmCtx, statsPtr, stats, stats.rtt, stats.packetLoss);
+
+      return 0;
+    },
     peer_get_id_length(peerIndex: number) {
       const peerId = network.indexToPeerId.get(peerIndex);
 
@@ -229,7 +296,7 @@ export function createWebSGNetworkModule(ctx: GameContext, wasmCtx: WASMModuleCo
         return -1;
       }
 
-      return peerId.length;
+      return getStringByteLength(wasmCtx, peerId);
     },
     peer_get_id(peerIndex: number, idPtr: number, maxBufLength: number) {
       const peerId = network.indexToPeerId.get(peerIndex);
@@ -321,14 +388,18 @@ export function createWebSGNetworkModule(ctx: GameContext, wasmCtx: WASMModuleCo
 
         const scriptPacket = readUint8Array(wasmCtx, packetPtr, byteLength);
 
-        const msg = createScriptMessage(ctx, scriptPacket, !!binary);
+        const compress = network.compressScriptMessages && peersAcceptCompressedScriptMessages(network, [peerId]);
+        const msg = createScriptMessage(scriptPacket, !!binary, compress);
 
-        if (reliable) {
-          sendReliable(ctx, network, peerId, msg);
-          return 0;
+        const sent = reliable ? sendReliable(ctx, network, peerId, msg) : sendUnreliable(ctx, network, peerId, msg);
+
+        if (sent) {
+          recordSent(wasmCtx.resourceManager.networkStats, byteLength);
         } else {
-          sendUnreliable(ctx, network, peerId, msg);
+          recordDropped(wasmCtx.resourceManager.networkStats);
         }
+
+        return 0;
       } catch (error) {
         console.error("WebSGNetworking: Error broadcasting packet:", error);
         return -1;
@@ -590,6 +661,22 @@ export function createWebSGNetworkModule(ctx: GameContext, wasmCtx: WASMModuleCo
         return -1;
       }
     },
+    node_set_network_priority: (nodeId: number, priority: number) => {
+      const node = getScriptResource(wasmCtx, RemoteNode, nodeId);
+
+      if (!node) {
+        return -1;
+      }
+
+      if (!(priority >= 0)) {
+        console.error("WebSGNetworking: network priority must be greater than or equal to 0.");
+        return -1;
+      }
+
+      setNetworkPriority(network, nodeId, priority);
+
+      return 0;
+    },
     node_add_network_synchronizer: (nodeId: number, propsPtr: number) => {
       try {
         const node = getScriptResource(wasmCtx, RemoteNode, nodeId);
@@ -644,6 +731,7 @@ export function createWebSGNetworkModule(ctx: GameContext, wasmCtx: WASMModuleCo
   const disposeNetworkModule = () => {
     wasmCtx.resourceManager.networkListeners.length = 0;
     wasmCtx.resourceManager.nextNetworkListenerId = 1;
+    resetNetworkTrafficStats(wasmCtx.resourceManager.networkStats);
     wasmCtx.resourceManager.replicators.clear();
     wasmCtx.resourceManager.nextReplicatorId = 1;
   };
@@ -651,22 +739,129 @@ export function createWebSGNetworkModule(ctx: GameContext, wasmCtx: WASMModuleCo
   return [networkWASMModule, disposeNetworkModule] as const;
 }
 
+const emptyStats = createNetworkTrafficStats();
+
+function writeNetworkStats(
+  wasmCtx: WASMModuleContext,
+  statsPtr: number,
+  stats: NetworkTrafficStats,
+  rtt: number,
+  packetLoss: number
+) {
+  moveCursorView(wasmCtx.cursorView, statsPtr);
+  writeUint32(wasmCtx.cursorView, stats.bytesSent);
+  writeUint32(wasmCtx.cursorView, stats.messagesSent);
+  writeUint32(wasmCtx.cursorView, stats.bytesReceived);
+  writeUint32(wasmCtx.cursorView, stats.messagesReceived);
+  writeFloat32(wasmCtx.cursorView, rtt);
+  writeFloat32(wasmCtx.cursorView, packetLoss);
+  writeUint32(wasmCtx.cursorView, stats.messagesDropped);
+}
+
 const messageView = createCursorView(new ArrayBuffer(10000));
 
-function createScriptMessage(ctx: GameContext, packet: ArrayBuffer, binary: boolean) {
+// set on the length header of script messages whose payload is LZ4 compressed
+const COMPRESSED_FLAG = 0x8000_0000;
+// payloads smaller than this are sent as is, compression wouldn't save enough to be worth the CPU time
+const COMPRESSION_THRESHOLD = 1024;
+// LZ4 never expands data by more than ~255x, anything claiming more is malformed
+const MAX_COMPRESSION_RATIO = 255;
+
+// Script message framing understood by this build, announced to each peer as it enters:
+// 0: uncompressed length header and payload, what peers that never announce a version send
+// 1: COMPRESSED_FLAG on the length header marks an LZ4 compressed payload
+export const SCRIPT_MESSAGE_VERSION = 1;
+const COMPRESSED_SCRIPT_MESSAGE_VERSION = 1;
+
+let compressionBuffer = new Uint8Array(0);
+
+function createScriptMessageVersionMessage() {
+  writeMetadata(messageView, NetworkAction.InformScriptMessageVersion);
+  writeUint8(messageView, SCRIPT_MESSAGE_VERSION);
+  return sliceCursorView(messageView);
+}
+
+function deserializeScriptMessageVersion(ctx: GameContext, v: CursorView, peerId: string) {
+  const network = getModule(ctx, NetworkModule);
+  network.peerIdToScriptMessageVersion.set(peerId, readUint8(v));
+}
+
+// A peer on an older build would read the compressed flag as part of the payload length
+export function peersAcceptCompressedScriptMessages(network: GameNetworkState, peerIds: string[]) {
+  for (let i = 0; i < peerIds.length; i++) {
+    const version = network.peerIdToScriptMessageVersion.get(peerIds[i]);
+
+    if (version === undefined || version < COMPRESSED_SCRIPT_MESSAGE_VERSION) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+function createScriptMessage(packet: Uint8Array, binary: boolean, compress: boolean) {
   writeMetadata(messageView, binary ? NetworkAction.BinaryScriptMessage : NetworkAction.StringScriptMessage);
-  serializeScriptMessage(messageView, packet);
+  serializeScriptMessage(messageView, packet, compress);
   return sliceCursorView(messageView);
 }
 
-function serializeScriptMessage(v: CursorView, packet: ArrayBuffer) {
+export function serializeScriptMessage(v: CursorView, packet: Uint8Array, compress: boolean) {
+  if (compress && packet.byteLength >= COMPRESSION_THRESHOLD) {
+    if (compressionBuffer.byteLength < packet.byteLength) {
+      compressionBuffer = new Uint8Array(packet.byteLength);
+    }
+
+    // only accept output that is smaller than the original payload
+    const compressedLength = lz4Compress(packet, compressionBuffer.subarray(0, packet.byteLength - 1));
+
+    if (compressedLength > 0) {
+      writeUint32(v, (packet.byteLength | COMPRESSED_FLAG) >>> 0);
+      writeUint32(v, compressedLength);
+      cursorWriteArrayBuffer(v, compressionBuffer.subarray(0, compressedLength));
+      return;
+    }
+  }
+
   writeUint32(v, packet.byteLength);
   cursorWriteArrayBuffer(v, packet);
 }
 
+export function readScriptMessagePacket(v: CursorView) {
+  const header = readUint32(v);
+
+  if (!(header & COMPRESSED_FLAG)) {
+    return readArrayBuffer(v, header);
+  }
+
+  const len = header & ~COMPRESSED_FLAG;
+  const compressedLength = readUint32(v);
+
+  if (len > compressedLength * MAX_COMPRESSION_RATIO) {
+    throw new Error("Invalid compressed script message length");
+  }
+
+  const packet = new ArrayBuffer(len);
+  const compressed = new Uint8Array(v.buffer, v.byteOffset + v.cursor, compressedLength);
+  v.cursor += compressedLength;
+
+  if (lz4Decompress(compressed, new Uint8Array(packet)) !== len) {
+    throw new Error("Compressed script message length mismatch");
+  }
+
+  return packet;
+}
+
 function deserializeScriptMessage(ctx: GameContext, v: CursorView, peerId: string, binary: boolean) {
-  const len = readUint32(v);
-  const packet = readArrayBuffer(v, len);
+  let packet: ArrayBuffer;
+
+  try {
+    packet = readScriptMessagePacket(v);
+  } catch (error) {
+    console.error("WebSGNetworking: Error reading script message from", peerId, error);
+    return;
+  }
+
+  const len = packet.byteLength;
 
   const message: [string, ArrayBuffer, boolean] = [peerId, packet, binary];
 
@@ -682,12 +877,15 @@ function deserializeScriptMessage(ctx: GameContext, v: CursorView, peerId: strin
     const resourceManager = script.wasmCtx.resourceManager;
 
     if (resourceManager.networkListeners.length === 0) {
-      return;
+      continue;
     }
 
+    recordReceived(resourceManager.networkStats, len);
+
     for (let i = 0; i < resourceManager.networkListeners.length; i++) {
       const listener = resourceManager.networkListeners[i];
       listener.inbound.push(message);
+      recordReceived(listener.stats, len);
     }
   }
 }
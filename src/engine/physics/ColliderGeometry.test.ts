@@ -0,0 +1,32 @@
+import { deepEqual, strictEqual } from "assert";
+
+import { clusterColliderVertices } from "./ColliderGeometry";
+
+describe("clusterColliderVertices", () => {
+  test("merge vertices in the same cell and drop collapsed triangles", () => {
+    // a quad with a sliver triangle along its bottom edge
+    const positions = new Float32Array([0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0.5, 0.01, 0]);
+    const indices = [0, 1, 2, 0, 2, 3, 0, 4, 1];
+
+    const { positions: clustered, indices: clusteredIndices } = clusterColliderVertices(positions, indices, 0.25);
+
+    strictEqual(clustered.length, 5 * 3);
+    deepEqual(Array.from(clusteredIndices), [0, 1, 2, 0, 2, 3, 0, 4, 1]);
+
+    const coarse = clusterColliderVertices(positions, indices, 0.75);
+    // vertex 4 joins vertex 0's cell, so the sliver collapses
+    strictEqual(coarse.positions.length, 4 * 3);
+    deepEqual(Array.from(coarse.indices), [0, 1, 2, 0, 2, 3]);
+    // merged vertices move to their average
+    strictEqual(coarse.positions[0], 0.25);
+    strictEqual(Math.abs(coarse.positions[1] - 0.005) < 1e-6, true);
+  });
+
+  test("treat unindexed geometry as a triangle list", () => {
+    const positions = new Float32Array([0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0]);
+    const { positions: clustered, indices } = clusterColliderVertices(positions, undefined, 0.5);
+
+    strictEqual(clustered.length, 4 * 3);
+    deepEqual(Array.from(indices), [0, 1, 2, 0, 2, 3]);
+  });
+});
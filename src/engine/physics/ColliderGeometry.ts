@@ -0,0 +1,80 @@
+/**
+ * Simplifies mesh geometry before it is turned into hull and trimesh colliders. Procedural and high poly meshes
+ * often have far more vertices than a collider needs, and both convex hull construction and trimesh queries scale
+ * with vertex and triangle count.
+ */
+
+export interface ColliderGeometry {
+  positions: Float32Array;
+  indices: Uint32Array;
+}
+
+/**
+ * Vertex clustering: snaps every vertex to a grid of cellSize and merges the vertices in each cell into their
+ * average. Triangles that collapse to a line or a point are dropped. Unindexed geometry is treated as a triangle
+ * list.
+ */
+export function clusterColliderVertices(
+  positions: Float32Array,
+  indices: ArrayLike<number> | undefined,
+  cellSize: number
+): ColliderGeometry {
+  const vertexCount = positions.length / 3;
+  const cellIndices = new Map<string, number>();
+  const vertexToCell = new Uint32Array(vertexCount);
+  const sums: number[] = [];
+  const counts: number[] = [];
+
+  for (let i = 0; i < vertexCount; i++) {
+    const x = positions[i * 3];
+    const y = positions[i * 3 + 1];
+    const z = positions[i * 3 + 2];
+    const key = `${Math.floor(x / cellSize)},${Math.floor(y / cellSize)},${Math.floor(z / cellSize)}`;
+
+    let cell = cellIndices.get(key);
+
+    if (cell === undefined) {
+      cell = counts.length;
+      cellIndices.set(key, cell);
+      sums.push(0, 0, 0);
+      counts.push(0);
+    }
+
+    sums[cell * 3] += x;
+    sums[cell * 3 + 1] += y;
+    sums[cell * 3 + 2] += z;
+    counts[cell]++;
+    vertexToCell[i] = cell;
+  }
+
+  const clusteredPositions = new Float32Array(counts.length * 3);
+
+  for (let i = 0; i < counts.length; i++) {
+    clusteredPositions[i * 3] = sums[i * 3] / counts[i];
+    clusteredPositions[i * 3 + 1] = sums[i * 3 + 1] / counts[i];
+    clusteredPositions[i * 3 + 2] = sums[i * 3 + 2] / counts[i];
+  }
+
+  const indexCount = indices ? indices.length : vertexCount;
+  const clusteredIndices = new Uint32Array(indexCount - (indexCount % 3));
+  let triangleIndex = 0;
+
+  for (let i = 0; i + 2 < indexCount; i += 3) {
+    const a = vertexToCell[indices ? indices[i] : i];
+    const b = vertexToCell[indices ? indices[i + 1] : i + 1];
+    const c = vertexToCell[indices ? indices[i + 2] : i + 2];
+
+    if (a === b || b === c || a === c) {
+      continue;
+    }
+
+    clusteredIndices[triangleIndex++] = a;
+    clusteredIndices[triangleIndex++] = b;
+    clusteredIndices[triangleIndex++] = c;
+  }
+
+  return {
+    positions: clusteredPositions,
+    indices: clusteredIndices.subarray(0, triangleIndex),
+  };
+}
@@ -0,0 +1,226 @@
+import RAPIER, { QueryFilterFlags } from "@dimforge/rapier3d-compat";
+import { quat, vec3 } from "gl-matrix";
+
+import { ColliderType } from "../resource/schema";
+import { PhysicsModuleState } from "./physics.game";
+
+/**
+ * Ray and shape casts against the physics world, shared by every system that needs to query it in bulk.
+ */
+
+export interface PhysicsQueryHit {
+  // entity id of the hit collider's node, 0 if the collider isn't attached to a node
+  eid: number;
+  // distance along the normalized cast direction
+  distance: number;
+  position: vec3;
+  normal: vec3;
+}
+
+export function createPhysicsQueryHit(): PhysicsQueryHit {
+  return {
+    eid: 0,
+    distance: 0,
+    position: vec3.create(),
+    normal: vec3.create(),
+  };
+}
+
+export interface PhysicsQueryFilter {
+  flags: QueryFilterFlags;
+  excludeRigidBody?: RAPIER.RigidBody;
+}
+
+const ray = new RAPIER.Ray({ x: 0, y: 0, z: 0 }, { x: 0, y: 0, z: 1 });
+
+/**
+ * Casts a ray and writes the closest hit into out. Returns false if nothing was hit or the direction has zero length.
+ */
+export function castPhysicsRay(
+  physics: PhysicsModuleState,
+  origin: vec3,
+  direction: vec3,
+  maxDistance: number,
+  filter: PhysicsQueryFilter,
+  out: PhysicsQueryHit
+): boolean {
+  const length = vec3.length(direction);
+
+  if (length === 0) {
+    return false;
+  }
+
+  ray.origin.x = origin[0];
+  ray.origin.y = origin[1];
+  ray.origin.z = origin[2];
+  ray.dir.x = direction[0] / length;
+  ray.dir.y = direction[1] / length;
+  ray.dir.z = direction[2] / length;
+
+  const hit = physics.physicsWorld.castRayAndGetNormal(
+    ray,
+    maxDistance,
+    true,
+    filter.flags,
+    undefined,
+    undefined,
+    filter.excludeRigidBody
+  );
+
+  if (!hit) {
+    return false;
+  }
+
+  const pos = ray.pointAt(hit.toi);
+
+  out.eid = physics.handleToEid.get(hit.collider.handle) || 0;
+  out.distance = hit.toi;
+  vec3.set(out.position, pos.x, pos.y, pos.z);
+  vec3.set(out.normal, hit.normal.x, hit.normal.y, hit.normal.z);
+
+  return true;
+}
+
+export interface PhysicsQueryShapeProps {
+  type: ColliderType;
+  size: ArrayLike<number>;
+  radius: number;
+  height: number;
+}
+
+export function createPhysicsQueryShape({ type, size, radius, height }: PhysicsQueryShapeProps): RAPIER.Shape {
+  switch (type) {
+    case ColliderType.Box:
+      return new RAPIER.Cuboid(size[0] / 2, size[1] / 2, size[2] / 2);
+    case ColliderType.Sphere:
+      return new RAPIER.Ball(radius);
+    case ColliderType.Capsule:
+      return new RAPIER.Capsule(height / 2, radius);
+    case ColliderType.Cylinder:
+      return new RAPIER.Cylinder(height / 2, radius);
+    default:
+      throw new Error(`Unsupported shape cast type ${type}`);
+  }
+}
+
+const shapePosition = new RAPIER.Vector3(0, 0, 0);
+const shapeRotation = new RAPIER.Quaternion(0, 0, 0, 1);
+const shapeVelocity = new RAPIER.Vector3(0, 0, 0);
+const tempRotation = quat.create();
+const tempWitness = vec3.create();
+
+/**
+ * Sweeps shape from origin along direction and writes the first hit into out. Returns false if nothing was hit or
+ * the direction has zero length.
+ */
+export function castPhysicsShape(
+  physics: PhysicsModuleState,
+  shape: RAPIER.Shape,
+  rotation: quat,
+  origin: vec3,
+  direction: vec3,
+  maxDistance: number,
+  filter: PhysicsQueryFilter,
+  out: PhysicsQueryHit
+): boolean {
+  const length = vec3.length(direction);
+
+  if (length === 0) {
+    return false;
+  }
+
+  shapePosition.x = origin[0];
+  shapePosition.y = origin[1];
+  shapePosition.z = origin[2];
+  shapeRotation.x = rotation[0];
+  shapeRotation.y = rotation[1];
+  shapeRotation.z = rotation[2];
+  shapeRotation.w = rotation[3];
+  shapeVelocity.x = direction[0] / length;
+  shapeVelocity.y = direction[1] / length;
+  shapeVelocity.z = direction[2] / length;
+
+  const hit = physics.physicsWorld.castShape(
+    shapePosition,
+    shapeRotation,
+    shapeVelocity,
+    shape,
+    maxDistance,
+    true,
+    filter.flags,
+    undefined,
+    undefined,
+    filter.excludeRigidBody
+  );
+
+  if (!hit) {
+    return false;
+  }
+
+  out.eid = physics.handleToEid.get(hit.collider.handle) || 0;
+  out.distance = hit.toi;
+
+  // witness2 and normal2 are in the cast shape's local space, move them to where the shape stopped
+  quat.normalize(tempRotation, rotation);
+  vec3.transformQuat(tempWitness, vec3.set(tempWitness, hit.witness2.x, hit.witness2.y, hit.witness2.z), tempRotation);
+  vec3.set(
+    out.position,
+    origin[0] + shapeVelocity.x * hit.toi + tempWitness[0],
+    origin[1] + shapeVelocity.y * hit.toi + tempWitness[1],
+    origin[2] + shapeVelocity.z * hit.toi + tempWitness[2]
+  );
+
+  // the surface normal of the hit collider points against the cast shape's normal
+  vec3.transformQuat(out.normal, vec3.set(out.normal, -hit.normal2.x, -hit.normal2.y, -hit.normal2.z), tempRotation);
+
+  return true;
+}
+
+const overlapEids = new Set<number>();
+
+/**
+ * Collects the entity ids of every node with a collider overlapping shape at position into out, once per node.
+ * out is cleared first. Returns the number of nodes found.
+ */
+export function overlapPhysicsShape(
+  physics: PhysicsModuleState,
+  shape: RAPIER.Shape,
+  position: ArrayLike<number>,
+  rotation: quat,
+  filter: PhysicsQueryFilter,
+  out: number[]
+): number {
+  shapePosition.x = position[0];
+  shapePosition.y = position[1];
+  shapePosition.z = position[2];
+  shapeRotation.x = rotation[0];
+  shapeRotation.y = rotation[1];
+  shapeRotation.z = rotation[2];
+  shapeRotation.w = rotation[3];
+
+  out.length = 0;
+  overlapEids.clear();
+
+  physics.physicsWorld.intersectionsWithShape(
+    shapePosition,
+    shapeRotation,
+    shape,
+    (collider) => {
+      const eid = physics.handleToEid.get(collider.handle);
+
+      // a node can have more than one collider
+      if (eid && !overlapEids.has(eid)) {
+        overlapEids.add(eid);
+        out.push(eid);
+      }
+
+      return true;
+    },
+    filter.flags,
+    undefined,
+    undefined,
+    filter.excludeRigidBody
+  );
+
+  return out.length;
+}
@@ -0,0 +1,50 @@
+import { deepStrictEqual, ok, strictEqual, throws } from "assert";
+
+import { addCharacterController, PhysicsModuleState, removeCharacterController } from "./physics.game";
+
+function createPhysicsState() {
+  const removed: unknown[] = [];
+
+  const physics = {
+    physicsWorld: {
+      createCharacterController: (offset: number) => ({ offset }),
+      removeCharacterController: (characterController: unknown) => removed.push(characterController),
+    },
+    eidTocharacterController: new Map(),
+  } as unknown as PhysicsModuleState;
+
+  return { physics, removed };
+}
+
+describe("character controllers", () => {
+  test("add, remove and re-add a node's character controller", () => {
+    const { physics, removed } = createPhysicsState();
+
+    const first = addCharacterController(physics, 1, 0.1);
+    strictEqual(physics.eidTocharacterController.get(1), first);
+
+    removeCharacterController(physics, 1);
+    ok(!physics.eidTocharacterController.has(1));
+    deepStrictEqual(removed, [first]);
+
+    const second = addCharacterController(physics, 1, 0.2);
+    ok(second !== first);
+    strictEqual(physics.eidTocharacterController.get(1), second);
+  });
+
+  test("allow one character controller per node", () => {
+    const { physics } = createPhysicsState();
+
+    addCharacterController(physics, 1, 0.1);
+    throws(() => addCharacterController(physics, 1, 0.1), /already has a character controller/);
+    addCharacterController(physics, 2, 0.1);
+    strictEqual(physics.eidTocharacterController.size, 2);
+  });
+
+  test("ignore removing a controller that doesn't exist", () => {
+    const { physics, removed } = createPhysicsState();
+
+    removeCharacterController(physics, 1);
+    deepStrictEqual(removed, []);
+  });
+});
@@ -15,6 +15,7 @@ import {
 } from "../resource/RemoteResources";
 import { ColliderType, MeshPrimitiveAttributeIndex, PhysicsBodyType } from "../resource/schema";
 import { getAccessorArrayView, scaleVec3Array } from "../common/accessor";
+import { clusterColliderVertices } from "./ColliderGeometry";
 import { updateMatrixWorld } from "../component/transform";
 import { Player } from "../player/Player";
 import { getRotationNoAlloc } from "../utils/getRotationNoAlloc";
@@ -27,6 +28,8 @@ export interface PhysicsModuleState {
   physicsWorld: RAPIER.World;
   eventQueue: RAPIER.EventQueue;
   handleToEid: Map<number, number>;
+  // rigid body handle to the eid of the node the body belongs to
+  bodyHandleToEid: Map<number, number>;
   characterCollision: RAPIER.CharacterCollision;
   collisionHandlers: CollisionHandler[];
   eidTocharacterController: Map<number, RAPIER.KinematicCharacterController>;
@@ -46,6 +49,7 @@ export const PhysicsModule = defineModule<GameContext, PhysicsModuleState>({
       physicsWorld,
       eventQueue,
       handleToEid,
+      bodyHandleToEid: new Map<number, number>(),
       collisionHandlers: [],
       characterCollision: new RAPIER.CharacterCollision(),
       eidTocharacterController: new Map<number, RAPIER.KinematicCharacterController>(),
@@ -200,9 +204,16 @@ export function createNodeColliderDescriptions(node: RemoteNode): RAPIER.Collide
         throw new Error("No position accessor found for collider.");
       }
 
-      const positions = getAccessorArrayView(positionAccessor).slice() as Float32Array;
+      let positions = getAccessorArrayView(positionAccessor).slice() as Float32Array;
       scaleVec3Array(positions, positions, tempScale);
 
+      let indices: Uint32Array | undefined;
+
+      if (collider.simplify > 0) {
+        const indicesView = primitive.indices ? getAccessorArrayView(primitive.indices) : undefined;
+        ({ positions, indices } = clusterColliderVertices(positions, indicesView, collider.simplify));
+      }
+
       if (type === ColliderType.Hull) {
         const hullDesc = RAPIER.ColliderDesc.convexHull(positions);
 
@@ -219,16 +230,16 @@ export function createNodeColliderDescriptions(node: RemoteNode): RAPIER.Collide
 
         descriptions.push(hullDesc);
       } else {
-        let indices: Uint32Array;
-
-        if (primitive.indices) {
-          const indicesView = getAccessorArrayView(primitive.indices);
-          indices = indicesView instanceof Uint32Array ? indicesView : new Uint32Array(indicesView);
-        } else {
-          indices = new Uint32Array(positions.length / 3);
-
-          for (let i = 0; i < indices.length; i++) {
-            indices[i] = i;
+        if (!indices) {
+          if (primitive.indices) {
+            const indicesView = getAccessorArrayView(primitive.indices);
+            indices = indicesView instanceof Uint32Array ? indicesView : new Uint32Array(indicesView);
+          } else {
+            indices = new Uint32Array(positions.length / 3);
+
+            for (let i = 0; i < indices.length; i++) {
+              indices[i] = i;
+            }
           }
         }
 
@@ -328,6 +339,7 @@ export function addPhysicsBody(
   const body = physicsWorld.createRigidBody(rigidBodyDesc);
 
   node.physicsBody.body = body;
+  physics.bodyHandleToEid.set(body.handle, node.eid);
 
   if (node.collider) {
     const colliderDescriptions = createNodeColliderDescriptions(node);
@@ -419,6 +431,26 @@ export function removePhysicsBody(world: World, node: RemoteNode) {
   removeComponent(world, RemotePhysicsBody, node.eid);
 }
 
+export function addCharacterController(physics: PhysicsModuleState, eid: number, offset: number) {
+  if (physics.eidTocharacterController.has(eid)) {
+    throw new Error("node already has a character controller.");
+  }
+
+  const characterController = physics.physicsWorld.createCharacterController(offset);
+  physics.eidTocharacterController.set(eid, characterController);
+
+  return characterController;
+}
+
+export function removeCharacterController(physics: PhysicsModuleState, eid: number) {
+  const characterController = physics.eidTocharacterController.get(eid);
+
+  if (characterController) {
+    physics.physicsWorld.removeCharacterController(characterController);
+    physics.eidTocharacterController.delete(eid);
+  }
+}
+
 export function registerCollisionHandler(ctx: GameContext, handler: CollisionHandler) {
   const { collisionHandlers } = getModule(ctx, PhysicsModule);
 
@@ -45,6 +45,7 @@ import { RendererModule, RenderContext } from "./renderer.render";
 import { removeUndefinedProperties } from "../utils/removeUndefinedProperties";
 import { RenderImageData, RenderImageDataType } from "./textures";
 import { toTrianglesDrawMode } from "./utils/toTrianglesDrawMode";
+import { createUICanvasDamage } from "./UICanvasDamage";
 import { defineLocalResourceClass } from "../resource/LocalResourceClass";
 import { createLocalResourceModule, LoadStatus } from "../resource/resource.common";
 import {
@@ -653,6 +654,11 @@ export class RenderUICanvas extends defineLocalResourceClass(UICanvasResource) {
   canvas?: OffscreenCanvas;
   ctx2d?: OffscreenCanvasRenderingContext2D;
   lastRedraw = 0;
+  damage = createUICanvasDamage();
+  // UITextCache generation the canvas was last drawn with
+  textCacheGeneration = 0;
+  // staging texture for partial uploads of the damaged region
+  damageTexture?: Texture;
 }
 export class RenderCollider extends defineLocalResourceClass(ColliderResource) {
   declare mesh: RenderMesh | undefined;
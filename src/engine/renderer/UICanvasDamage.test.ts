@@ -0,0 +1,109 @@
+import { deepStrictEqual, strictEqual } from "assert";
+
+import {
+  createUICanvasDamage,
+  invalidateUICanvasDamage,
+  UIDamageElement,
+  updateUICanvasDamage,
+} from "./UICanvasDamage";
+
+const createElement = (x: number, y: number, width: number, height: number, value?: string): UIDamageElement => ({
+  layout: { x, y, width, height },
+  backgroundColor: [0, 0, 0, 1],
+  borderColor: [0, 0, 0, 0],
+  borderWidth: [0, 0, 0, 0],
+  borderRadius: [0, 0, 0, 0],
+  padding: [0, 0, 0, 0],
+  text:
+    value === undefined
+      ? undefined
+      : { value, fontFamily: "", fontWeight: "", fontStyle: "", fontSize: 10, color: [1, 1, 1, 1] },
+});
+
+// 5 pixels per character
+const measureText = (element: UIDamageElement) => element.text!.value.length * 5;
+
+describe("UICanvasDamage", () => {
+  let root: UIDamageElement;
+  let title: UIDamageElement;
+  let score: UIDamageElement;
+
+  beforeEach(() => {
+    root = createElement(0, 0, 1000, 1000);
+    title = createElement(10, 10, 200, 20, "Title");
+    score = createElement(800, 900, 100, 20, "0");
+    root.firstChild = title;
+    title.nextSibling = score;
+  });
+
+  test("redraw everything the first time", () => {
+    strictEqual(updateUICanvasDamage(createUICanvasDamage(), root, 1000, 1000, measureText), true);
+  });
+
+  test("skip redraws when nothing changed", () => {
+    const damage = createUICanvasDamage();
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+    strictEqual(updateUICanvasDamage(damage, root, 1000, 1000, measureText), false);
+    strictEqual(damage.redrawCount, 1);
+  });
+
+  test("redraw everything after the damage is invalidated", () => {
+    const damage = createUICanvasDamage();
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+
+    invalidateUICanvasDamage(damage);
+
+    strictEqual(updateUICanvasDamage(damage, root, 1000, 1000, measureText), true);
+    strictEqual(damage.full, true);
+    strictEqual(damage.fullRedrawCount, 2);
+    strictEqual(updateUICanvasDamage(damage, root, 1000, 1000, measureText), false);
+  });
+
+  test("only redraw the changed text", () => {
+    const damage = createUICanvasDamage();
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+
+    for (let i = 1; i <= 10; i++) {
+      score.text!.value = String(i);
+      strictEqual(updateUICanvasDamage(damage, root, 1000, 1000, measureText), true);
+      strictEqual(damage.full, false);
+      deepStrictEqual(damage.rect, { x: 799, y: 899, width: 102, height: 22 });
+    }
+
+    strictEqual(damage.redrawCount, 11);
+    strictEqual(damage.fullRedrawCount, 1);
+    strictEqual(damage.redrawnArea, 1000 * 1000 + 10 * 102 * 22);
+  });
+
+  test("include where a moved element was", () => {
+    const damage = createUICanvasDamage();
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+
+    title.layout.x = 20;
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+    deepStrictEqual(damage.rect, { x: 9, y: 9, width: 212, height: 22 });
+  });
+
+  test("include overflowing text and removed elements", () => {
+    const damage = createUICanvasDamage();
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+
+    score.text!.value = "0".repeat(60);
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+    deepStrictEqual(damage.rect, { x: 799, y: 899, width: 201, height: 22 });
+
+    title.nextSibling = undefined;
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+    deepStrictEqual(damage.rect, { x: 799, y: 899, width: 201, height: 22 });
+  });
+
+  test("redraw everything when most of the canvas changed", () => {
+    const damage = createUICanvasDamage();
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+
+    root.backgroundColor = [1, 0, 0, 1];
+    updateUICanvasDamage(damage, root, 1000, 1000, measureText);
+    strictEqual(damage.full, true);
+    deepStrictEqual(damage.rect, { x: 0, y: 0, width: 1000, height: 1000 });
+  });
+});
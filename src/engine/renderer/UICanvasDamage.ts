@@ -0,0 +1,352 @@
+import { LoadStatus } from "../resource/resource.common";
+
+/**
+ * Tracks what each element of a UI canvas looked like when it was last drawn so that a redraw only needs to
+ * re-rasterize and re-upload the region that actually changed.
+ */
+
+export interface UIDamageElement {
+  layout: { x: number; y: number; width: number; height: number };
+  backgroundColor: ArrayLike<number>;
+  borderColor: ArrayLike<number>;
+  borderWidth: ArrayLike<number>;
+  borderRadius: ArrayLike<number>;
+  padding: ArrayLike<number>;
+  text?: {
+    value: string;
+    fontFamily: string;
+    fontWeight: string;
+    fontStyle: string;
+    fontSize: number;
+    color: ArrayLike<number>;
+  };
+  image?: { source: { imageData?: { data: unknown }; loadStatus: LoadStatus } };
+  firstChild?: UIDamageElement;
+  nextSibling?: UIDamageElement;
+}
+
+export interface UIRect {
+  x: number;
+  y: number;
+  width: number;
+  height: number;
+}
+
+interface UIElementDrawState {
+  frame: number;
+  drawIndex: number;
+  // the pixels touched when the element was drawn, including its border stroke and text
+  bounds: UIRect;
+  layout: UIRect;
+  backgroundColor: Float32Array;
+  borderColor: Float32Array;
+  borderWidth: Float32Array;
+  borderRadius: Float32Array;
+  padding: Float32Array;
+  textValue: string | undefined;
+  fontFamily: string;
+  fontWeight: string;
+  fontStyle: string;
+  fontSize: number;
+  textColor: Float32Array;
+  image: unknown;
+}
+
+export interface UICanvasDamage {
+  width: number;
+  height: number;
+  frame: number;
+  states: Map<UIDamageElement, UIElementDrawState>;
+  // the region to redraw this frame, in whole pixels and clamped to the canvas
+  rect: UIRect;
+  full: boolean;
+  // totals for profiling
+  redrawCount: number;
+  fullRedrawCount: number;
+  redrawnArea: number;
+}
+
+// when most of the canvas changed, one full redraw and upload is cheaper than a partial one
+const FULL_REDRAW_AREA_RATIO = 0.5;
+
+export function createUICanvasDamage(): UICanvasDamage {
+  return {
+    width: 0,
+    height: 0,
+    frame: 0,
+    states: new Map(),
+    rect: { x: 0, y: 0, width: 0, height: 0 },
+    full: false,
+    redrawCount: 0,
+    fullRedrawCount: 0,
+    redrawnArea: 0,
+  };
+}
+
+/**
+ * Forgets what was drawn so that the next updateUICanvasDamage call redraws the whole canvas.
+ */
+export function invalidateUICanvasDamage(damage: UICanvasDamage) {
+  damage.width = 0;
+  damage.height = 0;
+  damage.states.clear();
+}
+
+function createDrawState(): UIElementDrawState {
+  return {
+    frame: 0,
+    drawIndex: -1,
+    bounds: { x: 0, y: 0, width: 0, height: 0 },
+    layout: { x: 0, y: 0, width: 0, height: 0 },
+    backgroundColor: new Float32Array(4),
+    borderColor: new Float32Array(4),
+    borderWidth: new Float32Array(4),
+    borderRadius: new Float32Array(4),
+    padding: new Float32Array(4),
+    textValue: undefined,
+    fontFamily: "",
+    fontWeight: "",
+    fontStyle: "",
+    fontSize: 0,
+    textColor: new Float32Array(4),
+    image: undefined,
+  };
+}
+
+// copies source into target and returns true if anything changed
+function updateVec4(target: Float32Array, source: ArrayLike<number>): boolean {
+  let changed = false;
+
+  for (let i = 0; i < 4; i++) {
+    const value = Math.fround(source[i]);
+
+    if (target[i] !== value && !(Number.isNaN(target[i]) && Number.isNaN(value))) {
+      target[i] = value;
+      changed = true;
+    }
+  }
+
+  return changed;
+}
+
+interface DamageBounds {
+  minX: number;
+  minY: number;
+  maxX: number;
+  maxY: number;
+}
+
+function addDamage(bounds: DamageBounds, x: number, y: number, width: number, height: number) {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  bounds.minX = Math.min(bounds.minX, x);
+  bounds.minY = Math.min(bounds.minY, y);
+  bounds.maxX = Math.max(bounds.maxX, x + width);
+  bounds.maxY = Math.max(bounds.maxY, y + height);
+}
+
+function updateElementDrawState(
+  state: UIElementDrawState,
+  element: UIDamageElement,
+  drawIndex: number,
+  measureText: (element: UIDamageElement) => number
+): boolean {
+  const { layout, text } = element;
+  const source = element.image?.source;
+  const image = source?.loadStatus === LoadStatus.Loaded ? source.imageData?.data : undefined;
+
+  let changed = state.drawIndex !== drawIndex;
+  state.drawIndex = drawIndex;
+
+  if (
+    state.layout.x !== layout.x ||
+    state.layout.y !== layout.y ||
+    state.layout.width !== layout.width ||
+    state.layout.height !== layout.height
+  ) {
+    state.layout.x = layout.x;
+    state.layout.y = layout.y;
+    state.layout.width = layout.width;
+    state.layout.height = layout.height;
+    changed = true;
+  }
+
+  // non-short-circuiting so every stored value is brought up to date
+  changed = updateVec4(state.backgroundColor, element.backgroundColor) || changed;
+  changed = updateVec4(state.borderColor, element.borderColor) || changed;
+  changed = updateVec4(state.borderWidth, element.borderWidth) || changed;
+  changed = updateVec4(state.borderRadius, element.borderRadius) || changed;
+  changed = updateVec4(state.padding, element.padding) || changed;
+
+  if (state.image !== image) {
+    state.image = image;
+    changed = true;
+  }
+
+  const textValue = text ? text.value : undefined;
+
+  if (
+    state.textValue !== textValue ||
+    (text &&
+      (state.fontFamily !== text.fontFamily ||
+        state.fontWeight !== text.fontWeight ||
+        state.fontStyle !== text.fontStyle ||
+        state.fontSize !== text.fontSize))
+  ) {
+    state.textValue = textValue;
+
+    if (text) {
+      state.fontFamily = text.fontFamily;
+      state.fontWeight = text.fontWeight;
+      state.fontStyle = text.fontStyle;
+      state.fontSize = text.fontSize;
+    }
+
+    changed = true;
+  }
+
+  if (text) {
+    changed = updateVec4(state.textColor, text.color) || changed;
+  }
+
+  if (changed) {
+    // the border is stroked on the element's edge, half of it falls outside, plus a pixel for antialiasing
+    const outset = Math.max(state.borderWidth[0], 0) / 2 + 1;
+    let right = layout.x + layout.width + outset;
+    let bottom = layout.y + layout.height + outset;
+
+    // text isn't clipped to its element and can overflow it
+    if (textValue !== undefined && textValue.length > 0) {
+      const textX = layout.x + state.padding[3];
+      const textY = layout.y + state.padding[0];
+      right = Math.max(right, textX + measureText(element) + 1);
+      bottom = Math.max(bottom, textY + (text!.fontSize || 12) * 1.5);
+    }
+
+    state.bounds.x = layout.x - outset;
+    state.bounds.y = layout.y - outset;
+    state.bounds.width = right - state.bounds.x;
+    state.bounds.height = bottom - state.bounds.y;
+  }
+
+  return changed;
+}
+
+/**
+ * Compares the laid out element tree with what was drawn last time and computes the region to redraw into
+ * damage.rect. Returns false if nothing changed. Sets damage.full when the whole canvas should be redrawn.
+ */
+export function updateUICanvasDamage(
+  damage: UICanvasDamage,
+  root: UIDamageElement,
+  width: number,
+  height: number,
+  measureText: (element: UIDamageElement) => number
+): boolean {
+  const frame = ++damage.frame;
+  const bounds: DamageBounds = { minX: Infinity, minY: Infinity, maxX: -Infinity, maxY: -Infinity };
+
+  let full = damage.width !== width || damage.height !== height;
+  damage.width = width;
+  damage.height = height;
+
+  // depth first in draw order
+  const stack: UIDamageElement[] = [root];
+  let drawIndex = 0;
+
+  while (stack.length) {
+    const element = stack.pop()!;
+
+    let state = damage.states.get(element);
+
+    if (!state) {
+      state = createDrawState();
+      damage.states.set(element, state);
+    }
+
+    // the old bounds are needed in case the element moved or shrank
+    const { x, y, width: oldWidth, height: oldHeight } = state.bounds;
+
+    if (updateElementDrawState(state, element, drawIndex++, measureText)) {
+      addDamage(bounds, x, y, oldWidth, oldHeight);
+      addDamage(bounds, state.bounds.x, state.bounds.y, state.bounds.width, state.bounds.height);
+    }
+
+    state.frame = frame;
+    pushChildren(stack, element);
+  }
+
+  // elements that are no longer part of the tree leave a hole where they were drawn
+  for (const [element, state] of damage.states) {
+    if (state.frame !== frame) {
+      addDamage(bounds, state.bounds.x, state.bounds.y, state.bounds.width, state.bounds.height);
+      damage.states.delete(element);
+    }
+  }
+
+  const rect = damage.rect;
+
+  if (!full) {
+    if (bounds.minX === Infinity) {
+      return false;
+    }
+
+    rect.x = Math.max(Math.floor(bounds.minX), 0);
+    rect.y = Math.max(Math.floor(bounds.minY), 0);
+    rect.width = Math.min(Math.ceil(bounds.maxX), width) - rect.x;
+    rect.height = Math.min(Math.ceil(bounds.maxY), height) - rect.y;
+
+    if (rect.width <= 0 || rect.height <= 0) {
+      return false;
+    }
+
+    full = rect.width * rect.height >= width * height * FULL_REDRAW_AREA_RATIO;
+  }
+
+  if (full) {
+    rect.x = 0;
+    rect.y = 0;
+    rect.width = width;
+    rect.height = height;
+    damage.fullRedrawCount++;
+  }
+
+  damage.full = full;
+  damage.redrawCount++;
+  damage.redrawnArea += rect.width * rect.height;
+
+  return true;
+}
+
+function pushChildren(stack: UIDamageElement[], element: UIDamageElement) {
+  const start = stack.length;
+  let child = element.firstChild;
+
+  while (child) {
+    stack.push(child);
+    child = child.nextSibling;
+  }
+
+  // children are drawn first to last, so the first child has to be on top of the stack
+  let end = stack.length - 1;
+  let i = start;
+
+  while (i < end) {
+    const temp = stack[i];
+    stack[i++] = stack[end];
+    stack[end--] = temp;
+  }
+}
+
+/**
+ * Returns the last drawn bounds of element, or undefined if it hasn't been drawn.
+ */
+export function getUIElementDrawBounds(damage: UICanvasDamage, element: UIDamageElement): UIRect | undefined {
+  return damage.states.get(element)?.bounds;
+}
+
+export function intersectsUIRect(a: UIRect, b: UIRect): boolean {
+  return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
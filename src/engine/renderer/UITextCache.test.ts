@@ -0,0 +1,83 @@
+import { deepStrictEqual, strictEqual } from "assert";
+
+import { allocateUITextRun, clearUITextCache, createUITextCache, measureUIText } from "./UITextCache";
+
+const createContext = () => {
+  const ctx2d = {
+    font: "",
+    textBaseline: "",
+    measureCount: 0,
+    measureText(text: string) {
+      ctx2d.measureCount++;
+      return {
+        width: text.length * 5.5,
+        actualBoundingBoxLeft: 0,
+        actualBoundingBoxRight: text.length * 5.5,
+        actualBoundingBoxAscent: 0,
+        actualBoundingBoxDescent: 9.5,
+      };
+    },
+  };
+
+  return ctx2d;
+};
+
+describe("UITextCache", () => {
+  test("measure each string once per font", () => {
+    const cache = createUITextCache();
+    const ctx2d = createContext();
+    const context = ctx2d as unknown as OffscreenCanvasRenderingContext2D;
+
+    for (let i = 0; i < 100; i++) {
+      deepStrictEqual(measureUIText(cache, context, "12px sans-serif", "Score: 10"), {
+        width: 50,
+        height: 10,
+        left: 0,
+        right: 50,
+        ascent: 0,
+        descent: 10,
+      });
+    }
+
+    measureUIText(cache, context, "24px sans-serif", "Score: 10");
+
+    strictEqual(ctx2d.measureCount, 2);
+    strictEqual(cache.measureHits, 99);
+    strictEqual(cache.measureMisses, 2);
+  });
+
+  test("measure again after the cache is cleared", () => {
+    const cache = createUITextCache(100);
+    const ctx2d = createContext();
+    const context = ctx2d as unknown as OffscreenCanvasRenderingContext2D;
+
+    measureUIText(cache, context, "12px Inter", "Score: 10");
+    allocateUITextRun(cache, 60, 10);
+
+    // a web font finished loading, the first measurement used the fallback font
+    ctx2d.measureText = (text: string) => ({
+      width: text.length * 6,
+      actualBoundingBoxLeft: 0,
+      actualBoundingBoxRight: text.length * 6,
+      actualBoundingBoxAscent: 0,
+      actualBoundingBoxDescent: 11,
+    });
+    clearUITextCache(cache);
+
+    strictEqual(measureUIText(cache, context, "12px Inter", "Score: 10").width, 54);
+    strictEqual(cache.metricsCount, 1);
+    strictEqual(cache.generation, 1);
+    // the atlas starts over
+    deepStrictEqual(allocateUITextRun(cache, 60, 10), { x: 0, y: 0, width: 60, height: 10, originX: 0, originY: 0 });
+  });
+
+  test("pack runs into rows", () => {
+    const cache = createUITextCache(100);
+
+    deepStrictEqual(allocateUITextRun(cache, 60, 10), { x: 0, y: 0, width: 60, height: 10, originX: 0, originY: 0 });
+    deepStrictEqual(allocateUITextRun(cache, 40, 20), { x: 60, y: 0, width: 40, height: 20, originX: 0, originY: 0 });
+    deepStrictEqual(allocateUITextRun(cache, 50, 50), { x: 0, y: 20, width: 50, height: 50, originX: 0, originY: 0 });
+    deepStrictEqual(allocateUITextRun(cache, 50, 30), { x: 50, y: 20, width: 50, height: 30, originX: 0, originY: 0 });
+    strictEqual(allocateUITextRun(cache, 10, 40), undefined);
+  });
+});
@@ -0,0 +1,251 @@
+/**
+ * Caches text measurements and rasterized text runs shared by all UI canvases so that redrawing a canvas doesn't
+ * shape and rasterize the same strings over and over. Runs are keyed by font, color and string and packed into
+ * rows of a single atlas canvas which is cleared and refilled when it runs out of space.
+ */
+
+export interface UITextMetrics {
+  width: number;
+  height: number;
+  // extents of the drawn glyphs relative to the "top" text baseline origin
+  left: number;
+  right: number;
+  ascent: number;
+  descent: number;
+}
+
+export interface UITextRun {
+  x: number;
+  y: number;
+  width: number;
+  height: number;
+  // offset of the text origin within the run
+  originX: number;
+  originY: number;
+}
+
+export interface UITextCache {
+  metrics: Map<string, Map<string, UITextMetrics>>;
+  metricsCount: number;
+  runs: Map<string, UITextRun>;
+  atlasSize: number;
+  atlas?: OffscreenCanvas;
+  atlasCtx?: OffscreenCanvasRenderingContext2D;
+  // shelf packing cursor
+  rowX: number;
+  rowY: number;
+  rowHeight: number;
+  // totals for profiling
+  measureHits: number;
+  measureMisses: number;
+  runHits: number;
+  runMisses: number;
+  atlasResets: number;
+  // incremented by clearUITextCache so canvases drawn with the old entries know to redraw
+  generation: number;
+}
+
+const MAX_CACHED_METRICS = 4096;
+// padding around each run so that antialiasing doesn't bleed into its neighbours
+const RUN_PADDING = 1;
+// runs larger than this fraction of the atlas are drawn directly instead of evicting everything else
+const MAX_RUN_ATLAS_RATIO = 0.5;
+
+export function createUITextCache(atlasSize = 2048): UITextCache {
+  return {
+    metrics: new Map(),
+    metricsCount: 0,
+    runs: new Map(),
+    atlasSize,
+    rowX: 0,
+    rowY: 0,
+    rowHeight: 0,
+    measureHits: 0,
+    measureMisses: 0,
+    runHits: 0,
+    runMisses: 0,
+    atlasResets: 0,
+    generation: 0,
+  };
+}
+
+export function measureUIText(
+  cache: UITextCache,
+  ctx2d: OffscreenCanvasRenderingContext2D,
+  font: string,
+  text: string
+): UITextMetrics {
+  let fontMetrics = cache.metrics.get(font);
+
+  if (!fontMetrics) {
+    fontMetrics = new Map();
+    cache.metrics.set(font, fontMetrics);
+  }
+
+  let metrics = fontMetrics.get(text);
+
+  if (metrics) {
+    cache.measureHits++;
+    return metrics;
+  }
+
+  cache.measureMisses++;
+
+  // chat logs and counters produce an unbounded number of strings, start over rather than growing forever
+  if (cache.metricsCount >= MAX_CACHED_METRICS) {
+    cache.metrics.clear();
+    cache.metrics.set(font, fontMetrics);
+    fontMetrics.clear();
+    cache.metricsCount = 0;
+  }
+
+  ctx2d.textBaseline = "top";
+  ctx2d.font = font;
+  const textMetrics = ctx2d.measureText(text);
+
+  metrics = {
+    width: Math.ceil(textMetrics.width),
+    height: Math.ceil(textMetrics.actualBoundingBoxAscent + textMetrics.actualBoundingBoxDescent),
+    left: Math.ceil(Math.max(textMetrics.actualBoundingBoxLeft, 0)),
+    right: Math.ceil(Math.max(textMetrics.actualBoundingBoxRight, textMetrics.width)),
+    ascent: Math.ceil(Math.max(textMetrics.actualBoundingBoxAscent, 0)),
+    descent: Math.ceil(Math.max(textMetrics.actualBoundingBoxDescent, 0)),
+  };
+
+  fontMetrics.set(text, metrics);
+  cache.metricsCount++;
+
+  return metrics;
+}
+
+/**
+ * Reserves a width x height region of the atlas. Returns undefined if the region doesn't fit in the remaining
+ * space.
+ */
+export function allocateUITextRun(cache: UITextCache, width: number, height: number): UITextRun | undefined {
+  const size = cache.atlasSize;
+
+  if (cache.rowX + width > size) {
+    cache.rowX = 0;
+    cache.rowY += cache.rowHeight;
+    cache.rowHeight = 0;
+  }
+
+  if (cache.rowY + height > size) {
+    return undefined;
+  }
+
+  const run = { x: cache.rowX, y: cache.rowY, width, height, originX: 0, originY: 0 };
+  cache.rowX += width;
+  cache.rowHeight = Math.max(cache.rowHeight, height);
+
+  return run;
+}
+
+function resetAtlas(cache: UITextCache) {
+  cache.runs.clear();
+  cache.rowX = 0;
+  cache.rowY = 0;
+  cache.rowHeight = 0;
+  cache.atlasCtx?.clearRect(0, 0, cache.atlasSize, cache.atlasSize);
+  cache.atlasResets++;
+}
+
+/**
+ * Drops every cached measurement and run. Text measured or drawn while a web font was still loading used the
+ * fallback font's glyphs and metrics, so the cache is cleared once fonts finish loading.
+ */
+export function clearUITextCache(cache: UITextCache) {
+  cache.metrics.clear();
+  cache.metricsCount = 0;
+  resetAtlas(cache);
+  cache.generation++;
+}
+
+function getUITextRun(
+  cache: UITextCache,
+  ctx2d: OffscreenCanvasRenderingContext2D,
+  font: string,
+  color: string,
+  text: string
+): UITextRun | undefined {
+  const key = `${font}|${color}|${text}`;
+  let run = cache.runs.get(key);
+
+  if (run) {
+    cache.runHits++;
+    return run;
+  }
+
+  cache.runMisses++;
+
+  const metrics = measureUIText(cache, ctx2d, font, text);
+  const width = metrics.left + metrics.right + RUN_PADDING * 2;
+  const height = metrics.ascent + metrics.descent + RUN_PADDING * 2;
+  const maxSize = cache.atlasSize * MAX_RUN_ATLAS_RATIO;
+
+  if (width > maxSize || height > maxSize) {
+    return undefined;
+  }
+
+  run = allocateUITextRun(cache, width, height);
+
+  if (!run) {
+    resetAtlas(cache);
+    run = allocateUITextRun(cache, width, height)!;
+  }
+
+  if (!cache.atlas) {
+    cache.atlas = new OffscreenCanvas(cache.atlasSize, cache.atlasSize);
+    cache.atlasCtx = cache.atlas.getContext("2d") as OffscreenCanvasRenderingContext2D;
+  }
+
+  run.originX = RUN_PADDING + metrics.left;
+  run.originY = RUN_PADDING + metrics.ascent;
+
+  const atlasCtx = cache.atlasCtx!;
+  atlasCtx.textBaseline = "top";
+  atlasCtx.font = font;
+  atlasCtx.fillStyle = color;
+  atlasCtx.fillText(text, run.x + run.originX, run.y + run.originY);
+
+  cache.runs.set(key, run);
+
+  return run;
+}
+
+/**
+ * Draws text with a "top" baseline at x, y, copying it from the atlas when it has been drawn before.
+ */
+export function drawUIText(
+  cache: UITextCache,
+  ctx2d: OffscreenCanvasRenderingContext2D,
+  font: string,
+  color: string,
+  text: string,
+  x: number,
+  y: number
+) {
+  const run = getUITextRun(cache, ctx2d, font, color, text);
+
+  if (!run) {
+    ctx2d.textBaseline = "top";
+    ctx2d.font = font;
+    ctx2d.fillStyle = color;
+    ctx2d.fillText(text, x, y);
+    return;
+  }
+
+  // whole pixels so the copy isn't resampled
+  ctx2d.drawImage(
+    cache.atlas!,
+    run.x,
+    run.y,
+    run.width,
+    run.height,
+    Math.round(x) - run.originX,
+    Math.round(y) - run.originY,
+    run.width,
+    run.height
+  );
+}
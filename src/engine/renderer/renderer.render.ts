@@ -69,6 +69,7 @@ import { MatrixMaterial } from "./materials/MatrixMaterial";
 import { HologramMaterial } from "./materials/HologramMaterial";
 import { ArrayBufferKTX2Loader } from "./ArrayBufferKTX2Loader";
 import { findHitButton } from "./ui";
+import { clearUITextCache, createUITextCache, UITextCache } from "./UITextCache";
 import { StatsBuffer } from "../stats/stats.common";
 import { XRInputLayout, XRInputProfileManager } from "./xr/WebXRInputProfiles";
 import { InputRingBuffer } from "../common/InputRingBuffer";
@@ -120,6 +121,7 @@ export interface RendererModuleState {
   nodeOptimizationsEnabled: boolean;
   loadingImages: Set<RenderImage>;
   loadingText: Set<RenderUIText>;
+  uiTextCache: UITextCache;
   yoga: Yoga;
   statsBuffer: StatsBuffer;
   staleFrameCounter: number;
@@ -261,6 +263,7 @@ export const RendererModule = defineModule<RenderContext, RendererModuleState>({
       loadingImages: new Set(),
       // HACK: figure out why sometimes text.value is undefined
       loadingText: new Set(),
+      uiTextCache: createUITextCache(),
       statsBuffer,
       staleFrameCounter: 0,
       staleTripleBufferCounter: 0,
@@ -271,7 +274,10 @@ export const RendererModule = defineModule<RenderContext, RendererModuleState>({
     };
   },
   init(ctx) {
-    const { renderer, inputSourceItems, inputProfileManager, cameraPoseTripleBuffer } = getModule(ctx, RendererModule);
+    const { renderer, inputSourceItems, inputProfileManager, cameraPoseTripleBuffer, uiTextCache } = getModule(
+      ctx,
+      RendererModule
+    );
 
     let nextInputSourceId = Object.keys(InputSourceId).length;
 
@@ -373,6 +379,17 @@ export const RendererModule = defineModule<RenderContext, RendererModuleState>({
       renderer.xr.removeEventListener("sessionend", onXRSessionEnd);
     };
 
+    // the render thread is a worker unless it runs on the main thread, each has its own font set
+    const fontFaceSet: FontFaceSet | undefined =
+      typeof document !== "undefined" ? document.fonts : (self as unknown as { fonts?: FontFaceSet }).fonts;
+
+    // UI text measured and drawn while a web font was loading used the fallback font
+    const onFontsLoaded = () => clearUITextCache(uiTextCache);
+
+    fontFaceSet?.addEventListener("loadingdone", onFontsLoaded);
+
+    const disposeFontHandlers = () => fontFaceSet?.removeEventListener("loadingdone", onFontsLoaded);
+
     return createDisposables([
       registerMessageHandler(ctx, RendererMessageType.CanvasResize, onResize),
       registerMessageHandler(ctx, RendererMessageType.NotifySceneRendered, onNotifySceneRendered),
@@ -386,6 +403,7 @@ export const RendererModule = defineModule<RenderContext, RendererModuleState>({
       registerMessageHandler(ctx, RendererMessageType.UICanvasFocus, onUICanvasFocused),
       registerMessageHandler(ctx, RendererMessageType.SetXRReferenceSpace, onSetXRReferenceSpace),
       disposeSessionHandlers,
+      disposeFontHandlers,
     ]);
   },
 });
@@ -39,7 +39,7 @@ import {
 import { getModule } from "../../module/module.common";
 import { getLocalResources, RenderLightMap, RenderMesh, RenderMeshPrimitive, RenderNode } from "../RenderResources";
 import { CameraType, InstancedMeshAttributeIndex, LightType, MeshPrimitiveMode } from "../../resource/schema";
-import { updateUICanvas } from "../ui";
+import { updateUICanvas, uploadUICanvasDamage } from "../ui";
 import { HologramMaterial } from "../materials/HologramMaterial";
 import { MatrixMaterial } from "../materials/MatrixMaterial";
 import { MeshPrimitiveAttributeToThreeAttribute, PrimitiveObject3D } from "../mesh";
@@ -719,7 +719,12 @@ function updateNodeUICanvas(ctx: RenderContext, scene: Scene, node: RenderNode)
   // update
 
   if (updateUICanvas(ctx, uiCanvas)) {
-    (node.uiCanvasMesh.material as MeshBasicMaterial & { map: Texture }).map.needsUpdate = true;
+    const { renderer } = getModule(ctx, RendererModule);
+    const map = (node.uiCanvasMesh.material as MeshBasicMaterial & { map: Texture }).map;
+
+    if (!uploadUICanvasDamage(renderer, uiCanvas, map)) {
+      map.needsUpdate = true;
+    }
   }
 
   // update the canvas mesh transform with the node's
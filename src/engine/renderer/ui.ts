@@ -1,6 +1,7 @@
 // typedefs: https://github.com/facebook/yoga/blob/main/javascript/src_js/wrapAsm.d.ts
 import { Yoga, Node, DIRECTION_LTR, Edge, PositionType, FlexDirection, Wrap, Align, Justify } from "yoga-wasm-web";
 import { vec3 } from "gl-matrix";
+import { Texture, Vector2, WebGLRenderer } from "three";
 
 import { getModule } from "../module/module.common";
 import { RenderContext } from "./renderer.render";
@@ -9,6 +10,14 @@ import { RenderImageDataType } from "./textures";
 import { LoadStatus } from "../resource/resource.common";
 import { FlexEdge } from "../resource/schema";
 import { RendererModule } from "./renderer.render";
+import { drawUIText, measureUIText, UITextCache } from "./UITextCache";
+import {
+  getUIElementDrawBounds,
+  intersectsUIRect,
+  invalidateUICanvasDamage,
+  UICanvasDamage,
+  updateUICanvasDamage,
+} from "./UICanvasDamage";
 
 export function findHitButton(uiCanvas: RenderUICanvas, hitPoint: vec3): RenderUIButton | undefined {
   const { size, width, height, root } = uiCanvas;
@@ -53,44 +62,93 @@ function traverseUIElements(
 }
 
 export function updateUICanvas(ctx: RenderContext, uiCanvas: RenderUICanvas) {
-  const { yoga, loadingImages, loadingText } = getModule(ctx, RendererModule);
+  const { yoga, loadingImages, loadingText, uiTextCache } = getModule(ctx, RendererModule);
+
+  // text drawn before the cache was cleared may have used a fallback font, redraw all of it
+  if (uiCanvas.textCacheGeneration !== uiTextCache.generation) {
+    uiCanvas.textCacheGeneration = uiTextCache.generation;
+    invalidateUICanvasDamage(uiCanvas.damage);
+    uiCanvas.lastRedraw = 0;
+  }
 
   if (uiCanvas.redraw > uiCanvas.lastRedraw) {
     const ctx2d = uiCanvas.ctx2d!;
-    updateCanvasLayout(ctx2d, yoga, uiCanvas);
-    drawCanvas(ctx2d, uiCanvas, loadingImages, loadingText);
+    updateCanvasLayout(ctx2d, uiTextCache, yoga, uiCanvas);
+
+    // only redraw the elements whose appearance changed since the last draw
+    const damaged = updateUICanvasDamage(uiCanvas.damage, uiCanvas.root, uiCanvas.width, uiCanvas.height, (element) =>
+      getTextSize(ctx2d, uiTextCache, (element as RenderUIElement).text).width
+    );
+
+    if (damaged) {
+      drawCanvas(ctx2d, uiTextCache, uiCanvas, loadingImages, loadingText);
+    }
 
     // only stop rendering when all images have loaded
     if (loadingImages.size === 0 && loadingText.size === 0) {
       uiCanvas.lastRedraw = uiCanvas.redraw;
     }
 
-    return true;
+    return damaged;
   }
 
   return false;
 }
 
-function updateCanvasLayout(ctx2d: OffscreenCanvasRenderingContext2D, yoga: Yoga, uiCanvas: RenderUICanvas) {
-  const [process, node] = updateElementLayout(ctx2d, yoga, uiCanvas.root);
+const uploadPosition = new Vector2();
+
+/**
+ * Uploads the region of the canvas redrawn by the last updateUICanvas call to its texture. Returns false if the
+ * whole texture needs to be uploaded instead.
+ */
+export function uploadUICanvasDamage(renderer: WebGLRenderer, uiCanvas: RenderUICanvas, texture: Texture): boolean {
+  const { full, rect } = uiCanvas.damage;
+
+  if (full || texture.version === 0) {
+    return false;
+  }
+
+  const { x, y, width, height } = rect;
+
+  if (!uiCanvas.damageTexture) {
+    uiCanvas.damageTexture = new Texture();
+  }
+
+  uiCanvas.damageTexture.image = uiCanvas.ctx2d!.getImageData(x, y, width, height);
+
+  // texture rows are uploaded bottom up when flipped
+  uploadPosition.set(x, texture.flipY ? uiCanvas.height - y - height : y);
+  renderer.copyTextureToTexture(uploadPosition, uiCanvas.damageTexture, texture);
+
+  return true;
+}
+
+function updateCanvasLayout(
+  ctx2d: OffscreenCanvasRenderingContext2D,
+  textCache: UITextCache,
+  yoga: Yoga,
+  uiCanvas: RenderUICanvas
+) {
+  const [process, node] = updateElementLayout(ctx2d, textCache, yoga, uiCanvas.root);
   node.calculateLayout(uiCanvas.root.width, uiCanvas.root.height, DIRECTION_LTR);
   process();
 }
 
 function updateElementLayout(
   ctx2d: OffscreenCanvasRenderingContext2D,
+  textCache: UITextCache,
   yoga: Yoga,
   element: RenderUIElement
 ): [Function, Node] {
   const node = yoga.Node.create();
 
   const children: Function[] = [];
-  updateYogaNode(ctx2d, node, element);
+  updateYogaNode(ctx2d, textCache, node, element);
 
   let curChild = element.firstChild;
 
   while (curChild) {
-    const [processChild, childNode] = updateElementLayout(ctx2d, yoga, curChild);
+    const [processChild, childNode] = updateElementLayout(ctx2d, textCache, yoga, curChild);
     const index = children.push(processChild);
     node.insertChild(childNode, index - 1);
     curChild = curChild.nextSibling;
@@ -114,7 +172,12 @@ function updateElementLayout(
   return [process, node];
 }
 
-function updateYogaNode(ctx2d: OffscreenCanvasRenderingContext2D, yogaNode: Node, child: RenderUIElement) {
+function updateYogaNode(
+  ctx2d: OffscreenCanvasRenderingContext2D,
+  textCache: UITextCache,
+  yogaNode: Node,
+  child: RenderUIElement
+) {
   yogaNode.setPositionType(child.positionType as PositionType);
 
   yogaNode.setPosition(FlexEdge.TOP as Edge, child.position[0]);
@@ -158,7 +221,7 @@ function updateYogaNode(ctx2d: OffscreenCanvasRenderingContext2D, yogaNode: Node
 
   if (child.text) {
     yogaNode.setMeasureFunc(() => {
-      return getTextSize(ctx2d, child.text);
+      return getTextSize(ctx2d, textCache, child.text);
     });
   }
 }
@@ -173,28 +236,62 @@ const rgbaToString = ([r, g, b, a]: Float32Array) => `rgba(${r * 255},${g * 255}
 const createFontString = (text: RenderUIText) =>
   `${text.fontStyle} ${text.fontWeight} ${text.fontSize || 12}px ${text.fontFamily || "sans-serif"}`.trim();
 
-function getTextSize(ctx2d: OffscreenCanvasRenderingContext2D, text: RenderUIText): Size {
-  ctx2d.textBaseline = "top";
-  ctx2d.font = createFontString(text);
-  const metrics = ctx2d.measureText(text.value);
-  return {
-    width: Math.ceil(metrics.width),
-    height: Math.ceil(metrics.actualBoundingBoxAscent + metrics.actualBoundingBoxDescent),
-  };
+function getTextSize(ctx2d: OffscreenCanvasRenderingContext2D, textCache: UITextCache, text: RenderUIText): Size {
+  return measureUIText(textCache, ctx2d, createFontString(text), text.value);
 }
 
 function drawCanvas(
   ctx2d: OffscreenCanvasRenderingContext2D,
+  textCache: UITextCache,
   uiCanvas: RenderUICanvas,
   loadingImages: Set<RenderImage>,
   loadingText: Set<RenderUIText>
 ) {
-  ctx2d.clearRect(0, 0, uiCanvas.width, uiCanvas.height);
-  drawNode(ctx2d, loadingImages, loadingText, uiCanvas.root);
+  const damage = uiCanvas.damage;
+
+  if (damage.full) {
+    ctx2d.clearRect(0, 0, uiCanvas.width, uiCanvas.height);
+    drawNode(ctx2d, textCache, loadingImages, loadingText, uiCanvas.root);
+    return;
+  }
+
+  // redraw every element overlapping the damaged region, clipped to it
+  const { x, y, width, height } = damage.rect;
+  ctx2d.save();
+  ctx2d.beginPath();
+  ctx2d.rect(x, y, width, height);
+  ctx2d.clip();
+  ctx2d.clearRect(x, y, width, height);
+  drawNode(ctx2d, textCache, loadingImages, loadingText, uiCanvas.root, damage);
+  ctx2d.restore();
 }
 
 function drawNode(
   ctx2d: OffscreenCanvasRenderingContext2D,
+  textCache: UITextCache,
+  loadingImages: Set<RenderImage>,
+  loadingText: Set<RenderUIText>,
+  element: RenderUIElement,
+  damage?: UICanvasDamage
+) {
+  const bounds = damage && getUIElementDrawBounds(damage, element);
+
+  if (!damage || !bounds || intersectsUIRect(bounds, damage.rect)) {
+    drawElement(ctx2d, textCache, loadingImages, loadingText, element);
+  }
+
+  // Draw children
+  let curChild = element.firstChild;
+
+  while (curChild) {
+    drawNode(ctx2d, textCache, loadingImages, loadingText, curChild, damage);
+    curChild = curChild.nextSibling;
+  }
+}
+
+function drawElement(
+  ctx2d: OffscreenCanvasRenderingContext2D,
+  textCache: UITextCache,
   loadingImages: Set<RenderImage>,
   loadingText: Set<RenderUIText>,
   element: RenderUIElement
@@ -235,18 +332,15 @@ function drawNode(
       loadingText.add(element.text);
     } else {
       loadingText.delete(element.text);
-      ctx2d.textBaseline = "top";
-      ctx2d.font = createFontString(element.text);
-      ctx2d.fillStyle = rgbaToString(element.text.color);
-      ctx2d.fillText(element.text.value, layout.x + element.padding[3], layout.y + element.padding[0]);
+      drawUIText(
+        textCache,
+        ctx2d,
+        createFontString(element.text),
+        rgbaToString(element.text.color),
+        element.text.value,
+        layout.x + element.padding[3],
+        layout.y + element.padding[0]
+      );
     }
   }
-
-  // Draw children
-  let curChild = element.firstChild;
-
-  while (curChild) {
-    drawNode(ctx2d, loadingImages, loadingText, curChild);
-    curChild = curChild.nextSibling;
-  }
 }
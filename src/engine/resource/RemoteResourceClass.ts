@@ -1,12 +1,14 @@
 import { createTripleBuffer } from "../allocator/TripleBuffer";
 import { RemoteResourceManager } from "../GameTypes";
 import kebabToPascalCase from "../utils/kebabToPascalCase";
+import { addOwnedResource } from "./ResourceOwnership";
 import {
   addResourceRef,
   createArrayBufferResource,
   createRemoteResource,
   createStringResource,
   removeResourceRef,
+  renameRemoteResource,
 } from "./resource.game";
 import {
   Schema,
@@ -266,7 +268,7 @@ export function defineRemoteResourceClass<T extends number, S extends Schema, De
     }
 
     this.eid = createRemoteResource(this.manager.ctx, this);
-    this.manager.resourceIds.add(this.eid);
+    addOwnedResource(this.manager.ownership, this.eid);
   }
 
   Object.defineProperties(RemoteResourceClass, {
@@ -365,6 +367,10 @@ function defineProp<T extends number, S extends Schema, Def extends DefinedResou
                 addResourceRef(this.manager.ctx, resourceId);
                 this.u32View[offset] = resourceId;
               }
+
+              if (propName === "name" && this.manager.resourceMap.has(this.eid)) {
+                renameRemoteResource(this.manager.ctx, this as unknown as RemoteResource, value);
+              }
             }
           },
         }
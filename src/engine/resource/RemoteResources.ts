@@ -44,7 +44,9 @@ import {
   PhysicsBodyResource,
 } from "./schema";
 import { getModule } from "../module/module.common";
-import { PhysicsModule } from "../physics/physics.game";
+import { PhysicsModule, removeCharacterController } from "../physics/physics.game";
+import { NetworkModule } from "../network/network.game";
+import { disposeNetworkPriority } from "../network/NetworkPriority";
 import { removeResourceRef } from "./resource.game";
 
 export class RemoteNametag extends defineRemoteResourceClass(NametagResource) {}
@@ -169,6 +171,14 @@ export class RemotePhysicsBody extends defineRemoteResourceClass(PhysicsBodyReso
         physics.handleToEid.delete(collider.handle);
       }
 
+      const eid = physics.bodyHandleToEid.get(this.body.handle);
+
+      // a character controller moves its node's body, it goes with the body
+      if (eid !== undefined) {
+        removeCharacterController(physics, eid);
+      }
+
+      physics.bodyHandleToEid.delete(this.body.handle);
       physics.physicsWorld.removeRigidBody(this.body);
     }
 
@@ -223,6 +233,11 @@ export class RemoteNode extends defineRemoteResourceClass(NodeResource) {
   set isStatic(value: boolean) {
     this.u32View[NodeIsStaticOffset] = value ? 1 : 0;
   }
+
+  dispose() {
+    // scripts can set a priority on nodes that were never networked, which the Networked exit query doesn't clear
+    disposeNetworkPriority(getModule(this.manager.ctx, NetworkModule), this.eid);
+  }
 }
 
 export class RemoteAnimationSampler extends defineRemoteResourceClass(AnimationSamplerResource) {
@@ -0,0 +1,83 @@
+import { strictEqual } from "assert";
+
+import {
+  createResourceNameIndex,
+  findResourceByName,
+  findResourceByNameBytes,
+  removeResourceName,
+  setResourceName,
+} from "./ResourceNameIndex";
+
+describe("ResourceNameIndex", () => {
+  test("find resources by name", () => {
+    const index = createResourceNameIndex<{ id: number }>();
+    const a = { id: 1 };
+    const b = { id: 2 };
+    const c = { id: 3 };
+
+    setResourceName(index, a, "Door");
+    setResourceName(index, b, "Light");
+    setResourceName(index, c, "Door");
+
+    strictEqual(findResourceByName(index, "Door"), a);
+    strictEqual(findResourceByName(index, "Door", (resource) => resource !== a), c);
+    strictEqual(findResourceByName(index, "Light"), b);
+    strictEqual(findResourceByName(index, "Lamp"), undefined);
+  });
+
+  test("find resources by name bytes", () => {
+    const index = createResourceNameIndex<{ id: number }>();
+    const a = { id: 1 };
+    setResourceName(index, a, "Tür");
+
+    const heap = new Uint8Array(32);
+    const bytes = new TextEncoder().encode("Tür");
+    heap.set(bytes, 8);
+
+    strictEqual(findResourceByNameBytes(index, heap, 8, 8 + bytes.length), a);
+    strictEqual(findResourceByNameBytes(index, heap, 8, 8 + bytes.length - 1), undefined);
+  });
+
+  test("update the index on rename and removal", () => {
+    const index = createResourceNameIndex<{ id: number }>();
+    const a = { id: 1 };
+
+    setResourceName(index, a, "Door");
+    setResourceName(index, a, "Gate");
+    strictEqual(findResourceByName(index, "Door"), undefined);
+    strictEqual(findResourceByName(index, "Gate"), a);
+
+    removeResourceName(index, a);
+    strictEqual(findResourceByName(index, "Gate"), undefined);
+    strictEqual(index.buckets.size, 0);
+  });
+
+  test("return resources sharing a name in creation order", () => {
+    const index = createResourceNameIndex<{ id: number }>();
+    const a = { id: 1 };
+    const b = { id: 2 };
+    const c = { id: 3 };
+
+    // created in order, named later in a different order
+    setResourceName(index, a, undefined);
+    setResourceName(index, b, undefined);
+    setResourceName(index, c, "Door");
+    setResourceName(index, b, "Door");
+    setResourceName(index, a, "Door");
+
+    strictEqual(findResourceByName(index, "Door"), a);
+    strictEqual(findResourceByName(index, "Door", (resource) => resource !== a), b);
+
+    // renaming keeps a resource's place
+    setResourceName(index, a, "Gate");
+    setResourceName(index, a, "Door");
+    strictEqual(findResourceByName(index, "Door"), a);
+
+    // a resource created after a removal comes last
+    removeResourceName(index, a);
+    const d = { id: 4 };
+    setResourceName(index, d, "Door");
+    strictEqual(findResourceByName(index, "Door"), b);
+    strictEqual(findResourceByName(index, "Door", (resource) => resource !== b && resource !== c), d);
+  });
+});
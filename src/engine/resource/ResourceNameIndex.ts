@@ -0,0 +1,162 @@
+/**
+ * Maps resource names to resources by a hash of the name's UTF-8 bytes so that scripts can look resources up by a
+ * name in linear memory without decoding it or scanning every resource of the type.
+ *
+ * A resource's creation order is the order it was first passed to setResourceName, named or not. Resources that
+ * share a name are kept in that order so lookups return the earliest created one, like a scan over the resources
+ * of the type would.
+ */
+
+interface ResourceNameEntry<T> {
+  resource: T;
+  hash: number;
+  nameBytes: Uint8Array;
+  order: number;
+}
+
+export interface ResourceNameIndex<T> {
+  buckets: Map<number, ResourceNameEntry<T>[]>;
+  entries: Map<T, ResourceNameEntry<T>>;
+  creationOrder: Map<T, number>;
+  nextOrder: number;
+}
+
+const textEncoder = new TextEncoder();
+
+export function createResourceNameIndex<T>(): ResourceNameIndex<T> {
+  return {
+    buckets: new Map(),
+    entries: new Map(),
+    creationOrder: new Map(),
+    nextOrder: 0,
+  };
+}
+
+// 32 bit FNV-1a
+export function hashNameBytes(bytes: Uint8Array, start = 0, end = bytes.length): number {
+  let hash = 0x811c9dc5;
+
+  for (let i = start; i < end; i++) {
+    hash ^= bytes[i];
+    hash = Math.imul(hash, 0x01000193);
+  }
+
+  return hash >>> 0;
+}
+
+function unindexResourceName<T>(index: ResourceNameIndex<T>, resource: T) {
+  const entry = index.entries.get(resource);
+
+  if (!entry) {
+    return;
+  }
+
+  index.entries.delete(resource);
+
+  const bucket = index.buckets.get(entry.hash)!;
+
+  if (bucket.length === 1) {
+    index.buckets.delete(entry.hash);
+  } else {
+    bucket.splice(bucket.indexOf(entry), 1);
+  }
+}
+
+/**
+ * Removes resource from the index when it is disposed.
+ */
+export function removeResourceName<T>(index: ResourceNameIndex<T>, resource: T) {
+  unindexResourceName(index, resource);
+  index.creationOrder.delete(resource);
+}
+
+/**
+ * Indexes resource under name, replacing any previous name. Unnamed resources are not indexed.
+ */
+export function setResourceName<T>(index: ResourceNameIndex<T>, resource: T, name: string | undefined) {
+  unindexResourceName(index, resource);
+
+  let order = index.creationOrder.get(resource);
+
+  if (order === undefined) {
+    order = index.nextOrder++;
+    index.creationOrder.set(resource, order);
+  }
+
+  if (!name) {
+    return;
+  }
+
+  const nameBytes = textEncoder.encode(name);
+  const hash = hashNameBytes(nameBytes);
+  const entry = { resource, hash, nameBytes, order };
+
+  index.entries.set(resource, entry);
+
+  const bucket = index.buckets.get(hash);
+
+  if (!bucket) {
+    index.buckets.set(hash, [entry]);
+    return;
+  }
+
+  // buckets hold the few resources sharing a name hash, keep them in creation order
+  let i = bucket.length;
+
+  while (i > 0 && bucket[i - 1].order > order) {
+    i--;
+  }
+
+  bucket.splice(i, 0, entry);
+}
+
+function nameBytesEqual(nameBytes: Uint8Array, bytes: Uint8Array, start: number, end: number) {
+  if (nameBytes.length !== end - start) {
+    return false;
+  }
+
+  for (let i = 0; i < nameBytes.length; i++) {
+    if (nameBytes[i] !== bytes[start + i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Returns the earliest created indexed resource whose name equals the UTF-8 bytes in
+ * bytes[start..end) and that passes filter.
+ */
+export function findResourceByNameBytes<T>(
+  index: ResourceNameIndex<T>,
+  bytes: Uint8Array,
+  start: number,
+  end: number,
+  filter?: (resource: T) => boolean
+): T | undefined {
+  const bucket = index.buckets.get(hashNameBytes(bytes, start, end));
+
+  if (!bucket) {
+    return undefined;
+  }
+
+  for (let i = 0; i < bucket.length; i++) {
+    const { resource, nameBytes } = bucket[i];
+
+    if (nameBytesEqual(nameBytes, bytes, start, end) && (!filter || filter(resource))) {
+      return resource;
+    }
+  }
+
+  return undefined;
+}
+
+export function findResourceByName<T>(
+  index: ResourceNameIndex<T>,
+  name: string,
+  filter?: (resource: T) => boolean
+): T | undefined {
+  const bytes = textEncoder.encode(name);
+  return findResourceByNameBytes(index, bytes, 0, bytes.length, filter);
+}
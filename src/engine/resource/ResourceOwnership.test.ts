@@ -0,0 +1,60 @@
+import { strictEqual } from "assert";
+
+import {
+  addOwnedResource,
+  createResourceGenerations,
+  createResourceOwnership,
+  ownsResource,
+  retireResourceId,
+} from "./ResourceOwnership";
+
+describe("ResourceOwnership", () => {
+  test("only own added resources", () => {
+    const generations = createResourceGenerations(16);
+    const a = createResourceOwnership(generations);
+    const b = createResourceOwnership(generations);
+
+    addOwnedResource(a, 3);
+    addOwnedResource(b, 4);
+
+    strictEqual(ownsResource(a, 3), true);
+    strictEqual(ownsResource(a, 4), false);
+    strictEqual(ownsResource(b, 3), false);
+    strictEqual(ownsResource(b, 4), true);
+    strictEqual(ownsResource(a, 0), false);
+  });
+
+  test("reject out of range ids", () => {
+    const ownership = createResourceOwnership(createResourceGenerations(16));
+
+    strictEqual(ownsResource(ownership, 16), false);
+    strictEqual(ownsResource(ownership, 0xffffffff), false);
+  });
+
+  test("reject stale ids after they are recycled", () => {
+    const generations = createResourceGenerations(16);
+    const a = createResourceOwnership(generations);
+    const b = createResourceOwnership(generations);
+
+    addOwnedResource(a, 5);
+    retireResourceId(generations, 5);
+    strictEqual(ownsResource(a, 5), false);
+
+    addOwnedResource(b, 5);
+    strictEqual(ownsResource(a, 5), false);
+    strictEqual(ownsResource(b, 5), true);
+  });
+
+  test("skip the unowned generation when wrapping around", () => {
+    const generations = createResourceGenerations(1);
+    const ownership = createResourceOwnership(generations);
+
+    generations[0] = 0xffffffff;
+    retireResourceId(generations, 0);
+    strictEqual(generations[0], 1);
+
+    strictEqual(ownsResource(ownership, 0), false);
+    addOwnedResource(ownership, 0);
+    strictEqual(ownsResource(ownership, 0), true);
+  });
+});
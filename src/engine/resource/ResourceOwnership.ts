@@ -0,0 +1,45 @@
+/**
+ * Tracks which resources a resource manager may use in a dense array indexed by resource id, so that checking a
+ * script's access on every WebSG import is two array loads instead of a Set lookup.
+ *
+ * Resource ids are entity ids, which are recycled after a resource is removed. Every id has a generation shared by
+ * all managers that changes when the resource using it is removed. A manager stores the generation it was given the
+ * resource at, so ids of removed resources stop matching even once they are reused.
+ */
+
+export interface ResourceOwnership {
+  // current generation of each resource id, shared by all managers
+  generations: Uint32Array;
+  // generation each resource id was owned at, 0 if it was never owned
+  owned: Uint32Array;
+}
+
+export function createResourceGenerations(maxResources: number): Uint32Array {
+  // start at 1 so that 0 can mean "not owned"
+  return new Uint32Array(maxResources).fill(1);
+}
+
+export function createResourceOwnership(generations: Uint32Array): ResourceOwnership {
+  return {
+    generations,
+    owned: new Uint32Array(generations.length),
+  };
+}
+
+/**
+ * Invalidates every manager's ownership of resourceId. Call when the resource using the id is removed.
+ */
+export function retireResourceId(generations: Uint32Array, resourceId: number) {
+  // skip 0 when wrapping around
+  generations[resourceId] = (generations[resourceId] + 1) >>> 0 || 1;
+}
+
+export function addOwnedResource(ownership: ResourceOwnership, resourceId: number) {
+  ownership.owned[resourceId] = ownership.generations[resourceId];
+}
+
+export function ownsResource(ownership: ResourceOwnership, resourceId: number): boolean {
+  const generation = ownership.owned[resourceId];
+  // out of range ids read as undefined and fail the first comparison
+  return generation > 0 && generation === ownership.generations[resourceId];
+}
@@ -72,7 +72,10 @@ import {
   ResourceRingBufferItem,
 } from "./ResourceRingBuffer";
 import { IRemoteResourceClass, RemoteResource } from "./RemoteResourceClass";
+import { createResourceNameIndex, removeResourceName, ResourceNameIndex, setResourceName } from "./ResourceNameIndex";
+import { createResourceGenerations, createResourceOwnership, retireResourceId } from "./ResourceOwnership";
 import { maxEntities } from "../config.common";
+import { createNetworkTrafficStats } from "../network/NetworkStats";
 
 const ResourceComponent = defineComponent();
 
@@ -91,6 +94,8 @@ export interface ResourceModuleState {
   resourceMap: Map<number, RemoteResourceTypes>;
   resourceInfos: Map<ResourceId, ResourceInfo>;
   resourcesByType: Map<ResourceType, RemoteResource[]>;
+  resourceNamesByType: Map<ResourceType, ResourceNameIndex<RemoteResource>>;
+  resourceGenerations: Uint32Array;
   resourceDefByType: Map<number, ResourceDefinition>;
   fromGameState: FromGameResourceModuleStateTripleBuffer;
   mainToGameState: ToGameResourceModuleStateTripleBuffer;
@@ -161,6 +166,8 @@ export const ResourceModule = defineModule<GameContext, ResourceModuleState>({
       resourceInfos: new Map(),
       resourceMap: new Map(),
       resourcesByType: new Map(),
+      resourceNamesByType: new Map(),
+      resourceGenerations: createResourceGenerations(maxEntities),
       fromGameState,
       mainToGameState,
       renderToGameState,
@@ -232,7 +239,7 @@ export function createRemoteResourceManager(ctx: GameContext, id: string): Remot
   return {
     id,
     ctx,
-    resourceIds: new Set(),
+    ownership: createResourceOwnership(resourceModule.resourceGenerations),
     gltfCache: new Map(),
     resourceMap: resourceModule.resourceMap,
     nextQueryId: 1,
@@ -253,8 +260,10 @@ export function createRemoteResourceManager(ctx: GameContext, id: string): Remot
     nextReplicatorId: 1,
     matrixListening: false,
     inboundMatrixWidgetMessages: [],
+    matrixEventFilters: [],
     nextNetworkListenerId: 1,
     networkListeners: [],
+    networkStats: createNetworkTrafficStats(),
   };
 }
 
@@ -320,6 +329,11 @@ export function createRemoteResource(ctx: GameContext, resource: RemoteResource)
 
   resources.push(resource);
 
+  // unnamed resources are indexed too so that the index records their creation order
+  if ("name" in resource.resourceDef.schema) {
+    renameRemoteResource(ctx, resource, (resource as unknown as { name?: string }).name);
+  }
+
   return resourceId;
 }
 
@@ -357,6 +371,8 @@ export function removeResourceRef(ctx: GameContext, resourceId: ResourceId): boo
 
   resourceModule.resourceInfos.delete(resourceId);
 
+  retireResourceId(resourceModule.resourceGenerations, resourceId);
+
   const resource = resourceModule.resourceMap.get(resourceId) as RemoteResourceTypes;
 
   resourceModule.resourceMap.delete(resourceId);
@@ -380,6 +396,12 @@ export function removeResourceRef(ctx: GameContext, resourceId: ResourceId): boo
       }
     }
 
+    const nameIndex = resourceModule.resourceNamesByType.get(resourceType);
+
+    if (nameIndex) {
+      removeResourceName(nameIndex, resource);
+    }
+
     resource.removeResourceRefs();
     resource.dispose();
   }
@@ -419,6 +441,22 @@ export function getRemoteResources<Def extends ResourceDefinition>(
     []) as InstanceType<IRemoteResourceClass<Def>>[];
 }
 
+export function getRemoteResourceNameIndex(ctx: GameContext, resourceType: ResourceType) {
+  const { resourceNamesByType } = getModule(ctx, ResourceModule);
+  let nameIndex = resourceNamesByType.get(resourceType);
+
+  if (!nameIndex) {
+    nameIndex = createResourceNameIndex();
+    resourceNamesByType.set(resourceType, nameIndex);
+  }
+
+  return nameIndex;
+}
+
+export function renameRemoteResource(ctx: GameContext, resource: RemoteResource, name: string | undefined) {
+  setResourceName(getRemoteResourceNameIndex(ctx, resource.resourceType), resource, name);
+}
+
 export function ResourceTickSystem(ctx: GameContext) {
   const { fromGameState } = getModule(ctx, ResourceModule);
   const { tick } = getWriteObjectBufferView(fromGameState);
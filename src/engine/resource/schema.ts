@@ -521,6 +521,40 @@ export enum FlexEdge {
   BOTTOM = EDGE_BOTTOM,
 }
 
+// Properties that can be recorded in a script UI batch, matches UIProperty in scripting/idl/websg-ui.idl.ts
+export enum UIProperty {
+  PositionType,
+  Position,
+  AlignContent,
+  AlignItems,
+  AlignSelf,
+  FlexDirection,
+  FlexWrap,
+  FlexBasis,
+  FlexGrow,
+  FlexShrink,
+  JustifyContent,
+  Width,
+  Height,
+  MinWidth,
+  MinHeight,
+  MaxWidth,
+  MaxHeight,
+  BackgroundColor,
+  BorderColor,
+  Padding,
+  Margin,
+  BorderWidth,
+  BorderRadius,
+  ButtonLabel,
+  TextValue,
+  TextFontFamily,
+  TextFontStyle,
+  TextFontWeight,
+  TextFontSize,
+  TextColor,
+}
+
 export const UITextResource = defineResource("ui-text", ResourceType.UIText, {
   value: PropType.string({ script: true }),
   fontFamily: PropType.string({ script: true }),
@@ -655,6 +689,8 @@ export const ColliderResource = defineResource("collider", ResourceType.Collider
   radius: PropType.f32({ mutable: false }),
   height: PropType.f32({ mutable: false }),
   mesh: PropType.ref(MeshResource, { mutable: false }),
+  // grid cell size that hull and trimesh vertices are snapped to and merged in, 0 uses the mesh as is
+  simplify: PropType.f32({ mutable: false }),
 });
 
 export enum PhysicsBodyType {
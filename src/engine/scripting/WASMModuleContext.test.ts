@@ -0,0 +1,69 @@
+import { deepStrictEqual, strictEqual } from "assert";
+
+import {
+  createWASMStringCache,
+  getStringByteLength,
+  readJSON,
+  readString,
+  WASMModuleContext,
+  writeString,
+} from "./WASMModuleContext";
+
+function createStringContext(): WASMModuleContext {
+  const memory = new WebAssembly.Memory({ initial: 1 });
+
+  return {
+    memory,
+    U8Heap: new Uint8Array(memory.buffer),
+    textEncoder: new TextEncoder(),
+    textDecoder: new TextDecoder(),
+    strings: createWASMStringCache(),
+  } as unknown as WASMModuleContext;
+}
+
+describe("WASMModuleContext strings", () => {
+  test("report UTF-8 byte lengths", () => {
+    const wasmCtx = createStringContext();
+
+    strictEqual(getStringByteLength(wasmCtx, "abc"), 3);
+    strictEqual(getStringByteLength(wasmCtx, "héllo"), 6);
+    strictEqual(getStringByteLength(wasmCtx, "€".repeat(200)), 600);
+  });
+
+  test("write null terminated strings", () => {
+    const wasmCtx = createStringContext();
+
+    strictEqual(writeString(wasmCtx, 8, "héllo"), 6);
+    strictEqual(wasmCtx.U8Heap[14], 0);
+    strictEqual(readString(wasmCtx, 8, 255), "héllo");
+  });
+
+  test("reuse decoded strings until their bytes change", () => {
+    const wasmCtx = createStringContext();
+
+    writeString(wasmCtx, 8, "name");
+    const first = readString(wasmCtx, 8, 255);
+    strictEqual(readString(wasmCtx, 8, 255), first);
+    strictEqual(wasmCtx.strings.hits, 1);
+    strictEqual(wasmCtx.strings.misses, 1);
+
+    writeString(wasmCtx, 8, "nose");
+    strictEqual(readString(wasmCtx, 8, 255), "nose");
+    strictEqual(wasmCtx.strings.misses, 2);
+  });
+
+  test("only cache short strings", () => {
+    const wasmCtx = createStringContext();
+    const long = "a".repeat(257);
+
+    writeString(wasmCtx, 8, long);
+    strictEqual(readString(wasmCtx, 8, 1024), long);
+    strictEqual(readString(wasmCtx, 8, 1024), long);
+    strictEqual(wasmCtx.strings.decoded.size, 0);
+
+    writeString(wasmCtx, 8, JSON.stringify({ a: 1 }));
+    deepStrictEqual(readJSON(wasmCtx, 8, 1024), { a: 1 });
+    strictEqual(wasmCtx.strings.decoded.size, 0);
+    strictEqual(wasmCtx.strings.hits + wasmCtx.strings.misses, 0);
+  });
+});
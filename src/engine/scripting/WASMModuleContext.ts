@@ -7,8 +7,10 @@ import {
   skipUint32,
 } from "../allocator/CursorView";
 import { GameContext, RemoteResourceManager } from "../GameTypes";
-import { IRemoteResourceClass, RemoteResourceConstructor } from "../resource/RemoteResourceClass";
-import { getRemoteResources } from "../resource/resource.game";
+import { RemoteResourceConstructor } from "../resource/RemoteResourceClass";
+import { getRemoteResourceNameIndex } from "../resource/resource.game";
+import { findResourceByName, findResourceByNameBytes } from "../resource/ResourceNameIndex";
+import { ownsResource } from "../resource/ResourceOwnership";
 import { toSharedArrayBuffer } from "../utils/arraybuffer";
 
 export interface WASMModuleContext {
@@ -19,67 +21,165 @@ export interface WASMModuleContext {
   F32Heap: Float32Array;
   textEncoder: TextEncoder;
   textDecoder: TextDecoder;
+  strings: WASMStringCache;
   cursorView: CursorView;
   encodedJSSource?: Uint8Array;
   resourceManager: RemoteResourceManager;
+  // number of buffered WebSG commands that failed when flushed, for profiling
+  failedCommands: number;
+}
+
+interface WASMDecodedString {
+  // copy of the bytes the value was decoded from
+  bytes: Uint8Array;
+  value: string;
+}
+
+/**
+ * Scripts tend to pass the same strings from the same place in linear memory every frame, such as UI text and
+ * resource names, so short decoded strings are cached by pointer and reused while the bytes there are unchanged.
+ * Strings written into linear memory are encoded into a reusable scratch buffer instead of a new array per call.
+ */
+export interface WASMStringCache {
+  decoded: Map<number, WASMDecodedString>;
+  scratch: Uint8Array;
+  // the string last encoded into scratch, so that a byte length query followed by a write only encodes once
+  encoded?: string;
+  encodedByteLength: number;
+  // totals for profiling
+  hits: number;
+  misses: number;
+}
+
+const MAX_DECODED_STRINGS = 1024;
+// longer strings are rarely passed unchanged every frame and would make the cache hold onto a lot of memory
+const MAX_DECODED_STRING_BYTE_LENGTH = 256;
+
+export function createWASMStringCache(): WASMStringCache {
+  return {
+    decoded: new Map(),
+    scratch: new Uint8Array(256),
+    encodedByteLength: 0,
+    hits: 0,
+    misses: 0,
+  };
+}
+
+/**
+ * Encodes value into the scratch buffer and returns its UTF-8 byte length.
+ */
+export function getStringByteLength(wasmCtx: WASMModuleContext, value: string): number {
+  const strings = wasmCtx.strings;
+
+  if (strings.encoded === value) {
+    return strings.encodedByteLength;
+  }
+
+  let result = wasmCtx.textEncoder.encodeInto(value, strings.scratch);
+
+  if (result.read < value.length) {
+    // a UTF-16 code unit is at most 3 UTF-8 bytes
+    strings.scratch = new Uint8Array(value.length * 3);
+    result = wasmCtx.textEncoder.encodeInto(value, strings.scratch);
+  }
+
+  strings.encoded = value;
+  strings.encodedByteLength = result.written;
+
+  return result.written;
 }
 
 export function writeString(wasmCtx: WASMModuleContext, ptr: number, value: string, maxBufLength?: number) {
-  const arr = wasmCtx.textEncoder.encode(value);
+  const byteLength = getStringByteLength(wasmCtx, value);
 
-  if (maxBufLength !== undefined && arr.byteLength > maxBufLength) {
+  if (maxBufLength !== undefined && byteLength > maxBufLength) {
     throw new Error("Exceeded maximum byte length");
   }
 
-  return writeEncodedString(wasmCtx, ptr, arr);
+  return writeEncodedString(wasmCtx, ptr, wasmCtx.strings.scratch.subarray(0, byteLength));
 }
 
 export function writeEncodedString(wasmCtx: WASMModuleContext, ptr: number, arr: Uint8Array) {
-  const nullTerminatedArr = new Uint8Array(arr.byteLength + 1);
-  nullTerminatedArr.set(arr);
-  wasmCtx.U8Heap.set(nullTerminatedArr, ptr);
+  wasmCtx.U8Heap.set(arr, ptr);
+  wasmCtx.U8Heap[ptr + arr.byteLength] = 0;
   // Don't include null character in byte length
   return arr.byteLength;
 }
 
-export function readString(wasmCtx: WASMModuleContext, ptr: number, byteLength: number) {
-  if (!ptr) {
-    return "";
+function bytesEqual(bytes: Uint8Array, heap: Uint8Array, start: number, end: number) {
+  if (bytes.length !== end - start) {
+    return false;
+  }
+
+  for (let i = 0; i < bytes.length; i++) {
+    if (bytes[i] !== heap[start + i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+function decodeUncachedString(wasmCtx: WASMModuleContext, start: number, end: number) {
+  // create a new subarray to decode so that this always works with SharedArrayBuffer
+  return wasmCtx.textDecoder.decode(wasmCtx.U8Heap.slice(start, end));
+}
+
+function decodeString(wasmCtx: WASMModuleContext, start: number, end: number) {
+  if (end - start > MAX_DECODED_STRING_BYTE_LENGTH) {
+    return decodeUncachedString(wasmCtx, start, end);
+  }
+
+  const { U8Heap, strings } = wasmCtx;
+  const cached = strings.decoded.get(start);
+
+  if (cached && bytesEqual(cached.bytes, U8Heap, start, end)) {
+    strings.hits++;
+    return cached.value;
+  }
+
+  strings.misses++;
+
+  if (!cached && strings.decoded.size >= MAX_DECODED_STRINGS) {
+    strings.decoded.clear();
   }
 
+  // copy the bytes so that this always works with SharedArrayBuffer and stays valid after the heap changes
+  const bytes = U8Heap.slice(start, end);
+  const value = wasmCtx.textDecoder.decode(bytes);
+  strings.decoded.set(start, { bytes, value });
+
+  return value;
+}
+
+// Finds the end of the null-terminated C string on the heap
+function findStringEnd(wasmCtx: WASMModuleContext, ptr: number, byteLength: number) {
   const maxPtr = ptr + byteLength;
   let end = ptr;
 
-  // Find the end of the null-terminated C string on the heap
   while (!(end >= maxPtr) && wasmCtx.U8Heap[end]) {
     ++end;
   }
 
-  // create a new subarray to store the string so that this always works with SharedArrayBuffer
-  return wasmCtx.textDecoder.decode(wasmCtx.U8Heap.slice(ptr, end));
+  return end;
 }
 
-export function readStringFromCursorView(wasmCtx: WASMModuleContext, maxByteLength = 255) {
-  const ptr = readUint32(wasmCtx.cursorView);
-
+export function readString(wasmCtx: WASMModuleContext, ptr: number, byteLength: number) {
   if (!ptr) {
     return "";
   }
 
-  const maxPtr = ptr + maxByteLength;
-  let end = ptr;
-
-  // Find the end of the null-terminated C string on the heap
-  while (!(end >= maxPtr) && wasmCtx.U8Heap[end]) {
-    ++end;
-  }
+  return decodeString(wasmCtx, ptr, findStringEnd(wasmCtx, ptr, byteLength));
+}
 
-  // create a new subarray to store the string so that this always works with SharedArrayBuffer
-  return wasmCtx.textDecoder.decode(wasmCtx.U8Heap.slice(ptr, end));
+export function readStringFromCursorView(wasmCtx: WASMModuleContext, maxByteLength = 255) {
+  const ptr = readUint32(wasmCtx.cursorView);
+  return readString(wasmCtx, ptr, maxByteLength);
 }
 
 export function readJSON(wasmCtx: WASMModuleContext, ptr: number, byteLength: number) {
-  const jsonString = readString(wasmCtx, ptr, byteLength);
+  // JSON is parsed into a new object every time, so caching the string wouldn't save anything
+  const jsonString = ptr ? decodeUncachedString(wasmCtx, ptr, findStringEnd(wasmCtx, ptr, byteLength)) : "";
   return JSON.parse(jsonString);
 }
 
@@ -164,10 +264,10 @@ export function getScriptResource<T extends RemoteResourceConstructor>(
   resourceConstructor: T,
   resourceId: number
 ): InstanceType<T> | undefined {
-  const { resourceIds, resourceMap } = wasmCtx.resourceManager;
+  const { ownership, resourceMap } = wasmCtx.resourceManager;
   const { name, resourceType } = resourceConstructor.resourceDef;
 
-  if (!resourceIds.has(resourceId)) {
+  if (!ownsResource(ownership, resourceId)) {
     console.error(`WebSG: missing or unpermitted use of ${name}: ${resourceId}`);
     return undefined;
   }
@@ -193,19 +293,9 @@ export function getScriptResourceByName<T extends RemoteResourceConstructor>(
   resourceConstructor: T,
   name: string
 ): InstanceType<T> | undefined {
-  const resources = getRemoteResources(ctx, resourceConstructor as IRemoteResourceClass<T["resourceDef"]>);
-
-  const resourceIds = wasmCtx.resourceManager.resourceIds;
-
-  for (let i = 0; i < resources.length; i++) {
-    const resource = resources[i];
-
-    if (resource.name === name && resourceIds.has(resource.eid)) {
-      return resource as InstanceType<T>;
-    }
-  }
-
-  return undefined;
+  const nameIndex = getRemoteResourceNameIndex(ctx, resourceConstructor.resourceDef.resourceType);
+  const ownership = wasmCtx.resourceManager.ownership;
+  return findResourceByName(nameIndex, name, (resource) => ownsResource(ownership, resource.eid)) as InstanceType<T>;
 }
 
 export function getScriptResourceByNamePtr<T extends RemoteResourceConstructor>(
@@ -215,8 +305,25 @@ export function getScriptResourceByNamePtr<T extends RemoteResourceConstructor>(
   namePtr: number,
   byteLength: number
 ): InstanceType<T> | undefined {
-  const name = readString(wasmCtx, namePtr, byteLength);
-  return getScriptResourceByName(ctx, wasmCtx, resourceConstructor, name);
+  if (!namePtr) {
+    return undefined;
+  }
+
+  const U8Heap = wasmCtx.U8Heap;
+  const maxPtr = namePtr + byteLength;
+  let end = namePtr;
+
+  // Find the end of the null-terminated C string on the heap
+  while (!(end >= maxPtr) && U8Heap[end]) {
+    ++end;
+  }
+
+  // hash and compare the name in place instead of decoding it
+  const nameIndex = getRemoteResourceNameIndex(ctx, resourceConstructor.resourceDef.resourceType);
+  const ownership = wasmCtx.resourceManager.ownership;
+  return findResourceByNameBytes(nameIndex, U8Heap, namePtr, end, (resource) =>
+    ownsResource(ownership, resource.eid)
+  ) as InstanceType<T>;
 }
 
 export function getScriptResourceRef<T extends RemoteResourceConstructor>(
@@ -230,7 +337,7 @@ export function getScriptResourceRef<T extends RemoteResourceConstructor>(
 
   const resourceId = refResource.eid;
 
-  if (!wasmCtx.resourceManager.resourceIds.has(resourceId)) {
+  if (!ownsResource(wasmCtx.resourceManager.ownership, resourceId)) {
     console.error(`WebSG: missing or unpermitted use of ${resourceConstructor.name}: ${resourceId}`);
     return 0;
   }
@@ -1,21 +1,7 @@
 #!/bin/bash
 
-QUICKJS_ROOT=include/quickjs
-QUICKJS_CONFIG_VERSION=$(cat $QUICKJS_ROOT/VERSION)
+# Builds build/test.wasm, see the test profile in build.sh.
 
-emcc \
-  -O2 \
-  -g \
-  --no-entry \
-  --emit-symbol-map \
-  -s ALLOW_MEMORY_GROWTH=0 \
-  -s INITIAL_MEMORY=67108864 \
-  -s ERROR_ON_UNDEFINED_SYMBOLS=0 \
-  -Wl,--import-memory \
-  -o ./build/test.wasm \
-  -D_GNU_SOURCE \
-  -DCONFIG_VERSION=\"$QUICKJS_CONFIG_VERSION\" \
-  -DCONFIG_STACK_CHECK \
-  -DTHIRDROOM_TEST \
-  src/js-runtime/*.c \
-  src/js-runtime/quickjs/{quickjs,cutils,libregexp,libunicode}.c
+cd $(dirname $0)
+
+./build.sh test
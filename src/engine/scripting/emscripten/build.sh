@@ -1,28 +1,114 @@
 #!/bin/bash
 
+# Builds the script runtime once per build profile and reports each build's size, instantiate time and baseline heap.
+#
+#   ./build.sh        builds every profile
+#   ./build.sh lite   builds only the lite profile
+#
+# full: build/scripting-runtime.wasm, the runtime loaded for JavaScript scripts.
+# test: build/test.wasm, the full runtime with the test_* exports scripting.test.ts evaluates scripts through.
+# lite: build/scripting-runtime-lite.wasm, without the QuickJS features listed in LITE_STRIP, which defaults to all of:
+#   date     Date
+#   regexp   RegExp and regular expression literals
+#   proxy    Proxy
+#   unicode  the Unicode tables for String.prototype.normalize and \p{...} in regular expressions
+#
+# e.g. `LITE_STRIP="date proxy" ./build.sh lite`. BigNum isn't built in any profile.
+#
+# The builds and build/runtime-report.json are committed, rebuild them (e.g. with build-docker.sh) whenever the host
+# imports in websg.h, thirdroom.h, matrix.h or websg-networking.h change. Each build writes a hash of src/ to
+# <output>.sources.sha256, scripting.test.ts skips the runtime tests and fails when it doesn't match the sources.
+
 cd $(dirname $0)
 
 QUICKJS_ROOT=src/js-runtime/quickjs
 QUICKJS_CONFIG_VERSION=$(cat $QUICKJS_ROOT/VERSION)
 
-emcc \
-  -O2 \
-  -g \
-  --no-entry \
-  --emit-symbol-map \
-  -s ALLOW_MEMORY_GROWTH=0 \
-  -s INITIAL_MEMORY=67108864 \
-  -s ERROR_ON_UNDEFINED_SYMBOLS=0 \
-  -Wl,--import-memory \
-  -o ./build/scripting-runtime.wasm \
-  -D_GNU_SOURCE \
-  -DCONFIG_VERSION=\"$QUICKJS_CONFIG_VERSION\" \
-  -DCONFIG_STACK_CHECK \
-  src/js-runtime/*.c \
-  src/js-runtime/global/*.c \
-  src/js-runtime/matrix/*.c \
-  src/js-runtime/quickjs/{quickjs,cutils,libregexp,libunicode}.c \
-  src/js-runtime/thirdroom/*.c \
-  src/js-runtime/utils/*.c \
-  src/js-runtime/websg/*.c \
-  src/js-runtime/websg-networking/*.c
+PROFILES=${*:-full lite test}
+LITE_STRIP=${LITE_STRIP-date regexp proxy unicode}
+
+get_strip_flags() {
+  for feature in $1; do
+    case $feature in
+      date) echo -DTHIRDROOM_NO_DATE ;;
+      regexp) echo -DTHIRDROOM_NO_REGEXP ;;
+      proxy) echo -DTHIRDROOM_NO_PROXY ;;
+      unicode) echo -DCONFIG_NO_ALL_UNICODE ;;
+      *)
+        echo "Unknown feature \"$feature\" in LITE_STRIP" >&2
+        return 1
+        ;;
+    esac
+  done
+}
+
+build_runtime() {
+  local output=$1
+  shift
+
+  emcc \
+    -O2 \
+    -g \
+    --no-entry \
+    --emit-symbol-map \
+    -s ALLOW_MEMORY_GROWTH=0 \
+    -s INITIAL_MEMORY=67108864 \
+    -s ERROR_ON_UNDEFINED_SYMBOLS=0 \
+    -Wl,--import-memory \
+    -o $output \
+    -D_GNU_SOURCE \
+    -DCONFIG_VERSION=\"$QUICKJS_CONFIG_VERSION\" \
+    -DCONFIG_STACK_CHECK \
+    "$@" \
+    src/js-runtime/*.c \
+    src/js-runtime/global/*.c \
+    src/js-runtime/matrix/*.c \
+    src/js-runtime/quickjs/{quickjs,cutils,libregexp,libunicode}.c \
+    src/js-runtime/thirdroom/*.c \
+    src/js-runtime/utils/*.c \
+    src/js-runtime/websg/*.c \
+    src/js-runtime/websg-networking/*.c
+}
+
+# every file under src/ in C locale order, must match hashRuntimeSources in scripting.test.ts
+hash_sources() {
+  find src -type f | LC_ALL=C sort | xargs cat | sha256sum | cut -d " " -f 1
+}
+
+OUTPUTS=()
+# test.wasm is the full runtime with test exports, only the runtimes scripts load are reported
+REPORTED_OUTPUTS=()
+
+for profile in $PROFILES; do
+  case $profile in
+    full)
+      build_runtime ./build/scripting-runtime.wasm || exit 1
+      OUTPUTS+=(./build/scripting-runtime.wasm)
+      REPORTED_OUTPUTS+=(./build/scripting-runtime.wasm)
+      ;;
+    test)
+      build_runtime ./build/test.wasm -DTHIRDROOM_TEST || exit 1
+      OUTPUTS+=(./build/test.wasm)
+      ;;
+    lite)
+      STRIP_FLAGS=$(get_strip_flags "$LITE_STRIP") || exit 1
+      build_runtime ./build/scripting-runtime-lite.wasm $STRIP_FLAGS || exit 1
+      OUTPUTS+=(./build/scripting-runtime-lite.wasm)
+      REPORTED_OUTPUTS+=(./build/scripting-runtime-lite.wasm)
+      ;;
+    *)
+      echo "Unknown build profile \"$profile\", expected full, lite or test" >&2
+      exit 1
+      ;;
+  esac
+done
+
+SOURCES_HASH=$(hash_sources) || exit 1
+
+for output in "${OUTPUTS[@]}"; do
+  echo $SOURCES_HASH > $output.sources.sha256
+done
+
+if [ ${#REPORTED_OUTPUTS[@]} -gt 0 ]; then
+  node ./report-runtime.mjs "${REPORTED_OUTPUTS[@]}"
+fi
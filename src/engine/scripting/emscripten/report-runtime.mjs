@@ -0,0 +1,99 @@
+/**
+ * Reports the size, instantiate time and baseline heap of script runtime builds. Run by build.sh after building.
+ *
+ * node report-runtime.mjs build/scripting-runtime.wasm [...]
+ *
+ * Host imports are stubbed to return 0 and the runtime initializes with an empty script. Instantiate time
+ * includes websg_initialize, which creates the QuickJS context, and the baseline heap is what's allocated after it.
+ *
+ * The results are also written to build/runtime-report.json, which is committed with the builds. Entries for builds
+ * that weren't passed are kept, so building a single profile only updates its own entry. Each entry has the sources
+ * hash of its build so the report can be checked against the committed binaries.
+ */
+import { existsSync, readFileSync, writeFileSync } from "fs";
+import { basename, dirname, join } from "path";
+import { performance } from "perf_hooks";
+import { fileURLToPath } from "url";
+
+const REPORT_PATH = join(dirname(fileURLToPath(import.meta.url)), "build", "runtime-report.json");
+
+// the memory scripting.game.ts creates for each script
+const MEMORY_PAGES = 1024;
+
+function createStubImports(module, memory) {
+  const imports = {};
+
+  for (const { module: moduleName, name, kind } of WebAssembly.Module.imports(module)) {
+    imports[moduleName] = imports[moduleName] || {};
+    imports[moduleName][name] = kind === "memory" ? memory : () => 0;
+  }
+
+  // an empty script is only the null terminator, QuickJS can't allocate a 0 byte source buffer
+  imports.thirdroom.get_js_source_size = () => 1;
+
+  // discard output, but report it as written so that the writer doesn't retry
+  imports.wasi_snapshot_preview1.fd_write = (fd, iovsPtr, iovsLen, nwrittenPtr) => {
+    const U32Heap = new Uint32Array(memory.buffer);
+    let nwritten = 0;
+
+    for (let i = 0; i < iovsLen; i++) {
+      nwritten += U32Heap[iovsPtr / 4 + i * 2 + 1];
+    }
+
+    U32Heap[nwrittenPtr / 4] = nwritten;
+    return 0;
+  };
+
+  return imports;
+}
+
+const formatKiB = (bytes) => `${(bytes / 1024).toFixed(1)} KiB`;
+const formatMs = (ms) => `${ms.toFixed(2)} ms`;
+const roundMs = (ms) => Math.round(ms * 100) / 100;
+
+const report = existsSync(REPORT_PATH) ? JSON.parse(readFileSync(REPORT_PATH, "utf8")) : {};
+
+for (const path of process.argv.slice(2)) {
+  const buffer = readFileSync(path);
+
+  let start = performance.now();
+  const module = await WebAssembly.compile(buffer);
+  const compileTime = performance.now() - start;
+
+  const memory = new WebAssembly.Memory({ initial: MEMORY_PAGES, maximum: MEMORY_PAGES });
+
+  start = performance.now();
+  const instance = await WebAssembly.instantiate(module, createStubImports(module, memory));
+  const { _initialize, websg_initialize, websg_get_heap_usage } = instance.exports;
+
+  if (_initialize) {
+    _initialize();
+  }
+
+  if (websg_initialize() !== 0) {
+    throw new Error(`${path}: websg_initialize failed`);
+  }
+
+  const instantiateTime = performance.now() - start;
+
+  // builds from before websg_get_heap_usage was exported can't report their heap
+  const heapBytes = websg_get_heap_usage ? websg_get_heap_usage() >>> 0 : null;
+  const heap = heapBytes === null ? "unknown" : formatKiB(heapBytes);
+
+  console.log(
+    `${basename(path)}: ${formatKiB(buffer.byteLength)}, ` +
+      `compile ${formatMs(compileTime)}, instantiate ${formatMs(instantiateTime)}, baseline heap ${heap}`
+  );
+
+  const sourcesHashPath = `${path}.sources.sha256`;
+
+  report[basename(path)] = {
+    sourcesHash: existsSync(sourcesHashPath) ? readFileSync(sourcesHashPath, "utf8").trim() : null,
+    byteLength: buffer.byteLength,
+    compileMs: roundMs(compileTime),
+    instantiateMs: roundMs(instantiateTime),
+    heapBytes,
+  };
+}
+
+writeFileSync(REPORT_PATH, JSON.stringify(report, null, 2) + "\n");
@@ -2,6 +2,7 @@
 #include "../quickjs/cutils.h"
 #include "../quickjs/quickjs.h"
 #include "../../matrix.h"
+#include "../utils/cbor.h"
 #include "./matrix-js.h"
 
 static JSValue js_matrix_listen(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
@@ -24,24 +25,70 @@ static JSValue js_matrix_close(JSContext *ctx, JSValueConst this_val, int argc,
   return JS_EXCEPTION;
 }
 
-static JSValue js_matrix_send(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
-  JSValue eventStr = JS_JSONStringify(ctx, argv[0], JS_UNDEFINED, JS_UNDEFINED);
+static JSValue js_matrix_add_event_filter(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  static const char *const field_names[3] = { "type", "stateKey", "sender" };
 
-  if (JS_IsException(eventStr)) {
-    return JS_EXCEPTION;
+  const char *fields[3] = { NULL, NULL, NULL };
+  size_t lengths[3] = { 0, 0, 0 };
+  int32_t result = -1;
+
+  for (int i = 0; i < 3; i++) {
+    JSValue field_val = JS_GetPropertyStr(ctx, argv[0], field_names[i]);
+
+    if (JS_IsException(field_val)) {
+      goto done;
+    }
+
+    if (!JS_IsUndefined(field_val)) {
+      fields[i] = JS_ToCStringLen(ctx, &lengths[i], field_val);
+
+      if (fields[i] == NULL) {
+        JS_FreeValue(ctx, field_val);
+        goto done;
+      }
+    }
+
+    JS_FreeValue(ctx, field_val);
   }
 
-  size_t byte_length;
-  const char *event = JS_ToCStringLen(ctx, &byte_length, eventStr);
-  JS_FreeValue(ctx, eventStr);
+  result = matrix_add_event_filter(fields[0], lengths[0], fields[1], lengths[1], fields[2], lengths[2]);
 
-  if (event == NULL) {
+  if (result == -1) {
+    JS_ThrowInternalError(ctx, "Matrix: error adding event filter.");
+  }
+
+done:
+  for (int i = 0; i < 3; i++) {
+    if (fields[i] != NULL) {
+      JS_FreeCString(ctx, fields[i]);
+    }
+  }
+
+  return result == 0 ? JS_UNDEFINED : JS_EXCEPTION;
+}
+
+static JSValue js_matrix_clear_event_filters(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  if (matrix_clear_event_filters() == 0) {
+    return JS_UNDEFINED;
+  }
+
+  JS_ThrowInternalError(ctx, "Matrix: error clearing event filters.");
+
+  return JS_EXCEPTION;
+}
+
+static JSValue js_matrix_send(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  DynBuf event;
+  js_cbor_buf_init(ctx, &event);
+
+  if (js_cbor_encode(ctx, &event, argv[0]) == -1) {
+    dbuf_free(&event);
     return JS_EXCEPTION;
   }
-  
-  int32_t result = matrix_send(event, byte_length);
 
-  JS_FreeCString(ctx, event);
+  int32_t result = matrix_send_cbor(event.buf, event.size);
+
+  dbuf_free(&event);
 
   if (result == 0) {
     return JS_UNDEFINED;
@@ -52,31 +99,68 @@ static JSValue js_matrix_send(JSContext *ctx, JSValueConst this_val, int argc, J
   return JS_EXCEPTION;
 }
 
-
 static JSValue js_matrix_receive(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
-  uint32_t byte_length = matrix_get_event_size();
+  uint32_t byte_length = matrix_get_event_size_cbor();
 
   if (byte_length == 0) {
     return JS_UNDEFINED;
   }
 
-  char* event = js_mallocz(ctx, byte_length);
-  int32_t read_bytes = matrix_receive(event, byte_length);
+  uint8_t *event = js_mallocz(ctx, byte_length);
+
+  if (event == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  int32_t read_bytes = matrix_receive_cbor(event, byte_length);
 
   if (read_bytes == 0) {
+    js_free(ctx, event);
     return JS_UNDEFINED;
   } else if (read_bytes < 0) {
+    js_free(ctx, event);
     JS_ThrowInternalError(ctx, "Matrix: error receiving event.");
     return JS_EXCEPTION;
   }
 
-  JSValue value = JS_ParseJSON(ctx, event, read_bytes, NULL);
+  JSValue value = js_cbor_decode(ctx, event, read_bytes);
 
   js_free(ctx, event);
 
   return value;
 }
 
+static JSValue js_matrix_receive_all(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  uint32_t byte_length = matrix_get_events_size();
+
+  if (byte_length == 0) {
+    return JS_NewArray(ctx);
+  }
+
+  uint8_t *events = js_mallocz(ctx, byte_length);
+
+  if (events == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  int32_t read_bytes = matrix_receive_events(events, byte_length);
+
+  if (read_bytes == 0) {
+    js_free(ctx, events);
+    return JS_NewArray(ctx);
+  } else if (read_bytes < 0) {
+    js_free(ctx, events);
+    JS_ThrowInternalError(ctx, "Matrix: error receiving events.");
+    return JS_EXCEPTION;
+  }
+
+  JSValue value = js_cbor_decode(ctx, events, read_bytes);
+
+  js_free(ctx, events);
+
+  return value;
+}
+
 void js_define_matrix_api(JSContext *ctx) {
   JSValue global = JS_GetGlobalObject(ctx);
 
@@ -84,6 +168,19 @@ void js_define_matrix_api(JSContext *ctx) {
   JS_SetPropertyStr(ctx, matrix, "listen", JS_NewCFunction(ctx, js_matrix_listen, "listen", 0));
   JS_SetPropertyStr(ctx, matrix, "close", JS_NewCFunction(ctx, js_matrix_close, "close", 0));
   JS_SetPropertyStr(ctx, matrix, "receive", JS_NewCFunction(ctx, js_matrix_receive, "receive", 0));
+  JS_SetPropertyStr(ctx, matrix, "receiveAll", JS_NewCFunction(ctx, js_matrix_receive_all, "receiveAll", 0));
   JS_SetPropertyStr(ctx, matrix, "send", JS_NewCFunction(ctx, js_matrix_send, "send", 1));
+  JS_SetPropertyStr(
+    ctx,
+    matrix,
+    "addEventFilter",
+    JS_NewCFunction(ctx, js_matrix_add_event_filter, "addEventFilter", 1)
+  );
+  JS_SetPropertyStr(
+    ctx,
+    matrix,
+    "clearEventFilters",
+    JS_NewCFunction(ctx, js_matrix_clear_event_filters, "clearEventFilters", 0)
+  );
   JS_SetPropertyStr(ctx, global, "matrix", matrix);
 }
\ No newline at end of file
@@ -29,7 +29,9 @@
 #define LRE_BOOL  int       /* for documentation purposes */
 
 /* define it to include all the unicode tables (40KB larger) */
+#ifndef CONFIG_NO_ALL_UNICODE
 #define CONFIG_ALL_UNICODE
+#endif
 
 #define LRE_CC_RES_LEN_MAX 3
 
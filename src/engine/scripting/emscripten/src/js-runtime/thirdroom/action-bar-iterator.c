@@ -3,6 +3,7 @@
 #include "../quickjs/quickjs.h"
 #include "../../websg.h"
 #include "./action-bar-iterator.h"
+#include "../utils/string-scratch.h"
 
 JSClassID js_thirdroom_action_bar_iterator_class_id;
 
@@ -47,7 +48,11 @@ static JSValue js_thirdroom_action_bar_iterator_next(
 
   *pdone = FALSE;
 
-  const char *action = js_mallocz(ctx, action_length);
+  char *action = js_get_string_scratch(ctx, action_length);
+
+  if (action == NULL) {
+    return JS_EXCEPTION;
+  }
 
   if (thirdroom_action_bar_listener_get_next_action(it->listener_data->listener_id, action) == -1) {
     *pdone = FALSE;
@@ -0,0 +1,565 @@
+#include <math.h>
+#include <string.h>
+#include "../quickjs/cutils.h"
+#include "../quickjs/quickjs.h"
+#include "./cbor.h"
+
+/**
+ * A CBOR (RFC 8949) codec for JSON compatible values. Matches the host's implementation in
+ * src/engine/utils/cbor.ts so structured data can cross the wasm boundary without JSON strings.
+ **/
+
+#define CBOR_MAJOR_UNSIGNED 0
+#define CBOR_MAJOR_NEGATIVE 1
+#define CBOR_MAJOR_BYTES 2
+#define CBOR_MAJOR_TEXT 3
+#define CBOR_MAJOR_ARRAY 4
+#define CBOR_MAJOR_MAP 5
+#define CBOR_MAJOR_TAG 6
+#define CBOR_MAJOR_SIMPLE 7
+
+#define CBOR_FALSE 0xf4
+#define CBOR_TRUE 0xf5
+#define CBOR_NULL 0xf6
+#define CBOR_UNDEFINED 0xf7
+#define CBOR_FLOAT16 0xf9
+#define CBOR_FLOAT32 0xfa
+#define CBOR_FLOAT64 0xfb
+
+// guards against circular references
+#define CBOR_MAX_DEPTH 64
+
+// largest integer a double can represent exactly
+#define CBOR_MAX_SAFE_INTEGER 9007199254740991.0
+
+/**
+ * Encoding
+ **/
+
+void js_cbor_buf_init(JSContext *ctx, DynBuf *buf) {
+  dbuf_init2(buf, JS_GetRuntime(ctx), (DynBufReallocFunc *)js_realloc_rt);
+}
+
+static void cbor_put_head(DynBuf *buf, uint8_t major, uint64_t value) {
+  uint8_t head[9];
+  major <<= 5;
+
+  if (value < 24) {
+    dbuf_putc(buf, major | (uint8_t)value);
+  } else if (value <= 0xff) {
+    head[0] = major | 24;
+    head[1] = (uint8_t)value;
+    dbuf_put(buf, head, 2);
+  } else if (value <= 0xffff) {
+    head[0] = major | 25;
+    head[1] = (uint8_t)(value >> 8);
+    head[2] = (uint8_t)value;
+    dbuf_put(buf, head, 3);
+  } else if (value <= 0xffffffff) {
+    head[0] = major | 26;
+
+    for (int i = 0; i < 4; i++) {
+      head[1 + i] = (uint8_t)(value >> (24 - i * 8));
+    }
+
+    dbuf_put(buf, head, 5);
+  } else {
+    head[0] = major | 27;
+
+    for (int i = 0; i < 8; i++) {
+      head[1 + i] = (uint8_t)(value >> (56 - i * 8));
+    }
+
+    dbuf_put(buf, head, 9);
+  }
+}
+
+static void cbor_put_float64(DynBuf *buf, double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  uint8_t bytes[9];
+  bytes[0] = CBOR_FLOAT64;
+
+  for (int i = 0; i < 8; i++) {
+    bytes[1 + i] = (uint8_t)(bits >> (56 - i * 8));
+  }
+
+  dbuf_put(buf, bytes, 9);
+}
+
+static void cbor_put_number(DynBuf *buf, double value) {
+  // JSON.stringify writes NaN and Infinity as null
+  if (!isfinite(value)) {
+    dbuf_putc(buf, CBOR_NULL);
+  } else if (value == trunc(value) && fabs(value) <= CBOR_MAX_SAFE_INTEGER) {
+    // -0 >= 0, so it's written as 0 like JSON.stringify does
+    if (value >= 0) {
+      cbor_put_head(buf, CBOR_MAJOR_UNSIGNED, (uint64_t)value);
+    } else {
+      cbor_put_head(buf, CBOR_MAJOR_NEGATIVE, (uint64_t)(-1 - value));
+    }
+  } else {
+    cbor_put_float64(buf, value);
+  }
+}
+
+static int cbor_put_string(JSContext *ctx, DynBuf *buf, JSValueConst value) {
+  size_t byte_length;
+  const char *str = JS_ToCStringLen(ctx, &byte_length, value);
+
+  if (str == NULL) {
+    return -1;
+  }
+
+  cbor_put_head(buf, CBOR_MAJOR_TEXT, byte_length);
+  dbuf_put(buf, (const uint8_t *)str, byte_length);
+  JS_FreeCString(ctx, str);
+
+  return 0;
+}
+
+// Values JSON.stringify leaves out of objects and turns into null in arrays
+static int cbor_is_skipped(JSContext *ctx, JSValueConst value) {
+  int tag = JS_VALUE_GET_NORM_TAG(value);
+  return tag == JS_TAG_UNDEFINED || tag == JS_TAG_SYMBOL || JS_IsFunction(ctx, value);
+}
+
+static int cbor_encode_value(JSContext *ctx, DynBuf *buf, JSValueConst value, int depth);
+
+static int cbor_encode_array(JSContext *ctx, DynBuf *buf, JSValueConst value, int depth) {
+  JSValue length_val = JS_GetPropertyStr(ctx, value, "length");
+  uint32_t length;
+
+  if (JS_ToUint32(ctx, &length, length_val) == -1) {
+    JS_FreeValue(ctx, length_val);
+    return -1;
+  }
+
+  JS_FreeValue(ctx, length_val);
+
+  cbor_put_head(buf, CBOR_MAJOR_ARRAY, length);
+
+  for (uint32_t i = 0; i < length; i++) {
+    JSValue item = JS_GetPropertyUint32(ctx, value, i);
+
+    if (JS_IsException(item)) {
+      return -1;
+    }
+
+    int result = 0;
+
+    if (cbor_is_skipped(ctx, item)) {
+      dbuf_putc(buf, CBOR_NULL);
+    } else {
+      result = cbor_encode_value(ctx, buf, item, depth + 1);
+    }
+
+    JS_FreeValue(ctx, item);
+
+    if (result == -1) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+static int cbor_encode_object(JSContext *ctx, DynBuf *buf, JSValueConst value, int depth) {
+  JSPropertyEnum *props;
+  uint32_t prop_count;
+
+  if (JS_GetOwnPropertyNames(ctx, &props, &prop_count, value, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) == -1) {
+    return -1;
+  }
+
+  int result = 0;
+  uint32_t count = 0;
+  JSValue *items = js_mallocz(ctx, sizeof(JSValue) * (prop_count ? prop_count : 1));
+
+  if (items == NULL) {
+    result = -1;
+    goto done;
+  }
+
+  for (uint32_t i = 0; i < prop_count; i++) {
+    items[i] = JS_GetProperty(ctx, value, props[i].atom);
+
+    if (JS_IsException(items[i])) {
+      result = -1;
+      goto done;
+    }
+
+    if (!cbor_is_skipped(ctx, items[i])) {
+      count++;
+    }
+  }
+
+  cbor_put_head(buf, CBOR_MAJOR_MAP, count);
+
+  for (uint32_t i = 0; i < prop_count; i++) {
+    if (cbor_is_skipped(ctx, items[i])) {
+      continue;
+    }
+
+    JSValue key = JS_AtomToString(ctx, props[i].atom);
+
+    if (JS_IsException(key) || cbor_put_string(ctx, buf, key) == -1) {
+      JS_FreeValue(ctx, key);
+      result = -1;
+      goto done;
+    }
+
+    JS_FreeValue(ctx, key);
+
+    if (cbor_encode_value(ctx, buf, items[i], depth + 1) == -1) {
+      result = -1;
+      goto done;
+    }
+  }
+
+done:
+  for (uint32_t i = 0; i < prop_count; i++) {
+    if (items != NULL) {
+      JS_FreeValue(ctx, items[i]);
+    }
+
+    JS_FreeAtom(ctx, props[i].atom);
+  }
+
+  js_free(ctx, items);
+  js_free(ctx, props);
+
+  return result;
+}
+
+static int cbor_encode_value(JSContext *ctx, DynBuf *buf, JSValueConst value, int depth) {
+  if (depth > CBOR_MAX_DEPTH) {
+    JS_ThrowTypeError(ctx, "CBOR: circular reference or object nested too deeply.");
+    return -1;
+  }
+
+  switch (JS_VALUE_GET_NORM_TAG(value)) {
+    case JS_TAG_INT:
+      cbor_put_number(buf, JS_VALUE_GET_INT(value));
+      return 0;
+    case JS_TAG_FLOAT64:
+      cbor_put_number(buf, JS_VALUE_GET_FLOAT64(value));
+      return 0;
+    case JS_TAG_BOOL:
+      dbuf_putc(buf, JS_VALUE_GET_BOOL(value) ? CBOR_TRUE : CBOR_FALSE);
+      return 0;
+    case JS_TAG_STRING:
+      return cbor_put_string(ctx, buf, value);
+    case JS_TAG_OBJECT:
+      break;
+    default:
+      dbuf_putc(buf, CBOR_NULL);
+      return 0;
+  }
+
+  if (JS_IsFunction(ctx, value)) {
+    dbuf_putc(buf, CBOR_NULL);
+    return 0;
+  }
+
+  JSValue to_json = JS_GetPropertyStr(ctx, value, "toJSON");
+
+  if (JS_IsException(to_json)) {
+    return -1;
+  }
+
+  if (JS_IsFunction(ctx, to_json)) {
+    JSValue json_value = JS_Call(ctx, to_json, value, 0, NULL);
+    JS_FreeValue(ctx, to_json);
+
+    if (JS_IsException(json_value)) {
+      return -1;
+    }
+
+    int result = cbor_encode_value(ctx, buf, json_value, depth + 1);
+    JS_FreeValue(ctx, json_value);
+    return result;
+  }
+
+  JS_FreeValue(ctx, to_json);
+
+  int is_array = JS_IsArray(ctx, value);
+
+  if (is_array == -1) {
+    return -1;
+  }
+
+  if (is_array) {
+    return cbor_encode_array(ctx, buf, value, depth);
+  }
+
+  return cbor_encode_object(ctx, buf, value, depth);
+}
+
+int js_cbor_encode(JSContext *ctx, DynBuf *buf, JSValueConst value) {
+  if (cbor_encode_value(ctx, buf, value, 0) == -1) {
+    return -1;
+  }
+
+  if (buf->error) {
+    JS_ThrowOutOfMemory(ctx);
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * Decoding
+ **/
+
+typedef struct CBORReader {
+  const uint8_t *data;
+  size_t byte_length;
+  size_t offset;
+} CBORReader;
+
+static JSValue cbor_throw(JSContext *ctx, const char *message) {
+  return JS_ThrowSyntaxError(ctx, "CBOR: %s", message);
+}
+
+static int cbor_read_argument(JSContext *ctx, CBORReader *reader, uint8_t info, uint64_t *value) {
+  if (info < 24) {
+    *value = info;
+    return 0;
+  }
+
+  if (info > 27) {
+    cbor_throw(ctx, "Indefinite lengths are not supported.");
+    return -1;
+  }
+
+  size_t size = (size_t)1 << (info - 24);
+
+  if (reader->offset + size > reader->byte_length) {
+    cbor_throw(ctx, "Unexpected end of data.");
+    return -1;
+  }
+
+  uint64_t result = 0;
+
+  for (size_t i = 0; i < size; i++) {
+    result = (result << 8) | reader->data[reader->offset + i];
+  }
+
+  reader->offset += size;
+  *value = result;
+
+  return 0;
+}
+
+static double cbor_half_to_double(uint16_t half) {
+  int exponent = (half >> 10) & 0x1f;
+  int fraction = half & 0x3ff;
+  double sign = half & 0x8000 ? -1.0 : 1.0;
+
+  if (exponent == 0) {
+    return sign * ldexp(fraction, -24);
+  } else if (exponent == 0x1f) {
+    return fraction ? NAN : sign * INFINITY;
+  }
+
+  return sign * ldexp(fraction + 1024, exponent - 25);
+}
+
+static JSValue cbor_decode_value(JSContext *ctx, CBORReader *reader, int depth);
+
+static JSValue cbor_decode_simple(JSContext *ctx, CBORReader *reader, uint8_t initial_byte) {
+  uint64_t bits;
+
+  switch (initial_byte) {
+    case CBOR_FALSE:
+      return JS_FALSE;
+    case CBOR_TRUE:
+      return JS_TRUE;
+    case CBOR_NULL:
+    case CBOR_UNDEFINED:
+      return JS_NULL;
+    case CBOR_FLOAT16:
+      if (cbor_read_argument(ctx, reader, 25, &bits) == -1) {
+        return JS_EXCEPTION;
+      }
+
+      return JS_NewFloat64(ctx, cbor_half_to_double((uint16_t)bits));
+    case CBOR_FLOAT32: {
+      if (cbor_read_argument(ctx, reader, 26, &bits) == -1) {
+        return JS_EXCEPTION;
+      }
+
+      uint32_t bits32 = (uint32_t)bits;
+      float value;
+      memcpy(&value, &bits32, sizeof(value));
+      return JS_NewFloat64(ctx, value);
+    }
+    case CBOR_FLOAT64: {
+      if (cbor_read_argument(ctx, reader, 27, &bits) == -1) {
+        return JS_EXCEPTION;
+      }
+
+      double value;
+      memcpy(&value, &bits, sizeof(value));
+      return JS_NewFloat64(ctx, value);
+    }
+    default:
+      return cbor_throw(ctx, "Unsupported simple value.");
+  }
+}
+
+static JSValue cbor_decode_array(JSContext *ctx, CBORReader *reader, uint64_t length, int depth) {
+  // every item takes at least one byte
+  if (length > reader->byte_length - reader->offset) {
+    return cbor_throw(ctx, "Array length exceeds data.");
+  }
+
+  JSValue array = JS_NewArray(ctx);
+
+  if (JS_IsException(array)) {
+    return array;
+  }
+
+  for (uint32_t i = 0; i < length; i++) {
+    JSValue item = cbor_decode_value(ctx, reader, depth + 1);
+
+    if (JS_IsException(item) || JS_SetPropertyUint32(ctx, array, i, item) == -1) {
+      JS_FreeValue(ctx, array);
+      return JS_EXCEPTION;
+    }
+  }
+
+  return array;
+}
+
+static JSValue cbor_decode_map(JSContext *ctx, CBORReader *reader, uint64_t length, int depth) {
+  if (length > reader->byte_length - reader->offset) {
+    return cbor_throw(ctx, "Map length exceeds data.");
+  }
+
+  JSValue obj = JS_NewObject(ctx);
+
+  if (JS_IsException(obj)) {
+    return obj;
+  }
+
+  for (uint32_t i = 0; i < length; i++) {
+    if (reader->offset >= reader->byte_length || (reader->data[reader->offset] >> 5) != CBOR_MAJOR_TEXT) {
+      JS_FreeValue(ctx, obj);
+      return cbor_throw(ctx, "Map keys must be strings.");
+    }
+
+    uint64_t key_length;
+
+    if (cbor_read_argument(ctx, reader, reader->data[reader->offset++] & 0x1f, &key_length) == -1) {
+      JS_FreeValue(ctx, obj);
+      return JS_EXCEPTION;
+    }
+
+    if (key_length > reader->byte_length - reader->offset) {
+      JS_FreeValue(ctx, obj);
+      return cbor_throw(ctx, "Unexpected end of data.");
+    }
+
+    JSAtom key = JS_NewAtomLen(ctx, (const char *)reader->data + reader->offset, key_length);
+    reader->offset += key_length;
+
+    if (key == JS_ATOM_NULL) {
+      JS_FreeValue(ctx, obj);
+      return JS_EXCEPTION;
+    }
+
+    JSValue item = cbor_decode_value(ctx, reader, depth + 1);
+
+    // define rather than set so keys like __proto__ become plain properties, as with JSON.parse
+    if (JS_IsException(item) || JS_DefinePropertyValue(ctx, obj, key, item, JS_PROP_C_W_E) == -1) {
+      JS_FreeAtom(ctx, key);
+      JS_FreeValue(ctx, obj);
+      return JS_EXCEPTION;
+    }
+
+    JS_FreeAtom(ctx, key);
+  }
+
+  return obj;
+}
+
+static JSValue cbor_decode_value(JSContext *ctx, CBORReader *reader, int depth) {
+  if (depth > CBOR_MAX_DEPTH) {
+    return cbor_throw(ctx, "Data nested too deeply.");
+  }
+
+  if (reader->offset >= reader->byte_length) {
+    return cbor_throw(ctx, "Unexpected end of data.");
+  }
+
+  uint8_t initial_byte = reader->data[reader->offset++];
+  uint8_t major = initial_byte >> 5;
+
+  if (major == CBOR_MAJOR_SIMPLE) {
+    return cbor_decode_simple(ctx, reader, initial_byte);
+  }
+
+  uint64_t argument;
+
+  if (cbor_read_argument(ctx, reader, initial_byte & 0x1f, &argument) == -1) {
+    return JS_EXCEPTION;
+  }
+
+  switch (major) {
+    case CBOR_MAJOR_UNSIGNED:
+      if (argument <= (uint64_t)CBOR_MAX_SAFE_INTEGER) {
+        return JS_NewInt64(ctx, (int64_t)argument);
+      }
+
+      return JS_NewFloat64(ctx, (double)argument);
+    case CBOR_MAJOR_NEGATIVE:
+      if (argument < (uint64_t)CBOR_MAX_SAFE_INTEGER) {
+        return JS_NewInt64(ctx, -1 - (int64_t)argument);
+      }
+
+      return JS_NewFloat64(ctx, -1.0 - (double)argument);
+    case CBOR_MAJOR_BYTES:
+    case CBOR_MAJOR_TEXT: {
+      if (argument > reader->byte_length - reader->offset) {
+        return cbor_throw(ctx, "Unexpected end of data.");
+      }
+
+      const uint8_t *start = reader->data + reader->offset;
+      reader->offset += argument;
+
+      if (major == CBOR_MAJOR_TEXT) {
+        return JS_NewStringLen(ctx, (const char *)start, argument);
+      }
+
+      return JS_NewArrayBufferCopy(ctx, start, argument);
+    }
+    case CBOR_MAJOR_ARRAY:
+      return cbor_decode_array(ctx, reader, argument, depth);
+    case CBOR_MAJOR_MAP:
+      return cbor_decode_map(ctx, reader, argument, depth);
+    default:
+      // tags carry no meaning for JSON data, decode the tagged value
+      return cbor_decode_value(ctx, reader, depth + 1);
+  }
+}
+
+JSValue js_cbor_decode(JSContext *ctx, const uint8_t *data, size_t byte_length) {
+  CBORReader reader = { data, byte_length, 0 };
+
+  JSValue value = cbor_decode_value(ctx, &reader, 0);
+
+  if (JS_IsException(value)) {
+    return value;
+  }
+
+  if (reader.offset != byte_length) {
+    JS_FreeValue(ctx, value);
+    return cbor_throw(ctx, "Unexpected data after value.");
+  }
+
+  return value;
+}
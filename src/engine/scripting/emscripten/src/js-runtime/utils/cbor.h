@@ -0,0 +1,17 @@
+#ifndef __js_utils_cbor_h
+#define __js_utils_cbor_h
+#include <stdint.h>
+#include "../quickjs/quickjs.h"
+#include "../quickjs/cutils.h"
+
+// Initializes a DynBuf that allocates with the runtime's allocator. Free it with dbuf_free().
+void js_cbor_buf_init(JSContext *ctx, DynBuf *buf);
+
+// Appends value to buf as CBOR using JSON.stringify semantics.
+// Returns 0 if successful and -1 with a pending exception if there was an error.
+int js_cbor_encode(JSContext *ctx, DynBuf *buf, JSValueConst value);
+
+// Decodes a single CBOR data item. Returns JS_EXCEPTION if the data is malformed.
+JSValue js_cbor_decode(JSContext *ctx, const uint8_t *data, size_t byte_length);
+
+#endif
@@ -0,0 +1,29 @@
+#include <stddef.h>
+#include "../quickjs/quickjs.h"
+#include "./string-scratch.h"
+
+static char *string_scratch = NULL;
+static size_t string_scratch_size = 0;
+
+char *js_get_string_scratch(JSContext *ctx, size_t byte_length) {
+  size_t size = byte_length + 1;
+
+  if (size > string_scratch_size) {
+    size_t new_size = string_scratch_size == 0 ? 256 : string_scratch_size;
+
+    while (new_size < size) {
+      new_size *= 2;
+    }
+
+    char *scratch = js_realloc(ctx, string_scratch, new_size);
+
+    if (scratch == NULL) {
+      return NULL;
+    }
+
+    string_scratch = scratch;
+    string_scratch_size = new_size;
+  }
+
+  return string_scratch;
+}
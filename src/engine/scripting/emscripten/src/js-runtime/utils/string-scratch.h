@@ -0,0 +1,11 @@
+#ifndef __js_utils_string_scratch_h
+#define __js_utils_string_scratch_h
+#include <stddef.h>
+#include "../quickjs/quickjs.h"
+
+// Returns a buffer with room for a string of byte_length bytes and the null terminator the host writes after it,
+// or NULL on allocation failure. The buffer is shared and reused by the next call, so create the JS string from it
+// before calling back into the host.
+char *js_get_string_scratch(JSContext *ctx, size_t byte_length);
+
+#endif
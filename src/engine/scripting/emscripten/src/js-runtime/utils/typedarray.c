@@ -24,4 +24,83 @@ void *get_typed_array_data(JSContext *ctx, JSValue *value, size_t byte_length) {
   data += view_byte_offset;
 
   return (void *)data;
-}
\ No newline at end of file
+}
+
+// Returns a pointer to the elements of a typed array without copying them and writes the element count to length.
+void *get_typed_array_view(JSContext *ctx, JSValueConst value, size_t bytes_per_element, size_t *length) {
+  size_t view_byte_offset;
+  size_t view_byte_length;
+  size_t view_bytes_per_element;
+
+  JSValue buffer = JS_GetTypedArrayBuffer(ctx, value, &view_byte_offset, &view_byte_length, &view_bytes_per_element);
+
+  if (JS_IsException(buffer)) {
+    return NULL;
+  }
+
+  if (view_bytes_per_element != bytes_per_element) {
+    JS_FreeValue(ctx, buffer);
+    JS_ThrowTypeError(ctx, "WebSG: Invalid typed array type.");
+    return NULL;
+  }
+
+  size_t buffer_byte_length;
+  uint8_t *data = JS_GetArrayBuffer(ctx, &buffer_byte_length, buffer);
+
+  // the typed array keeps its buffer alive
+  JS_FreeValue(ctx, buffer);
+
+  if (data == NULL) {
+    return NULL;
+  }
+
+  *length = view_byte_length / bytes_per_element;
+
+  return (void *)(data + view_byte_offset);
+}
+
+static int float32_array_class_id = -1;
+static int uint32_array_class_id = -1;
+
+// Class ids of the built-in classes are the same in every context, so they're looked up once from an instance.
+static int get_typed_array_class_id(JSContext *ctx, const char *constructor_name, int *class_id) {
+  if (*class_id == -1) {
+    JSValue global = JS_GetGlobalObject(ctx);
+    JSValue constructor = JS_GetPropertyStr(ctx, global, constructor_name);
+    JSValue array = JS_CallConstructor(ctx, constructor, 0, NULL);
+
+    if (JS_IsObject(array)) {
+      *class_id = JS_GetClassID(array);
+    }
+
+    JS_FreeValue(ctx, array);
+    JS_FreeValue(ctx, constructor);
+    JS_FreeValue(ctx, global);
+  }
+
+  return *class_id;
+}
+
+// Like get_typed_array_view but only accepts a Float32Array, other 4 byte typed arrays would be read as floats.
+float_t *get_float32_array_view(JSContext *ctx, JSValueConst value, size_t *length) {
+  int class_id = get_typed_array_class_id(ctx, "Float32Array", &float32_array_class_id);
+
+  if (!JS_IsObject(value) || JS_GetClassID(value) != class_id) {
+    JS_ThrowTypeError(ctx, "WebSG: Expected a Float32Array.");
+    return NULL;
+  }
+
+  return get_typed_array_view(ctx, value, sizeof(float_t), length);
+}
+
+// Like get_typed_array_view but only accepts a Uint32Array.
+uint32_t *get_uint32_array_view(JSContext *ctx, JSValueConst value, size_t *length) {
+  int class_id = get_typed_array_class_id(ctx, "Uint32Array", &uint32_array_class_id);
+
+  if (!JS_IsObject(value) || JS_GetClassID(value) != class_id) {
+    JS_ThrowTypeError(ctx, "WebSG: Expected a Uint32Array.");
+    return NULL;
+  }
+
+  return get_typed_array_view(ctx, value, sizeof(uint32_t), length);
+}
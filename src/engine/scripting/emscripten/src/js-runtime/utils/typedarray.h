@@ -1,7 +1,14 @@
 #ifndef __js_utils_typedarray_h
 #define __js_utils_typedarray_h
+#include <math.h>
 #include "../quickjs/quickjs.h"
 
 void *get_typed_array_data(JSContext *ctx, JSValue *value, size_t byte_length);
 
+void *get_typed_array_view(JSContext *ctx, JSValueConst value, size_t bytes_per_element, size_t *length);
+
+float_t *get_float32_array_view(JSContext *ctx, JSValueConst value, size_t *length);
+
+uint32_t *get_uint32_array_view(JSContext *ctx, JSValueConst value, size_t *length);
+
 #endif
@@ -4,6 +4,7 @@
 #include "./websg-networking-js.h"
 #include "./network-listener.h"
 #include "./network-message-iterator.h"
+#include "./network-stats.h"
 
 JSClassID js_websg_network_listener_class_id;
 
@@ -41,9 +42,23 @@ static JSValue js_websg_network_listener_close(JSContext *ctx, JSValueConst this
   return JS_EXCEPTION;
 }
 
+static JSValue js_websg_network_listener_get_stats(JSContext *ctx, JSValueConst this_val) {
+  WebSGNetworkListenerData *network_listener_data = JS_GetOpaque(this_val, js_websg_network_listener_class_id);
+
+  NetworkStats stats;
+
+  if (websg_network_listener_get_stats(network_listener_data->listener_id, &stats) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGNetworking: error getting listener stats.");
+    return JS_EXCEPTION;
+  }
+
+  return js_websg_new_network_stats_instance(ctx, &stats);
+}
+
 static const JSCFunctionListEntry js_websg_network_listener_proto_funcs[] = {
   JS_CFUNC_DEF("receive", 1, js_websg_network_listener_receive),
   JS_CFUNC_DEF("close", 0, js_websg_network_listener_close),
+  JS_CGETSET_DEF("stats", js_websg_network_listener_get_stats, NULL),
   JS_PROP_STRING_DEF("[Symbol.toStringTag]", "NetworkListener", JS_PROP_CONFIGURABLE),
 };
 
@@ -0,0 +1,74 @@
+#include "../quickjs/cutils.h"
+#include "../quickjs/quickjs.h"
+#include "../../websg-networking.h"
+#include "./websg-networking-js.h"
+#include "./network-stats.h"
+
+JSClassID js_websg_network_stats_class_id;
+
+/**
+ * Class Definition
+ **/
+
+static JSClassDef js_websg_network_stats_class = {
+  "NetworkStats",
+};
+
+static const JSCFunctionListEntry js_websg_network_stats_proto_funcs[] = {
+  JS_PROP_STRING_DEF("[Symbol.toStringTag]", "NetworkStats", JS_PROP_CONFIGURABLE),
+};
+
+static JSValue js_websg_network_stats_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  return JS_ThrowTypeError(ctx, "Illegal Constructor.");
+}
+
+void js_websg_define_network_stats(JSContext *ctx, JSValue websg_networking) {
+  JS_NewClassID(&js_websg_network_stats_class_id);
+  JS_NewClass(JS_GetRuntime(ctx), js_websg_network_stats_class_id, &js_websg_network_stats_class);
+  JSValue network_stats_proto = JS_NewObject(ctx);
+  JS_SetPropertyFunctionList(
+    ctx,
+    network_stats_proto,
+    js_websg_network_stats_proto_funcs,
+    countof(js_websg_network_stats_proto_funcs)
+  );
+  JS_SetClassProto(ctx, js_websg_network_stats_class_id, network_stats_proto);
+
+  JSValue constructor = JS_NewCFunction2(
+    ctx,
+    js_websg_network_stats_constructor,
+    "NetworkStats",
+    0,
+    JS_CFUNC_constructor,
+    0
+  );
+  JS_SetConstructor(ctx, constructor, network_stats_proto);
+  JS_SetPropertyStr(
+    ctx,
+    websg_networking,
+    "NetworkStats",
+    constructor
+  );
+}
+
+/**
+ * Public Methods
+ **/
+
+JSValue js_websg_new_network_stats_instance(JSContext *ctx, NetworkStats *stats) {
+  JSValue network_stats = JS_NewObjectClass(ctx, js_websg_network_stats_class_id);
+
+  if (JS_IsException(network_stats)) {
+    return network_stats;
+  }
+
+  JS_SetPropertyStr(ctx, network_stats, "bytesSent", JS_NewUint32(ctx, stats->bytes_sent));
+  JS_SetPropertyStr(ctx, network_stats, "messagesSent", JS_NewUint32(ctx, stats->messages_sent));
+  JS_SetPropertyStr(ctx, network_stats, "bytesReceived", JS_NewUint32(ctx, stats->bytes_received));
+  JS_SetPropertyStr(ctx, network_stats, "messagesReceived", JS_NewUint32(ctx, stats->messages_received));
+  JS_SetPropertyStr(ctx, network_stats, "rtt", JS_NewFloat64(ctx, stats->rtt));
+  JS_SetPropertyStr(ctx, network_stats, "packetLoss", JS_NewFloat64(ctx, stats->packet_loss));
+  JS_SetPropertyStr(ctx, network_stats, "messagesDropped", JS_NewUint32(ctx, stats->messages_dropped));
+
+  return network_stats;
+}
@@ -0,0 +1,12 @@
+#ifndef __websg_network_stats_js_h
+#define __websg_network_stats_js_h
+#include "../../websg-networking.h"
+#include "../quickjs/quickjs.h"
+
+extern JSClassID js_websg_network_stats_class_id;
+
+void js_websg_define_network_stats(JSContext *ctx, JSValue websg_networking);
+
+JSValue js_websg_new_network_stats_instance(JSContext *ctx, NetworkStats *stats);
+
+#endif
@@ -3,9 +3,11 @@
 #include "../../websg-networking.h"
 #include "../../websg-networking.h"
 #include "./network-listener.h"
+#include "./network-stats.h"
 #include "./peer.h"
 #include "../utils/exception.h"
 #include "./replicator.h"
+#include "../websg/node.h"
 
 JSClassID js_websg_network_class_id;
 
@@ -92,6 +94,42 @@ static JSValue js_websg_network_get_peers(JSContext *ctx, JSValueConst this_val)
   return JS_DupValue(ctx, network_data->peers);
 }
 
+static JSValue js_websg_network_get_stats(JSContext *ctx, JSValueConst this_val) {
+  NetworkStats stats;
+
+  if (websg_network_get_stats(&stats) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGNetworking: error getting network stats.");
+    return JS_EXCEPTION;
+  }
+
+  return js_websg_new_network_stats_instance(ctx, &stats);
+}
+
+static JSValue js_websg_network_set_priority(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGNodeData *node_data = JS_GetOpaque2(ctx, argv[0], js_websg_node_class_id);
+
+  if (node_data == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  double priority;
+
+  if (JS_ToFloat64(ctx, &priority, argv[1]) == -1) {
+    return JS_EXCEPTION;
+  }
+
+  if (priority < 0) {
+    return JS_ThrowRangeError(ctx, "WebSGNetworking: priority must be greater than or equal to 0.");
+  }
+
+  if (websg_node_set_network_priority(node_data->node_id, (float_t)priority) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGNetworking: error setting network priority.");
+    return JS_EXCEPTION;
+  }
+
+  return JS_UNDEFINED;
+}
+
 static JSValue js_websg_network_define_replicator(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   if (argc < 1 || !JS_IsFunction(ctx, argv[0])) {
     return JS_ThrowTypeError(ctx, "WebSGNetworking: Unable to create replicator, expected a function as the first argument.");
@@ -111,8 +149,10 @@ static const JSCFunctionListEntry js_websg_network_proto_funcs[] = {
   JS_CFUNC_DEF("listen", 0, js_websg_network_listen),
   JS_CFUNC_DEF("broadcast", 2, js_websg_network_broadcast),
   JS_CFUNC_DEF("defineReplicator", 1, js_websg_network_define_replicator),
+  JS_CFUNC_DEF("setPriority", 2, js_websg_network_set_priority),
   JS_CGETSET_DEF("host", js_websg_network_get_host, NULL),
   JS_CGETSET_DEF("local", js_websg_network_get_local, NULL),
+  JS_CGETSET_DEF("stats", js_websg_network_get_stats, NULL),
   JS_PROP_STRING_DEF("[Symbol.toStringTag]", "Network", JS_PROP_CONFIGURABLE),
 };
 
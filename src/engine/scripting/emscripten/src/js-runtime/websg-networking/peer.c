@@ -4,8 +4,10 @@
 #include "./websg-networking-js.h"
 #include "./network.h"
 #include "./peer.h"
+#include "./network-stats.h"
 #include "../websg/vector3.h"
 #include "../websg/quaternion.h"
+#include "../utils/string-scratch.h"
 
 JSClassID js_websg_peer_class_id;
 
@@ -31,7 +33,11 @@ static JSValue js_websg_peer_get_id(JSContext *ctx, JSValueConst this_val) {
 
   int32_t length = websg_peer_get_id_length(peer_data->peer_index);
 
-  const char *str = js_mallocz(ctx, sizeof(char) * length);
+  char *str = js_get_string_scratch(ctx, length);
+
+  if (str == NULL) {
+    return JS_EXCEPTION;
+  }
 
   int32_t result = websg_peer_get_id(peer_data->peer_index, str, length);
 
@@ -55,6 +61,19 @@ static JSValue js_websg_peer_get_is_local(JSContext *ctx, JSValueConst this_val)
   return JS_NewBool(ctx, result);
 }
 
+static JSValue js_websg_peer_get_stats(JSContext *ctx, JSValueConst this_val) {
+  WebSGPeerData *peer_data = JS_GetOpaque(this_val, js_websg_peer_class_id);
+
+  NetworkStats stats;
+
+  if (websg_peer_get_stats(peer_data->peer_index, &stats) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGNetworking: error getting peer stats.");
+    return JS_EXCEPTION;
+  }
+
+  return js_websg_new_network_stats_instance(ctx, &stats);
+}
+
 static JSValue js_websg_peer_send(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGPeerData *peer_data = JS_GetOpaque(this_val, js_websg_peer_class_id);
 
@@ -96,6 +115,7 @@ static const JSCFunctionListEntry js_websg_peer_proto_funcs[] = {
   JS_CGETSET_DEF("id", js_websg_peer_get_id, NULL),
   JS_CGETSET_DEF("isHost", js_websg_peer_get_is_host, NULL),
   JS_CGETSET_DEF("isLocal", js_websg_peer_get_is_local, NULL),
+  JS_CGETSET_DEF("stats", js_websg_peer_get_stats, NULL),
   JS_CFUNC_DEF("send", 2, js_websg_peer_send),
   JS_PROP_STRING_DEF("[Symbol.toStringTag]", "Peer", JS_PROP_CONFIGURABLE),
 };
@@ -6,6 +6,7 @@
 #include "./network-message-iterator.h"
 #include "./network-message.h"
 #include "./network.h"
+#include "./network-stats.h"
 #include "./peer.h"
 #include "./replicator.h"
 #include "./replication.h"
@@ -20,6 +21,7 @@ void js_define_websg_networking_api(JSContext *ctx) {
   js_websg_define_network_message_iterator(ctx);
   js_websg_define_network_message(ctx, websg_networking);
   js_websg_define_network(ctx, websg_networking);
+  js_websg_define_network_stats(ctx, websg_networking);
   js_websg_define_peer(ctx, websg_networking);
   js_websg_define_replicator(ctx, websg_networking);
   js_websg_define_replication_iterator(ctx);
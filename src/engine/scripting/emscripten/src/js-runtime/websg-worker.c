@@ -1,5 +1,6 @@
 #include <emscripten.h>
 #include <emscripten/console.h>
+#include <malloc.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -17,6 +18,7 @@
 #include "./matrix/matrix-js.h"
 #include "./thirdroom/thirdroom-js.h"
 #include "./websg/websg-js.h"
+#include "./websg/command-buffer.h"
 #include "./websg-networking/websg-networking-js.h"
 #include "./websg-networking/network.h"
 
@@ -27,6 +29,40 @@
 JSRuntime *rt;
 JSContext *ctx;
 
+/**
+ * Build Profiles
+ **/
+
+// Same as JS_NewContext, minus the intrinsics stripped by the build profile (see build.sh). The code for an intrinsic
+// that isn't added here is never referenced and is dropped by the linker.
+static JSContext *js_new_context(JSRuntime *rt) {
+  JSContext *ctx = JS_NewContextRaw(rt);
+
+  if (ctx == NULL) {
+    return NULL;
+  }
+
+  JS_AddIntrinsicBaseObjects(ctx);
+#ifndef THIRDROOM_NO_DATE
+  JS_AddIntrinsicDate(ctx);
+#endif
+  JS_AddIntrinsicEval(ctx);
+  // String.prototype.normalize is only defined when QuickJS is built with all of its Unicode tables
+  JS_AddIntrinsicStringNormalize(ctx);
+#ifndef THIRDROOM_NO_REGEXP
+  JS_AddIntrinsicRegExp(ctx);
+#endif
+  JS_AddIntrinsicJSON(ctx);
+#ifndef THIRDROOM_NO_PROXY
+  JS_AddIntrinsicProxy(ctx);
+#endif
+  JS_AddIntrinsicMapSet(ctx);
+  JS_AddIntrinsicTypedArrays(ctx);
+  JS_AddIntrinsicPromise(ctx);
+
+  return ctx;
+}
+
 /**
  * Web Scene Graph (WebSG) Implementation
  **/
@@ -37,7 +73,7 @@ JSContext *ctx;
 
 export int32_t websg_initialize() {
   rt = JS_NewRuntime();
-  ctx = JS_NewContext(rt);
+  ctx = js_new_context(rt);
 
   js_define_global_api(ctx);
   js_define_thirdroom_api(ctx);
@@ -50,6 +86,7 @@ export int32_t websg_initialize() {
   int32_t read_source_len = thirdroom_get_js_source(source);
 
   JSValue val = JS_Eval(ctx, source, read_source_len, "<environment-script>", JS_EVAL_TYPE_GLOBAL);
+  js_websg_flush_commands();
 
   if (js_handle_exception(ctx, val) < 0) {
     return -1;
@@ -73,6 +110,7 @@ export int32_t websg_load() {
   JSValueConst args[] = {};
   JSValue val = JS_Call(ctx, world_on_load_func, JS_UNDEFINED, 0, args);
   JS_FreeValue(ctx, world_on_load_func);
+  js_websg_flush_commands();
 
   if (js_handle_exception(ctx, val) < 0) {
     return -1;
@@ -100,6 +138,7 @@ export int32_t websg_enter() {
   JSValueConst args[] = {};
   JSValue val = JS_Call(ctx, world_on_enter_func, JS_UNDEFINED, 0, args);
   JS_FreeValue(ctx, world_on_enter_func);
+  js_websg_flush_commands();
 
   if (js_handle_exception(ctx, val) < 0) {
     return -1;
@@ -136,6 +175,9 @@ export int32_t websg_update(float_t dt, float_t time) {
   JSValue val = JS_Call(ctx, world_on_update_func, JS_UNDEFINED, 2, args);
   JS_FreeValue(ctx, world_on_update_func);
 
+  // fire-and-forget setters called during the update are executed by the host in one call
+  js_websg_flush_commands();
+
   if (js_handle_exception(ctx, val) < 0) {
     return -1;
   } else {
@@ -147,13 +189,22 @@ export int32_t websg_update(float_t dt, float_t time) {
 export int32_t websg_peer_entered(uint32_t peer_index) {
   JSValue global = JS_GetGlobalObject(ctx);
   JSValue network = JS_GetPropertyStr(ctx, global, "network");
-  return js_websg_network_peer_entered(ctx, network, peer_index);
+  int32_t result = js_websg_network_peer_entered(ctx, network, peer_index);
+  js_websg_flush_commands();
+  return result;
 }
 
 export int32_t websg_peer_exited(uint32_t peer_index) {
   JSValue global = JS_GetGlobalObject(ctx);
   JSValue network = JS_GetPropertyStr(ctx, global, "network");
-  return js_websg_network_peer_exited(ctx, network, peer_index);
+  int32_t result = js_websg_network_peer_exited(ctx, network, peer_index);
+  js_websg_flush_commands();
+  return result;
+}
+
+// Bytes currently allocated on the heap, used by the build script to report each profile's baseline heap
+export uint32_t websg_get_heap_usage() {
+  return mallinfo().uordblks;
 }
 
 #ifdef THIRDROOM_TEST
@@ -164,6 +215,7 @@ export void *test_alloc(int size) {
 
 export const char *test_eval_js(const char * code) {
   JSValue result = JS_Eval(ctx, code, strlen(code), "<module>", JS_EVAL_TYPE_GLOBAL);
+  js_websg_flush_commands();
 
   if (JS_IsException(result)) {
     JSValue error = JS_GetException(ctx);
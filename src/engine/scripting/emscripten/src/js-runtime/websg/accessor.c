@@ -3,6 +3,7 @@
 #include "../../websg.h"
 #include "./world.h"
 #include "./accessor.h"
+#include "./props.h"
 
 JSClassID js_websg_accessor_class_id;
 
@@ -189,7 +190,7 @@ JSValue js_websg_world_create_accessor_from(JSContext *ctx, JSValueConst this_va
 
   AccessorFromProps *props = js_mallocz(ctx, sizeof(AccessorFromProps));
 
-  JSValue type_val = JS_GetPropertyStr(ctx, props_obj, "type");
+  JSValue type_val = JS_WEBSG_GET_PROP(ctx, props_obj, type);
 
   if (JS_IsUndefined(type_val)) {
     JS_ThrowTypeError(ctx, "WebSG: Missing accessor type.");
@@ -205,7 +206,7 @@ JSValue js_websg_world_create_accessor_from(JSContext *ctx, JSValueConst this_va
 
   props->type = type;
 
-  JSValue component_type_val = JS_GetPropertyStr(ctx, props_obj, "componentType");
+  JSValue component_type_val = JS_WEBSG_GET_PROP(ctx, props_obj, componentType);
 
   if (JS_IsUndefined(component_type_val)) {
     JS_ThrowTypeError(ctx, "WebSG: Missing component type.");
@@ -220,7 +221,7 @@ JSValue js_websg_world_create_accessor_from(JSContext *ctx, JSValueConst this_va
 
   props->component_type = component_type;
 
-  JSValue countVal = JS_GetPropertyStr(ctx, props_obj, "count");
+  JSValue countVal = JS_WEBSG_GET_PROP(ctx, props_obj, count);
 
   if (JS_IsUndefined(countVal)) {
     JS_ThrowTypeError(ctx, "WebSG: Missing accessor count.");
@@ -235,7 +236,7 @@ JSValue js_websg_world_create_accessor_from(JSContext *ctx, JSValueConst this_va
 
   props->count = count;
 
-  JSValue normalized_val = JS_GetPropertyStr(ctx, props_obj, "normalized");
+  JSValue normalized_val = JS_WEBSG_GET_PROP(ctx, props_obj, normalized);
 
   if (!JS_IsUndefined(normalized_val)) {
     int normalized = JS_ToBool(ctx, normalized_val);
@@ -247,7 +248,7 @@ JSValue js_websg_world_create_accessor_from(JSContext *ctx, JSValueConst this_va
     props->normalized = normalized;
   }
 
-  JSValue dynamic_val = JS_GetPropertyStr(ctx, props_obj, "dynamic");
+  JSValue dynamic_val = JS_WEBSG_GET_PROP(ctx, props_obj, dynamic);
 
   if (!JS_IsUndefined(dynamic_val)) {
     int dynamic = JS_ToBool(ctx, dynamic_val);
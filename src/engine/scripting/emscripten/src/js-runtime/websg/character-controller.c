@@ -0,0 +1,268 @@
+#include <string.h>
+#include <math.h>
+#include "../quickjs/cutils.h"
+#include "../quickjs/quickjs.h"
+#include "../../websg.h"
+#include "../utils/array.h"
+#include "./command-buffer.h"
+#include "./node.h"
+#include "./vector3.h"
+#include "./character-controller.h"
+#include "./props.h"
+
+JSClassID js_websg_character_controller_class_id;
+
+/**
+ * Private Methods and Variables
+ **/
+
+static int js_websg_get_float_prop(JSContext *ctx, JSValueConst props, WebSGProp prop, float_t *value) {
+  JSValue val = JS_GetProperty(ctx, props, js_websg_prop_atoms[prop]);
+
+  if (JS_IsUndefined(val)) {
+    return 0;
+  }
+
+  double_t number;
+
+  if (JS_ToFloat64(ctx, &number, val) == -1) {
+    JS_FreeValue(ctx, val);
+    return -1;
+  }
+
+  *value = (float_t)number;
+
+  return 0;
+}
+
+static int js_websg_parse_character_controller_props(
+  JSContext *ctx,
+  JSValueConst props,
+  CharacterControllerProps *controller_props
+) {
+  // same as the player's controller
+  controller_props->offset = 0.01f;
+  controller_props->max_slope_climb_angle = M_PI / 4;
+  controller_props->min_slope_slide_angle = M_PI / 6;
+  controller_props->max_step_height = 0.1f;
+  controller_props->min_step_width = 0.1f;
+  controller_props->snap_to_ground = 0.1f;
+  controller_props->slide = 1;
+
+  if (JS_IsUndefined(props)) {
+    return 0;
+  }
+
+  if (
+    js_websg_get_float_prop(ctx, props, WEBSG_PROP_offset, &controller_props->offset) < 0 ||
+    js_websg_get_float_prop(ctx, props, WEBSG_PROP_maxSlopeClimbAngle, &controller_props->max_slope_climb_angle) < 0 ||
+    js_websg_get_float_prop(ctx, props, WEBSG_PROP_minSlopeSlideAngle, &controller_props->min_slope_slide_angle) < 0 ||
+    js_websg_get_float_prop(ctx, props, WEBSG_PROP_maxStepHeight, &controller_props->max_step_height) < 0 ||
+    js_websg_get_float_prop(ctx, props, WEBSG_PROP_minStepWidth, &controller_props->min_step_width) < 0 ||
+    js_websg_get_float_prop(ctx, props, WEBSG_PROP_snapToGround, &controller_props->snap_to_ground) < 0
+  ) {
+    return -1;
+  }
+
+  JSValue slide_val = JS_WEBSG_GET_PROP(ctx, props, slide);
+
+  if (!JS_IsUndefined(slide_val)) {
+    int slide = JS_ToBool(ctx, slide_val);
+    JS_FreeValue(ctx, slide_val);
+
+    if (slide == -1) {
+      return -1;
+    }
+
+    controller_props->slide = slide;
+  }
+
+  return 0;
+}
+
+/**
+ * Class Definition
+ **/
+
+static void js_websg_character_controller_finalizer(JSRuntime *rt, JSValue val) {
+  WebSGCharacterControllerData *character_controller_data = JS_GetOpaque(
+    val,
+    js_websg_character_controller_class_id
+  );
+
+  if (character_controller_data) {
+    js_free_rt(rt, character_controller_data);
+  }
+}
+
+static JSClassDef js_websg_character_controller_class = {
+  "CharacterController",
+  .finalizer = js_websg_character_controller_finalizer
+};
+
+static JSValue js_websg_character_controller_move(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  WebSGCharacterControllerData *character_controller_data = JS_GetOpaque(
+    this_val,
+    js_websg_character_controller_class_id
+  );
+
+  float_t translation[3];
+
+  if (js_get_float_array_like(ctx, argv[0], translation, 3) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  CharacterControllerMoveResult *result = &character_controller_data->result;
+
+  js_websg_flush_commands();
+
+  if (websg_character_controller_move(character_controller_data->node_id, translation, result) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGCharacterController: error moving character.");
+    return JS_EXCEPTION;
+  }
+
+  return JS_NewBool(ctx, result->grounded);
+}
+
+static JSValue js_websg_character_controller_get_grounded(JSContext *ctx, JSValueConst this_val) {
+  WebSGCharacterControllerData *character_controller_data = JS_GetOpaque(
+    this_val,
+    js_websg_character_controller_class_id
+  );
+
+  return JS_NewBool(ctx, character_controller_data->result.grounded);
+}
+
+static JSValue js_websg_character_controller_get_collision_count(JSContext *ctx, JSValueConst this_val) {
+  WebSGCharacterControllerData *character_controller_data = JS_GetOpaque(
+    this_val,
+    js_websg_character_controller_class_id
+  );
+
+  return JS_NewUint32(ctx, character_controller_data->result.collision_count);
+}
+
+static JSValue js_websg_character_controller_get_movement(JSContext *ctx, JSValueConst this_val) {
+  WebSGCharacterControllerData *character_controller_data = JS_GetOpaque(
+    this_val,
+    js_websg_character_controller_class_id
+  );
+
+  float_t *movement = js_malloc(ctx, sizeof(float_t) * 3);
+  memcpy(movement, character_controller_data->result.movement, sizeof(float_t) * 3);
+
+  return js_websg_create_vector3(ctx, movement);
+}
+
+static const JSCFunctionListEntry js_websg_character_controller_proto_funcs[] = {
+  JS_CFUNC_DEF("move", 1, js_websg_character_controller_move),
+  JS_CGETSET_DEF("grounded", js_websg_character_controller_get_grounded, NULL),
+  JS_CGETSET_DEF("collisionCount", js_websg_character_controller_get_collision_count, NULL),
+  JS_CGETSET_DEF("movement", js_websg_character_controller_get_movement, NULL),
+  JS_PROP_STRING_DEF("[Symbol.toStringTag]", "CharacterController", JS_PROP_CONFIGURABLE),
+};
+
+static JSValue js_websg_character_controller_constructor(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  return JS_ThrowTypeError(ctx, "Illegal Constructor.");
+}
+
+void js_websg_define_character_controller(JSContext *ctx, JSValue websg) {
+  JS_NewClassID(&js_websg_character_controller_class_id);
+  JS_NewClass(JS_GetRuntime(ctx), js_websg_character_controller_class_id, &js_websg_character_controller_class);
+  JSValue character_controller_proto = JS_NewObject(ctx);
+  JS_SetPropertyFunctionList(
+    ctx,
+    character_controller_proto,
+    js_websg_character_controller_proto_funcs,
+    countof(js_websg_character_controller_proto_funcs)
+  );
+  JS_SetClassProto(ctx, js_websg_character_controller_class_id, character_controller_proto);
+
+  JSValue constructor = JS_NewCFunction2(
+    ctx,
+    js_websg_character_controller_constructor,
+    "CharacterController",
+    0,
+    JS_CFUNC_constructor,
+    0
+  );
+  JS_SetConstructor(ctx, constructor, character_controller_proto);
+  JS_SetPropertyStr(
+    ctx,
+    websg,
+    "CharacterController",
+    constructor
+  );
+}
+
+/**
+ * Node Methods
+ **/
+
+JSValue js_websg_node_add_character_controller(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGNodeData *node_data = JS_GetOpaque(this_val, js_websg_node_class_id);
+
+  CharacterControllerProps props;
+
+  if (js_websg_parse_character_controller_props(ctx, argv[0], &props) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  js_websg_flush_commands();
+
+  if (websg_node_add_character_controller(node_data->node_id, &props) == -1) {
+    JS_ThrowInternalError(ctx, "WebSG: Error adding character controller.");
+    return JS_EXCEPTION;
+  }
+
+  JSValue character_controller = JS_NewObjectClass(ctx, js_websg_character_controller_class_id);
+
+  if (JS_IsException(character_controller)) {
+    return character_controller;
+  }
+
+  WebSGCharacterControllerData *character_controller_data = js_mallocz(ctx, sizeof(WebSGCharacterControllerData));
+  character_controller_data->node_id = node_data->node_id;
+  JS_SetOpaque(character_controller, character_controller_data);
+
+  node_data->character_controller = JS_DupValue(ctx, character_controller);
+
+  return character_controller;
+}
+
+JSValue js_websg_node_remove_character_controller(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  WebSGNodeData *node_data = JS_GetOpaque(this_val, js_websg_node_class_id);
+
+  js_websg_flush_commands();
+
+  if (websg_node_remove_character_controller(node_data->node_id) == -1) {
+    JS_ThrowInternalError(ctx, "WebSG: Error removing character controller.");
+    return JS_EXCEPTION;
+  }
+
+  JS_FreeValue(ctx, node_data->character_controller);
+
+  node_data->character_controller = JS_UNDEFINED;
+
+  return JS_UNDEFINED;
+}
+
+JSValue js_websg_node_get_character_controller(JSContext *ctx, JSValueConst this_val) {
+  WebSGNodeData *node_data = JS_GetOpaque(this_val, js_websg_node_class_id);
+  return JS_DupValue(ctx, node_data->character_controller);
+}
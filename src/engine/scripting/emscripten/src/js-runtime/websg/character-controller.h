@@ -0,0 +1,22 @@
+#ifndef __websg_character_controller_js_h
+#define __websg_character_controller_js_h
+#include "../../websg.h"
+#include "../quickjs/quickjs.h"
+
+typedef struct WebSGCharacterControllerData {
+  node_id_t node_id;
+  // result of the last move
+  CharacterControllerMoveResult result;
+} WebSGCharacterControllerData;
+
+extern JSClassID js_websg_character_controller_class_id;
+
+void js_websg_define_character_controller(JSContext *ctx, JSValue websg);
+
+JSValue js_websg_node_add_character_controller(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+JSValue js_websg_node_remove_character_controller(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+JSValue js_websg_node_get_character_controller(JSContext *ctx, JSValueConst this_val);
+
+#endif
@@ -1,9 +1,11 @@
+#include <string.h>
 #include "../quickjs/cutils.h"
 #include "../quickjs/quickjs.h"
 #include "../../websg.h"
 #include "./websg-js.h"
 #include "./collider.h"
 #include "./mesh.h"
+#include "./props.h"
 #include "../utils/array.h"
 
 JSClassID js_websg_collider_class_id;
@@ -142,12 +144,33 @@ JSValue js_websg_get_collider_by_id(JSContext *ctx, WebSGWorldData *world_data,
  * World Methods
  **/
 
+static int js_websg_parse_collider_simplify(JSContext *ctx, JSValueConst props, ColliderProps *collider_props) {
+  JSValue simplify_val = JS_WEBSG_GET_PROP(ctx, props, simplify);
+
+  if (JS_IsUndefined(simplify_val)) {
+    return 0;
+  }
+
+  double_t simplify;
+
+  if (JS_ToFloat64(ctx, &simplify, simplify_val) == -1) {
+    JS_FreeValue(ctx, simplify_val);
+    return -1;
+  }
+
+  JS_FreeValue(ctx, simplify_val);
+
+  collider_props->simplify = (float_t)simplify;
+
+  return 0;
+}
+
 JSValue js_websg_world_create_collider(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
   
   ColliderProps *props = js_mallocz(ctx, sizeof(ColliderProps));
 
-  JSValue type = JS_GetPropertyStr(ctx, argv[0], "type");
+  JSValue type = JS_WEBSG_GET_PROP(ctx, argv[0], type);
 
   ColliderType collider_type =  get_collider_type_from_atom(JS_ValueToAtom(ctx, type));
 
@@ -157,7 +180,7 @@ JSValue js_websg_world_create_collider(JSContext *ctx, JSValueConst this_val, in
     return JS_EXCEPTION;
   }
 
-  JSValue is_trigger_val = JS_GetPropertyStr(ctx, argv[0], "isTrigger");
+  JSValue is_trigger_val = JS_WEBSG_GET_PROP(ctx, argv[0], isTrigger);
 
   if (!JS_IsUndefined(is_trigger_val)) {
     int is_trigger = JS_ToBool(ctx, is_trigger_val);
@@ -170,7 +193,7 @@ JSValue js_websg_world_create_collider(JSContext *ctx, JSValueConst this_val, in
     props->is_trigger = is_trigger;
   }
 
-  JSValue size_val = JS_GetPropertyStr(ctx, argv[0], "size");
+  JSValue size_val = JS_WEBSG_GET_PROP(ctx, argv[0], size);
 
   if (!JS_IsUndefined(size_val)) {
     if (js_get_float_array_like(ctx, size_val, props->size, 3) < 0) {
@@ -178,7 +201,7 @@ JSValue js_websg_world_create_collider(JSContext *ctx, JSValueConst this_val, in
       return JS_EXCEPTION;}
   }
 
-  JSValue radius_val = JS_GetPropertyStr(ctx, argv[0], "radius");
+  JSValue radius_val = JS_WEBSG_GET_PROP(ctx, argv[0], radius);
 
   if (!JS_IsUndefined(radius_val)) {
     double_t radius;
@@ -191,7 +214,7 @@ JSValue js_websg_world_create_collider(JSContext *ctx, JSValueConst this_val, in
     props->radius = (float_t)radius;
   }
 
-  JSValue height_val = JS_GetPropertyStr(ctx, argv[0], "height");
+  JSValue height_val = JS_WEBSG_GET_PROP(ctx, argv[0], height);
 
   if (!JS_IsUndefined(height_val)) {
     double_t height;
@@ -204,7 +227,7 @@ JSValue js_websg_world_create_collider(JSContext *ctx, JSValueConst this_val, in
     props->height = (float_t)height;
   }
 
-  JSValue mesh_val = JS_GetPropertyStr(ctx, argv[0], "mesh");
+  JSValue mesh_val = JS_WEBSG_GET_PROP(ctx, argv[0], mesh);
 
   if (!JS_IsUndefined(mesh_val)) {
     WebSGMeshData *mesh_data = JS_GetOpaque2(ctx, mesh_val, js_websg_mesh_class_id);
@@ -217,7 +240,12 @@ JSValue js_websg_world_create_collider(JSContext *ctx, JSValueConst this_val, in
     props->mesh = mesh_data->mesh_id;
   }
 
-  collider_id_t collider_id = websg_world_create_collider(props);
+  if (js_websg_parse_collider_simplify(ctx, argv[0], props) < 0) {
+    js_free(ctx, props);
+    return JS_EXCEPTION;
+  }
+
+  collider_id_t collider_id = websg_world_create_collider_with_simplify(props);
 
   js_free(ctx, props);
 
@@ -229,6 +257,66 @@ JSValue js_websg_world_create_collider(JSContext *ctx, JSValueConst this_val, in
   return js_websg_new_collider_instance(ctx, world_data, collider_id);
 }
 
+JSValue js_websg_world_create_collider_from_mesh(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  WebSGMeshData *mesh_data = JS_GetOpaque2(ctx, argv[0], js_websg_mesh_class_id);
+
+  if (mesh_data == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  ColliderProps props;
+  memset(&props, 0, sizeof(ColliderProps));
+  props.type = ColliderType_Hull;
+  props.mesh = mesh_data->mesh_id;
+
+  JSValueConst options = argv[1];
+
+  if (!JS_IsUndefined(options)) {
+    JSValue type_val = JS_WEBSG_GET_PROP(ctx, options, type);
+
+    if (!JS_IsUndefined(type_val)) {
+      JSAtom type_atom = JS_ValueToAtom(ctx, type_val);
+      props.type = get_collider_type_from_atom(type_atom);
+      JS_FreeAtom(ctx, type_atom);
+      JS_FreeValue(ctx, type_val);
+
+      if (props.type != ColliderType_Hull && props.type != ColliderType_Trimesh) {
+        JS_ThrowTypeError(ctx, "WebSG: Mesh colliders must be hull or trimesh colliders.");
+        return JS_EXCEPTION;
+      }
+    }
+
+    JSValue is_trigger_val = JS_WEBSG_GET_PROP(ctx, options, isTrigger);
+
+    if (!JS_IsUndefined(is_trigger_val)) {
+      int is_trigger = JS_ToBool(ctx, is_trigger_val);
+      JS_FreeValue(ctx, is_trigger_val);
+
+      if (is_trigger < 0) {
+        return JS_EXCEPTION;
+      }
+
+      props.is_trigger = is_trigger;
+    }
+
+    if (js_websg_parse_collider_simplify(ctx, options, &props) < 0) {
+      return JS_EXCEPTION;
+    }
+  }
+
+  // the host builds the shape from the mesh's accessors, no vertex data passes through the script
+  collider_id_t collider_id = websg_world_create_collider_with_simplify(&props);
+
+  if (collider_id == 0) {
+    JS_ThrowInternalError(ctx, "WebSG: Couldn't create collider.");
+    return JS_EXCEPTION;
+  }
+
+  return js_websg_new_collider_instance(ctx, world_data, collider_id);
+}
+
 JSValue js_websg_world_find_collider_by_name(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
 
@@ -11,7 +11,7 @@ static void js_websg_collision_iterator_finalizer(JSRuntime *rt, JSValue val) {
   WebSGCollisionIteratorData *it = JS_GetOpaque(val, js_websg_collision_iterator_class_id);
 
   if (it) {
-    js_free_rt(rt, it->collisions);
+    JS_FreeValueRT(rt, it->listener);
     js_free_rt(rt, it);
   }
 }
@@ -36,18 +36,21 @@ static JSValue js_websg_collision_iterator_next(
     return JS_EXCEPTION;
   }
 
-  if (it->idx >= it->count) {
+  CollisionRing *ring = &it->listener_data->ring;
+
+  if (it->listener_data->disposed || ring->read_index == it->end_index) {
     *pdone = TRUE;
     return JS_UNDEFINED;
   }
 
   *pdone = FALSE;
 
-  CollisionItem collision = it->collisions[it->idx];
+  CollisionItem *collision = &ring->items[ring->read_index & (ring->capacity - 1)];
 
-  JSValue val = js_websg_new_collision(ctx, it->world_data, &collision);
+  JSValue val = js_websg_new_collision(ctx, it->listener_data->world_data, collision);
 
-  it->idx = it->idx + 1;
+  // frees the slot for the host
+  ring->read_index++;
 
   return val;
 }
@@ -70,27 +73,8 @@ void js_websg_define_collision_iterator(JSContext *ctx) {
   JS_SetClassProto(ctx, js_websg_collision_iterator_class_id, proto);
 }
 
-JSValue js_websg_create_collision_iterator(JSContext *ctx, WebSGCollisionListenerData *listener_data) {
-  WebSGCollisionIteratorData *it = js_mallocz(ctx, sizeof(WebSGCollisionIteratorData));
-  it->world_data = listener_data->world_data;
-  it->count = websg_collisions_listener_get_collision_count(listener_data->listener_id);
-
-  if (it->count == -1) {
-    js_free(ctx, it);
-    JS_ThrowInternalError(ctx, "WebSGNetworking: error getting collision count.");
-    return JS_EXCEPTION;
-  }
-
-  CollisionItem *collisions = it->count == 0 ? NULL : js_mallocz(ctx, it->count * sizeof(CollisionItem));
-
-  if (websg_collisions_listener_get_collisions(listener_data->listener_id, collisions, it->count) == -1) {
-    js_free(ctx, it);
-    js_free(ctx, collisions);
-    JS_ThrowInternalError(ctx, "WebSGNetworking: error getting collisions.");
-    return JS_EXCEPTION;
-  }
-
-  it->collisions = collisions;
+JSValue js_websg_create_collision_iterator(JSContext *ctx, JSValueConst listener) {
+  WebSGCollisionListenerData *listener_data = JS_GetOpaque(listener, js_websg_collision_listener_class_id);
 
   JSValue iter_obj = JS_NewObjectClass(ctx, js_websg_collision_iterator_class_id);
 
@@ -98,7 +82,13 @@ JSValue js_websg_create_collision_iterator(JSContext *ctx, WebSGCollisionListene
     return JS_EXCEPTION;
   }
 
+  // collisions are read straight out of the listener's ring, nothing is copied
+  WebSGCollisionIteratorData *it = js_mallocz(ctx, sizeof(WebSGCollisionIteratorData));
+  it->listener = JS_DupValue(ctx, listener);
+  it->listener_data = listener_data;
+  it->end_index = listener_data->ring.write_index;
+
   JS_SetOpaque(iter_obj, it);
 
   return iter_obj;
-}
\ No newline at end of file
+}
@@ -5,19 +5,17 @@
 #include "./collision-listener.h"
 
 typedef struct WebSGCollisionIteratorData {
-    WebSGWorldData *world_data;
-    CollisionItem *collisions;
-    uint32_t idx;
-    uint32_t count;
+    // keeps the listener and its ring alive while iterating
+    JSValue listener;
+    WebSGCollisionListenerData *listener_data;
+    // collisions written after the iterator was created are left for the next one
+    uint32_t end_index;
 } WebSGCollisionIteratorData;
 
 extern JSClassID js_websg_collision_iterator_class_id;
 
 void js_websg_define_collision_iterator(JSContext *ctx);
 
-JSValue js_websg_create_collision_iterator(
-    JSContext *ctx,
-    WebSGCollisionListenerData *listener_data
-);
+JSValue js_websg_create_collision_iterator(JSContext *ctx, JSValueConst listener);
 
 #endif
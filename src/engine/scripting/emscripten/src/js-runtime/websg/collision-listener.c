@@ -3,8 +3,10 @@
 #include "../../websg.h"
 #include "./websg-js.h"
 #include "./world.h"
+#include "./node.h"
 #include "./collision-listener.h"
 #include "./collision-iterator.h"
+#include "./props.h"
 
 JSClassID js_websg_collision_listener_class_id;
 
@@ -16,6 +18,12 @@ static void js_websg_collision_listener_finalizer(JSRuntime *rt, JSValue val) {
   WebSGCollisionListenerData *collision_listener_data = JS_GetOpaque(val, js_websg_collision_listener_class_id);
 
   if (collision_listener_data) {
+    // the host writes into the ring until the listener is disposed
+    if (!collision_listener_data->disposed) {
+      websg_collision_listener_dispose(collision_listener_data->listener_id);
+    }
+
+    js_free_rt(rt, collision_listener_data->ring.items);
     js_free_rt(rt, collision_listener_data);
   }
 }
@@ -31,8 +39,12 @@ static JSValue js_websg_collision_listener_collisions(
   int argc,
   JSValueConst *argv
 ) {
+  return js_websg_create_collision_iterator(ctx, this_val);
+}
+
+static JSValue js_websg_collision_listener_get_dropped_count(JSContext *ctx, JSValueConst this_val) {
   WebSGCollisionListenerData *collision_listener_data = JS_GetOpaque(this_val, js_websg_collision_listener_class_id);
-  return js_websg_create_collision_iterator(ctx, collision_listener_data);
+  return JS_NewUint32(ctx, collision_listener_data->ring.dropped_count);
 }
 
 static JSValue js_websg_collision_listener_dispose(
@@ -43,7 +55,12 @@ static JSValue js_websg_collision_listener_dispose(
 ) {
   WebSGCollisionListenerData *collision_listener_data = JS_GetOpaque(this_val, js_websg_collision_listener_class_id);
 
+  if (collision_listener_data->disposed) {
+    return JS_UNDEFINED;
+  }
+
   if (websg_collision_listener_dispose(collision_listener_data->listener_id) == 0) {
+    collision_listener_data->disposed = 1;
     return JS_UNDEFINED;
   }
 
@@ -55,6 +72,7 @@ static JSValue js_websg_collision_listener_dispose(
 static const JSCFunctionListEntry js_websg_collision_listener_proto_funcs[] = {
   JS_CFUNC_DEF("collisions", 1, js_websg_collision_listener_collisions),
   JS_CFUNC_DEF("dispose", 0, js_websg_collision_listener_dispose),
+  JS_CGETSET_DEF("droppedCount", js_websg_collision_listener_get_dropped_count, NULL),
   JS_PROP_STRING_DEF("[Symbol.toStringTag]", "CollisionListener", JS_PROP_CONFIGURABLE),
 };
 
@@ -100,6 +118,89 @@ void js_websg_define_collision_listener(JSContext *ctx, JSValue websg) {
  * World Methods
  **/
 
+static int js_websg_parse_collision_listener_props(
+  JSContext *ctx,
+  JSValueConst props,
+  CollisionListenerProps *listener_props,
+  uint32_t *capacity
+) {
+  if (JS_IsUndefined(props)) {
+    return 0;
+  }
+
+  JSValue capacity_val = JS_WEBSG_GET_PROP(ctx, props, capacity);
+
+  if (!JS_IsUndefined(capacity_val)) {
+    if (JS_ToUint32(ctx, capacity, capacity_val) == -1) {
+      return -1;
+    }
+
+    if (*capacity == 0 || *capacity > WEBSG_COLLISION_LISTENER_MAX_CAPACITY) {
+      JS_ThrowRangeError(
+        ctx,
+        "WebSG: CollisionListener capacity must be between 1 and %d.",
+        WEBSG_COLLISION_LISTENER_MAX_CAPACITY
+      );
+      return -1;
+    }
+
+    // ring slots are masked out of the free running indices, which only stays correct across the 2^32 wrap
+    // when the capacity divides 2^32
+    uint32_t power_of_two = 1;
+
+    while (power_of_two < *capacity) {
+      power_of_two <<= 1;
+    }
+
+    *capacity = power_of_two;
+  }
+
+  JSValue nodes_val = JS_WEBSG_GET_PROP(ctx, props, nodes);
+
+  if (JS_IsUndefined(nodes_val)) {
+    return 0;
+  }
+
+  JSValue length_val = JS_WEBSG_GET_PROP(ctx, nodes_val, length);
+
+  uint32_t node_count;
+
+  if (JS_ToUint32(ctx, &node_count, length_val) == -1) {
+    JS_FreeValue(ctx, nodes_val);
+    return -1;
+  }
+
+  JS_FreeValue(ctx, length_val);
+
+  node_id_t *nodes = js_mallocz(ctx, sizeof(node_id_t) * node_count);
+
+  if (nodes == NULL) {
+    JS_FreeValue(ctx, nodes_val);
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < node_count; i++) {
+    JSValue node_val = JS_GetPropertyUint32(ctx, nodes_val, i);
+    WebSGNodeData *node_data = JS_GetOpaque2(ctx, node_val, js_websg_node_class_id);
+    JS_FreeValue(ctx, node_val);
+
+    if (node_data == NULL) {
+      js_free(ctx, nodes);
+      JS_FreeValue(ctx, nodes_val);
+      return -1;
+    }
+
+    nodes[i] = node_data->node_id;
+  }
+
+  JS_FreeValue(ctx, nodes_val);
+
+  listener_props->nodes = nodes;
+  listener_props->node_count = node_count;
+
+  return 0;
+}
+
 JSValue js_websg_world_create_collision_listener(
   JSContext *ctx,
   JSValueConst this_val,
@@ -108,23 +209,56 @@ JSValue js_websg_world_create_collision_listener(
 ) {
   WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
 
+  CollisionListenerProps props = { 0 };
+  uint32_t capacity = WEBSG_COLLISION_LISTENER_DEFAULT_CAPACITY;
+
+  if (js_websg_parse_collision_listener_props(ctx, argv[0], &props, &capacity) == -1) {
+    return JS_EXCEPTION;
+  }
+
   JSValue collision_listener = JS_NewObjectClass(ctx, js_websg_collision_listener_class_id);
 
   if (JS_IsException(collision_listener)) {
+    js_free(ctx, props.nodes);
     return collision_listener;
   }
 
-  collision_listener_id_t listener_id = websg_world_create_collision_listener();
+  WebSGCollisionListenerData *listener_data = js_mallocz(ctx, sizeof(WebSGCollisionListenerData));
 
-  if (listener_id == 0) {
-    JS_ThrowInternalError(ctx, "WebSGNetworking: error creating listener.");
+  if (listener_data == NULL) {
+    js_free(ctx, props.nodes);
+    JS_FreeValue(ctx, collision_listener);
     return JS_EXCEPTION;
   }
 
-  WebSGCollisionListenerData *listener_data = js_mallocz(ctx, sizeof(WebSGCollisionListenerData));
   listener_data->world_data = world_data;
-  listener_data->listener_id = listener_id;
+  listener_data->ring.items = js_mallocz(ctx, sizeof(CollisionItem) * capacity);
+  listener_data->ring.capacity = capacity;
+  // the finalizer frees the ring, so attach it before anything can fail
+  listener_data->disposed = 1;
   JS_SetOpaque(collision_listener, listener_data);
-  
+
+  if (listener_data->ring.items == NULL) {
+    js_free(ctx, props.nodes);
+    JS_FreeValue(ctx, collision_listener);
+    return JS_EXCEPTION;
+  }
+
+  props.ring = &listener_data->ring;
+
+  collision_listener_id_t listener_id = websg_world_create_collision_ring_listener(&props);
+
+  // the host copies the node ids
+  js_free(ctx, props.nodes);
+
+  if (listener_id == 0) {
+    JS_FreeValue(ctx, collision_listener);
+    JS_ThrowInternalError(ctx, "WebSG: error creating collision listener.");
+    return JS_EXCEPTION;
+  }
+
+  listener_data->listener_id = listener_id;
+  listener_data->disposed = 0;
+
   return collision_listener;
 }
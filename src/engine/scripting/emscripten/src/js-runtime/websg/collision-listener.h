@@ -4,9 +4,16 @@
 #include "../quickjs/quickjs.h"
 #include "./world.h"
 
+#define WEBSG_COLLISION_LISTENER_DEFAULT_CAPACITY 256
+// bounds the ring allocation, which is sized by a script-supplied capacity
+#define WEBSG_COLLISION_LISTENER_MAX_CAPACITY 65536
+
 typedef struct WebSGCollisionListenerData {
   WebSGWorldData *world_data;
   collision_listener_id_t listener_id;
+  // written to by the host, lives as long as the listener
+  CollisionRing ring;
+  int disposed;
 } WebSGCollisionListenerData;
 
 extern JSClassID js_websg_collision_listener_class_id;
@@ -0,0 +1,203 @@
+#include <string.h>
+
+#include "../../websg.h"
+#include "./command-buffer.h"
+
+/**
+ * Private Methods and Variables
+ **/
+
+// a full buffer is flushed early so recording a command never fails
+#define WEBSG_COMMAND_BUFFER_CAPACITY 1024
+
+static WebSGCommand commands[WEBSG_COMMAND_BUFFER_CAPACITY];
+static uint32_t command_count = 0;
+
+static WebSGCommand *js_websg_push_command(WebSGCommandType type, uint32_t resource_id) {
+  if (command_count == WEBSG_COMMAND_BUFFER_CAPACITY) {
+    js_websg_flush_commands();
+  }
+
+  WebSGCommand *command = &commands[command_count++];
+  command->type = type;
+  command->resource_id = resource_id;
+  command->index = 0;
+
+  return command;
+}
+
+static int32_t js_websg_push_element_command(
+  WebSGCommandType type,
+  uint32_t resource_id,
+  uint32_t index,
+  float_t value
+) {
+  WebSGCommand *command = js_websg_push_command(type, resource_id);
+  command->index = index;
+  command->value[0] = value;
+  return 0;
+}
+
+static int32_t js_websg_push_array_command(
+  WebSGCommandType type,
+  uint32_t resource_id,
+  float_t *array,
+  uint32_t length
+) {
+  WebSGCommand *command = js_websg_push_command(type, resource_id);
+  memcpy(command->value, array, sizeof(float_t) * length);
+  return 0;
+}
+
+/**
+ * Public Methods
+ **/
+
+int32_t js_websg_flush_commands() {
+  if (command_count == 0) {
+    return 0;
+  }
+
+  int32_t failed = websg_commands_flush(commands, command_count);
+  command_count = 0;
+  return failed;
+}
+
+/**
+ * Node
+ **/
+
+int32_t js_websg_command_node_set_translation(node_id_t node_id, float_t *translation) {
+  return js_websg_push_array_command(WebSGCommandType_NODE_SET_TRANSLATION, node_id, translation, 3);
+}
+
+int32_t js_websg_command_node_set_translation_element(node_id_t node_id, uint32_t index, float_t value) {
+  return js_websg_push_element_command(WebSGCommandType_NODE_SET_TRANSLATION_ELEMENT, node_id, index, value);
+}
+
+float_t js_websg_command_node_get_translation_element(node_id_t node_id, uint32_t index) {
+  js_websg_flush_commands();
+  return websg_node_get_translation_element(node_id, index);
+}
+
+int32_t js_websg_command_node_set_rotation(node_id_t node_id, float_t *rotation) {
+  return js_websg_push_array_command(WebSGCommandType_NODE_SET_ROTATION, node_id, rotation, 4);
+}
+
+int32_t js_websg_command_node_set_rotation_element(node_id_t node_id, uint32_t index, float_t value) {
+  return js_websg_push_element_command(WebSGCommandType_NODE_SET_ROTATION_ELEMENT, node_id, index, value);
+}
+
+float_t js_websg_command_node_get_rotation_element(node_id_t node_id, uint32_t index) {
+  js_websg_flush_commands();
+  return websg_node_get_rotation_element(node_id, index);
+}
+
+int32_t js_websg_command_node_set_scale(node_id_t node_id, float_t *scale) {
+  return js_websg_push_array_command(WebSGCommandType_NODE_SET_SCALE, node_id, scale, 3);
+}
+
+int32_t js_websg_command_node_set_scale_element(node_id_t node_id, uint32_t index, float_t value) {
+  return js_websg_push_element_command(WebSGCommandType_NODE_SET_SCALE_ELEMENT, node_id, index, value);
+}
+
+float_t js_websg_command_node_get_scale_element(node_id_t node_id, uint32_t index) {
+  js_websg_flush_commands();
+  return websg_node_get_scale_element(node_id, index);
+}
+
+// the local matrix isn't buffered but is composed from and replaces the buffered transform
+
+int32_t js_websg_command_node_set_matrix(node_id_t node_id, float_t *matrix) {
+  js_websg_flush_commands();
+  return websg_node_set_matrix(node_id, matrix);
+}
+
+int32_t js_websg_command_node_set_matrix_element(node_id_t node_id, uint32_t index, float_t value) {
+  js_websg_flush_commands();
+  return websg_node_set_matrix_element(node_id, index, value);
+}
+
+float_t js_websg_command_node_get_matrix_element(node_id_t node_id, uint32_t index) {
+  js_websg_flush_commands();
+  return websg_node_get_matrix_element(node_id, index);
+}
+
+float_t js_websg_command_node_get_world_matrix_element(node_id_t node_id, uint32_t index) {
+  js_websg_flush_commands();
+  return websg_node_get_world_matrix_element(node_id, index);
+}
+
+int32_t js_websg_command_node_set_visible(node_id_t node_id, uint32_t visible) {
+  return js_websg_push_element_command(WebSGCommandType_NODE_SET_VISIBLE, node_id, 0, (float_t)visible);
+}
+
+uint32_t js_websg_command_node_get_visible(node_id_t node_id) {
+  js_websg_flush_commands();
+  return websg_node_get_visible(node_id);
+}
+
+/**
+ * Material
+ **/
+
+int32_t js_websg_command_material_set_base_color_factor(material_id_t material_id, float_t *base_color_factor) {
+  return js_websg_push_array_command(
+    WebSGCommandType_MATERIAL_SET_BASE_COLOR_FACTOR,
+    material_id,
+    base_color_factor,
+    4
+  );
+}
+
+int32_t js_websg_command_material_set_base_color_factor_element(
+  material_id_t material_id,
+  uint32_t index,
+  float_t value
+) {
+  return js_websg_push_element_command(
+    WebSGCommandType_MATERIAL_SET_BASE_COLOR_FACTOR_ELEMENT,
+    material_id,
+    index,
+    value
+  );
+}
+
+float_t js_websg_command_material_get_base_color_factor_element(material_id_t material_id, uint32_t index) {
+  js_websg_flush_commands();
+  return websg_material_get_base_color_factor_element(material_id, index);
+}
+
+/**
+ * Light
+ **/
+
+int32_t js_websg_command_light_set_color(light_id_t light_id, float_t *color) {
+  return js_websg_push_array_command(WebSGCommandType_LIGHT_SET_COLOR, light_id, color, 3);
+}
+
+int32_t js_websg_command_light_set_color_element(light_id_t light_id, uint32_t index, float_t value) {
+  return js_websg_push_element_command(WebSGCommandType_LIGHT_SET_COLOR_ELEMENT, light_id, index, value);
+}
+
+float_t js_websg_command_light_get_color_element(light_id_t light_id, uint32_t index) {
+  js_websg_flush_commands();
+  return websg_light_get_color_element(light_id, index);
+}
+
+int32_t js_websg_command_light_set_intensity(light_id_t light_id, float_t intensity) {
+  return js_websg_push_element_command(WebSGCommandType_LIGHT_SET_INTENSITY, light_id, 0, intensity);
+}
+
+float_t js_websg_command_light_get_intensity(light_id_t light_id) {
+  js_websg_flush_commands();
+  return websg_light_get_intensity(light_id);
+}
+
+/**
+ * Physics Body
+ **/
+
+int32_t js_websg_command_physics_body_apply_impulse(node_id_t node_id, float_t *impulse) {
+  return js_websg_push_array_command(WebSGCommandType_PHYSICS_BODY_APPLY_IMPULSE, node_id, impulse, 3);
+}
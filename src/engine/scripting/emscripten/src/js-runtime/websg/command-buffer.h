@@ -0,0 +1,50 @@
+#ifndef __websg_command_buffer_js_h
+#define __websg_command_buffer_js_h
+#include "../../websg.h"
+
+/**
+ * Fire-and-forget setters are recorded into a command buffer in linear memory and executed by the host with one
+ * websg_commands_flush call when the script returns control to the host. The functions below have the same
+ * signatures as the imports they replace so they can be passed to the vector, quaternion and color accessors.
+ *
+ * To keep calls observing the order they were made in, getters of buffered state and host calls that read or
+ * replace it flush first.
+ **/
+
+// Executes and clears the recorded commands. Returns the number of commands that failed, which the host also adds
+// to its failedCommands total since most callers have no way to report them.
+int32_t js_websg_flush_commands();
+
+int32_t js_websg_command_node_set_translation(node_id_t node_id, float_t *translation);
+int32_t js_websg_command_node_set_translation_element(node_id_t node_id, uint32_t index, float_t value);
+float_t js_websg_command_node_get_translation_element(node_id_t node_id, uint32_t index);
+int32_t js_websg_command_node_set_rotation(node_id_t node_id, float_t *rotation);
+int32_t js_websg_command_node_set_rotation_element(node_id_t node_id, uint32_t index, float_t value);
+float_t js_websg_command_node_get_rotation_element(node_id_t node_id, uint32_t index);
+int32_t js_websg_command_node_set_scale(node_id_t node_id, float_t *scale);
+int32_t js_websg_command_node_set_scale_element(node_id_t node_id, uint32_t index, float_t value);
+float_t js_websg_command_node_get_scale_element(node_id_t node_id, uint32_t index);
+int32_t js_websg_command_node_set_matrix(node_id_t node_id, float_t *matrix);
+int32_t js_websg_command_node_set_matrix_element(node_id_t node_id, uint32_t index, float_t value);
+float_t js_websg_command_node_get_matrix_element(node_id_t node_id, uint32_t index);
+float_t js_websg_command_node_get_world_matrix_element(node_id_t node_id, uint32_t index);
+int32_t js_websg_command_node_set_visible(node_id_t node_id, uint32_t visible);
+uint32_t js_websg_command_node_get_visible(node_id_t node_id);
+
+int32_t js_websg_command_material_set_base_color_factor(material_id_t material_id, float_t *base_color_factor);
+int32_t js_websg_command_material_set_base_color_factor_element(
+  material_id_t material_id,
+  uint32_t index,
+  float_t value
+);
+float_t js_websg_command_material_get_base_color_factor_element(material_id_t material_id, uint32_t index);
+
+int32_t js_websg_command_light_set_color(light_id_t light_id, float_t *color);
+int32_t js_websg_command_light_set_color_element(light_id_t light_id, uint32_t index, float_t value);
+float_t js_websg_command_light_get_color_element(light_id_t light_id, uint32_t index);
+int32_t js_websg_command_light_set_intensity(light_id_t light_id, float_t intensity);
+float_t js_websg_command_light_get_intensity(light_id_t light_id);
+
+int32_t js_websg_command_physics_body_apply_impulse(node_id_t node_id, float_t *impulse);
+
+#endif
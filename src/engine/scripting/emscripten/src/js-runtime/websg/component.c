@@ -365,7 +365,7 @@ JSClassID js_websg_define_component_instance(
     return 0;
   }
 
-  const char *component_name = js_mallocz(ctx, sizeof(char) * component_name_length);
+  const char *component_name = js_mallocz(ctx, sizeof(char) * (component_name_length + 1));
 
   if (websg_component_definition_get_name(component_id, component_name, component_name_length) == -1) {
     JS_ThrowInternalError(ctx, "Failed to get component name");
@@ -405,7 +405,7 @@ JSClassID js_websg_define_component_instance(
         return 0;
       }
 
-      const char *prop_name = js_mallocz(ctx, sizeof(char) * prop_name_length);
+      const char *prop_name = js_mallocz(ctx, sizeof(char) * (prop_name_length + 1));
 
       if (websg_component_definition_get_prop_name(component_id, i, prop_name, prop_name_length) == -1) {
         JS_ThrowInternalError(ctx, "Failed to get prop name");
@@ -419,7 +419,7 @@ JSClassID js_websg_define_component_instance(
         return 0;
       }
 
-      const char *prop_type = js_mallocz(ctx, sizeof(char) * prop_type_length);
+      const char *prop_type = js_mallocz(ctx, sizeof(char) * (prop_type_length + 1));
 
       if (websg_component_definition_get_prop_type(component_id, i, prop_type, prop_type_length) == -1) {
         JS_ThrowInternalError(ctx, "Failed to get prop type");
@@ -436,7 +436,7 @@ JSClassID js_websg_define_component_instance(
           return 0;
         }
 
-        const char *ref_type = js_mallocz(ctx, sizeof(char) * ref_type_length);
+        const char *ref_type = js_mallocz(ctx, sizeof(char) * (ref_type_length + 1));
 
         if (websg_component_definition_get_ref_type(component_id, i, ref_type, ref_type_length) == -1) {
           JS_ThrowInternalError(ctx, "Failed to get ref type");
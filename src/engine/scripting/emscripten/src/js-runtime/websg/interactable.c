@@ -3,6 +3,7 @@
 #include "../../websg.h"
 #include "./node.h"
 #include "./interactable.h"
+#include "./props.h"
 
 JSClassID js_websg_interactable_class_id;
 
@@ -142,7 +143,7 @@ JSValue js_websg_node_add_interactable(JSContext *ctx, JSValueConst this_val, in
   props->type = InteractableType_Interactable;
 
   if (!JS_IsUndefined(argv[0])) {
-    JSValue type_val = JS_GetPropertyStr(ctx, argv[0], "type");
+    JSValue type_val = JS_WEBSG_GET_PROP(ctx, argv[0], type);
     if (!JS_IsUndefined(type_val)) { 
       uint32_t type;
 
@@ -0,0 +1,459 @@
+#include <string.h>
+#include "../quickjs/cutils.h"
+#include "../quickjs/quickjs.h"
+#include "../../websg.h"
+#include "./interpolation-buffer.h"
+#include "./quaternion.h"
+#include "./vector3.h"
+#include "./props.h"
+#include "../utils/array.h"
+
+JSClassID js_websg_interpolation_buffer_class_id;
+
+#define DEFAULT_CAPACITY 32
+#define DEFAULT_DELAY 0.1
+
+/**
+ * Private Methods and Variables
+ **/
+
+static uint32_t get_slot(WebSGInterpolationBufferData *buffer_data, uint32_t index) {
+  return (buffer_data->head + index) % buffer_data->capacity;
+}
+
+static float_t *get_sample(WebSGInterpolationBufferData *buffer_data, uint32_t index) {
+  return buffer_data->values + get_slot(buffer_data, index) * buffer_data->size;
+}
+
+static double_t get_sample_time(WebSGInterpolationBufferData *buffer_data, uint32_t index) {
+  return buffer_data->times[get_slot(buffer_data, index)];
+}
+
+// Drops the oldest samples so that the sample at index becomes the new head
+static void discard_samples(WebSGInterpolationBufferData *buffer_data, uint32_t index) {
+  buffer_data->head = get_slot(buffer_data, index);
+  buffer_data->count -= index;
+}
+
+static void lerp(float_t *out, float_t *a, float_t *b, float_t t, uint32_t size) {
+  for (uint32_t i = 0; i < size; i++) {
+    out[i] = a[i] + (b[i] - a[i]) * t;
+  }
+}
+
+static void slerp(float_t *out, float_t *a, float_t *b, float_t t) {
+  float_t cos_omega = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+  float_t sign = 1.0f;
+
+  // take the shortest path around the hypersphere
+  if (cos_omega < 0.0f) {
+    cos_omega = -cos_omega;
+    sign = -1.0f;
+  }
+
+  float_t scale_a;
+  float_t scale_b;
+
+  if (1.0f - cos_omega > 0.000001f) {
+    float_t omega = acosf(cos_omega);
+    float_t sin_omega = sinf(omega);
+    scale_a = sinf((1.0f - t) * omega) / sin_omega;
+    scale_b = sinf(t * omega) / sin_omega;
+  } else {
+    // the quaternions are very close so fall back to a linear interpolation
+    scale_a = 1.0f - t;
+    scale_b = t;
+  }
+
+  scale_b *= sign;
+
+  for (uint32_t i = 0; i < 4; i++) {
+    out[i] = scale_a * a[i] + scale_b * b[i];
+  }
+}
+
+static int write_sample(
+  JSContext *ctx,
+  WebSGInterpolationBufferData *buffer_data,
+  JSValue out,
+  float_t *sample
+) {
+  // Vector3 and Quaternion properties are written back to the host in a single call
+  WebSGVector3Data *vec3_data = JS_GetOpaque(out, js_websg_vector3_class_id);
+
+  if (vec3_data && buffer_data->size == 3) {
+    if (vec3_data->read_only == 1) {
+      JS_ThrowTypeError(ctx, "Vector3 is marked as read only.");
+      return -1;
+    }
+
+    memcpy(vec3_data->elements, sample, sizeof(float_t) * 3);
+
+    if (vec3_data->set_array != NULL && vec3_data->set_array(vec3_data->resource_id, vec3_data->elements) < 0) {
+      JS_ThrowInternalError(ctx, "Failed to set Vector3 value");
+      return -1;
+    }
+
+    return 0;
+  }
+
+  WebSGQuaternionData *quat_data = JS_GetOpaque(out, js_websg_quaternion_class_id);
+
+  if (quat_data && buffer_data->size == 4) {
+    if (quat_data->read_only == 1) {
+      JS_ThrowTypeError(ctx, "Quaternion is marked as read only.");
+      return -1;
+    }
+
+    memcpy(quat_data->elements, sample, sizeof(float_t) * 4);
+
+    if (quat_data->set_array != NULL && quat_data->set_array(quat_data->resource_id, quat_data->elements) < 0) {
+      JS_ThrowInternalError(ctx, "Failed to set Quaternion value");
+      return -1;
+    }
+
+    return 0;
+  }
+
+  for (uint32_t i = 0; i < buffer_data->size; i++) {
+    if (JS_SetPropertyUint32(ctx, out, i, JS_NewFloat64(ctx, sample[i])) < 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * Class Definition
+ **/
+
+static void js_websg_interpolation_buffer_finalizer(JSRuntime *rt, JSValue val) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(val, js_websg_interpolation_buffer_class_id);
+
+  if (buffer_data) {
+    js_free_rt(rt, buffer_data->times);
+    js_free_rt(rt, buffer_data->values);
+    js_free_rt(rt, buffer_data);
+  }
+}
+
+static JSClassDef js_websg_interpolation_buffer_class = {
+  "InterpolationBuffer",
+  .finalizer = js_websg_interpolation_buffer_finalizer
+};
+
+static JSValue js_websg_interpolation_buffer_push(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(this_val, js_websg_interpolation_buffer_class_id);
+
+  double_t time;
+
+  if (JS_ToFloat64(ctx, &time, argv[0]) == -1) {
+    return JS_EXCEPTION;
+  }
+
+  float_t value[WEBSG_INTERPOLATION_BUFFER_MAX_SIZE];
+
+  if (js_get_float_array_like(ctx, argv[1], value, buffer_data->size) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  if (buffer_data->count == buffer_data->capacity) {
+    // a full buffer has no use for a sample older than everything it already holds
+    if (time < get_sample_time(buffer_data, 0)) {
+      return JS_DupValue(ctx, this_val);
+    }
+
+    discard_samples(buffer_data, 1);
+  }
+
+  // samples usually arrive in order, but unreliable messages may not, so insert sorted by time
+  uint32_t index = buffer_data->count;
+
+  while (index > 0 && get_sample_time(buffer_data, index - 1) > time) {
+    buffer_data->times[get_slot(buffer_data, index)] = get_sample_time(buffer_data, index - 1);
+    memcpy(
+      get_sample(buffer_data, index),
+      get_sample(buffer_data, index - 1),
+      sizeof(float_t) * buffer_data->size
+    );
+    index--;
+  }
+
+  buffer_data->times[get_slot(buffer_data, index)] = time;
+  memcpy(get_sample(buffer_data, index), value, sizeof(float_t) * buffer_data->size);
+  buffer_data->count++;
+
+  return JS_DupValue(ctx, this_val);
+}
+
+static JSValue js_websg_interpolation_buffer_sample(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(this_val, js_websg_interpolation_buffer_class_id);
+
+  double_t time;
+
+  if (JS_ToFloat64(ctx, &time, argv[0]) == -1) {
+    return JS_EXCEPTION;
+  }
+
+  JSValue out = argv[1];
+
+  if (buffer_data->count == 0) {
+    return JS_DupValue(ctx, out);
+  }
+
+  double_t render_time = time - buffer_data->delay;
+  uint32_t last = buffer_data->count - 1;
+
+  if (render_time <= get_sample_time(buffer_data, 0)) {
+    if (write_sample(ctx, buffer_data, out, get_sample(buffer_data, 0)) < 0) {
+      return JS_EXCEPTION;
+    }
+
+    return JS_DupValue(ctx, out);
+  }
+
+  if (render_time >= get_sample_time(buffer_data, last)) {
+    // no extrapolation, hold the newest sample until another one arrives
+    discard_samples(buffer_data, last);
+
+    if (write_sample(ctx, buffer_data, out, get_sample(buffer_data, 0)) < 0) {
+      return JS_EXCEPTION;
+    }
+
+    return JS_DupValue(ctx, out);
+  }
+
+  // the render time usually trails the newest samples by a few entries so search from the end
+  uint32_t index = last;
+
+  while (get_sample_time(buffer_data, index - 1) > render_time) {
+    index--;
+  }
+
+  // samples before the bracketing pair are in the past and won't be sampled again
+  discard_samples(buffer_data, index - 1);
+
+  double_t from_time = get_sample_time(buffer_data, 0);
+  double_t to_time = get_sample_time(buffer_data, 1);
+  float_t t = to_time > from_time ? (float_t)((render_time - from_time) / (to_time - from_time)) : 1.0f;
+
+  float_t value[WEBSG_INTERPOLATION_BUFFER_MAX_SIZE];
+
+  if (buffer_data->quaternion) {
+    slerp(value, get_sample(buffer_data, 0), get_sample(buffer_data, 1), t);
+  } else {
+    lerp(value, get_sample(buffer_data, 0), get_sample(buffer_data, 1), t, buffer_data->size);
+  }
+
+  if (write_sample(ctx, buffer_data, out, value) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  return JS_DupValue(ctx, out);
+}
+
+static JSValue js_websg_interpolation_buffer_clear(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(this_val, js_websg_interpolation_buffer_class_id);
+  buffer_data->head = 0;
+  buffer_data->count = 0;
+  return JS_UNDEFINED;
+}
+
+static JSValue js_websg_interpolation_buffer_get_count(JSContext *ctx, JSValueConst this_val) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(this_val, js_websg_interpolation_buffer_class_id);
+  return JS_NewUint32(ctx, buffer_data->count);
+}
+
+static JSValue js_websg_interpolation_buffer_get_size(JSContext *ctx, JSValueConst this_val) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(this_val, js_websg_interpolation_buffer_class_id);
+  return JS_NewUint32(ctx, buffer_data->size);
+}
+
+static JSValue js_websg_interpolation_buffer_get_capacity(JSContext *ctx, JSValueConst this_val) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(this_val, js_websg_interpolation_buffer_class_id);
+  return JS_NewUint32(ctx, buffer_data->capacity);
+}
+
+static JSValue js_websg_interpolation_buffer_get_delay(JSContext *ctx, JSValueConst this_val) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(this_val, js_websg_interpolation_buffer_class_id);
+  return JS_NewFloat64(ctx, buffer_data->delay);
+}
+
+static JSValue js_websg_interpolation_buffer_set_delay(JSContext *ctx, JSValueConst this_val, JSValueConst arg) {
+  WebSGInterpolationBufferData *buffer_data = JS_GetOpaque(this_val, js_websg_interpolation_buffer_class_id);
+
+  double_t delay;
+
+  if (JS_ToFloat64(ctx, &delay, arg) == -1) {
+    return JS_EXCEPTION;
+  }
+
+  if (delay < 0) {
+    return JS_ThrowRangeError(ctx, "WebSG: InterpolationBuffer delay must be non-negative.");
+  }
+
+  buffer_data->delay = delay;
+
+  return JS_UNDEFINED;
+}
+
+static const JSCFunctionListEntry js_websg_interpolation_buffer_proto_funcs[] = {
+  JS_CFUNC_DEF("push", 2, js_websg_interpolation_buffer_push),
+  JS_CFUNC_DEF("sample", 2, js_websg_interpolation_buffer_sample),
+  JS_CFUNC_DEF("clear", 0, js_websg_interpolation_buffer_clear),
+  JS_CGETSET_DEF("count", js_websg_interpolation_buffer_get_count, NULL),
+  JS_CGETSET_DEF("size", js_websg_interpolation_buffer_get_size, NULL),
+  JS_CGETSET_DEF("capacity", js_websg_interpolation_buffer_get_capacity, NULL),
+  JS_CGETSET_DEF("delay", js_websg_interpolation_buffer_get_delay, js_websg_interpolation_buffer_set_delay),
+  JS_PROP_STRING_DEF("[Symbol.toStringTag]", "InterpolationBuffer", JS_PROP_CONFIGURABLE),
+};
+
+static JSValue js_websg_interpolation_buffer_constructor(
+  JSContext *ctx,
+  JSValueConst new_target,
+  int argc,
+  JSValueConst *argv
+) {
+  uint32_t size = 3;
+  int quaternion = 0;
+  uint32_t capacity = DEFAULT_CAPACITY;
+  double_t delay = DEFAULT_DELAY;
+
+  if (argc > 0 && !JS_IsUndefined(argv[0])) {
+    JSValue quaternion_val = JS_WEBSG_GET_PROP(ctx, argv[0], quaternion);
+
+    if (!JS_IsUndefined(quaternion_val)) {
+      quaternion = JS_ToBool(ctx, quaternion_val);
+
+      if (quaternion == -1) {
+        return JS_EXCEPTION;
+      }
+
+      if (quaternion) {
+        size = 4;
+      }
+    }
+
+    JSValue size_val = JS_WEBSG_GET_PROP(ctx, argv[0], size);
+
+    if (!JS_IsUndefined(size_val)) {
+      if (JS_ToUint32(ctx, &size, size_val) == -1) {
+        return JS_EXCEPTION;
+      }
+    }
+
+    JSValue capacity_val = JS_WEBSG_GET_PROP(ctx, argv[0], capacity);
+
+    if (!JS_IsUndefined(capacity_val)) {
+      if (JS_ToUint32(ctx, &capacity, capacity_val) == -1) {
+        return JS_EXCEPTION;
+      }
+    }
+
+    JSValue delay_val = JS_WEBSG_GET_PROP(ctx, argv[0], delay);
+
+    if (!JS_IsUndefined(delay_val)) {
+      if (JS_ToFloat64(ctx, &delay, delay_val) == -1) {
+        return JS_EXCEPTION;
+      }
+    }
+  }
+
+  if (quaternion && size != 4) {
+    return JS_ThrowRangeError(ctx, "WebSG: Quaternion InterpolationBuffer size must be 4.");
+  }
+
+  if (size == 0 || size > WEBSG_INTERPOLATION_BUFFER_MAX_SIZE) {
+    return JS_ThrowRangeError(
+      ctx,
+      "WebSG: InterpolationBuffer size must be between 1 and %d.",
+      WEBSG_INTERPOLATION_BUFFER_MAX_SIZE
+    );
+  }
+
+  if (capacity < 2 || capacity > WEBSG_INTERPOLATION_BUFFER_MAX_CAPACITY) {
+    return JS_ThrowRangeError(
+      ctx,
+      "WebSG: InterpolationBuffer capacity must be between 2 and %d.",
+      WEBSG_INTERPOLATION_BUFFER_MAX_CAPACITY
+    );
+  }
+
+  if (delay < 0) {
+    return JS_ThrowRangeError(ctx, "WebSG: InterpolationBuffer delay must be non-negative.");
+  }
+
+  JSValue obj = JS_NewObjectClass(ctx, js_websg_interpolation_buffer_class_id);
+
+  if (JS_IsException(obj)) {
+    return obj;
+  }
+
+  WebSGInterpolationBufferData *buffer_data = js_mallocz(ctx, sizeof(WebSGInterpolationBufferData));
+
+  if (!buffer_data) {
+    JS_FreeValue(ctx, obj);
+    return JS_EXCEPTION;
+  }
+
+  buffer_data->size = size;
+  buffer_data->quaternion = quaternion;
+  buffer_data->capacity = capacity;
+  buffer_data->delay = delay;
+  buffer_data->times = js_mallocz(ctx, sizeof(double_t) * capacity);
+  buffer_data->values = js_mallocz(ctx, sizeof(float_t) * capacity * size);
+
+  JS_SetOpaque(obj, buffer_data);
+
+  if (!buffer_data->times || !buffer_data->values) {
+    JS_FreeValue(ctx, obj);
+    return JS_EXCEPTION;
+  }
+
+  return obj;
+}
+
+void js_websg_define_interpolation_buffer(JSContext *ctx, JSValue websg) {
+  JS_NewClassID(&js_websg_interpolation_buffer_class_id);
+  JS_NewClass(JS_GetRuntime(ctx), js_websg_interpolation_buffer_class_id, &js_websg_interpolation_buffer_class);
+  JSValue interpolation_buffer_proto = JS_NewObject(ctx);
+  JS_SetPropertyFunctionList(
+    ctx,
+    interpolation_buffer_proto,
+    js_websg_interpolation_buffer_proto_funcs,
+    countof(js_websg_interpolation_buffer_proto_funcs)
+  );
+  JS_SetClassProto(ctx, js_websg_interpolation_buffer_class_id, interpolation_buffer_proto);
+
+  JSValue constructor = JS_NewCFunction2(
+    ctx,
+    js_websg_interpolation_buffer_constructor,
+    "InterpolationBuffer",
+    1,
+    JS_CFUNC_constructor,
+    0
+  );
+  JS_SetConstructor(ctx, constructor, interpolation_buffer_proto);
+  JS_SetPropertyStr(
+    ctx,
+    websg,
+    "InterpolationBuffer",
+    constructor
+  );
+}
@@ -0,0 +1,29 @@
+#ifndef __websg_interpolation_buffer_js_h
+#define __websg_interpolation_buffer_js_h
+#include <math.h>
+#include "../quickjs/quickjs.h"
+
+#define WEBSG_INTERPOLATION_BUFFER_MAX_SIZE 16
+// bounds the sample allocations, which are sized by a script-supplied capacity
+#define WEBSG_INTERPOLATION_BUFFER_MAX_CAPACITY 1024
+
+typedef struct WebSGInterpolationBufferData {
+  // number of floats in each sample
+  uint32_t size;
+  // samples are 4 component quaternions that are slerped instead of lerped
+  int quaternion;
+  uint32_t capacity;
+  // index of the oldest sample in the ring
+  uint32_t head;
+  uint32_t count;
+  // seconds behind the sample time that the buffer is rendered at
+  double_t delay;
+  double_t *times;
+  float_t *values;
+} WebSGInterpolationBufferData;
+
+extern JSClassID js_websg_interpolation_buffer_class_id;
+
+void js_websg_define_interpolation_buffer(JSContext *ctx, JSValue websg);
+
+#endif
@@ -2,9 +2,11 @@
 #include "../quickjs/cutils.h"
 #include "../quickjs/quickjs.h"
 #include "../../websg.h"
+#include "./command-buffer.h"
 #include "./websg-js.h"
 #include "./light.h"
 #include "./rgb.h"
+#include "./props.h"
 #include "../utils/array.h"
 
 JSClassID js_websg_light_class_id;
@@ -49,7 +51,7 @@ static JSClassDef js_websg_light_class = {
 static JSValue js_websg_light_get_intensity(JSContext *ctx, JSValueConst this_val) {
  WebSGLightData *light_data = JS_GetOpaque(this_val, js_websg_light_class_id);
 
-  float_t result = websg_light_get_intensity(light_data->light_id);
+  float_t result = js_websg_command_light_get_intensity(light_data->light_id);
 
   return JS_NewFloat64(ctx, result);
 }
@@ -63,7 +65,7 @@ static JSValue js_websg_light_set_intensity(JSContext *ctx, JSValueConst this_va
     return JS_EXCEPTION;
   }
 
-  int32_t result = websg_light_set_intensity(light_data->light_id, (float_t)value);
+  int32_t result = js_websg_command_light_set_intensity(light_data->light_id, (float_t)value);
 
   if (result == -1) {
     JS_ThrowInternalError(ctx, "WebSG: Error setting intensity.");
@@ -128,9 +130,9 @@ JSValue js_websg_new_light_instance(JSContext *ctx, WebSGWorldData *world_data,
     light,
     "color",
     light_id,
-    &websg_light_get_color_element,
-    &websg_light_set_color_element,
-    &websg_light_set_color
+    &js_websg_command_light_get_color_element,
+    &js_websg_command_light_set_color_element,
+    &js_websg_command_light_set_color
   );
 
   WebSGLightData *light_data = js_mallocz(ctx, sizeof(WebSGLightData));
@@ -164,6 +166,10 @@ JSValue js_websg_get_light_by_id(JSContext *ctx, WebSGWorldData *world_data, lig
 JSValue js_websg_world_create_light(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
 
+  if (js_websg_check_props(ctx, argv[0], "props") < 0) {
+    return JS_EXCEPTION;
+  }
+
   LightProps *props = js_mallocz(ctx, sizeof(LightProps));
   props->color[0] = 1.0f;
   props->color[1] = 1.0f;
@@ -171,7 +177,11 @@ JSValue js_websg_world_create_light(JSContext *ctx, JSValueConst this_val, int a
   props->intensity = 1.0f;
   props->range = 1.0f;
 
-  props->type = get_light_type_from_atom(JS_ValueToAtom(ctx, argv[0]));
+  JSValue type_val = JS_WEBSG_GET_PROP(ctx, argv[0], type);
+  JSAtom type_atom = JS_ValueToAtom(ctx, type_val);
+  JS_FreeValue(ctx, type_val);
+  props->type = get_light_type_from_atom(type_atom);
+  JS_FreeAtom(ctx, type_atom);
 
   if (props->type == -1) {
     js_free(ctx, props);
@@ -179,7 +189,7 @@ JSValue js_websg_world_create_light(JSContext *ctx, JSValueConst this_val, int a
     return JS_EXCEPTION;
   }
 
-  JSValue name_val = JS_GetPropertyStr(ctx, argv[0], "name");
+  JSValue name_val = JS_WEBSG_GET_PROP(ctx, argv[0], name);
 
   if (!JS_IsUndefined(name_val)) {
     props->name = JS_ToCString(ctx, name_val);
@@ -190,7 +200,7 @@ JSValue js_websg_world_create_light(JSContext *ctx, JSValueConst this_val, int a
     }
   }
 
-  JSValue color_val = JS_GetPropertyStr(ctx, argv[0], "color");
+  JSValue color_val = JS_WEBSG_GET_PROP(ctx, argv[0], color);
 
   if (!JS_IsUndefined(color_val)) {
     if (js_get_float_array_like(ctx, color_val, props->color, 3) < 0) {
@@ -199,7 +209,7 @@ JSValue js_websg_world_create_light(JSContext *ctx, JSValueConst this_val, int a
     }
   }
 
-  JSValue intensity_val = JS_GetPropertyStr(ctx, argv[0], "intensity");
+  JSValue intensity_val = JS_WEBSG_GET_PROP(ctx, argv[0], intensity);
 
   if (!JS_IsUndefined(intensity_val)) {
     double intensity;
@@ -212,7 +222,7 @@ JSValue js_websg_world_create_light(JSContext *ctx, JSValueConst this_val, int a
     props->intensity = (float_t)intensity;
   }
 
-  JSValue range_val = JS_GetPropertyStr(ctx, argv[0], "range");
+  JSValue range_val = JS_WEBSG_GET_PROP(ctx, argv[0], range);
 
   if (!JS_IsUndefined(range_val)) {
     double range;
@@ -226,7 +236,7 @@ JSValue js_websg_world_create_light(JSContext *ctx, JSValueConst this_val, int a
   }
 
   if (props->type == LightType_Spot) {
-    JSValue inner_cone_angle_val = JS_GetPropertyStr(ctx, argv[0], "innerConeAngle");
+    JSValue inner_cone_angle_val = JS_WEBSG_GET_PROP(ctx, argv[0], innerConeAngle);
 
     if (!JS_IsUndefined(inner_cone_angle_val)) {
       double inner_cone_angle;
@@ -239,7 +249,7 @@ JSValue js_websg_world_create_light(JSContext *ctx, JSValueConst this_val, int a
       props->spot.inner_cone_angle = (float_t)inner_cone_angle;
     }
 
-    JSValue outer_cone_angle_val = JS_GetPropertyStr(ctx, argv[0], "outerConeAngle");
+    JSValue outer_cone_angle_val = JS_WEBSG_GET_PROP(ctx, argv[0], outerConeAngle);
 
     if (!JS_IsUndefined(outer_cone_angle_val)) {
       double outer_cone_angle;
@@ -2,10 +2,12 @@
 #include "../quickjs/cutils.h"
 #include "../quickjs/quickjs.h"
 #include "../../websg.h"
+#include "./command-buffer.h"
 #include "./material.h"
 #include "./rgba.h"
 #include "./rgb.h"
 #include "./texture.h"
+#include "./props.h"
 #include "../utils/array.h"
 
 JSClassID js_websg_material_class_id;
@@ -170,9 +172,9 @@ JSValue js_websg_new_material_instance(JSContext *ctx, WebSGWorldData *world_dat
     material,
     "baseColorFactor",
     material_id,
-    &websg_material_get_base_color_factor_element,
-    &websg_material_set_base_color_factor_element,
-    &websg_material_set_base_color_factor
+    &js_websg_command_material_get_base_color_factor_element,
+    &js_websg_command_material_set_base_color_factor_element,
+    &js_websg_command_material_set_base_color_factor
   );
 
   js_websg_define_rgb_prop(
@@ -214,13 +216,17 @@ JSValue js_websg_get_material_by_id(JSContext *ctx, WebSGWorldData *world_data,
 JSValue js_websg_world_create_unlit_material(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
 
+  if (js_websg_check_props(ctx, argv[0], "props") < 0) {
+    return JS_EXCEPTION;
+  }
+
   MaterialProps *props = js_mallocz(ctx, sizeof(MaterialProps));
   props->extensions.count = 1;
   props->extensions.items = js_mallocz(ctx, sizeof(ExtensionItem));
   props->extensions.items[0].name = strdup("KHR_materials_unlit");
   props->extensions.items[0].extension = NULL;
 
-  JSValue name_val = JS_GetPropertyStr(ctx, argv[0], "name");
+  JSValue name_val = JS_WEBSG_GET_PROP(ctx, argv[0], name);
 
   if (!JS_IsUndefined(name_val)) {
     props->name = JS_ToCString(ctx, name_val);
@@ -234,7 +240,7 @@ JSValue js_websg_world_create_unlit_material(JSContext *ctx, JSValueConst this_v
   MaterialPbrMetallicRoughnessProps *pbr = js_mallocz(ctx, sizeof(MaterialPbrMetallicRoughnessProps));
   props->pbr_metallic_roughness = pbr;
 
-  JSValue base_color_factor_val = JS_GetPropertyStr(ctx, argv[0], "baseColorFactor");
+  JSValue base_color_factor_val = JS_WEBSG_GET_PROP(ctx, argv[0], baseColorFactor);
 
   if (!JS_IsUndefined(base_color_factor_val)) {
     if (js_get_float_array_like(ctx, base_color_factor_val, pbr->base_color_factor, 4) < 0) {
@@ -247,7 +253,7 @@ JSValue js_websg_world_create_unlit_material(JSContext *ctx, JSValueConst this_v
     pbr->base_color_factor[3] = 1.0f;
   }
 
-  JSValue base_color_texture_val = JS_GetPropertyStr(ctx, argv[0], "baseColorTexture");
+  JSValue base_color_texture_val = JS_WEBSG_GET_PROP(ctx, argv[0], baseColorTexture);
 
   if (!JS_IsUndefined(base_color_texture_val)) {
     WebSGTextureData *base_color_texture_data = JS_GetOpaque2(ctx, base_color_texture_val, js_websg_texture_class_id);
@@ -259,7 +265,7 @@ JSValue js_websg_world_create_unlit_material(JSContext *ctx, JSValueConst this_v
     pbr->base_color_texture->texture = base_color_texture_data->texture_id;
   }
 
-  JSValue double_sided_val = JS_GetPropertyStr(ctx, argv[0], "doubleSided");
+  JSValue double_sided_val = JS_WEBSG_GET_PROP(ctx, argv[0], doubleSided);
 
   if (!JS_IsUndefined(double_sided_val)) {
     int result = JS_ToBool(ctx, double_sided_val);
@@ -271,7 +277,7 @@ JSValue js_websg_world_create_unlit_material(JSContext *ctx, JSValueConst this_v
     props->double_sided = result;
   }
 
-  JSValue alpha_cutoff_val = JS_GetPropertyStr(ctx, argv[0], "alphaCutoff");
+  JSValue alpha_cutoff_val = JS_WEBSG_GET_PROP(ctx, argv[0], alphaCutoff);
 
   if (!JS_IsUndefined(alpha_cutoff_val)) {
     double alpha_cutoff;
@@ -285,7 +291,7 @@ JSValue js_websg_world_create_unlit_material(JSContext *ctx, JSValueConst this_v
     props->alpha_cutoff = 0.5f;
   }
 
-  JSValue alpha_mode_val = JS_GetPropertyStr(ctx, argv[0], "alphaMode");
+  JSValue alpha_mode_val = JS_WEBSG_GET_PROP(ctx, argv[0], alphaMode);
 
   if (!JS_IsUndefined(alpha_mode_val)) {
     MaterialAlphaMode alpha_mode = get_alpha_mode_from_atom(JS_ValueToAtom(ctx, alpha_mode_val));
@@ -321,9 +327,13 @@ JSValue js_websg_world_create_unlit_material(JSContext *ctx, JSValueConst this_v
 JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
 
+  if (js_websg_check_props(ctx, argv[0], "props") < 0) {
+    return JS_EXCEPTION;
+  }
+
   MaterialProps *props = js_mallocz(ctx, sizeof(MaterialProps));
 
-  JSValue name_val = JS_GetPropertyStr(ctx, argv[0], "name");
+  JSValue name_val = JS_WEBSG_GET_PROP(ctx, argv[0], name);
 
   if (!JS_IsUndefined(name_val)) {
     props->name = JS_ToCString(ctx, name_val);
@@ -334,7 +344,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     }
   }
 
-  JSValue double_sided_val = JS_GetPropertyStr(ctx, argv[0], "doubleSided");
+  JSValue double_sided_val = JS_WEBSG_GET_PROP(ctx, argv[0], doubleSided);
 
   if (!JS_IsUndefined(double_sided_val)) {
     int result = JS_ToBool(ctx, double_sided_val);
@@ -347,7 +357,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     props->double_sided = result;
   }
 
-  JSValue alpha_cutoff_val = JS_GetPropertyStr(ctx, argv[0], "alphaCutoff");
+  JSValue alpha_cutoff_val = JS_WEBSG_GET_PROP(ctx, argv[0], alphaCutoff);
 
   if (!JS_IsUndefined(alpha_cutoff_val)) {
     double alpha_cutoff;
@@ -362,7 +372,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     props->alpha_cutoff = 0.5f;
   }
 
-  JSValue alpha_mode_val = JS_GetPropertyStr(ctx, argv[0], "alphaMode");
+  JSValue alpha_mode_val = JS_WEBSG_GET_PROP(ctx, argv[0], alphaMode);
 
   if (!JS_IsUndefined(alpha_mode_val)) {
     MaterialAlphaMode alpha_mode = get_alpha_mode_from_atom(JS_ValueToAtom(ctx, alpha_mode_val));
@@ -379,7 +389,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
   MaterialPbrMetallicRoughnessProps *pbr = js_mallocz(ctx, sizeof(MaterialPbrMetallicRoughnessProps));
   props->pbr_metallic_roughness = pbr;
 
-  JSValue base_color_factor_val = JS_GetPropertyStr(ctx, argv[0], "baseColorFactor");
+  JSValue base_color_factor_val = JS_WEBSG_GET_PROP(ctx, argv[0], baseColorFactor);
 
   if (!JS_IsUndefined(base_color_factor_val)) {
     if (js_get_float_array_like(ctx, base_color_factor_val, pbr->base_color_factor, 4) < 0) {
@@ -393,7 +403,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     pbr->base_color_factor[3] = 1.0f;
   }
 
-  JSValue base_color_texture_val = JS_GetPropertyStr(ctx, argv[0], "baseColorTexture");
+  JSValue base_color_texture_val = JS_WEBSG_GET_PROP(ctx, argv[0], baseColorTexture);
 
   if (!JS_IsUndefined(base_color_texture_val)) {
     WebSGTextureData *base_color_texture_data = JS_GetOpaque2(ctx, base_color_texture_val, js_websg_texture_class_id);
@@ -408,7 +418,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     pbr->base_color_texture = base_color_texture;
   }
 
-  JSValue metallic_factor_val = JS_GetPropertyStr(ctx, argv[0], "metallicFactor");
+  JSValue metallic_factor_val = JS_WEBSG_GET_PROP(ctx, argv[0], metallicFactor);
 
   if (!JS_IsUndefined(metallic_factor_val)) {
     double metallic_factor;
@@ -423,7 +433,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     pbr->metallic_factor = 1.0f;
   }
 
-  JSValue roughness_factor_val = JS_GetPropertyStr(ctx, argv[0], "roughnessFactor");
+  JSValue roughness_factor_val = JS_WEBSG_GET_PROP(ctx, argv[0], roughnessFactor);
 
   if (!JS_IsUndefined(roughness_factor_val)) {
     double roughness_factor;
@@ -438,7 +448,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     pbr->roughness_factor = 1.0f;
   }
 
-  JSValue metallic_roughness_texture_val = JS_GetPropertyStr(ctx, argv[0], "metallicRoughnessTexture");
+  JSValue metallic_roughness_texture_val = JS_WEBSG_GET_PROP(ctx, argv[0], metallicRoughnessTexture);
 
   if (!JS_IsUndefined(metallic_roughness_texture_val)) {
     WebSGTextureData *metallic_roughness_texture_data = JS_GetOpaque2(ctx, metallic_roughness_texture_val, js_websg_texture_class_id);
@@ -453,7 +463,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     pbr->metallic_roughness_texture = metallic_roughness_texture;
   }
 
-  JSValue normal_texture_val = JS_GetPropertyStr(ctx, argv[0], "normalTexture");
+  JSValue normal_texture_val = JS_WEBSG_GET_PROP(ctx, argv[0], normalTexture);
 
   if (!JS_IsUndefined(normal_texture_val)) {
     WebSGTextureData *normal_texture_data = JS_GetOpaque2(ctx, normal_texture_val, js_websg_texture_class_id);
@@ -466,7 +476,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     MaterialNormalTextureInfoProps *normal_texture = js_mallocz(ctx, sizeof(MaterialNormalTextureInfoProps));
     normal_texture->texture = normal_texture_data->texture_id;
 
-    JSValue normal_scale_val = JS_GetPropertyStr(ctx, argv[0], "normalScale");
+    JSValue normal_scale_val = JS_WEBSG_GET_PROP(ctx, argv[0], normalScale);
 
     if (!JS_IsUndefined(normal_scale_val)) {
       double normal_scale;
@@ -484,7 +494,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     props->normal_texture = normal_texture;
   }
 
-  JSValue occlusion_texture_val = JS_GetPropertyStr(ctx, argv[0], "occlusionTexture");
+  JSValue occlusion_texture_val = JS_WEBSG_GET_PROP(ctx, argv[0], occlusionTexture);
 
   if (!JS_IsUndefined(occlusion_texture_val)) {
     WebSGTextureData *occlusion_texture_data = JS_GetOpaque2(ctx, occlusion_texture_val, js_websg_texture_class_id);
@@ -497,7 +507,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     MaterialOcclusionTextureInfoProps *occlusion_texture = js_mallocz(ctx, sizeof(MaterialOcclusionTextureInfoProps));
     occlusion_texture->texture = occlusion_texture_data->texture_id;
 
-    JSValue occlusion_strength_val = JS_GetPropertyStr(ctx, argv[0], "occlusionStrength");
+    JSValue occlusion_strength_val = JS_WEBSG_GET_PROP(ctx, argv[0], occlusionStrength);
 
     if (!JS_IsUndefined(occlusion_strength_val)) {
       double occlusion_strength;
@@ -515,7 +525,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     props->occlusion_texture = occlusion_texture;
   }
 
-  JSValue emissive_factor_val = JS_GetPropertyStr(ctx, argv[0], "emissiveFactor");
+  JSValue emissive_factor_val = JS_WEBSG_GET_PROP(ctx, argv[0], emissiveFactor);
 
   if (!JS_IsUndefined(emissive_factor_val)) {
     if (js_get_float_array_like(ctx, emissive_factor_val, props->emissive_factor, 3) < 0) {
@@ -528,7 +538,7 @@ JSValue js_websg_world_create_material(JSContext *ctx, JSValueConst this_val, in
     props->emissive_factor[2] = 0.0f;
   }
 
-  JSValue emissive_texture_val = JS_GetPropertyStr(ctx, argv[0], "emissiveTexture");
+  JSValue emissive_texture_val = JS_WEBSG_GET_PROP(ctx, argv[0], emissiveTexture);
 
   if (!JS_IsUndefined(emissive_texture_val)) {
     WebSGTextureData *emissive_texture_data = JS_GetOpaque2(ctx, emissive_texture_val, js_websg_texture_class_id);
@@ -6,6 +6,7 @@
 #include "./mesh-primitive.h"
 #include "./accessor.h"
 #include "./material.h"
+#include "./props.h"
 #include "../utils/array.h"
 
 JSClassID js_websg_mesh_class_id;
@@ -118,7 +119,7 @@ JSValue js_websg_world_create_mesh(JSContext *ctx, JSValueConst this_val, int ar
 
   MeshProps *props = js_mallocz(ctx, sizeof(MeshProps));
 
-  JSValue name_val = JS_GetPropertyStr(ctx, argv[0], "name");
+  JSValue name_val = JS_WEBSG_GET_PROP(ctx, argv[0], name);
 
   if (!JS_IsUndefined(name_val)) {
     props->name = JS_ToCString(ctx, name_val);
@@ -130,7 +131,7 @@ JSValue js_websg_world_create_mesh(JSContext *ctx, JSValueConst this_val, int ar
   }
 
   // TODO: Parse primitives array
-  JSValue primitives_arr = JS_GetPropertyStr(ctx, argv[0], "primitives");
+  JSValue primitives_arr = JS_WEBSG_GET_PROP(ctx, argv[0], primitives);
 
   if (JS_IsUndefined(primitives_arr)) {
     JS_ThrowTypeError(ctx, "WebSG: Mesh must have at least one primitive.");
@@ -143,7 +144,7 @@ JSValue js_websg_world_create_mesh(JSContext *ctx, JSValueConst this_val, int ar
     return JS_EXCEPTION;
   }
 
-  JSValue length_arr = JS_GetPropertyStr(ctx, primitives_arr, "length");
+  JSValue length_arr = JS_WEBSG_GET_PROP(ctx, primitives_arr, length);
 
   if (JS_IsException(length_arr)) {
     js_free(ctx, props);
@@ -171,7 +172,7 @@ JSValue js_websg_world_create_mesh(JSContext *ctx, JSValueConst this_val, int ar
 
     MeshPrimitiveProps *primitive_props = &primitives[i];
 
-    JSValue modeVal = JS_GetPropertyStr(ctx, primitive_obj, "mode");
+    JSValue modeVal = JS_WEBSG_GET_PROP(ctx, primitive_obj, mode);
 
     uint32_t mode;
 
@@ -186,7 +187,7 @@ JSValue js_websg_world_create_mesh(JSContext *ctx, JSValueConst this_val, int ar
       primitive_props->mode = MeshPrimitiveMode_TRIANGLES;
     }
 
-    JSValue indices_val = JS_GetPropertyStr(ctx, primitive_obj, "indices");
+    JSValue indices_val = JS_WEBSG_GET_PROP(ctx, primitive_obj, indices);
 
     if (!JS_IsUndefined(indices_val)) {
       WebSGAccessorData *indices_data = JS_GetOpaque2(ctx, indices_val, js_websg_accessor_class_id);
@@ -199,7 +200,7 @@ JSValue js_websg_world_create_mesh(JSContext *ctx, JSValueConst this_val, int ar
       primitive_props->indices = indices_data->accessor_id;
     }
 
-    JSValue material_val = JS_GetPropertyStr(ctx, primitive_obj, "material");
+    JSValue material_val = JS_WEBSG_GET_PROP(ctx, primitive_obj, material);
 
     if (!JS_IsUndefined(material_val)) {
        WebSGMaterialData *material_data = JS_GetOpaque2(ctx, material_val, js_websg_material_class_id);
@@ -212,7 +213,7 @@ JSValue js_websg_world_create_mesh(JSContext *ctx, JSValueConst this_val, int ar
       primitive_props->material = material_data->material_id;
     }
 
-    JSValue attributes_obj = JS_GetPropertyStr(ctx, primitive_obj, "attributes");
+    JSValue attributes_obj = JS_WEBSG_GET_PROP(ctx, primitive_obj, attributes);
 
     if (!JS_IsUndefined(attributes_obj)) {
       JSPropertyEnum *attribute_props;
@@ -304,7 +305,7 @@ JSValue js_websg_world_create_box_mesh(JSContext *ctx, JSValueConst this_val, in
 
   BoxMeshProps *props = js_mallocz(ctx, sizeof(BoxMeshProps));
 
-  JSValue size_val = JS_GetPropertyStr(ctx, argv[0], "size");
+  JSValue size_val = JS_WEBSG_GET_PROP(ctx, argv[0], size);
 
   if (!JS_IsUndefined(size_val)) {
     if (js_get_float_array_like(ctx, size_val, props->size, 3) < 0) {
@@ -312,7 +313,7 @@ JSValue js_websg_world_create_box_mesh(JSContext *ctx, JSValueConst this_val, in
     }
   }
 
-   JSValue segments_val = JS_GetPropertyStr(ctx, argv[0], "segments");
+   JSValue segments_val = JS_WEBSG_GET_PROP(ctx, argv[0], segments);
 
   if (!JS_IsUndefined(segments_val)) {
     if (js_get_int_array_like(ctx, segments_val, props->segments, 3) < 0) {
@@ -320,7 +321,7 @@ JSValue js_websg_world_create_box_mesh(JSContext *ctx, JSValueConst this_val, in
     }
   }
 
-  JSValue material_val = JS_GetPropertyStr(ctx, argv[0], "material");
+  JSValue material_val = JS_WEBSG_GET_PROP(ctx, argv[0], material);
 
   if (!JS_IsUndefined(material_val)) {
       WebSGMaterialData *material_data = JS_GetOpaque2(ctx, material_val, js_websg_material_class_id);
@@ -2,6 +2,7 @@
 #include "../quickjs/cutils.h"
 #include "../quickjs/quickjs.h"
 #include "../../websg.h"
+#include "./command-buffer.h"
 #include "./node.h"
 #include "./scene.h"
 #include "./mesh.h"
@@ -9,13 +10,16 @@
 #include "./collider.h"
 #include "./interactable.h"
 #include "./physics-body.h"
+#include "./character-controller.h"
 #include "./node-iterator.h"
 #include "./vector3.h"
 #include "./quaternion.h"
 #include "./matrix4.h"
 #include "./ui-canvas.h"
 #include "./component-store.h"
+#include "./props.h"
 #include "../utils/array.h"
+#include "../utils/typedarray.h"
 
 JSClassID js_websg_node_class_id;
 
@@ -25,6 +29,7 @@ static void js_websg_node_finalizer(JSRuntime *rt, JSValue val) {
   if (node_data) {
     JS_FreeValueRT(rt, node_data->interactable);
     JS_FreeValueRT(rt, node_data->physics_body);
+    JS_FreeValueRT(rt, node_data->character_controller);
     js_free_rt(rt, node_data);
   }
 }
@@ -114,6 +119,8 @@ JSValue js_websg_node_children(JSContext *ctx, JSValueConst this_val, int argc,
 JSValue js_websg_node_dispose(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGNodeData *node_data = JS_GetOpaque(this_val, js_websg_node_class_id);
 
+  js_websg_flush_commands();
+
   if (websg_node_dispose(node_data->node_id) == -1) {
     JS_ThrowInternalError(ctx, "WebSG: Couldn't set collider.");
     return JS_EXCEPTION;
@@ -142,6 +149,11 @@ static JSValue js_websg_node_parent(JSContext *ctx, JSValueConst this_val) {
   return JS_UNDEFINED;
 }
 
+static JSValue js_websg_node_get_id(JSContext *ctx, JSValueConst this_val) {
+  WebSGNodeData *node_data = JS_GetOpaque(this_val, js_websg_node_class_id);
+  return JS_NewUint32(ctx, node_data->node_id);
+}
+
 static JSValue js_websg_node_get_is_static(JSContext *ctx, JSValueConst this_val) {
   WebSGNodeData *node_data = JS_GetOpaque(this_val, js_websg_node_class_id);
   uint32_t result = websg_node_get_is_static(node_data->node_id);
@@ -169,7 +181,7 @@ static JSValue js_websg_node_set_is_static(JSContext *ctx, JSValueConst this_val
 
 static JSValue js_websg_node_get_visible(JSContext *ctx, JSValueConst this_val) {
   WebSGNodeData *node_data = JS_GetOpaque(this_val, js_websg_node_class_id);
-  uint32_t result = websg_node_get_visible(node_data->node_id);
+  uint32_t result = js_websg_command_node_get_visible(node_data->node_id);
   return JS_NewBool(ctx, result);
 }
 
@@ -182,7 +194,7 @@ static JSValue js_websg_node_set_visible(JSContext *ctx, JSValueConst this_val,
     return JS_EXCEPTION;
   }
 
-  int32_t result = websg_node_set_visible(node_data->node_id, value);
+  int32_t result = js_websg_command_node_set_visible(node_data->node_id, value);
 
   if (result == -1) {
     JS_ThrowInternalError(ctx, "WebSG: Error setting visible.");
@@ -292,7 +304,7 @@ static JSValue js_websg_node_start_orbit(JSContext *ctx, JSValueConst this_val,
 
   if (!JS_IsUndefined(argv[0])) { 
 
-    JSValue pitch_val = JS_GetPropertyStr(ctx, argv[0], "pitch");
+    JSValue pitch_val = JS_WEBSG_GET_PROP(ctx, argv[0], pitch);
     if (!JS_IsUndefined(pitch_val)) {
       double_t pitch;
       if (JS_ToFloat64(ctx, &pitch, pitch_val) == -1) {
@@ -301,7 +313,7 @@ static JSValue js_websg_node_start_orbit(JSContext *ctx, JSValueConst this_val,
       options->pitch = (float_t)pitch;
     }
 
-    JSValue yaw_val = JS_GetPropertyStr(ctx, argv[0], "yaw");
+    JSValue yaw_val = JS_WEBSG_GET_PROP(ctx, argv[0], yaw);
     if (!JS_IsUndefined(yaw_val)) {
       double_t yaw;
       if (JS_ToFloat64(ctx, &yaw, yaw_val) == -1) {
@@ -310,7 +322,7 @@ static JSValue js_websg_node_start_orbit(JSContext *ctx, JSValueConst this_val,
       options->yaw = (float_t)yaw;
     }
 
-    JSValue zoom_val = JS_GetPropertyStr(ctx, argv[0], "zoom");
+    JSValue zoom_val = JS_WEBSG_GET_PROP(ctx, argv[0], zoom);
     if (!JS_IsUndefined(zoom_val)) {
       double_t zoom;
       if (JS_ToFloat64(ctx, &zoom, zoom_val) == -1) {
@@ -321,6 +333,8 @@ static JSValue js_websg_node_start_orbit(JSContext *ctx, JSValueConst this_val,
 
   }
 
+  js_websg_flush_commands();
+
   if (websg_node_start_orbit(node_data->node_id, options) == -1) {
     js_free(ctx, options);
     JS_ThrowInternalError(ctx, "WebSG: Error starting orbit.");
@@ -410,6 +424,8 @@ static JSValue js_websg_node_set_forward_direction(JSContext *ctx, JSValueConst
     return JS_EXCEPTION;
   }
 
+  js_websg_flush_commands();
+
   if (websg_node_set_forward_direction(node_data->node_id, direction) == -1) {
     js_free(ctx, direction);
     JS_ThrowInternalError(ctx, "WebSG: Couldn't set forward direction.");
@@ -429,6 +445,7 @@ static const JSCFunctionListEntry js_websg_node_proto_funcs[] = {
   JS_CFUNC_DEF("children", 0, js_websg_node_children),
   JS_CFUNC_DEF("dispose", 0, js_websg_node_dispose),
   JS_CGETSET_DEF("parent", js_websg_node_parent, NULL),
+  JS_CGETSET_DEF("id", js_websg_node_get_id, NULL),
   JS_CGETSET_DEF("isStatic", js_websg_node_get_is_static, js_websg_node_set_is_static),
   JS_CGETSET_DEF("visible", js_websg_node_get_visible, js_websg_node_set_visible),
   JS_CGETSET_DEF("mesh", js_websg_node_get_mesh, js_websg_node_set_mesh),
@@ -441,6 +458,9 @@ static const JSCFunctionListEntry js_websg_node_proto_funcs[] = {
   JS_CGETSET_DEF("physicsBody", js_websg_node_get_physics_body, NULL),
   JS_CFUNC_DEF("addPhysicsBody", 1, js_websg_node_add_physics_body),
   JS_CFUNC_DEF("removePhysicsBody", 0, js_websg_node_remove_physics_body),
+  JS_CGETSET_DEF("characterController", js_websg_node_get_character_controller, NULL),
+  JS_CFUNC_DEF("addCharacterController", 1, js_websg_node_add_character_controller),
+  JS_CFUNC_DEF("removeCharacterController", 0, js_websg_node_remove_character_controller),
   JS_CFUNC_DEF("startOrbit", 1, js_websg_node_start_orbit),
   JS_CFUNC_DEF("addComponent", 1, js_websg_node_add_component),
   JS_CFUNC_DEF("removeComponent", 1, js_websg_node_remove_component),
@@ -490,9 +510,9 @@ JSValue js_websg_new_node_instance(JSContext *ctx, WebSGWorldData *world_data, n
     node,
     "translation",
     node_id,
-    &websg_node_get_translation_element,
-    &websg_node_set_translation_element,
-    &websg_node_set_translation
+    &js_websg_command_node_get_translation_element,
+    &js_websg_command_node_set_translation_element,
+    &js_websg_command_node_set_translation
   );
 
   js_websg_define_quaternion_prop(
@@ -500,9 +520,9 @@ JSValue js_websg_new_node_instance(JSContext *ctx, WebSGWorldData *world_data, n
     node,
     "rotation",
     node_id,
-    &websg_node_get_rotation_element,
-    &websg_node_set_rotation_element,
-    &websg_node_set_rotation
+    &js_websg_command_node_get_rotation_element,
+    &js_websg_command_node_set_rotation_element,
+    &js_websg_command_node_set_rotation
   );
 
   js_websg_define_vector3_prop(
@@ -510,9 +530,9 @@ JSValue js_websg_new_node_instance(JSContext *ctx, WebSGWorldData *world_data, n
     node,
     "scale",
     node_id,
-    &websg_node_get_scale_element,
-    &websg_node_set_scale_element,
-    &websg_node_set_scale
+    &js_websg_command_node_get_scale_element,
+    &js_websg_command_node_set_scale_element,
+    &js_websg_command_node_set_scale
   );
 
   js_websg_define_matrix4_prop(
@@ -520,9 +540,9 @@ JSValue js_websg_new_node_instance(JSContext *ctx, WebSGWorldData *world_data, n
     node,
     "matrix",
     node_id,
-    &websg_node_get_matrix_element,
-    &websg_node_set_matrix_element,
-    &websg_node_set_matrix
+    &js_websg_command_node_get_matrix_element,
+    &js_websg_command_node_set_matrix_element,
+    &js_websg_command_node_set_matrix
   );
 
   js_websg_define_matrix4_prop_read_only(
@@ -530,7 +550,7 @@ JSValue js_websg_new_node_instance(JSContext *ctx, WebSGWorldData *world_data, n
     node,
     "worldMatrix",
     node_id,
-    &websg_node_get_world_matrix_element
+    &js_websg_command_node_get_world_matrix_element
   );
 
   WebSGNodeData *node_data = js_mallocz(ctx, sizeof(WebSGNodeData));
@@ -539,6 +559,7 @@ JSValue js_websg_new_node_instance(JSContext *ctx, WebSGWorldData *world_data, n
   node_data->component_store_index = websg_node_get_component_store_index(node_id);
   node_data->interactable = js_websg_init_node_interactable(ctx, node_id);
   node_data->physics_body = js_websg_init_node_physics_body(ctx, node_id);
+  node_data->character_controller = JS_UNDEFINED;
   JS_SetOpaque(node, node_data);
 
   JS_SetPropertyUint32(ctx, world_data->nodes, node_id, JS_DupValue(ctx, node));
@@ -560,6 +581,78 @@ JSValue js_websg_get_node_by_id(JSContext *ctx, WebSGWorldData *world_data, node
   return js_websg_new_node_instance(ctx, world_data, node_id);
 }
 
+// node id queries with up to this many results don't allocate when returning nodes
+#define NODE_ID_QUERY_RESULTS_SIZE 64
+
+JSValue js_websg_run_node_id_query(
+  JSContext *ctx,
+  WebSGWorldData *world_data,
+  WebSGNodeIdQuery query,
+  void *query_data,
+  JSValueConst out_val,
+  const char *error_message
+) {
+  if (!JS_IsUndefined(out_val)) {
+    size_t length;
+    uint32_t *out = get_uint32_array_view(ctx, out_val, &length);
+
+    if (out == NULL) {
+      return JS_EXCEPTION;
+    }
+
+    int32_t count = query(query_data, out, length);
+
+    if (count == -1) {
+      JS_ThrowInternalError(ctx, "WebSG: %s", error_message);
+      return JS_EXCEPTION;
+    }
+
+    return JS_NewInt32(ctx, count);
+  }
+
+  node_id_t stack_results[NODE_ID_QUERY_RESULTS_SIZE];
+  node_id_t *results = stack_results;
+
+  int32_t count = query(query_data, results, NODE_ID_QUERY_RESULTS_SIZE);
+
+  // the query returns the total count, repeat it with a buffer big enough for every result
+  if (count > NODE_ID_QUERY_RESULTS_SIZE) {
+    results = js_malloc(ctx, sizeof(node_id_t) * count);
+
+    if (results == NULL) {
+      return JS_EXCEPTION;
+    }
+
+    uint32_t max_count = count;
+    count = query(query_data, results, max_count);
+
+    if (count > (int32_t)max_count) {
+      count = max_count;
+    }
+  }
+
+  if (count == -1) {
+    if (results != stack_results) {
+      js_free(ctx, results);
+    }
+
+    JS_ThrowInternalError(ctx, "WebSG: %s", error_message);
+    return JS_EXCEPTION;
+  }
+
+  JSValue nodes = JS_NewArray(ctx);
+
+  for (int32_t i = 0; i < count; i++) {
+    JS_SetPropertyUint32(ctx, nodes, i, js_websg_get_node_by_id(ctx, world_data, results[i]));
+  }
+
+  if (results != stack_results) {
+    js_free(ctx, results);
+  }
+
+  return nodes;
+}
+
 /**
  * World Methods
  **/
@@ -577,9 +670,14 @@ JSValue js_websg_world_create_node(JSContext *ctx, JSValue this_val, int argc, J
   props->scale[2] = 1.0f;
 
   if (!JS_IsUndefined(argv[0])) {
+    if (js_websg_check_props(ctx, argv[0], "props") < 0) {
+      js_free(ctx, props);
+      return JS_EXCEPTION;
+    }
+
     uint32_t extension_count = 0;
 
-    JSValue name_val = JS_GetPropertyStr(ctx, argv[0], "name");
+    JSValue name_val = JS_WEBSG_GET_PROP(ctx, argv[0], name);
 
     if (!JS_IsUndefined(name_val)) {
       props->name = JS_ToCString(ctx, name_val);
@@ -590,7 +688,7 @@ JSValue js_websg_world_create_node(JSContext *ctx, JSValue this_val, int argc, J
       }
     }
 
-    JSValue mesh_val = JS_GetPropertyStr(ctx, argv[0], "mesh");
+    JSValue mesh_val = JS_WEBSG_GET_PROP(ctx, argv[0], mesh);
 
     if (!JS_IsUndefined(mesh_val)) {
       WebSGMeshData *mesh_data = JS_GetOpaque2(ctx, mesh_val, js_websg_mesh_class_id);
@@ -603,7 +701,7 @@ JSValue js_websg_world_create_node(JSContext *ctx, JSValue this_val, int argc, J
       props->mesh = mesh_data->mesh_id;
     }
 
-    JSValue collider_val = JS_GetPropertyStr(ctx, argv[0], "collider");
+    JSValue collider_val = JS_WEBSG_GET_PROP(ctx, argv[0], collider);
 
     ExtensionNodeColliderRef *collider_extension = NULL;
 
@@ -621,7 +719,7 @@ JSValue js_websg_world_create_node(JSContext *ctx, JSValue this_val, int argc, J
     }
 
 
-    JSValue ui_canvas_val = JS_GetPropertyStr(ctx, argv[0], "uiCanvas");
+    JSValue ui_canvas_val = JS_WEBSG_GET_PROP(ctx, argv[0], uiCanvas);
 
     UIExtensionNodeCanvasRef *ui_extension = NULL;
 
@@ -638,7 +736,7 @@ JSValue js_websg_world_create_node(JSContext *ctx, JSValue this_val, int argc, J
       extension_count++;
     }
 
-    JSValue translation_val = JS_GetPropertyStr(ctx, argv[0], "translation");
+    JSValue translation_val = JS_WEBSG_GET_PROP(ctx, argv[0], translation);
 
     if (!JS_IsUndefined(translation_val)) {
       if (js_get_float_array_like(ctx, translation_val, props->translation, 3) < 0) {
@@ -647,7 +745,7 @@ JSValue js_websg_world_create_node(JSContext *ctx, JSValue this_val, int argc, J
       }
     }
 
-    JSValue rotation_val = JS_GetPropertyStr(ctx, argv[0], "rotation");
+    JSValue rotation_val = JS_WEBSG_GET_PROP(ctx, argv[0], rotation);
 
     if (!JS_IsUndefined(rotation_val)) {
       if (js_get_float_array_like(ctx, rotation_val, props->rotation, 4) < 0) {
@@ -656,7 +754,7 @@ JSValue js_websg_world_create_node(JSContext *ctx, JSValue this_val, int argc, J
       }
     }
 
-    JSValue scale_val = JS_GetPropertyStr(ctx, argv[0], "scale");
+    JSValue scale_val = JS_WEBSG_GET_PROP(ctx, argv[0], scale);
 
     if (!JS_IsUndefined(scale_val)) {
       if (js_get_float_array_like(ctx, scale_val, props->scale, 3) < 0) {
@@ -12,12 +12,27 @@ typedef struct WebSGNodeData {
   uint32_t component_store_index;
   JSValue interactable;
   JSValue physics_body;
+  JSValue character_controller;
 } WebSGNodeData;
 
 void js_websg_define_node(JSContext *ctx, JSValue websg);
 
 JSValue js_websg_get_node_by_id(JSContext *ctx,  WebSGWorldData *world_data, node_id_t node_id);
 
+// Writes up to max_count node ids into results and returns the total number of nodes, or -1 on error.
+typedef int32_t (*WebSGNodeIdQuery)(void *query_data, node_id_t *results, uint32_t max_count);
+
+// Runs a node id query. If out_val is a Uint32Array the ids are written into it and the total number of nodes is
+// returned, otherwise the nodes are returned as an array.
+JSValue js_websg_run_node_id_query(
+  JSContext *ctx,
+  WebSGWorldData *world_data,
+  WebSGNodeIdQuery query,
+  void *query_data,
+  JSValueConst out_val,
+  const char *error_message
+);
+
 JSValue js_websg_world_create_node(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
 
 JSValue js_websg_world_find_node_by_name(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
@@ -0,0 +1,240 @@
+#include "../quickjs/cutils.h"
+#include "../quickjs/quickjs.h"
+#include "../../websg.h"
+#include "../utils/typedarray.h"
+#include "./websg-js.h"
+#include "./command-buffer.h"
+#include "./node.h"
+#include "./physics-body-batch.h"
+#include "./props.h"
+
+JSClassID js_websg_physics_body_batch_class_id;
+
+/**
+ * Private Methods and Variables
+ **/
+
+// returns a view of values or NULL if it isn't a Float32Array with stride floats per body
+static float_t *js_websg_get_physics_body_batch_values(
+  JSContext *ctx,
+  WebSGPhysicsBodyBatchData *batch_data,
+  JSValueConst values,
+  uint32_t stride
+) {
+  size_t length;
+  float_t *data = get_float32_array_view(ctx, values, &length);
+
+  if (data == NULL) {
+    return NULL;
+  }
+
+  if (length != (size_t)batch_data->count * stride) {
+    JS_ThrowRangeError(ctx, "WebSGPhysicsBodyBatch: Expected a Float32Array of length %u.", batch_data->count * stride);
+    return NULL;
+  }
+
+  return data;
+}
+
+/**
+ * Class Definition
+ **/
+
+static void js_websg_physics_body_batch_finalizer(JSRuntime *rt, JSValue val) {
+  WebSGPhysicsBodyBatchData *batch_data = JS_GetOpaque(val, js_websg_physics_body_batch_class_id);
+
+  if (batch_data) {
+    js_free_rt(rt, batch_data->node_ids);
+    js_free_rt(rt, batch_data);
+  }
+}
+
+static JSClassDef js_websg_physics_body_batch_class = {
+  "PhysicsBodyBatch",
+  .finalizer = js_websg_physics_body_batch_finalizer
+};
+
+static JSValue js_websg_physics_body_batch_get_length(JSContext *ctx, JSValueConst this_val) {
+  WebSGPhysicsBodyBatchData *batch_data = JS_GetOpaque(this_val, js_websg_physics_body_batch_class_id);
+  return JS_NewUint32(ctx, batch_data->count);
+}
+
+static JSValue js_websg_physics_body_batch_apply_impulses(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  WebSGPhysicsBodyBatchData *batch_data = JS_GetOpaque(this_val, js_websg_physics_body_batch_class_id);
+
+  float_t *impulses = js_websg_get_physics_body_batch_values(ctx, batch_data, argv[0], 3);
+
+  if (impulses == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  js_websg_flush_commands();
+
+  if (websg_physics_bodies_apply_impulses(batch_data->node_ids, impulses, batch_data->count) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGPhysicsBodyBatch: error applying impulses.");
+    return JS_EXCEPTION;
+  }
+
+  return JS_UNDEFINED;
+}
+
+static JSValue js_websg_physics_body_batch_get_velocities(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  WebSGPhysicsBodyBatchData *batch_data = JS_GetOpaque(this_val, js_websg_physics_body_batch_class_id);
+
+  float_t *velocities = js_websg_get_physics_body_batch_values(ctx, batch_data, argv[0], 6);
+
+  if (velocities == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  js_websg_flush_commands();
+
+  if (websg_physics_bodies_get_velocities(batch_data->node_ids, velocities, batch_data->count) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGPhysicsBodyBatch: error getting velocities.");
+    return JS_EXCEPTION;
+  }
+
+  return JS_DupValue(ctx, argv[0]);
+}
+
+static JSValue js_websg_physics_body_batch_set_velocities(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  WebSGPhysicsBodyBatchData *batch_data = JS_GetOpaque(this_val, js_websg_physics_body_batch_class_id);
+
+  float_t *velocities = js_websg_get_physics_body_batch_values(ctx, batch_data, argv[0], 6);
+
+  if (velocities == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  js_websg_flush_commands();
+
+  if (websg_physics_bodies_set_velocities(batch_data->node_ids, velocities, batch_data->count) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGPhysicsBodyBatch: error setting velocities.");
+    return JS_EXCEPTION;
+  }
+
+  return JS_UNDEFINED;
+}
+
+static const JSCFunctionListEntry js_websg_physics_body_batch_proto_funcs[] = {
+  JS_CGETSET_DEF("length", js_websg_physics_body_batch_get_length, NULL),
+  JS_CFUNC_DEF("applyImpulses", 1, js_websg_physics_body_batch_apply_impulses),
+  JS_CFUNC_DEF("getVelocities", 1, js_websg_physics_body_batch_get_velocities),
+  JS_CFUNC_DEF("setVelocities", 1, js_websg_physics_body_batch_set_velocities),
+  JS_PROP_STRING_DEF("[Symbol.toStringTag]", "PhysicsBodyBatch", JS_PROP_CONFIGURABLE),
+};
+
+static JSValue js_websg_physics_body_batch_constructor(
+  JSContext *ctx,
+  JSValueConst this_val,
+  int argc,
+  JSValueConst *argv
+) {
+  return JS_ThrowTypeError(ctx, "Illegal Constructor.");
+}
+
+void js_websg_define_physics_body_batch(JSContext *ctx, JSValue websg) {
+  JS_NewClassID(&js_websg_physics_body_batch_class_id);
+  JS_NewClass(JS_GetRuntime(ctx), js_websg_physics_body_batch_class_id, &js_websg_physics_body_batch_class);
+  JSValue physics_body_batch_proto = JS_NewObject(ctx);
+  JS_SetPropertyFunctionList(
+    ctx,
+    physics_body_batch_proto,
+    js_websg_physics_body_batch_proto_funcs,
+    countof(js_websg_physics_body_batch_proto_funcs)
+  );
+  JS_SetClassProto(ctx, js_websg_physics_body_batch_class_id, physics_body_batch_proto);
+
+  JSValue constructor = JS_NewCFunction2(
+    ctx,
+    js_websg_physics_body_batch_constructor,
+    "PhysicsBodyBatch",
+    0,
+    JS_CFUNC_constructor,
+    0
+  );
+  JS_SetConstructor(ctx, constructor, physics_body_batch_proto);
+  JS_SetPropertyStr(
+    ctx,
+    websg,
+    "PhysicsBodyBatch",
+    constructor
+  );
+}
+
+/**
+ * World Methods
+ **/
+
+JSValue js_websg_world_create_physics_body_batch(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  JSValue length_val = JS_WEBSG_GET_PROP(ctx, argv[0], length);
+
+  uint32_t count;
+  int result = JS_ToUint32(ctx, &count, length_val);
+  JS_FreeValue(ctx, length_val);
+
+  if (result == -1) {
+    return JS_EXCEPTION;
+  }
+
+  // node ids are resolved once so per frame calls don't touch the node objects
+  node_id_t *node_ids = NULL;
+
+  // js_mallocz doesn't accept a size of 0, an empty batch has no node ids
+  if (count > 0) {
+    node_ids = js_mallocz(ctx, sizeof(node_id_t) * count);
+
+    if (node_ids == NULL) {
+      return JS_EXCEPTION;
+    }
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    JSValue node_val = JS_GetPropertyUint32(ctx, argv[0], i);
+    WebSGNodeData *node_data = JS_GetOpaque2(ctx, node_val, js_websg_node_class_id);
+    JS_FreeValue(ctx, node_val);
+
+    if (node_data == NULL) {
+      js_free(ctx, node_ids);
+      return JS_EXCEPTION;
+    }
+
+    node_ids[i] = node_data->node_id;
+  }
+
+  JSValue batch = JS_NewObjectClass(ctx, js_websg_physics_body_batch_class_id);
+
+  if (JS_IsException(batch)) {
+    js_free(ctx, node_ids);
+    return batch;
+  }
+
+  WebSGPhysicsBodyBatchData *batch_data = js_mallocz(ctx, sizeof(WebSGPhysicsBodyBatchData));
+
+  if (batch_data == NULL) {
+    js_free(ctx, node_ids);
+    JS_FreeValue(ctx, batch);
+    return JS_EXCEPTION;
+  }
+
+  batch_data->node_ids = node_ids;
+  batch_data->count = count;
+  JS_SetOpaque(batch, batch_data);
+
+  return batch;
+}
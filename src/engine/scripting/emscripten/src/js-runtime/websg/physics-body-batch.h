@@ -0,0 +1,17 @@
+#ifndef __websg_physics_body_batch_js_h
+#define __websg_physics_body_batch_js_h
+#include "../../websg.h"
+#include "../quickjs/quickjs.h"
+
+typedef struct WebSGPhysicsBodyBatchData {
+  node_id_t *node_ids;
+  uint32_t count;
+} WebSGPhysicsBodyBatchData;
+
+extern JSClassID js_websg_physics_body_batch_class_id;
+
+void js_websg_define_physics_body_batch(JSContext *ctx, JSValue websg);
+
+JSValue js_websg_world_create_physics_body_batch(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+#endif
@@ -1,8 +1,10 @@
 #include "../quickjs/cutils.h"
 #include "../quickjs/quickjs.h"
 #include "../../websg.h"
+#include "./command-buffer.h"
 #include "./node.h"
 #include "./physics-body.h"
+#include "./props.h"
 #include "../utils/array.h"
 
 JSClassID js_websg_physics_body_class_id;
@@ -47,13 +49,13 @@ static JSClassDef js_websg_physics_body_class = {
 static JSValue js_websg_physics_body_apply_impulse(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGPhysicsBodyData *physics_body_data = JS_GetOpaque(this_val, js_websg_physics_body_class_id);
 
-  float_t *impulse = js_mallocz(ctx, sizeof(float_t) * 3);
+  float_t impulse[3];
 
   if (js_get_float_array_like(ctx, argv[0], impulse, 3) < 0) {
     return JS_EXCEPTION;
   }
 
-  if (websg_physics_body_apply_impulse(physics_body_data->node_id, impulse) == -1) {
+  if (js_websg_command_physics_body_apply_impulse(physics_body_data->node_id, impulse) == -1) {
     JS_ThrowInternalError(ctx, "WebSGPhysicsBody: error applying impulse.");
     return JS_EXCEPTION;
   }
@@ -61,8 +63,52 @@ static JSValue js_websg_physics_body_apply_impulse(JSContext *ctx, JSValueConst
   return JS_UNDEFINED;
 }
 
+static JSValue js_websg_physics_body_sleep(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGPhysicsBodyData *physics_body_data = JS_GetOpaque(this_val, js_websg_physics_body_class_id);
+
+  js_websg_flush_commands();
+
+  if (websg_physics_body_sleep(physics_body_data->node_id) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGPhysicsBody: error putting body to sleep.");
+    return JS_EXCEPTION;
+  }
+
+  return JS_UNDEFINED;
+}
+
+static JSValue js_websg_physics_body_wake_up(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGPhysicsBodyData *physics_body_data = JS_GetOpaque(this_val, js_websg_physics_body_class_id);
+
+  js_websg_flush_commands();
+
+  if (websg_physics_body_wake_up(physics_body_data->node_id) == -1) {
+    JS_ThrowInternalError(ctx, "WebSGPhysicsBody: error waking up body.");
+    return JS_EXCEPTION;
+  }
+
+  return JS_UNDEFINED;
+}
+
+static JSValue js_websg_physics_body_get_is_sleeping(JSContext *ctx, JSValueConst this_val) {
+  WebSGPhysicsBodyData *physics_body_data = JS_GetOpaque(this_val, js_websg_physics_body_class_id);
+
+  js_websg_flush_commands();
+
+  int32_t result = websg_physics_body_is_sleeping(physics_body_data->node_id);
+
+  if (result == -1) {
+    JS_ThrowInternalError(ctx, "WebSGPhysicsBody: error getting sleep state.");
+    return JS_EXCEPTION;
+  }
+
+  return JS_NewBool(ctx, result);
+}
+
 static const JSCFunctionListEntry js_websg_physics_body_proto_funcs[] = {
   JS_CFUNC_DEF("applyImpulse", 1, js_websg_physics_body_apply_impulse),
+  JS_CFUNC_DEF("sleep", 0, js_websg_physics_body_sleep),
+  JS_CFUNC_DEF("wakeUp", 0, js_websg_physics_body_wake_up),
+  JS_CGETSET_DEF("isSleeping", js_websg_physics_body_get_is_sleeping, NULL),
   JS_PROP_STRING_DEF("[Symbol.toStringTag]", "PhysicsBody", JS_PROP_CONFIGURABLE),
 };
 
@@ -136,7 +182,7 @@ JSValue js_websg_node_add_physics_body(JSContext *ctx, JSValueConst this_val, in
 
   PhysicsBodyProps *props = js_mallocz(ctx, sizeof(PhysicsBodyProps));
 
-  JSValue typeVal = JS_GetPropertyStr(ctx, argv[0], "type");
+  JSValue typeVal = JS_WEBSG_GET_PROP(ctx, argv[0], type);
 
   PhysicsBodyType physics_body_type = get_physics_body_type_from_atom(JS_ValueToAtom(ctx, typeVal));
 
@@ -147,7 +193,7 @@ JSValue js_websg_node_add_physics_body(JSContext *ctx, JSValueConst this_val, in
 
   props->type = physics_body_type;
 
-  JSValue mass_val = JS_GetPropertyStr(ctx, argv[0], "mass");
+  JSValue mass_val = JS_WEBSG_GET_PROP(ctx, argv[0], mass);
 
   if (!JS_IsUndefined(mass_val)) {
     double mass;
@@ -161,7 +207,7 @@ JSValue js_websg_node_add_physics_body(JSContext *ctx, JSValueConst this_val, in
     props->mass = 1;
   }
 
-  JSValue linear_velocity_val = JS_GetPropertyStr(ctx, argv[0], "linearVelocity");
+  JSValue linear_velocity_val = JS_WEBSG_GET_PROP(ctx, argv[0], linearVelocity);
 
   if (!JS_IsUndefined(linear_velocity_val)) {
     if (js_get_float_array_like(ctx, linear_velocity_val, props->linear_velocity, 3) < 0) {
@@ -169,7 +215,7 @@ JSValue js_websg_node_add_physics_body(JSContext *ctx, JSValueConst this_val, in
     }
   }
 
-  JSValue angular_velocity_val = JS_GetPropertyStr(ctx, argv[0], "angularVelocity");
+  JSValue angular_velocity_val = JS_WEBSG_GET_PROP(ctx, argv[0], angularVelocity);
 
   if (!JS_IsUndefined(angular_velocity_val)) {
     if (js_get_float_array_like(ctx, angular_velocity_val, props->angular_velocity, 3) < 0) {
@@ -177,7 +223,7 @@ JSValue js_websg_node_add_physics_body(JSContext *ctx, JSValueConst this_val, in
     }
   }
 
-  JSValue inertia_tensor_val = JS_GetPropertyStr(ctx, argv[0], "inertiaTensor");
+  JSValue inertia_tensor_val = JS_WEBSG_GET_PROP(ctx, argv[0], inertiaTensor);
 
   if (!JS_IsUndefined(inertia_tensor_val)) {
     if (js_get_float_array_like(ctx, inertia_tensor_val, props->inertia_tensor, 9) < 0) {
@@ -185,6 +231,8 @@ JSValue js_websg_node_add_physics_body(JSContext *ctx, JSValueConst this_val, in
     }
   }
 
+  js_websg_flush_commands();
+
   int32_t result = websg_node_add_physics_body(node_data->node_id, props);
 
   if (result == -1) {
@@ -210,6 +258,8 @@ JSValue js_websg_node_add_physics_body(JSContext *ctx, JSValueConst this_val, in
 JSValue js_websg_node_remove_physics_body(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGNodeData *node_data = JS_GetOpaque(this_val, js_websg_node_class_id);
 
+  js_websg_flush_commands();
+
   int32_t result = websg_node_remove_physics_body(node_data->node_id);
 
   if (result == -1) {
@@ -246,3 +296,24 @@ JSValue js_websg_node_get_physics_body(JSContext *ctx, JSValueConst this_val) {
 
   return JS_DupValue(ctx, node_data->physics_body);
 }
+
+/**
+ * World Methods
+ **/
+
+static int32_t js_websg_active_bodies_query(void *query_data, node_id_t *results, uint32_t max_count) {
+  return websg_physics_get_active_bodies(results, max_count);
+}
+
+JSValue js_websg_world_get_active_bodies(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  return js_websg_run_node_id_query(
+    ctx,
+    world_data,
+    &js_websg_active_bodies_query,
+    NULL,
+    argv[0],
+    "Error getting active bodies."
+  );
+}
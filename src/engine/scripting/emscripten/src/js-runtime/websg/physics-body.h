@@ -19,4 +19,6 @@ JSValue js_websg_node_remove_physics_body(JSContext *ctx, JSValueConst this_val,
 
 JSValue js_websg_node_get_physics_body(JSContext *ctx, JSValueConst this_val);
 
+JSValue js_websg_world_get_active_bodies(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
 #endif
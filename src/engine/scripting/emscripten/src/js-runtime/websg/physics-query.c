@@ -0,0 +1,565 @@
+#include <string.h>
+#include <math.h>
+#include "../quickjs/cutils.h"
+#include "../quickjs/quickjs.h"
+#include "../../websg.h"
+#include "../utils/array.h"
+#include "../utils/typedarray.h"
+#include "./websg-js.h"
+#include "./collider.h"
+#include "./node.h"
+#include "./physics-query.h"
+#include "./vector3.h"
+#include "./world.h"
+#include "./props.h"
+
+// origin xyz, direction xyz, max distance
+#define PHYSICS_CAST_STRIDE 7
+
+JSClassID js_websg_physics_hit_class_id;
+
+/**
+ * Private Methods and Variables
+ **/
+
+static int js_websg_get_filter_flag(
+  JSContext *ctx,
+  JSValueConst options,
+  WebSGProp prop,
+  PhysicsQueryFilterFlags flag,
+  PhysicsQueryFilter *filter
+) {
+  JSValue flag_val = JS_GetProperty(ctx, options, js_websg_prop_atoms[prop]);
+
+  if (JS_IsUndefined(flag_val)) {
+    return 0;
+  }
+
+  int value = JS_ToBool(ctx, flag_val);
+
+  JS_FreeValue(ctx, flag_val);
+
+  if (value < 0) {
+    return -1;
+  }
+
+  if (value) {
+    filter->flags |= flag;
+  }
+
+  return 0;
+}
+
+static int js_websg_parse_physics_query_options(
+  JSContext *ctx,
+  JSValueConst options,
+  PhysicsQueryFilter *filter,
+  float_t *max_distance
+) {
+  if (JS_IsUndefined(options)) {
+    return 0;
+  }
+
+  if (
+    js_websg_get_filter_flag(
+      ctx,
+      options,
+      WEBSG_PROP_excludeStatic,
+      PhysicsQueryFilterFlags_ExcludeStatic,
+      filter
+    ) < 0 ||
+    js_websg_get_filter_flag(
+      ctx,
+      options,
+      WEBSG_PROP_excludeKinematic,
+      PhysicsQueryFilterFlags_ExcludeKinematic,
+      filter
+    ) < 0 ||
+    js_websg_get_filter_flag(
+      ctx,
+      options,
+      WEBSG_PROP_excludeRigid,
+      PhysicsQueryFilterFlags_ExcludeRigid,
+      filter
+    ) < 0 ||
+    js_websg_get_filter_flag(
+      ctx,
+      options,
+      WEBSG_PROP_excludeTriggers,
+      PhysicsQueryFilterFlags_ExcludeTriggers,
+      filter
+    ) < 0
+  ) {
+    return -1;
+  }
+
+  JSValue exclude_node_val = JS_WEBSG_GET_PROP(ctx, options, excludeNode);
+
+  if (!JS_IsUndefined(exclude_node_val)) {
+    WebSGNodeData *node_data = JS_GetOpaque2(ctx, exclude_node_val, js_websg_node_class_id);
+
+    JS_FreeValue(ctx, exclude_node_val);
+
+    if (node_data == NULL) {
+      return -1;
+    }
+
+    filter->exclude_node = node_data->node_id;
+  }
+
+  if (max_distance != NULL) {
+    JSValue max_distance_val = JS_WEBSG_GET_PROP(ctx, options, maxDistance);
+
+    if (!JS_IsUndefined(max_distance_val)) {
+      double_t value;
+
+      if (JS_ToFloat64(ctx, &value, max_distance_val) == -1) {
+        return -1;
+      }
+
+      *max_distance = (float_t)value;
+    }
+  }
+
+  return 0;
+}
+
+static int js_websg_parse_physics_shape(JSContext *ctx, JSValueConst shape, PhysicsShapeProps *props) {
+  JSValue type_val = JS_WEBSG_GET_PROP(ctx, shape, type);
+
+  if (JS_IsException(type_val)) {
+    return -1;
+  }
+
+  JSAtom type_atom = JS_ValueToAtom(ctx, type_val);
+  props->type = get_collider_type_from_atom(type_atom);
+  JS_FreeAtom(ctx, type_atom);
+  JS_FreeValue(ctx, type_val);
+
+  if (props->type == -1 || props->type == ColliderType_Hull || props->type == ColliderType_Trimesh) {
+    JS_ThrowTypeError(ctx, "WebSG: Shape casts only support box, sphere, capsule and cylinder shapes.");
+    return -1;
+  }
+
+  JSValue size_val = JS_WEBSG_GET_PROP(ctx, shape, size);
+
+  if (!JS_IsUndefined(size_val)) {
+    if (js_get_float_array_like(ctx, size_val, props->size, 3) < 0) {
+      return -1;
+    }
+  }
+
+  JSValue radius_val = JS_WEBSG_GET_PROP(ctx, shape, radius);
+
+  if (!JS_IsUndefined(radius_val)) {
+    double_t radius;
+
+    if (JS_ToFloat64(ctx, &radius, radius_val) == -1) {
+      return -1;
+    }
+
+    props->radius = (float_t)radius;
+  }
+
+  JSValue height_val = JS_WEBSG_GET_PROP(ctx, shape, height);
+
+  if (!JS_IsUndefined(height_val)) {
+    double_t height;
+
+    if (JS_ToFloat64(ctx, &height, height_val) == -1) {
+      return -1;
+    }
+
+    props->height = (float_t)height;
+  }
+
+  props->rotation[3] = 1.0f;
+
+  JSValue rotation_val = JS_WEBSG_GET_PROP(ctx, shape, rotation);
+
+  if (!JS_IsUndefined(rotation_val)) {
+    if (js_get_float_array_like(ctx, rotation_val, props->rotation, 4) < 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+static int js_websg_get_single_cast(JSContext *ctx, JSValueConst origin, JSValueConst direction, float_t *cast) {
+  if (js_get_float_array_like(ctx, origin, cast, 3) < 0) {
+    return -1;
+  }
+
+  if (js_get_float_array_like(ctx, direction, cast + 3, 3) < 0) {
+    return -1;
+  }
+
+  cast[6] = INFINITY;
+
+  return 0;
+}
+
+static float_t *js_websg_get_casts(JSContext *ctx, JSValueConst casts_val, uint32_t *count) {
+  size_t length;
+  float_t *casts = get_float32_array_view(ctx, casts_val, &length);
+
+  if (casts == NULL) {
+    return NULL;
+  }
+
+  if (length % PHYSICS_CAST_STRIDE != 0) {
+    JS_ThrowRangeError(ctx, "WebSG: Casts must be a Float32Array of origin, direction and max distance tuples.");
+    return NULL;
+  }
+
+  *count = length / PHYSICS_CAST_STRIDE;
+
+  return casts;
+}
+
+static JSValue js_websg_new_physics_hits(JSContext *ctx, WebSGWorldData *world_data, PhysicsHit *hits, uint32_t count) {
+  JSValue results = JS_NewArray(ctx);
+
+  for (uint32_t i = 0; i < count; i++) {
+    JSValue result = JS_UNDEFINED;
+
+    if (hits[i].hit) {
+      result = js_websg_new_physics_hit(ctx, world_data, &hits[i]);
+
+      if (JS_IsException(result)) {
+        JS_FreeValue(ctx, results);
+        return JS_EXCEPTION;
+      }
+    }
+
+    JS_SetPropertyUint32(ctx, results, i, result);
+  }
+
+  return results;
+}
+
+typedef struct WebSGOverlapQuery {
+  PhysicsShapeProps *shape;
+  float_t position[3];
+  PhysicsQueryFilter filter;
+} WebSGOverlapQuery;
+
+static int32_t js_websg_overlap_shape_query(void *query_data, node_id_t *results, uint32_t max_count) {
+  WebSGOverlapQuery *query = query_data;
+  return websg_physics_overlap_shape(query->shape, query->position, &query->filter, results, max_count);
+}
+
+static JSValue js_websg_overlap_shape(
+  JSContext *ctx,
+  WebSGWorldData *world_data,
+  PhysicsShapeProps *shape,
+  JSValueConst position_val,
+  JSValueConst options,
+  JSValueConst out_val
+) {
+  WebSGOverlapQuery query = { .shape = shape, .filter = { 0, 0 } };
+
+  if (js_get_float_array_like(ctx, position_val, query.position, 3) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  if (js_websg_parse_physics_query_options(ctx, options, &query.filter, NULL) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  return js_websg_run_node_id_query(
+    ctx,
+    world_data,
+    &js_websg_overlap_shape_query,
+    &query,
+    out_val,
+    "Error finding overlapping nodes."
+  );
+}
+
+/**
+ * Class Definition
+ **/
+
+static JSClassDef js_websg_physics_hit_class = {
+  "PhysicsHit",
+};
+
+static const JSCFunctionListEntry js_websg_physics_hit_proto_funcs[] = {
+  JS_PROP_STRING_DEF("[Symbol.toStringTag]", "PhysicsHit", JS_PROP_CONFIGURABLE),
+};
+
+static JSValue js_websg_physics_hit_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  return JS_ThrowTypeError(ctx, "Illegal Constructor.");
+}
+
+void js_websg_define_physics_hit(JSContext *ctx, JSValue websg) {
+  JS_NewClassID(&js_websg_physics_hit_class_id);
+  JS_NewClass(JS_GetRuntime(ctx), js_websg_physics_hit_class_id, &js_websg_physics_hit_class);
+  JSValue physics_hit_proto = JS_NewObject(ctx);
+  JS_SetPropertyFunctionList(
+    ctx,
+    physics_hit_proto,
+    js_websg_physics_hit_proto_funcs,
+    countof(js_websg_physics_hit_proto_funcs)
+  );
+  JS_SetClassProto(ctx, js_websg_physics_hit_class_id, physics_hit_proto);
+
+  JSValue constructor = JS_NewCFunction2(
+    ctx,
+    js_websg_physics_hit_constructor,
+    "PhysicsHit",
+    0,
+    JS_CFUNC_constructor,
+    0
+  );
+  JS_SetConstructor(ctx, constructor, physics_hit_proto);
+  JS_SetPropertyStr(
+    ctx,
+    websg,
+    "PhysicsHit",
+    constructor
+  );
+}
+
+/**
+ * Public Methods
+ **/
+
+JSValue js_websg_new_physics_hit(JSContext *ctx, WebSGWorldData *world_data, PhysicsHit *hit) {
+  JSValue physics_hit = JS_NewObjectClass(ctx, js_websg_physics_hit_class_id);
+
+  if (JS_IsException(physics_hit)) {
+    return physics_hit;
+  }
+
+  JSValue node = hit->node == 0 ? JS_UNDEFINED : js_websg_get_node_by_id(ctx, world_data, hit->node);
+
+  JS_DefinePropertyValueStr(ctx, physics_hit, "node", node, JS_PROP_ENUMERABLE | JS_PROP_CONFIGURABLE);
+
+  JS_DefinePropertyValueStr(
+    ctx,
+    physics_hit,
+    "distance",
+    JS_NewFloat64(ctx, hit->distance),
+    JS_PROP_ENUMERABLE | JS_PROP_CONFIGURABLE
+  );
+
+  float_t *position = js_malloc(ctx, sizeof(float_t) * 3);
+
+  if (!position) {
+    JS_FreeValue(ctx, physics_hit);
+    return JS_EXCEPTION;
+  }
+
+  memcpy(position, hit->position, sizeof(float_t) * 3);
+
+  JS_DefinePropertyValueStr(
+    ctx,
+    physics_hit,
+    "position",
+    js_websg_create_vector3(ctx, position),
+    JS_PROP_ENUMERABLE | JS_PROP_CONFIGURABLE
+  );
+
+  float_t *normal = js_malloc(ctx, sizeof(float_t) * 3);
+
+  if (!normal) {
+    JS_FreeValue(ctx, physics_hit);
+    return JS_EXCEPTION;
+  }
+
+  memcpy(normal, hit->normal, sizeof(float_t) * 3);
+
+  JS_DefinePropertyValueStr(
+    ctx,
+    physics_hit,
+    "normal",
+    js_websg_create_vector3(ctx, normal),
+    JS_PROP_ENUMERABLE | JS_PROP_CONFIGURABLE
+  );
+
+  return physics_hit;
+}
+
+JSValue js_websg_world_cast_ray(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  float_t ray[PHYSICS_CAST_STRIDE];
+  PhysicsQueryFilter filter = { 0, 0 };
+  PhysicsHit hit;
+
+  if (js_websg_get_single_cast(ctx, argv[0], argv[1], ray) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  if (js_websg_parse_physics_query_options(ctx, argv[2], &filter, &ray[6]) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  if (websg_physics_cast_rays(ray, 1, &filter, &hit) == -1) {
+    JS_ThrowInternalError(ctx, "WebSG: Error casting ray.");
+    return JS_EXCEPTION;
+  }
+
+  if (!hit.hit) {
+    return JS_UNDEFINED;
+  }
+
+  return js_websg_new_physics_hit(ctx, world_data, &hit);
+}
+
+JSValue js_websg_world_cast_rays(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  PhysicsQueryFilter filter = { 0, 0 };
+
+  if (js_websg_parse_physics_query_options(ctx, argv[1], &filter, NULL) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  // read in place, the typed array lives in the same memory the host reads from
+  uint32_t count;
+  float_t *rays = js_websg_get_casts(ctx, argv[0], &count);
+
+  if (rays == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  if (count == 0) {
+    return JS_NewArray(ctx);
+  }
+
+  PhysicsHit *hits = js_mallocz(ctx, sizeof(PhysicsHit) * count);
+
+  if (hits == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  if (websg_physics_cast_rays(rays, count, &filter, hits) == -1) {
+    js_free(ctx, hits);
+    JS_ThrowInternalError(ctx, "WebSG: Error casting rays.");
+    return JS_EXCEPTION;
+  }
+
+  JSValue results = js_websg_new_physics_hits(ctx, world_data, hits, count);
+
+  js_free(ctx, hits);
+
+  return results;
+}
+
+JSValue js_websg_world_cast_shape(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  PhysicsShapeProps shape;
+  memset(&shape, 0, sizeof(PhysicsShapeProps));
+
+  if (js_websg_parse_physics_shape(ctx, argv[0], &shape) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  float_t cast[PHYSICS_CAST_STRIDE];
+  PhysicsQueryFilter filter = { 0, 0 };
+  PhysicsHit hit;
+
+  if (js_websg_get_single_cast(ctx, argv[1], argv[2], cast) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  if (js_websg_parse_physics_query_options(ctx, argv[3], &filter, &cast[6]) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  if (websg_physics_cast_shapes(&shape, cast, 1, &filter, &hit) == -1) {
+    JS_ThrowInternalError(ctx, "WebSG: Error casting shape.");
+    return JS_EXCEPTION;
+  }
+
+  if (!hit.hit) {
+    return JS_UNDEFINED;
+  }
+
+  return js_websg_new_physics_hit(ctx, world_data, &hit);
+}
+
+JSValue js_websg_world_cast_shapes(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  PhysicsShapeProps shape;
+  memset(&shape, 0, sizeof(PhysicsShapeProps));
+
+  if (js_websg_parse_physics_shape(ctx, argv[0], &shape) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  PhysicsQueryFilter filter = { 0, 0 };
+
+  if (js_websg_parse_physics_query_options(ctx, argv[2], &filter, NULL) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  uint32_t count;
+  float_t *casts = js_websg_get_casts(ctx, argv[1], &count);
+
+  if (casts == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  if (count == 0) {
+    return JS_NewArray(ctx);
+  }
+
+  PhysicsHit *hits = js_mallocz(ctx, sizeof(PhysicsHit) * count);
+
+  if (hits == NULL) {
+    return JS_EXCEPTION;
+  }
+
+  if (websg_physics_cast_shapes(&shape, casts, count, &filter, hits) == -1) {
+    js_free(ctx, hits);
+    JS_ThrowInternalError(ctx, "WebSG: Error casting shapes.");
+    return JS_EXCEPTION;
+  }
+
+  JSValue results = js_websg_new_physics_hits(ctx, world_data, hits, count);
+
+  js_free(ctx, hits);
+
+  return results;
+}
+
+JSValue js_websg_world_overlap_sphere(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  PhysicsShapeProps shape;
+  memset(&shape, 0, sizeof(PhysicsShapeProps));
+  shape.type = ColliderType_Sphere;
+  shape.rotation[3] = 1.0f;
+
+  double_t radius;
+
+  if (JS_ToFloat64(ctx, &radius, argv[1]) == -1) {
+    return JS_EXCEPTION;
+  }
+
+  shape.radius = (float_t)radius;
+
+  return js_websg_overlap_shape(ctx, world_data, &shape, argv[0], argv[2], argv[3]);
+}
+
+JSValue js_websg_world_overlap_box(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  PhysicsShapeProps shape;
+  memset(&shape, 0, sizeof(PhysicsShapeProps));
+  shape.type = ColliderType_Box;
+  shape.rotation[3] = 1.0f;
+
+  if (js_get_float_array_like(ctx, argv[1], shape.size, 3) < 0) {
+    return JS_EXCEPTION;
+  }
+
+  return js_websg_overlap_shape(ctx, world_data, &shape, argv[0], argv[2], argv[3]);
+}
@@ -0,0 +1,25 @@
+#ifndef __websg_physics_query_js_h
+#define __websg_physics_query_js_h
+#include "../../websg.h"
+#include "../quickjs/quickjs.h"
+#include "./world.h"
+
+extern JSClassID js_websg_physics_hit_class_id;
+
+void js_websg_define_physics_hit(JSContext *ctx, JSValue websg);
+
+JSValue js_websg_new_physics_hit(JSContext *ctx, WebSGWorldData *world_data, PhysicsHit *hit);
+
+JSValue js_websg_world_cast_ray(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+JSValue js_websg_world_cast_rays(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+JSValue js_websg_world_cast_shape(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+JSValue js_websg_world_cast_shapes(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+JSValue js_websg_world_overlap_sphere(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+JSValue js_websg_world_overlap_box(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
+#endif
@@ -0,0 +1,19 @@
+#include "../quickjs/quickjs.h"
+#include "./props.h"
+
+JSAtom js_websg_prop_atoms[WEBSG_PROP_COUNT];
+
+void js_websg_define_props(JSContext *ctx) {
+#define DEF(name) js_websg_prop_atoms[WEBSG_PROP_##name] = JS_NewAtom(ctx, #name);
+  WEBSG_PROP_NAMES(DEF)
+#undef DEF
+}
+
+int js_websg_check_props(JSContext *ctx, JSValueConst props, const char *name) {
+  if (!JS_IsObject(props)) {
+    JS_ThrowTypeError(ctx, "WebSG: %s must be an object.", name);
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+#ifndef __websg_props_js_h
+#define __websg_props_js_h
+#include "../quickjs/quickjs.h"
+
+// Names of the properties read from props and options objects passed to WebSG functions. Each one is interned once
+// when the API is defined so that parsing a props object doesn't re-atomize every property name.
+#define WEBSG_PROP_NAMES(DEF) \
+  DEF(alignContent) \
+  DEF(alignItems) \
+  DEF(alignSelf) \
+  DEF(alphaCutoff) \
+  DEF(alphaMode) \
+  DEF(angularVelocity) \
+  DEF(attributes) \
+  DEF(backgroundColor) \
+  DEF(baseColorFactor) \
+  DEF(baseColorTexture) \
+  DEF(borderColor) \
+  DEF(borderRadius) \
+  DEF(borderWidth) \
+  DEF(bottom) \
+  DEF(capacity) \
+  DEF(collider) \
+  DEF(color) \
+  DEF(componentType) \
+  DEF(count) \
+  DEF(delay) \
+  DEF(doubleSided) \
+  DEF(dynamic) \
+  DEF(emissiveFactor) \
+  DEF(emissiveTexture) \
+  DEF(excludeKinematic) \
+  DEF(excludeNode) \
+  DEF(excludeRigid) \
+  DEF(excludeStatic) \
+  DEF(excludeTriggers) \
+  DEF(flexBasis) \
+  DEF(flexDirection) \
+  DEF(flexGrow) \
+  DEF(flexShrink) \
+  DEF(flexWrap) \
+  DEF(fontFamily) \
+  DEF(fontSize) \
+  DEF(fontStyle) \
+  DEF(fontWeight) \
+  DEF(height) \
+  DEF(indices) \
+  DEF(inertiaTensor) \
+  DEF(innerConeAngle) \
+  DEF(intensity) \
+  DEF(isTrigger) \
+  DEF(justifyContent) \
+  DEF(label) \
+  DEF(left) \
+  DEF(length) \
+  DEF(linearVelocity) \
+  DEF(margin) \
+  DEF(mass) \
+  DEF(material) \
+  DEF(maxDistance) \
+  DEF(maxHeight) \
+  DEF(maxSlopeClimbAngle) \
+  DEF(maxStepHeight) \
+  DEF(maxWidth) \
+  DEF(mesh) \
+  DEF(metallicFactor) \
+  DEF(metallicRoughnessTexture) \
+  DEF(minHeight) \
+  DEF(minSlopeSlideAngle) \
+  DEF(minStepWidth) \
+  DEF(minWidth) \
+  DEF(mode) \
+  DEF(name) \
+  DEF(nodes) \
+  DEF(normalScale) \
+  DEF(normalTexture) \
+  DEF(normalized) \
+  DEF(occlusionStrength) \
+  DEF(occlusionTexture) \
+  DEF(offset) \
+  DEF(outerConeAngle) \
+  DEF(padding) \
+  DEF(pitch) \
+  DEF(position) \
+  DEF(primitives) \
+  DEF(quaternion) \
+  DEF(radius) \
+  DEF(range) \
+  DEF(right) \
+  DEF(root) \
+  DEF(rotation) \
+  DEF(roughnessFactor) \
+  DEF(scale) \
+  DEF(segments) \
+  DEF(simplify) \
+  DEF(size) \
+  DEF(slide) \
+  DEF(snapToGround) \
+  DEF(top) \
+  DEF(translation) \
+  DEF(type) \
+  DEF(uiCanvas) \
+  DEF(value) \
+  DEF(width) \
+  DEF(yaw) \
+  DEF(zoom)
+
+typedef enum WebSGProp {
+#define DEF(name) WEBSG_PROP_##name,
+  WEBSG_PROP_NAMES(DEF)
+#undef DEF
+  WEBSG_PROP_COUNT
+} WebSGProp;
+
+extern JSAtom js_websg_prop_atoms[WEBSG_PROP_COUNT];
+
+void js_websg_define_props(JSContext *ctx);
+
+// Equivalent to JS_GetPropertyStr(ctx, obj, "name") using the interned atom.
+#define JS_WEBSG_GET_PROP(ctx, obj, name) JS_GetProperty(ctx, obj, js_websg_prop_atoms[WEBSG_PROP_##name])
+
+// Returns 0 if props is an object, otherwise throws a TypeError and returns -1.
+int js_websg_check_props(JSContext *ctx, JSValueConst props, const char *name);
+
+#endif
@@ -5,6 +5,7 @@
 #include "./query.h"
 #include "./component-store.h"
 #include "./node-iterator.h"
+#include "./props.h"
 
 JSClassID js_websg_query_class_id;
 
@@ -89,7 +90,7 @@ void js_websg_define_query(JSContext *ctx, JSValue websg) {
 JSValue js_websg_world_create_query(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
 
-  JSValue query_list_length_val = JS_GetPropertyStr(ctx, argv[0], "length");
+  JSValue query_list_length_val = JS_WEBSG_GET_PROP(ctx, argv[0], length);
 
   if (JS_IsException(query_list_length_val)) {
     return JS_EXCEPTION;
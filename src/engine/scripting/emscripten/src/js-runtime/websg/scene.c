@@ -5,6 +5,7 @@
 #include "./scene.h"
 #include "./node.h"
 #include "./node-iterator.h"
+#include "./props.h"
 
 JSClassID js_websg_scene_class_id;
 
@@ -204,7 +205,7 @@ JSValue js_websg_world_create_scene(JSContext *ctx, JSValue this_val, int argc,
   SceneProps *props = js_mallocz(ctx, sizeof(SceneProps));
 
   if (!JS_IsUndefined(argv[0])) {
-    JSValue name_val = JS_GetPropertyStr(ctx, argv[0], "name");
+    JSValue name_val = JS_WEBSG_GET_PROP(ctx, argv[0], name);
 
     if (!JS_IsUndefined(name_val)) {
       props->name = JS_ToCString(ctx, name_val);
@@ -5,7 +5,10 @@
 #include "./websg-js.h"
 #include "./ui-element.h"
 #include "./ui-text.h"
+#include "./ui-canvas.h"
+#include "./props.h"
 #include "../utils/array.h"
+#include "../utils/string-scratch.h"
 
 JSClassID js_websg_ui_button_class_id;
 
@@ -29,9 +32,15 @@ static JSClassDef js_websg_ui_button_class = {
 static JSValue js_websg_ui_button_get_label(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_button_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   int32_t length = websg_ui_button_get_label_length(ui_button_data->ui_element_id);
 
-  const char *str = js_mallocz(ctx, sizeof(char) * length);
+  char *str = js_get_string_scratch(ctx, length);
+
+  if (str == NULL) {
+    return JS_EXCEPTION;
+  }
 
   int32_t result = websg_ui_button_get_label(ui_button_data->ui_element_id, str, length);
 
@@ -53,6 +62,12 @@ static JSValue js_websg_ui_button_set_label(JSContext *ctx, JSValueConst this_va
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record_string(ui_button_data->ui_element_id, UIProperty_BUTTON_LABEL, label, length);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_button_set_label(ui_button_data->ui_element_id, label, length);
 
   if (result == -1) {
@@ -237,7 +252,7 @@ JSValue js_websg_world_create_ui_button(JSContext *ctx, JSValueConst this_val, i
     return JS_EXCEPTION;
   }
 
-  JSValue label_val = JS_GetPropertyStr(ctx, argv[0], "label");
+  JSValue label_val = JS_IsUndefined(argv[0]) ? JS_UNDEFINED : JS_WEBSG_GET_PROP(ctx, argv[0], label);
 
   if (!JS_IsUndefined(label_val)) {
     size_t label_len;
@@ -6,10 +6,169 @@
 #include "./ui-canvas.h"
 #include "./ui-element.h"
 #include "./vector2.h"
+#include "./props.h"
 #include "../utils/array.h"
 
 JSClassID js_websg_ui_canvas_class_id;
 
+/**
+ * UI Batches
+ *
+ * While canvas.batch() runs its callback, UI property setters record their changes in the canvas's batch instead of
+ * calling the host. The whole batch is applied with a single ui_canvas_commit call.
+ *
+ * Vector and color setters only receive the element id, so the canvas with the innermost open batch is tracked here.
+ * A script runtime has a single JS context.
+ **/
+
+static WebSGUICanvasData *open_ui_canvas = NULL;
+
+static UIPropertyUpdate *js_websg_ui_batch_push(ui_element_id_t element_id, UIProperty property) {
+  WebSGUIBatch *batch = &open_ui_canvas->batch;
+
+  if (batch->count == batch->capacity) {
+    uint32_t capacity = batch->capacity == 0 ? 64 : batch->capacity * 2;
+
+    UIPropertyUpdate *updates = js_realloc(batch->ctx, batch->updates, sizeof(UIPropertyUpdate) * capacity);
+
+    if (updates == NULL) {
+      return NULL;
+    }
+
+    batch->updates = updates;
+    batch->capacity = capacity;
+  }
+
+  UIPropertyUpdate *update = &batch->updates[batch->count++];
+  memset(update, 0, sizeof(UIPropertyUpdate));
+  update->element_id = element_id;
+  update->property = property;
+
+  return update;
+}
+
+int js_websg_ui_batch_record(ui_element_id_t element_id, UIProperty property, uint32_t index, float_t value) {
+  if (open_ui_canvas == NULL) {
+    return 0;
+  }
+
+  UIPropertyUpdate *update = js_websg_ui_batch_push(element_id, property);
+
+  if (update == NULL) {
+    return -1;
+  }
+
+  update->index = index;
+  update->value = value;
+
+  return 1;
+}
+
+int js_websg_ui_batch_record_string(
+  ui_element_id_t element_id,
+  UIProperty property,
+  const char *string,
+  size_t length
+) {
+  if (open_ui_canvas == NULL) {
+    return 0;
+  }
+
+  UIPropertyUpdate *update = js_websg_ui_batch_push(element_id, property);
+
+  if (update == NULL) {
+    return -1;
+  }
+
+  // the batch owns the string until it is committed or discarded
+  update->string = string;
+  update->length = length;
+
+  return 1;
+}
+
+int32_t js_websg_ui_batch_set_element(
+  ui_element_id_t element_id,
+  UIProperty property,
+  uint32_t index,
+  float_t value,
+  int32_t (*set)(uint32_t resource_id, uint32_t index, float_t value)
+) {
+  int recorded = js_websg_ui_batch_record(element_id, property, index, value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? 0 : -1;
+  }
+
+  return set(element_id, index, value);
+}
+
+int32_t js_websg_ui_batch_set_array(
+  ui_element_id_t element_id,
+  UIProperty property,
+  float_t *array,
+  uint32_t length,
+  int32_t (*set_array)(uint32_t resource_id, float_t *array)
+) {
+  if (open_ui_canvas == NULL) {
+    return set_array(element_id, array);
+  }
+
+  for (uint32_t i = 0; i < length; i++) {
+    if (js_websg_ui_batch_record(element_id, property, i, array[i]) == -1) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+float_t js_websg_ui_batch_get_element(
+  ui_element_id_t element_id,
+  uint32_t index,
+  float_t (*get)(uint32_t resource_id, uint32_t index)
+) {
+  js_websg_ui_batch_flush();
+  return get(element_id, index);
+}
+
+static void js_websg_ui_batch_clear(WebSGUIBatch *batch) {
+  for (uint32_t i = 0; i < batch->count; i++) {
+    if (batch->updates[i].string != NULL) {
+      JS_FreeCString(batch->ctx, batch->updates[i].string);
+    }
+  }
+
+  batch->count = 0;
+}
+
+// Returns the number of updates that failed, including those of earlier flushes, or -1 if the canvas doesn't exist.
+static int32_t js_websg_ui_batch_commit(WebSGUICanvasData *ui_canvas_data) {
+  WebSGUIBatch *batch = &ui_canvas_data->batch;
+
+  if (batch->count == 0) {
+    return batch->failed;
+  }
+
+  int32_t failed = websg_ui_canvas_commit(ui_canvas_data->ui_canvas_id, batch->updates, batch->count);
+
+  js_websg_ui_batch_clear(batch);
+
+  if (failed == -1 || batch->failed == -1) {
+    batch->failed = -1;
+  } else {
+    batch->failed += failed;
+  }
+
+  return batch->failed;
+}
+
+void js_websg_ui_batch_flush() {
+  if (open_ui_canvas != NULL) {
+    js_websg_ui_batch_commit(open_ui_canvas);
+  }
+}
+
 /**
  * Class Definition
  **/
@@ -18,6 +177,7 @@ static void js_websg_ui_canvas_finalizer(JSRuntime *rt, JSValue val) {
   WebSGUICanvasData *ui_canvas_data = JS_GetOpaque(val, js_websg_ui_canvas_class_id);
 
   if (ui_canvas_data) {
+    js_free_rt(rt, ui_canvas_data->batch.updates);
     js_free_rt(rt, ui_canvas_data);
   }
 }
@@ -125,11 +285,67 @@ static JSValue js_websg_ui_canvas_redraw(JSContext *ctx, JSValueConst this_val,
   return JS_UNDEFINED;
 }
 
+static JSValue js_websg_ui_canvas_batch(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGUICanvasData *ui_canvas_data = JS_GetOpaque(this_val, js_websg_ui_canvas_class_id);
+
+  if (!JS_IsFunction(ctx, argv[0])) {
+    return JS_ThrowTypeError(ctx, "WebSG UI: batch expects a function.");
+  }
+
+  WebSGUIBatch *batch = &ui_canvas_data->batch;
+
+  // nested batches on the same canvas are applied with the outermost one
+  if (batch->depth > 0) {
+    WebSGUICanvasData *prev_open_ui_canvas = open_ui_canvas;
+    open_ui_canvas = ui_canvas_data;
+    batch->depth++;
+    JSValue result = JS_Call(ctx, argv[0], JS_UNDEFINED, 0, NULL);
+    batch->depth--;
+    open_ui_canvas = prev_open_ui_canvas;
+    return result;
+  }
+
+  // a batch on another canvas inside this one is committed on its own when its callback returns
+  WebSGUICanvasData *prev_open_ui_canvas = open_ui_canvas;
+  open_ui_canvas = ui_canvas_data;
+  batch->ctx = ctx;
+  batch->depth = 1;
+  batch->failed = 0;
+
+  JSValue result = JS_Call(ctx, argv[0], JS_UNDEFINED, 0, NULL);
+
+  batch->depth = 0;
+  open_ui_canvas = prev_open_ui_canvas;
+
+  // the rest of the batch is discarded if the callback throws
+  if (JS_IsException(result)) {
+    js_websg_ui_batch_clear(batch);
+    return result;
+  }
+
+  int32_t failed = js_websg_ui_batch_commit(ui_canvas_data);
+
+  if (failed != 0) {
+    JS_FreeValue(ctx, result);
+
+    if (failed == -1) {
+      JS_ThrowInternalError(ctx, "WebSG UI: Error committing UI batch.");
+    } else {
+      JS_ThrowInternalError(ctx, "WebSG UI: %d updates in UI batch failed.", failed);
+    }
+
+    return JS_EXCEPTION;
+  }
+
+  return result;
+}
+
 static const JSCFunctionListEntry js_websg_ui_canvas_proto_funcs[] = {
   JS_CGETSET_DEF("root", js_websg_ui_canvas_get_root, js_websg_ui_canvas_set_root),
   JS_CGETSET_DEF("width", js_websg_ui_canvas_get_width, js_websg_ui_canvas_set_width),
   JS_CGETSET_DEF("height", js_websg_ui_canvas_get_height, js_websg_ui_canvas_set_height),
   JS_CFUNC_DEF("redraw", 0, js_websg_ui_canvas_redraw),
+  JS_CFUNC_DEF("batch", 1, js_websg_ui_canvas_batch),
   JS_PROP_STRING_DEF("[Symbol.toStringTag]", "UICanvas", JS_PROP_CONFIGURABLE),
 };
 
@@ -217,7 +433,7 @@ JSValue js_websg_world_create_ui_canvas(JSContext *ctx, JSValueConst this_val, i
 
   if (!JS_IsUndefined(argv[0])) {
 
-    JSValue root_val = JS_GetPropertyStr(ctx, argv[0], "root");
+    JSValue root_val = JS_WEBSG_GET_PROP(ctx, argv[0], root);
 
     if (!JS_IsUndefined(root_val)) {
       WebSGUIElementData *ui_element_data = JS_GetOpaque2(ctx, root_val, js_websg_ui_element_class_id);
@@ -229,7 +445,7 @@ JSValue js_websg_world_create_ui_canvas(JSContext *ctx, JSValueConst this_val, i
       props->root = ui_element_data->ui_element_id;
     }
 
-    JSValue size_val = JS_GetPropertyStr(ctx, argv[0], "size");
+    JSValue size_val = JS_WEBSG_GET_PROP(ctx, argv[0], size);
 
     if (!JS_IsUndefined(size_val)) {
       if (js_get_float_array_like(ctx, size_val, props->size, 2) < 0) {
@@ -237,7 +453,7 @@ JSValue js_websg_world_create_ui_canvas(JSContext *ctx, JSValueConst this_val, i
       }
     }
 
-    JSValue width_val = JS_GetPropertyStr(ctx, argv[0], "width");
+    JSValue width_val = JS_WEBSG_GET_PROP(ctx, argv[0], width);
 
     if (!JS_IsUndefined(width_val)) {
       double width;
@@ -249,7 +465,7 @@ JSValue js_websg_world_create_ui_canvas(JSContext *ctx, JSValueConst this_val, i
       props->width = (float_t)width;
     }
 
-    JSValue height_val = JS_GetPropertyStr(ctx, argv[0], "height");
+    JSValue height_val = JS_WEBSG_GET_PROP(ctx, argv[0], height);
 
     if (!JS_IsUndefined(height_val)) {
       double height;
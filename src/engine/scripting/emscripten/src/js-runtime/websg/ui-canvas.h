@@ -4,9 +4,22 @@
 #include "../quickjs/quickjs.h"
 #include "./world.h"
 
+// Property updates recorded by canvas.batch(), applied with one ui_canvas_commit call.
+typedef struct WebSGUIBatch {
+  JSContext *ctx;
+  UIPropertyUpdate *updates;
+  uint32_t count;
+  uint32_t capacity;
+  // nesting depth of batch() calls on the canvas, 0 when no batch is open
+  uint32_t depth;
+  // updates that failed when the batch was flushed early
+  int32_t failed;
+} WebSGUIBatch;
+
 typedef struct WebSGUICanvasData {
   WebSGWorldData *world_data;
   ui_canvas_id_t ui_canvas_id;
+  WebSGUIBatch batch;
 } WebSGUICanvasData;
 
 extern JSClassID js_websg_ui_canvas_class_id;
@@ -24,4 +37,42 @@ JSValue js_websg_world_find_ui_canvas_by_name(
   JSValueConst *argv
 );
 
+// Commits the updates recorded so far in the open UI batch so getters read the values that were set.
+void js_websg_ui_batch_flush();
+
+// Returns 1 if a UI batch is open and the update was recorded, 0 if no batch is open or -1 on error.
+int js_websg_ui_batch_record(ui_element_id_t element_id, UIProperty property, uint32_t index, float_t value);
+
+// Takes ownership of string, which must come from JS_ToCStringLen, when the update is recorded.
+int js_websg_ui_batch_record_string(
+  ui_element_id_t element_id,
+  UIProperty property,
+  const char *string,
+  size_t length
+);
+
+// Records the update if a UI batch is open, otherwise calls set. Used for vector and color properties.
+int32_t js_websg_ui_batch_set_element(
+  ui_element_id_t element_id,
+  UIProperty property,
+  uint32_t index,
+  float_t value,
+  int32_t (*set)(uint32_t resource_id, uint32_t index, float_t value)
+);
+
+int32_t js_websg_ui_batch_set_array(
+  ui_element_id_t element_id,
+  UIProperty property,
+  float_t *array,
+  uint32_t length,
+  int32_t (*set_array)(uint32_t resource_id, float_t *array)
+);
+
+// Flushes the open UI batch, then calls get. Used for vector and color properties.
+float_t js_websg_ui_batch_get_element(
+  ui_element_id_t element_id,
+  uint32_t index,
+  float_t (*get)(uint32_t resource_id, uint32_t index)
+);
+
 #endif
@@ -6,10 +6,13 @@
 #include "./ui-element.h"
 #include "./ui-text.h"
 #include "./ui-button.h"
+#include "./ui-canvas.h"
 #include "./rgba.h"
 #include "./vector4.h"
 #include "./ui-element-iterator.h"
+#include "./props.h"
 #include "../utils/array.h"
+#include "../utils/cbor.h"
 
 JSClassID js_websg_ui_element_class_id;
 
@@ -231,6 +234,8 @@ static JSClassDef js_websg_ui_element_class = {
 static JSValue js_websg_ui_element_get_flex_direction(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   FlexDirection result = websg_ui_element_get_flex_direction(ui_element_data->ui_element_id);
 
   JSAtom atom = get_atom_from_flex_direction(result);
@@ -250,6 +255,12 @@ static JSValue js_websg_ui_element_set_flex_direction(JSContext *ctx, JSValueCon
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_FLEX_DIRECTION, 0, value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_flex_direction(ui_element_data->ui_element_id, value);
 
   if (result == -1) {
@@ -263,6 +274,8 @@ static JSValue js_websg_ui_element_set_flex_direction(JSContext *ctx, JSValueCon
 static JSValue js_websg_ui_element_get_position_type(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   ElementPositionType result = websg_ui_element_get_position_type(ui_element_data->ui_element_id);
 
   JSAtom atom = get_atom_from_element_position(result);
@@ -282,6 +295,12 @@ static JSValue js_websg_ui_element_set_position_type(JSContext *ctx, JSValueCons
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_POSITION_TYPE, 0, value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_position_type(ui_element_data->ui_element_id, value);
 
   if (result == -1) {
@@ -294,6 +313,8 @@ static JSValue js_websg_ui_element_set_position_type(JSContext *ctx, JSValueCons
 
 static JSValue js_websg_ui_element_get_position(JSContext *ctx, JSValueConst this_val, int index) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
+
+  js_websg_ui_batch_flush();
   float_t result = websg_ui_element_get_position_element(ui_element_data->ui_element_id, index);
   return JS_NewFloat64(ctx, result);
 }
@@ -307,6 +328,12 @@ static JSValue js_websg_ui_element_set_position(JSContext *ctx, JSValueConst thi
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_POSITION, index, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_position_element(ui_element_data->ui_element_id, index, (float_t)value);
 
   if (result == -1) {
@@ -320,6 +347,8 @@ static JSValue js_websg_ui_element_set_position(JSContext *ctx, JSValueConst thi
 static JSValue js_websg_ui_element_get_align_content(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   FlexAlign result = websg_ui_element_get_align_content(ui_element_data->ui_element_id);
 
   JSAtom atom = get_atom_from_flex_align(result);
@@ -339,6 +368,12 @@ static JSValue js_websg_ui_element_set_align_content(JSContext *ctx, JSValueCons
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_ALIGN_CONTENT, 0, value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_align_content(ui_element_data->ui_element_id, value);
 
   if (result == -1) {
@@ -352,6 +387,8 @@ static JSValue js_websg_ui_element_set_align_content(JSContext *ctx, JSValueCons
 static JSValue js_websg_ui_element_get_align_items(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   FlexAlign result = websg_ui_element_get_align_items(ui_element_data->ui_element_id);
 
   JSAtom atom = get_atom_from_flex_align(result);
@@ -371,6 +408,12 @@ static JSValue js_websg_ui_element_set_align_items(JSContext *ctx, JSValueConst
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_ALIGN_ITEMS, 0, value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_align_items(ui_element_data->ui_element_id, value);
 
   if (result == -1) {
@@ -384,6 +427,8 @@ static JSValue js_websg_ui_element_set_align_items(JSContext *ctx, JSValueConst
 static JSValue js_websg_ui_element_get_align_self(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   FlexAlign result = websg_ui_element_get_align_self(ui_element_data->ui_element_id);
 
   JSAtom atom = get_atom_from_flex_align(result);
@@ -403,6 +448,12 @@ static JSValue js_websg_ui_element_set_align_self(JSContext *ctx, JSValueConst t
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_ALIGN_SELF, 0, value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_align_self(ui_element_data->ui_element_id, value);
 
   if (result == -1) {
@@ -416,6 +467,8 @@ static JSValue js_websg_ui_element_set_align_self(JSContext *ctx, JSValueConst t
 static JSValue js_websg_ui_element_get_flex_wrap(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   FlexWrap result = websg_ui_element_get_flex_wrap(ui_element_data->ui_element_id);
 
   JSAtom atom = get_atom_from_flex_wrap(result);
@@ -435,6 +488,12 @@ static JSValue js_websg_ui_element_set_flex_wrap(JSContext *ctx, JSValueConst th
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_FLEX_WRAP, 0, value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_flex_wrap(ui_element_data->ui_element_id, value);
 
   if (result == -1) {
@@ -448,6 +507,8 @@ static JSValue js_websg_ui_element_set_flex_wrap(JSContext *ctx, JSValueConst th
 static JSValue js_websg_ui_element_get_flex_basis(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_flex_basis(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -462,6 +523,12 @@ static JSValue js_websg_ui_element_set_flex_basis(JSContext *ctx, JSValueConst t
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_FLEX_BASIS, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_flex_basis(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -475,6 +542,8 @@ static JSValue js_websg_ui_element_set_flex_basis(JSContext *ctx, JSValueConst t
 static JSValue js_websg_ui_element_get_flex_grow(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_flex_grow(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -489,6 +558,12 @@ static JSValue js_websg_ui_element_set_flex_grow(JSContext *ctx, JSValueConst th
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_FLEX_GROW, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_flex_grow(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -502,6 +577,8 @@ static JSValue js_websg_ui_element_set_flex_grow(JSContext *ctx, JSValueConst th
 static JSValue js_websg_ui_element_get_flex_shrink(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_flex_shrink(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -516,6 +593,12 @@ static JSValue js_websg_ui_element_set_flex_shrink(JSContext *ctx, JSValueConst
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_FLEX_SHRINK, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_flex_shrink(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -529,6 +612,8 @@ static JSValue js_websg_ui_element_set_flex_shrink(JSContext *ctx, JSValueConst
 static JSValue js_websg_ui_element_get_justify_content(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   FlexJustify result = websg_ui_element_get_justify_content(ui_element_data->ui_element_id);
 
   JSAtom atom = get_atom_from_flex_justify(result);
@@ -548,6 +633,12 @@ static JSValue js_websg_ui_element_set_justify_content(JSContext *ctx, JSValueCo
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_JUSTIFY_CONTENT, 0, value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_justify_content(ui_element_data->ui_element_id, value);
 
   if (result == -1) {
@@ -561,6 +652,8 @@ static JSValue js_websg_ui_element_set_justify_content(JSContext *ctx, JSValueCo
 static JSValue js_websg_ui_element_get_width(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_width(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -575,6 +668,12 @@ static JSValue js_websg_ui_element_set_width(JSContext *ctx, JSValueConst this_v
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_WIDTH, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_width(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -588,6 +687,8 @@ static JSValue js_websg_ui_element_set_width(JSContext *ctx, JSValueConst this_v
 static JSValue js_websg_ui_element_get_height(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_height(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -602,6 +703,12 @@ static JSValue js_websg_ui_element_set_height(JSContext *ctx, JSValueConst this_
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_HEIGHT, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_height(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -615,6 +722,8 @@ static JSValue js_websg_ui_element_set_height(JSContext *ctx, JSValueConst this_
 static JSValue js_websg_ui_element_get_min_width(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_min_width(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -629,6 +738,12 @@ static JSValue js_websg_ui_element_set_min_width(JSContext *ctx, JSValueConst th
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_MIN_WIDTH, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_min_width(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -642,6 +757,8 @@ static JSValue js_websg_ui_element_set_min_width(JSContext *ctx, JSValueConst th
 static JSValue js_websg_ui_element_get_min_height(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_min_height(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -656,6 +773,12 @@ static JSValue js_websg_ui_element_set_min_height(JSContext *ctx, JSValueConst t
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_MIN_HEIGHT, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_min_height(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -669,6 +792,8 @@ static JSValue js_websg_ui_element_set_min_height(JSContext *ctx, JSValueConst t
 static JSValue js_websg_ui_element_get_max_width(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_max_width(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -683,6 +808,12 @@ static JSValue js_websg_ui_element_set_max_width(JSContext *ctx, JSValueConst th
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_MAX_WIDTH, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_max_width(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -696,6 +827,8 @@ static JSValue js_websg_ui_element_set_max_width(JSContext *ctx, JSValueConst th
 static JSValue js_websg_ui_element_get_max_height(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_element_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_element_get_max_height(ui_element_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -710,6 +843,12 @@ static JSValue js_websg_ui_element_set_max_height(JSContext *ctx, JSValueConst t
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_element_data->ui_element_id, UIProperty_MAX_HEIGHT, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_element_set_max_height(ui_element_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -925,6 +1064,154 @@ void js_websg_define_ui_element(JSContext *ctx, JSValue websg) {
   JS_SetPropertyStr(ctx, websg, "UIElementType", element_type);
 }
 
+/**
+ * Batched Vector Props
+ **/
+
+static float_t js_websg_ui_element_get_background_color_element(uint32_t ui_element_id, uint32_t index) {
+  return js_websg_ui_batch_get_element(ui_element_id, index, &websg_ui_element_get_background_color_element);
+}
+
+static float_t js_websg_ui_element_get_border_color_element(uint32_t ui_element_id, uint32_t index) {
+  return js_websg_ui_batch_get_element(ui_element_id, index, &websg_ui_element_get_border_color_element);
+}
+
+static float_t js_websg_ui_element_get_padding_element(uint32_t ui_element_id, uint32_t index) {
+  return js_websg_ui_batch_get_element(ui_element_id, index, &websg_ui_element_get_padding_element);
+}
+
+static float_t js_websg_ui_element_get_margin_element(uint32_t ui_element_id, uint32_t index) {
+  return js_websg_ui_batch_get_element(ui_element_id, index, &websg_ui_element_get_margin_element);
+}
+
+static float_t js_websg_ui_element_get_border_width_element(uint32_t ui_element_id, uint32_t index) {
+  return js_websg_ui_batch_get_element(ui_element_id, index, &websg_ui_element_get_border_width_element);
+}
+
+static float_t js_websg_ui_element_get_border_radius_element(uint32_t ui_element_id, uint32_t index) {
+  return js_websg_ui_batch_get_element(ui_element_id, index, &websg_ui_element_get_border_radius_element);
+}
+
+static int32_t js_websg_ui_element_set_background_color_element(uint32_t ui_element_id, uint32_t index, float_t value) {
+  return js_websg_ui_batch_set_element(
+    ui_element_id,
+    UIProperty_BACKGROUND_COLOR,
+    index,
+    value,
+    &websg_ui_element_set_background_color_element
+  );
+}
+
+static int32_t js_websg_ui_element_set_background_color_array(uint32_t ui_element_id, float_t *array) {
+  return js_websg_ui_batch_set_array(
+    ui_element_id,
+    UIProperty_BACKGROUND_COLOR,
+    array,
+    4,
+    &websg_ui_element_set_background_color
+  );
+}
+
+static int32_t js_websg_ui_element_set_border_color_element(uint32_t ui_element_id, uint32_t index, float_t value) {
+  return js_websg_ui_batch_set_element(
+    ui_element_id,
+    UIProperty_BORDER_COLOR,
+    index,
+    value,
+    &websg_ui_element_set_border_color_element
+  );
+}
+
+static int32_t js_websg_ui_element_set_border_color_array(uint32_t ui_element_id, float_t *array) {
+  return js_websg_ui_batch_set_array(
+    ui_element_id,
+    UIProperty_BORDER_COLOR,
+    array,
+    4,
+    &websg_ui_element_set_border_color
+  );
+}
+
+static int32_t js_websg_ui_element_set_padding_element(uint32_t ui_element_id, uint32_t index, float_t value) {
+  return js_websg_ui_batch_set_element(
+    ui_element_id,
+    UIProperty_PADDING,
+    index,
+    value,
+    &websg_ui_element_set_padding_element
+  );
+}
+
+static int32_t js_websg_ui_element_set_padding_array(uint32_t ui_element_id, float_t *array) {
+  return js_websg_ui_batch_set_array(
+    ui_element_id,
+    UIProperty_PADDING,
+    array,
+    4,
+    &websg_ui_element_set_padding
+  );
+}
+
+static int32_t js_websg_ui_element_set_margin_element(uint32_t ui_element_id, uint32_t index, float_t value) {
+  return js_websg_ui_batch_set_element(
+    ui_element_id,
+    UIProperty_MARGIN,
+    index,
+    value,
+    &websg_ui_element_set_margin_element
+  );
+}
+
+static int32_t js_websg_ui_element_set_margin_array(uint32_t ui_element_id, float_t *array) {
+  return js_websg_ui_batch_set_array(
+    ui_element_id,
+    UIProperty_MARGIN,
+    array,
+    4,
+    &websg_ui_element_set_margin
+  );
+}
+
+static int32_t js_websg_ui_element_set_border_width_element(uint32_t ui_element_id, uint32_t index, float_t value) {
+  return js_websg_ui_batch_set_element(
+    ui_element_id,
+    UIProperty_BORDER_WIDTH,
+    index,
+    value,
+    &websg_ui_element_set_border_width_element
+  );
+}
+
+static int32_t js_websg_ui_element_set_border_width_array(uint32_t ui_element_id, float_t *array) {
+  return js_websg_ui_batch_set_array(
+    ui_element_id,
+    UIProperty_BORDER_WIDTH,
+    array,
+    4,
+    &websg_ui_element_set_border_width
+  );
+}
+
+static int32_t js_websg_ui_element_set_border_radius_element(uint32_t ui_element_id, uint32_t index, float_t value) {
+  return js_websg_ui_batch_set_element(
+    ui_element_id,
+    UIProperty_BORDER_RADIUS,
+    index,
+    value,
+    &websg_ui_element_set_border_radius_element
+  );
+}
+
+static int32_t js_websg_ui_element_set_border_radius_array(uint32_t ui_element_id, float_t *array) {
+  return js_websg_ui_batch_set_array(
+    ui_element_id,
+    UIProperty_BORDER_RADIUS,
+    array,
+    4,
+    &websg_ui_element_set_border_radius
+  );
+}
+
 void js_define_ui_element_props(
   JSContext *ctx,
   WebSGWorldData *world_data,
@@ -936,9 +1223,9 @@ void js_define_ui_element_props(
     ui_element,
     "backgroundColor",
     ui_element_id,
-    &websg_ui_element_get_background_color_element,
-    &websg_ui_element_set_background_color_element,
-    &websg_ui_element_set_background_color
+    &js_websg_ui_element_get_background_color_element,
+    &js_websg_ui_element_set_background_color_element,
+    &js_websg_ui_element_set_background_color_array
   );
 
   js_websg_define_rgba_prop(
@@ -946,9 +1233,9 @@ void js_define_ui_element_props(
     ui_element,
     "borderColor",
     ui_element_id,
-    &websg_ui_element_get_border_color_element,
-    &websg_ui_element_set_border_color_element,
-    &websg_ui_element_set_border_color
+    &js_websg_ui_element_get_border_color_element,
+    &js_websg_ui_element_set_border_color_element,
+    &js_websg_ui_element_set_border_color_array
   );
 
   js_websg_define_vector4_prop(
@@ -956,9 +1243,9 @@ void js_define_ui_element_props(
     ui_element,
     "padding",
     ui_element_id,
-    &websg_ui_element_get_padding_element,
-    &websg_ui_element_set_padding_element,
-    &websg_ui_element_set_padding
+    &js_websg_ui_element_get_padding_element,
+    &js_websg_ui_element_set_padding_element,
+    &js_websg_ui_element_set_padding_array
   );
 
   js_websg_define_vector4_prop(
@@ -966,9 +1253,9 @@ void js_define_ui_element_props(
     ui_element,
     "margin",
     ui_element_id,
-    &websg_ui_element_get_margin_element,
-    &websg_ui_element_set_margin_element,
-    &websg_ui_element_set_margin
+    &js_websg_ui_element_get_margin_element,
+    &js_websg_ui_element_set_margin_element,
+    &js_websg_ui_element_set_margin_array
   );
 
   js_websg_define_vector4_prop(
@@ -976,9 +1263,9 @@ void js_define_ui_element_props(
     ui_element,
     "borderWidth",
     ui_element_id,
-    &websg_ui_element_get_border_width_element,
-    &websg_ui_element_set_border_width_element,
-    &websg_ui_element_set_border_width
+    &js_websg_ui_element_get_border_width_element,
+    &js_websg_ui_element_set_border_width_element,
+    &js_websg_ui_element_set_border_width_array
   );
 
   js_websg_define_vector4_prop(
@@ -986,9 +1273,9 @@ void js_define_ui_element_props(
     ui_element,
     "borderRadius",
     ui_element_id,
-    &websg_ui_element_get_border_radius_element,
-    &websg_ui_element_set_border_radius_element,
-    &websg_ui_element_set_border_radius
+    &js_websg_ui_element_get_border_radius_element,
+    &js_websg_ui_element_set_border_radius_element,
+    &js_websg_ui_element_set_border_radius_array
   );
 }
 
@@ -1045,7 +1332,15 @@ int js_websg_parse_ui_element_props(
   UIElementProps *props,
   JSValueConst arg
 ) {
-  JSValue top_val = JS_GetPropertyStr(ctx, arg, "top");
+  if (JS_IsUndefined(arg)) {
+    return 0;
+  }
+
+  if (js_websg_check_props(ctx, arg, "props") < 0) {
+    return -1;
+  }
+
+  JSValue top_val = JS_WEBSG_GET_PROP(ctx, arg, top);
 
   if (!JS_IsUndefined(top_val)) {
     double_t top;
@@ -1057,7 +1352,7 @@ int js_websg_parse_ui_element_props(
     props->position[0] = (float_t)top;
   }
 
-  JSValue right_val = JS_GetPropertyStr(ctx, arg, "right");
+  JSValue right_val = JS_WEBSG_GET_PROP(ctx, arg, right);
 
   if (!JS_IsUndefined(right_val)) {
     double_t right;
@@ -1069,7 +1364,7 @@ int js_websg_parse_ui_element_props(
     props->position[1] = (float_t)right;
   }
 
-  JSValue bottom_val = JS_GetPropertyStr(ctx, arg, "bottom");
+  JSValue bottom_val = JS_WEBSG_GET_PROP(ctx, arg, bottom);
 
   if (!JS_IsUndefined(bottom_val)) {
     double_t bottom;
@@ -1081,7 +1376,7 @@ int js_websg_parse_ui_element_props(
     props->position[2] = (float_t)bottom;
   }
 
-  JSValue left_val = JS_GetPropertyStr(ctx, arg, "left");
+  JSValue left_val = JS_WEBSG_GET_PROP(ctx, arg, left);
 
   if (!JS_IsUndefined(left_val)) {
     double_t left;
@@ -1093,7 +1388,7 @@ int js_websg_parse_ui_element_props(
     props->position[3] = (float_t)left;
   }
 
-  JSValue position_val = JS_GetPropertyStr(ctx, arg, "position");
+  JSValue position_val = JS_WEBSG_GET_PROP(ctx, arg, position);
 
   if (!JS_IsUndefined(position_val)) {
     ElementPositionType position_type = get_element_position_from_atom(JS_ValueToAtom(ctx, position_val));
@@ -1106,7 +1401,7 @@ int js_websg_parse_ui_element_props(
     props->position_type = position_type;
   }
 
-  JSValue align_content_val = JS_GetPropertyStr(ctx, arg, "alignContent");
+  JSValue align_content_val = JS_WEBSG_GET_PROP(ctx, arg, alignContent);
 
   if (!JS_IsUndefined(align_content_val)) {
     FlexAlign align_content = get_flex_align_from_atom(JS_ValueToAtom(ctx, align_content_val));
@@ -1119,7 +1414,7 @@ int js_websg_parse_ui_element_props(
     props->align_content = align_content;
   }
 
-  JSValue align_items_val = JS_GetPropertyStr(ctx, arg, "alignItems");
+  JSValue align_items_val = JS_WEBSG_GET_PROP(ctx, arg, alignItems);
 
   if (!JS_IsUndefined(align_items_val)) {
     FlexAlign align_items = get_flex_align_from_atom(JS_ValueToAtom(ctx, align_items_val));
@@ -1132,7 +1427,7 @@ int js_websg_parse_ui_element_props(
     props->align_items = align_items;
   }
 
-  JSValue align_self_val = JS_GetPropertyStr(ctx, arg, "alignSelf");
+  JSValue align_self_val = JS_WEBSG_GET_PROP(ctx, arg, alignSelf);
 
   if (!JS_IsUndefined(align_self_val)) {
     FlexAlign align_self = get_flex_align_from_atom(JS_ValueToAtom(ctx, align_self_val));
@@ -1145,7 +1440,7 @@ int js_websg_parse_ui_element_props(
     props->align_self = align_self;
   }
 
-  JSValue flex_direction_val = JS_GetPropertyStr(ctx, arg, "flexDirection");
+  JSValue flex_direction_val = JS_WEBSG_GET_PROP(ctx, arg, flexDirection);
 
   if (!JS_IsUndefined(flex_direction_val)) {
     FlexDirection flex_direction = get_flex_direction_from_atom(JS_ValueToAtom(ctx, flex_direction_val));
@@ -1158,7 +1453,7 @@ int js_websg_parse_ui_element_props(
     props->flex_direction = flex_direction;
   }
 
-  JSValue flex_wrap_val = JS_GetPropertyStr(ctx, arg, "flexWrap");
+  JSValue flex_wrap_val = JS_WEBSG_GET_PROP(ctx, arg, flexWrap);
 
   if (!JS_IsUndefined(flex_wrap_val)) {
     FlexWrap flex_wrap = get_flex_wrap_from_atom(JS_ValueToAtom(ctx, flex_wrap_val));
@@ -1171,7 +1466,7 @@ int js_websg_parse_ui_element_props(
     props->flex_wrap = flex_wrap;
   }
 
-  JSValue flex_basis_val = JS_GetPropertyStr(ctx, arg, "flexBasis");
+  JSValue flex_basis_val = JS_WEBSG_GET_PROP(ctx, arg, flexBasis);
 
   if (!JS_IsUndefined(flex_basis_val)) {
     double_t flex_basis;
@@ -1183,7 +1478,7 @@ int js_websg_parse_ui_element_props(
     props->flex_basis = (float_t)flex_basis;
   }
 
-  JSValue flex_grow_val = JS_GetPropertyStr(ctx, arg, "flexGrow");
+  JSValue flex_grow_val = JS_WEBSG_GET_PROP(ctx, arg, flexGrow);
 
   if (!JS_IsUndefined(flex_grow_val)) {
     double_t flex_grow;
@@ -1195,7 +1490,7 @@ int js_websg_parse_ui_element_props(
     props->flex_grow = (float_t)flex_grow;
   }
 
-  JSValue flex_shrink_val = JS_GetPropertyStr(ctx, arg, "flexShrink");
+  JSValue flex_shrink_val = JS_WEBSG_GET_PROP(ctx, arg, flexShrink);
 
   if (!JS_IsUndefined(flex_shrink_val)) {
     double_t flex_shrink;
@@ -1207,7 +1502,7 @@ int js_websg_parse_ui_element_props(
     props->flex_shrink = (float_t)flex_shrink;
   }
 
-  JSValue justify_content_val = JS_GetPropertyStr(ctx, arg, "justifyContent");
+  JSValue justify_content_val = JS_WEBSG_GET_PROP(ctx, arg, justifyContent);
 
   if (!JS_IsUndefined(justify_content_val)) {
     FlexJustify justify_content = get_flex_justify_from_atom(JS_ValueToAtom(ctx, justify_content_val));
@@ -1220,7 +1515,7 @@ int js_websg_parse_ui_element_props(
     props->justify_content = justify_content;
   }
 
-  JSValue width_val = JS_GetPropertyStr(ctx, arg, "width");
+  JSValue width_val = JS_WEBSG_GET_PROP(ctx, arg, width);
 
   if (!JS_IsUndefined(width_val)) {
     double_t width;
@@ -1232,7 +1527,7 @@ int js_websg_parse_ui_element_props(
     props->width = (float_t)width;
   }
 
-  JSValue height_val = JS_GetPropertyStr(ctx, arg, "height");
+  JSValue height_val = JS_WEBSG_GET_PROP(ctx, arg, height);
 
   if (!JS_IsUndefined(height_val)) {
     double_t height;
@@ -1244,7 +1539,7 @@ int js_websg_parse_ui_element_props(
     props->height = (float_t)height;
   }
 
-  JSValue min_width_val = JS_GetPropertyStr(ctx, arg, "minWidth");
+  JSValue min_width_val = JS_WEBSG_GET_PROP(ctx, arg, minWidth);
 
   if (!JS_IsUndefined(min_width_val)) {
     double_t min_width;
@@ -1256,7 +1551,7 @@ int js_websg_parse_ui_element_props(
     props->min_width = (float_t)min_width;
   }
 
-  JSValue min_height_val = JS_GetPropertyStr(ctx, arg, "minHeight");
+  JSValue min_height_val = JS_WEBSG_GET_PROP(ctx, arg, minHeight);
 
   if (!JS_IsUndefined(min_height_val)) {
     double_t min_height;
@@ -1268,7 +1563,7 @@ int js_websg_parse_ui_element_props(
     props->min_height = (float_t)min_height;
   }
 
-  JSValue max_width_val = JS_GetPropertyStr(ctx, arg, "maxWidth");
+  JSValue max_width_val = JS_WEBSG_GET_PROP(ctx, arg, maxWidth);
 
   if (!JS_IsUndefined(max_width_val)) {
     double_t max_width;
@@ -1280,7 +1575,7 @@ int js_websg_parse_ui_element_props(
     props->max_width = (float_t)max_width;
   }
 
-  JSValue max_height_val = JS_GetPropertyStr(ctx, arg, "maxHeight");
+  JSValue max_height_val = JS_WEBSG_GET_PROP(ctx, arg, maxHeight);
 
   if (!JS_IsUndefined(max_height_val)) {
     double_t max_height;
@@ -1292,7 +1587,7 @@ int js_websg_parse_ui_element_props(
     props->max_height = (float_t)max_height;
   }
 
-  JSValue background_color_val = JS_GetPropertyStr(ctx, arg, "backgroundColor");
+  JSValue background_color_val = JS_WEBSG_GET_PROP(ctx, arg, backgroundColor);
 
   if (!JS_IsUndefined(background_color_val)) {
     if (js_get_float_array_like(ctx, background_color_val, props->background_color, 4) < 0) {
@@ -1300,7 +1595,7 @@ int js_websg_parse_ui_element_props(
     }
   }
 
-  JSValue border_color_val = JS_GetPropertyStr(ctx, arg, "borderColor");
+  JSValue border_color_val = JS_WEBSG_GET_PROP(ctx, arg, borderColor);
 
   if (!JS_IsUndefined(border_color_val)) {
     if (js_get_float_array_like(ctx, border_color_val, props->border_color, 4) < 0) {
@@ -1308,7 +1603,7 @@ int js_websg_parse_ui_element_props(
     }
   }
 
-  JSValue padding_val = JS_GetPropertyStr(ctx, arg, "padding");
+  JSValue padding_val = JS_WEBSG_GET_PROP(ctx, arg, padding);
 
   if (!JS_IsUndefined(padding_val)) {
     if (js_get_float_array_like(ctx, padding_val, props->padding, 4) < 0) {
@@ -1316,7 +1611,7 @@ int js_websg_parse_ui_element_props(
     }
   }
 
-  JSValue margin_val = JS_GetPropertyStr(ctx, arg, "margin");
+  JSValue margin_val = JS_WEBSG_GET_PROP(ctx, arg, margin);
 
   if (!JS_IsUndefined(margin_val)) {
     if (js_get_float_array_like(ctx, margin_val, props->margin, 4) < 0) {
@@ -1324,7 +1619,7 @@ int js_websg_parse_ui_element_props(
     }
   }
 
-  JSValue border_width_val = JS_GetPropertyStr(ctx, arg, "borderWidth");
+  JSValue border_width_val = JS_WEBSG_GET_PROP(ctx, arg, borderWidth);
 
   if (!JS_IsUndefined(border_width_val)) {
     if (js_get_float_array_like(ctx, border_width_val, props->border_width, 4) < 0) {
@@ -1332,7 +1627,7 @@ int js_websg_parse_ui_element_props(
     }
   }
 
-  JSValue border_radius_val = JS_GetPropertyStr(ctx, arg, "borderRadius");
+  JSValue border_radius_val = JS_WEBSG_GET_PROP(ctx, arg, borderRadius);
 
   if (!JS_IsUndefined(border_radius_val)) {
     if (js_get_float_array_like(ctx, border_radius_val, props->border_radius, 4) < 0) {
@@ -1396,4 +1691,86 @@ JSValue js_websg_world_find_ui_element_by_name(JSContext *ctx, JSValueConst this
   }
 
   return js_websg_get_ui_element_by_id(ctx, world_data, ui_element_id);
-}
\ No newline at end of file
+}
+
+static int js_websg_is_array_buffer(JSContext *ctx, JSValueConst value) {
+  JSValue global = JS_GetGlobalObject(ctx);
+  JSValue array_buffer = JS_GetPropertyStr(ctx, global, "ArrayBuffer");
+  int result = JS_IsInstanceOf(ctx, value, array_buffer);
+  JS_FreeValue(ctx, array_buffer);
+  JS_FreeValue(ctx, global);
+  return result;
+}
+
+JSValue js_websg_world_create_ui_tree(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  WebSGWorldData *world_data = JS_GetOpaque(this_val, js_websg_world_class_id);
+
+  DynBuf description;
+  js_cbor_buf_init(ctx, &description);
+
+  const uint8_t *data;
+  size_t byte_length;
+
+  int is_array_buffer = js_websg_is_array_buffer(ctx, argv[0]);
+
+  if (is_array_buffer == -1) {
+    return JS_EXCEPTION;
+  }
+
+  // an ArrayBuffer is an already encoded description, which lets scripts reuse the encoding for repeated trees
+  if (is_array_buffer) {
+    data = JS_GetArrayBuffer(ctx, &byte_length, argv[0]);
+
+    if (data == NULL) {
+      return JS_EXCEPTION;
+    }
+  } else {
+    if (js_cbor_encode(ctx, &description, argv[0]) == -1) {
+      dbuf_free(&description);
+      return JS_EXCEPTION;
+    }
+
+    data = description.buf;
+    byte_length = description.size;
+  }
+
+  // every element takes at least one byte of the description, so this always fits the whole tree
+  ui_element_id_t *element_ids = js_malloc(ctx, sizeof(ui_element_id_t) * (byte_length > 0 ? byte_length : 1));
+
+  if (element_ids == NULL) {
+    dbuf_free(&description);
+    return JS_EXCEPTION;
+  }
+
+  int32_t count = websg_world_create_ui_tree(data, byte_length, element_ids, byte_length);
+
+  dbuf_free(&description);
+
+  if (count <= 0) {
+    js_free(ctx, element_ids);
+    JS_ThrowInternalError(ctx, "WebSG UI: Error creating UI tree.");
+    return JS_EXCEPTION;
+  }
+
+  JSValue elements = JS_NewArray(ctx);
+
+  for (int32_t i = 0; i < count; i++) {
+    JSValue element = js_websg_get_ui_element_by_id(ctx, world_data, element_ids[i]);
+
+    if (JS_IsException(element)) {
+      js_free(ctx, element_ids);
+      JS_FreeValue(ctx, elements);
+      return JS_EXCEPTION;
+    }
+
+    JS_SetPropertyUint32(ctx, elements, i, element);
+  }
+
+  js_free(ctx, element_ids);
+
+  JSValue tree = JS_NewObject(ctx);
+  JS_SetPropertyStr(ctx, tree, "root", JS_GetPropertyUint32(ctx, elements, 0));
+  JS_SetPropertyStr(ctx, tree, "elements", elements);
+
+  return tree;
+}
@@ -31,6 +31,8 @@ int js_websg_parse_ui_element_props(
   JSValueConst arg
 );
 
+JSValue js_websg_world_create_ui_tree(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv);
+
 JSValue js_websg_world_find_ui_element_by_name(
   JSContext *ctx,
   JSValueConst this_val,
@@ -5,8 +5,11 @@
 #include "./websg-js.h"
 #include "./ui-element.h"
 #include "./ui-text.h"
+#include "./ui-canvas.h"
 #include "./rgba.h"
+#include "./props.h"
 #include "../utils/array.h"
+#include "../utils/string-scratch.h"
 
 JSClassID js_websg_ui_text_class_id;
 
@@ -30,9 +33,15 @@ static JSClassDef js_websg_ui_text_class = {
 static JSValue js_websg_ui_text_get_value(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_text_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   int32_t length = websg_ui_text_get_value_length(ui_text_data->ui_element_id);
 
-  const char *str = js_mallocz(ctx, sizeof(char) * length);
+  char *str = js_get_string_scratch(ctx, length);
+
+  if (str == NULL) {
+    return JS_EXCEPTION;
+  }
 
   int32_t result = websg_ui_text_get_value(ui_text_data->ui_element_id, str, length);
 
@@ -54,6 +63,12 @@ static JSValue js_websg_ui_text_set_value(JSContext *ctx, JSValueConst this_val,
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record_string(ui_text_data->ui_element_id, UIProperty_TEXT_VALUE, value, length);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_text_set_value(ui_text_data->ui_element_id, value, length);
 
   if (result == -1) {
@@ -67,9 +82,15 @@ static JSValue js_websg_ui_text_set_value(JSContext *ctx, JSValueConst this_val,
 static JSValue js_websg_ui_text_get_font_family(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_text_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   int32_t length = websg_ui_text_get_font_family_length(ui_text_data->ui_element_id);
 
-  const char *str = js_mallocz(ctx, sizeof(char) * length);
+  char *str = js_get_string_scratch(ctx, length);
+
+  if (str == NULL) {
+    return JS_EXCEPTION;
+  }
 
   int32_t result = websg_ui_text_get_font_family(ui_text_data->ui_element_id, str, length);
 
@@ -91,6 +112,12 @@ static JSValue js_websg_ui_text_set_font_family(JSContext *ctx, JSValueConst thi
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record_string(ui_text_data->ui_element_id, UIProperty_TEXT_FONT_FAMILY, font_family, length);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_text_set_font_family(ui_text_data->ui_element_id, font_family, length);
 
   if (result == -1) {
@@ -104,9 +131,15 @@ static JSValue js_websg_ui_text_set_font_family(JSContext *ctx, JSValueConst thi
 static JSValue js_websg_ui_text_get_font_weight(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_text_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   int32_t length = websg_ui_text_get_font_weight_length(ui_text_data->ui_element_id);
 
-  const char *str = js_mallocz(ctx, sizeof(char) * length);
+  char *str = js_get_string_scratch(ctx, length);
+
+  if (str == NULL) {
+    return JS_EXCEPTION;
+  }
 
   int32_t result = websg_ui_text_get_font_weight(ui_text_data->ui_element_id, str, length);
 
@@ -128,6 +161,12 @@ static JSValue js_websg_ui_text_set_font_weight(JSContext *ctx, JSValueConst thi
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record_string(ui_text_data->ui_element_id, UIProperty_TEXT_FONT_WEIGHT, font_weight, length);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_text_set_font_weight(ui_text_data->ui_element_id, font_weight, length);
 
   if (result == -1) {
@@ -141,6 +180,8 @@ static JSValue js_websg_ui_text_set_font_weight(JSContext *ctx, JSValueConst thi
 static JSValue js_websg_ui_text_get_font_size(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_text_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   float_t result = websg_ui_text_get_font_size(ui_text_data->ui_element_id);
 
   return JS_NewFloat64(ctx, result);
@@ -155,6 +196,12 @@ static JSValue js_websg_ui_text_set_font_size(JSContext *ctx, JSValueConst this_
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record(ui_text_data->ui_element_id, UIProperty_TEXT_FONT_SIZE, 0, (float_t)value);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_text_set_font_size(ui_text_data->ui_element_id, (float_t)value);
 
   if (result == -1) {
@@ -168,9 +215,15 @@ static JSValue js_websg_ui_text_set_font_size(JSContext *ctx, JSValueConst this_
 static JSValue js_websg_ui_text_get_font_style(JSContext *ctx, JSValueConst this_val) {
   WebSGUIElementData *ui_text_data = JS_GetOpaque_UNSAFE(this_val);
 
+  js_websg_ui_batch_flush();
+
   int32_t length = websg_ui_text_get_font_style_length(ui_text_data->ui_element_id);
 
-  const char *str = js_mallocz(ctx, sizeof(char) * length);
+  char *str = js_get_string_scratch(ctx, length);
+
+  if (str == NULL) {
+    return JS_EXCEPTION;
+  }
 
   int32_t result = websg_ui_text_get_font_style(ui_text_data->ui_element_id, str, length);
 
@@ -192,6 +245,12 @@ static JSValue js_websg_ui_text_set_font_style(JSContext *ctx, JSValueConst this
     return JS_EXCEPTION;
   }
 
+  int recorded = js_websg_ui_batch_record_string(ui_text_data->ui_element_id, UIProperty_TEXT_FONT_STYLE, font_style, length);
+
+  if (recorded != 0) {
+    return recorded == 1 ? JS_UNDEFINED : JS_EXCEPTION;
+  }
+
   int32_t result = websg_ui_text_set_font_style(ui_text_data->ui_element_id, font_style, length);
 
   if (result == -1) {
@@ -212,6 +271,30 @@ static JSValue js_websg_ui_text_remove_child(JSContext *ctx, JSValueConst this_v
   return JS_EXCEPTION;
 }
 
+static float_t js_websg_ui_text_get_color_element(uint32_t ui_element_id, uint32_t index) {
+  return js_websg_ui_batch_get_element(ui_element_id, index, &websg_ui_text_get_color_element);
+}
+
+static int32_t js_websg_ui_text_set_color_element(uint32_t ui_element_id, uint32_t index, float_t value) {
+  return js_websg_ui_batch_set_element(
+    ui_element_id,
+    UIProperty_TEXT_COLOR,
+    index,
+    value,
+    &websg_ui_text_set_color_element
+  );
+}
+
+static int32_t js_websg_ui_text_set_color_array(uint32_t ui_element_id, float_t *array) {
+  return js_websg_ui_batch_set_array(
+    ui_element_id,
+    UIProperty_TEXT_COLOR,
+    array,
+    4,
+    &websg_ui_text_set_color
+  );
+}
+
 static const JSCFunctionListEntry js_websg_ui_text_proto_funcs[] = {
   JS_CGETSET_DEF("value", js_websg_ui_text_get_value, js_websg_ui_text_set_value),
   JS_CGETSET_DEF("fontFamily", js_websg_ui_text_get_font_family, js_websg_ui_text_set_font_family),
@@ -266,9 +349,9 @@ void js_define_ui_text_props(
     ui_text,
     "color",
     ui_element_id,
-    &websg_ui_text_get_color_element,
-    &websg_ui_text_set_color_element,
-    &websg_ui_text_set_color
+    &js_websg_ui_text_get_color_element,
+    &js_websg_ui_text_set_color_element,
+    &js_websg_ui_text_set_color_array
   );
 }
 
@@ -301,7 +384,11 @@ int js_websg_parse_ui_text_props(
   UITextProps *props,
   JSValueConst arg
 ) {
-  JSValue value_val = JS_GetPropertyStr(ctx, arg, "value");
+  if (JS_IsUndefined(arg)) {
+    return 0;
+  }
+
+  JSValue value_val = JS_WEBSG_GET_PROP(ctx, arg, value);
 
   if (!JS_IsUndefined(value_val)) {
     size_t value_len;
@@ -313,7 +400,7 @@ int js_websg_parse_ui_text_props(
     }
   }
 
-  JSValue font_family_val = JS_GetPropertyStr(ctx, arg, "fontFamily");
+  JSValue font_family_val = JS_WEBSG_GET_PROP(ctx, arg, fontFamily);
 
   if (!JS_IsUndefined(font_family_val)) {
     size_t font_style_len;
@@ -325,7 +412,7 @@ int js_websg_parse_ui_text_props(
     }
   }
 
-  JSValue font_style_val = JS_GetPropertyStr(ctx, arg, "fontStyle");
+  JSValue font_style_val = JS_WEBSG_GET_PROP(ctx, arg, fontStyle);
 
   if (!JS_IsUndefined(font_style_val)) {
     size_t font_style_len;
@@ -337,7 +424,7 @@ int js_websg_parse_ui_text_props(
     }
   }
 
-  JSValue font_weight_val = JS_GetPropertyStr(ctx, arg, "fontWeight");
+  JSValue font_weight_val = JS_WEBSG_GET_PROP(ctx, arg, fontWeight);
 
   if (!JS_IsUndefined(font_weight_val)) {
     size_t font_weight_len;
@@ -349,7 +436,7 @@ int js_websg_parse_ui_text_props(
     }
   }
 
-  JSValue color_val = JS_GetPropertyStr(ctx, arg, "color");
+  JSValue color_val = JS_WEBSG_GET_PROP(ctx, arg, color);
 
   if (!JS_IsUndefined(color_val)) {
     if (js_get_float_array_like(ctx, color_val, props->color, 4) < 0) {
@@ -362,7 +449,7 @@ int js_websg_parse_ui_text_props(
     props->color[3] = 1.0f;
   }
 
-  JSValue font_size_val = JS_GetPropertyStr(ctx, arg, "fontSize");
+  JSValue font_size_val = JS_WEBSG_GET_PROP(ctx, arg, fontSize);
 
   if (!JS_IsUndefined(font_size_val)) {
     double_t font_size;
@@ -10,6 +10,7 @@
 #include "./accessor.h"
 #include "./collider.h"
 #include "./interactable.h"
+#include "./interpolation-buffer.h"
 #include "./light.h"
 #include "./material.h"
 #include "./matrix4.h"
@@ -18,6 +19,9 @@
 #include "./node.h"
 #include "./node-iterator.h"
 #include "./physics-body.h"
+#include "./physics-body-batch.h"
+#include "./character-controller.h"
+#include "./physics-query.h"
 #include "./quaternion.h"
 #include "./rgb.h"
 #include "./rgba.h"
@@ -38,15 +42,19 @@
 #include "./collision-iterator.h"
 #include "./collision-listener.h"
 #include "./collision.h"
+#include "./props.h"
 
 void js_define_websg_api(JSContext *ctx) {
   JSValue global = JS_GetGlobalObject(ctx);
 
   JSValue websg = JS_NewObject(ctx);
 
+  js_websg_define_props(ctx);
+
   js_websg_define_accessor(ctx, websg);
   js_websg_define_collider(ctx, websg);
   js_websg_define_interactable(ctx, websg);
+  js_websg_define_interpolation_buffer(ctx, websg);
   js_websg_define_light(ctx, websg);
   js_websg_define_material(ctx, websg);
   js_websg_define_matrix4(ctx, websg);
@@ -55,6 +63,9 @@ void js_define_websg_api(JSContext *ctx) {
   js_websg_define_node(ctx, websg);
   js_websg_define_node_iterator(ctx);
   js_websg_define_physics_body(ctx, websg);
+  js_websg_define_physics_body_batch(ctx, websg);
+  js_websg_define_character_controller(ctx, websg);
+  js_websg_define_physics_hit(ctx, websg);
   js_websg_define_quaternion(ctx, websg);
   js_websg_define_rgb(ctx, websg);
   js_websg_define_rgba(ctx, websg);
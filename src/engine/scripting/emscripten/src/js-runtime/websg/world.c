@@ -23,6 +23,9 @@
 #include "./component-store.h"
 #include "./query.h"
 #include "./collision-listener.h"
+#include "./physics-query.h"
+#include "./physics-body.h"
+#include "./physics-body-batch.h"
 #include "./vector3.h"
 
 JSClassID js_websg_world_class_id;
@@ -92,6 +95,7 @@ static const JSCFunctionListEntry js_websg_world_proto_funcs[] = {
   JS_CFUNC_DEF("createAccessorFrom", 1, js_websg_world_create_accessor_from),
   JS_CFUNC_DEF("findAccessorByName", 1, js_websg_world_find_accessor_by_name),
   JS_CFUNC_DEF("createCollider", 1, js_websg_world_create_collider),
+  JS_CFUNC_DEF("createColliderFromMesh", 2, js_websg_world_create_collider_from_mesh),
   JS_CFUNC_DEF("findColliderByName", 1, js_websg_world_find_collider_by_name),
   JS_CFUNC_DEF("createLight", 1, js_websg_world_create_light),
   JS_CFUNC_DEF("findLightByName", 1, js_websg_world_find_light_by_name),
@@ -112,6 +116,7 @@ static const JSCFunctionListEntry js_websg_world_proto_funcs[] = {
   JS_CFUNC_DEF("createUIElement", 1, js_websg_world_create_ui_element),
   JS_CFUNC_DEF("createUIText", 1, js_websg_world_create_ui_text),
   JS_CFUNC_DEF("createUIButton", 1, js_websg_world_create_ui_button),
+  JS_CFUNC_DEF("createUITree", 1, js_websg_world_create_ui_tree),
   JS_CFUNC_DEF("findUIElementByName", 1, js_websg_world_find_ui_element_by_name),
   JS_CFUNC_DEF("findComponentStoreByName", 1, js_websg_world_find_component_store_by_name),
   JS_CGETSET_DEF(
@@ -119,7 +124,15 @@ static const JSCFunctionListEntry js_websg_world_proto_funcs[] = {
     js_websg_world_get_component_store_size,
     js_websg_world_set_component_store_size
   ),
-  JS_CFUNC_DEF("createCollisionListener", 0, js_websg_world_create_collision_listener),
+  JS_CFUNC_DEF("createCollisionListener", 1, js_websg_world_create_collision_listener),
+  JS_CFUNC_DEF("castRay", 3, js_websg_world_cast_ray),
+  JS_CFUNC_DEF("castRays", 2, js_websg_world_cast_rays),
+  JS_CFUNC_DEF("castShape", 4, js_websg_world_cast_shape),
+  JS_CFUNC_DEF("castShapes", 3, js_websg_world_cast_shapes),
+  JS_CFUNC_DEF("overlapSphere", 4, js_websg_world_overlap_sphere),
+  JS_CFUNC_DEF("overlapBox", 4, js_websg_world_overlap_box),
+  JS_CFUNC_DEF("createPhysicsBodyBatch", 1, js_websg_world_create_physics_body_batch),
+  JS_CFUNC_DEF("getActiveBodies", 1, js_websg_world_get_active_bodies),
   JS_CFUNC_DEF("stopOrbit", 0, js_websg_world_stop_orbit),
   JS_CFUNC_DEF("createQuery", 1, js_websg_world_create_query),
   JS_PROP_STRING_DEF("[Symbol.toStringTag]", "World", JS_PROP_CONFIGURABLE),
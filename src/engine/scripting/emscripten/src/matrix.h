@@ -10,20 +10,51 @@ import_matrix(listen) int32_t matrix_listen();
 // Returns 0 if successful and -1 if there was an error.
 import_matrix(close) int32_t matrix_close();
 
-// Sends JSON encoded event from the provided buffer with the provided byte length
+// Only delivers room events sent to the widget that match at least one registered filter. Other widget API
+// messages are always delivered. Pass NULL for a field to match any value.
 // Returns 0 if successful and -1 if there was an error.
-import_matrix(send) int32_t matrix_send(const char *event, uint32_t byte_length);
+import_matrix(add_event_filter) int32_t matrix_add_event_filter(
+  const char *type,
+  uint32_t type_length,
+  const char *state_key,
+  uint32_t state_key_length,
+  const char *sender,
+  uint32_t sender_length
+);
+
+// Removes all event filters so that every event is delivered again.
+// Returns 0 if successful and -1 if there was an error.
+import_matrix(clear_event_filters) int32_t matrix_clear_event_filters();
+
+// The send, get_event_size and receive imports pass events as JSON strings and are only kept for runtimes built
+// before events were CBOR encoded, the _cbor imports replace them.
+
+// Sends a CBOR encoded event from the provided buffer with the provided byte length
+// Returns 0 if successful and -1 if there was an error.
+import_matrix(send_cbor) int32_t matrix_send_cbor(const uint8_t *event, uint32_t byte_length);
 
-// Gets the next event's byte length.
+// Gets the next event's CBOR encoded byte length.
 // Returns 0 if there is no event.
 // Does not pop the event off the queue.
-import_matrix(get_event_size) uint32_t matrix_get_event_size();
+import_matrix(get_event_size_cbor) uint32_t matrix_get_event_size_cbor();
 
-// Pops the most recent event off the queue and writes its JSON into the provided buffer
+// Pops the most recent event off the queue and writes its CBOR encoding into the provided buffer
 // Errors if event larger than max byte length.
 // Returns the number of bytes written into the buffer. 0 if there was no event and -1 if there was an error.
-import_matrix(receive) int32_t matrix_receive(
-  const char *event,
+import_matrix(receive_cbor) int32_t matrix_receive_cbor(
+  uint8_t *event,
+  uint32_t max_byte_length
+);
+
+// Gets the byte length of all queued events encoded as a single CBOR array.
+// Returns 0 if there are no events.
+import_matrix(get_events_size) uint32_t matrix_get_events_size();
+
+// Writes all queued events, oldest first, into the provided buffer as a single CBOR array and clears the queue.
+// Errors if the events are larger than max byte length.
+// Returns the number of bytes written into the buffer. 0 if there were no events and -1 if there was an error.
+import_matrix(receive_events) int32_t matrix_receive_events(
+  uint8_t *events,
   uint32_t max_byte_length
 );
 
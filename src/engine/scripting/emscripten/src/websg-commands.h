@@ -0,0 +1,41 @@
+// Generated from the Commands IDL module by src/engine/scripting/idl/generate.ts. Do not edit.
+#ifndef __websg_commands_generated_h
+#define __websg_commands_generated_h
+
+typedef enum WebSGCommandType {
+  WebSGCommandType_NODE_SET_TRANSLATION,
+  WebSGCommandType_NODE_SET_TRANSLATION_ELEMENT,
+  WebSGCommandType_NODE_SET_ROTATION,
+  WebSGCommandType_NODE_SET_ROTATION_ELEMENT,
+  WebSGCommandType_NODE_SET_SCALE,
+  WebSGCommandType_NODE_SET_SCALE_ELEMENT,
+  WebSGCommandType_NODE_SET_VISIBLE,
+  WebSGCommandType_MATERIAL_SET_BASE_COLOR_FACTOR,
+  WebSGCommandType_MATERIAL_SET_BASE_COLOR_FACTOR_ELEMENT,
+  WebSGCommandType_LIGHT_SET_COLOR,
+  WebSGCommandType_LIGHT_SET_COLOR_ELEMENT,
+  WebSGCommandType_LIGHT_SET_INTENSITY,
+  WebSGCommandType_PHYSICS_BODY_APPLY_IMPULSE,
+} WebSGCommandType;
+
+typedef struct WebSGCommand {
+  WebSGCommandType type;
+  uint32_t resource_id;
+  // component of _ELEMENT commands
+  uint32_t index;
+  // the whole vector, or the element or scalar in value[0]
+  float_t value[4];
+} WebSGCommand;
+
+#if defined(__wasm32__)
+#include <stddef.h>
+
+_Static_assert(offsetof(WebSGCommand, type) == 0, "WebSGCommand.type");
+_Static_assert(offsetof(WebSGCommand, resource_id) == 4, "WebSGCommand.resource_id");
+_Static_assert(offsetof(WebSGCommand, index) == 8, "WebSGCommand.index");
+_Static_assert(offsetof(WebSGCommand, value) == 12, "WebSGCommand.value");
+_Static_assert(sizeof(WebSGCommand) == 28, "WebSGCommand");
+
+#endif
+
+#endif
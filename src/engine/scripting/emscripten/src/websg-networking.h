@@ -23,12 +23,32 @@ import_websg_networking(peer_is_host) int32_t websg_peer_is_host(uint32_t peer_i
 import_websg_networking(peer_is_local) int32_t websg_peer_is_local(uint32_t peer_index);
 import_websg_networking(peer_send) int32_t websg_peer_send(uint32_t peer_index, uint8_t *packet, uint32_t byte_length, uint32_t binary, uint32_t reliable);
 
+typedef struct NetworkStats {
+  uint32_t bytes_sent;
+  uint32_t messages_sent;
+  uint32_t bytes_received;
+  uint32_t messages_received;
+  // Smoothed round trip time in milliseconds. Averaged across connected peers for script stats, 0 for listener stats.
+  float_t rtt;
+  float_t packet_loss; // Estimated fraction of lost packets (0 - 1). Averaged like rtt.
+  uint32_t messages_dropped; // Messages that weren't sent because the outgoing queue was full. 0 for listener stats.
+} NetworkStats;
+
+// Fills the stats struct with the traffic exchanged with this peer by the whole engine.
+// Returns 0 if successful, -1 on error.
+import_websg_networking(peer_get_stats) int32_t websg_peer_get_stats(uint32_t peer_index, NetworkStats *stats);
+
 import_websg_networking(network_get_host_peer_index) uint32_t websg_network_get_host_peer_index();
 import_websg_networking(network_get_local_peer_index) uint32_t websg_network_get_local_peer_index();
 import_websg_networking(network_broadcast) int32_t websg_network_broadcast(uint8_t *packet, uint32_t byte_length, uint32_t binary, uint32_t reliable);
 
+// Fills the stats struct with the messages sent and received by this script.
+// rtt and packet_loss are averaged across all connected peers.
+import_websg_networking(network_get_stats) int32_t websg_network_get_stats(NetworkStats *stats);
+
 import_websg_networking(network_listen) network_listener_id_t websg_network_listen();
 import_websg_networking(network_listener_close) int32_t websg_network_listener_close(network_listener_id_t listener_id);
+import_websg_networking(network_listener_get_stats) int32_t websg_network_listener_get_stats(network_listener_id_t listener_id, NetworkStats *stats);
 
 typedef struct NetworkMessageInfo {
   uint32_t peer_index;
@@ -89,6 +109,12 @@ typedef struct NetworkSynchronizerProps {
   replicator_id_t replicator_id;
 } NetworkSynchronizerProps;
 
+// Sets the priority multiplier used when scheduling this node's updates within each peer's bandwidth budget.
+// 1.0 is the default priority. Higher values are sent more often, 0 only sends the node when there is budget left over.
+// Returns 0 if successful
+// Returns -1 on error
+import_websg_networking(node_set_network_priority) int32_t websg_node_set_network_priority(node_id_t node_id, float_t priority);
+
 // Returns 0 if successful
 // Returns -1 on error
 import_websg_networking(node_add_network_synchronizer) int32_t websg_node_add_network_synchronizer(node_id_t node_id,  NetworkSynchronizerProps *props);
@@ -0,0 +1,235 @@
+// Generated from the UI IDL module by src/engine/scripting/idl/generate.ts. Do not edit.
+#ifndef __websg_ui_generated_h
+#define __websg_ui_generated_h
+
+typedef enum ElementType {
+  ElementType_FLEX,
+  ElementType_TEXT,
+  ElementType_BUTTON,
+  ElementType_IMAGE,
+} ElementType;
+
+typedef enum FlexDirection {
+  FlexDirection_COLUMN,
+  FlexDirection_COLUMN_REVERSE,
+  FlexDirection_ROW,
+  FlexDirection_ROW_REVERSE,
+} FlexDirection;
+
+typedef enum ElementPositionType {
+  ElementPositionType_STATIC,
+  ElementPositionType_RELATIVE,
+  ElementPositionType_ABSOLUTE,
+} ElementPositionType;
+
+typedef enum FlexAlign {
+  FlexAlign_AUTO,
+  FlexAlign_FLEX_START,
+  FlexAlign_CENTER,
+  FlexAlign_FLEX_END,
+  FlexAlign_STRETCH,
+  FlexAlign_BASELINE,
+  FlexAlign_SPACE_BETWEEN,
+  FlexAlign_SPACE_AROUND,
+} FlexAlign;
+
+typedef enum FlexJustify {
+  FlexJustify_FLEX_START,
+  FlexJustify_CENTER,
+  FlexJustify_FLEX_END,
+  FlexJustify_SPACE_BETWEEN,
+  FlexJustify_SPACE_AROUND,
+  FlexJustify_SPACE_EVENLY,
+} FlexJustify;
+
+typedef enum FlexWrap {
+  FlexWrap_NO_WRAP,
+  FlexWrap_WRAP,
+  FlexWrap_WRAP_REVERSE,
+} FlexWrap;
+
+typedef enum UIProperty {
+  UIProperty_POSITION_TYPE,
+  UIProperty_POSITION,
+  UIProperty_ALIGN_CONTENT,
+  UIProperty_ALIGN_ITEMS,
+  UIProperty_ALIGN_SELF,
+  UIProperty_FLEX_DIRECTION,
+  UIProperty_FLEX_WRAP,
+  UIProperty_FLEX_BASIS,
+  UIProperty_FLEX_GROW,
+  UIProperty_FLEX_SHRINK,
+  UIProperty_JUSTIFY_CONTENT,
+  UIProperty_WIDTH,
+  UIProperty_HEIGHT,
+  UIProperty_MIN_WIDTH,
+  UIProperty_MIN_HEIGHT,
+  UIProperty_MAX_WIDTH,
+  UIProperty_MAX_HEIGHT,
+  UIProperty_BACKGROUND_COLOR,
+  UIProperty_BORDER_COLOR,
+  UIProperty_PADDING,
+  UIProperty_MARGIN,
+  UIProperty_BORDER_WIDTH,
+  UIProperty_BORDER_RADIUS,
+  UIProperty_BUTTON_LABEL,
+  UIProperty_TEXT_VALUE,
+  UIProperty_TEXT_FONT_FAMILY,
+  UIProperty_TEXT_FONT_STYLE,
+  UIProperty_TEXT_FONT_WEIGHT,
+  UIProperty_TEXT_FONT_SIZE,
+  UIProperty_TEXT_COLOR,
+} UIProperty;
+
+typedef struct UIExtensionNodeCanvasRef {
+  Extensions extensions;
+  void *extras;
+  ui_canvas_id_t canvas;
+} UIExtensionNodeCanvasRef;
+
+typedef struct UICanvasProps {
+  const char *name;
+  Extensions extensions;
+  void *extras;
+  ui_element_id_t root;
+  float_t size[2];
+  float_t width;
+  float_t height;
+} UICanvasProps;
+
+typedef struct UIButtonProps {
+  Extensions extensions;
+  void *extras;
+  WebSGString label;
+} UIButtonProps;
+
+typedef struct UITextProps {
+  Extensions extensions;
+  void *extras;
+  WebSGString value;
+  WebSGString font_family;
+  WebSGString font_weight;
+  WebSGString font_style;
+  float_t font_size;
+  float_t color[4];
+} UITextProps;
+
+typedef struct UIElementProps {
+  const char *name;
+  Extensions extensions;
+  void *extras;
+  ElementType type;
+  float_t position[4];
+  ElementPositionType position_type;
+  FlexAlign align_content;
+  FlexAlign align_items;
+  FlexAlign align_self;
+  FlexDirection flex_direction;
+  FlexWrap flex_wrap;
+  float_t flex_basis;
+  float_t flex_grow;
+  float_t flex_shrink;
+  FlexJustify justify_content;
+  float_t width;
+  float_t height;
+  float_t min_width;
+  float_t min_height;
+  float_t max_width;
+  float_t max_height;
+  float_t background_color[4];
+  float_t border_color[4];
+  float_t padding[4];
+  float_t margin[4];
+  float_t border_width[4];
+  float_t border_radius[4];
+  UIButtonProps *button;
+  UITextProps *text;
+} UIElementProps;
+
+typedef struct UIPropertyUpdate {
+  ui_element_id_t element_id;
+  UIProperty property;
+  // component of vector and color properties
+  uint32_t index;
+  // value of number and enum properties
+  float_t value;
+  // value of string properties
+  const char *string;
+  // byte length of string
+  uint32_t length;
+} UIPropertyUpdate;
+
+#if defined(__wasm32__)
+#include <stddef.h>
+
+_Static_assert(offsetof(UIExtensionNodeCanvasRef, extensions) == 0, "UIExtensionNodeCanvasRef.extensions");
+_Static_assert(offsetof(UIExtensionNodeCanvasRef, extras) == 8, "UIExtensionNodeCanvasRef.extras");
+_Static_assert(offsetof(UIExtensionNodeCanvasRef, canvas) == 12, "UIExtensionNodeCanvasRef.canvas");
+_Static_assert(sizeof(UIExtensionNodeCanvasRef) == 16, "UIExtensionNodeCanvasRef");
+
+_Static_assert(offsetof(UICanvasProps, name) == 0, "UICanvasProps.name");
+_Static_assert(offsetof(UICanvasProps, extensions) == 4, "UICanvasProps.extensions");
+_Static_assert(offsetof(UICanvasProps, extras) == 12, "UICanvasProps.extras");
+_Static_assert(offsetof(UICanvasProps, root) == 16, "UICanvasProps.root");
+_Static_assert(offsetof(UICanvasProps, size) == 20, "UICanvasProps.size");
+_Static_assert(offsetof(UICanvasProps, width) == 28, "UICanvasProps.width");
+_Static_assert(offsetof(UICanvasProps, height) == 32, "UICanvasProps.height");
+_Static_assert(sizeof(UICanvasProps) == 36, "UICanvasProps");
+
+_Static_assert(offsetof(UIButtonProps, extensions) == 0, "UIButtonProps.extensions");
+_Static_assert(offsetof(UIButtonProps, extras) == 8, "UIButtonProps.extras");
+_Static_assert(offsetof(UIButtonProps, label) == 12, "UIButtonProps.label");
+_Static_assert(sizeof(UIButtonProps) == 20, "UIButtonProps");
+
+_Static_assert(offsetof(UITextProps, extensions) == 0, "UITextProps.extensions");
+_Static_assert(offsetof(UITextProps, extras) == 8, "UITextProps.extras");
+_Static_assert(offsetof(UITextProps, value) == 12, "UITextProps.value");
+_Static_assert(offsetof(UITextProps, font_family) == 20, "UITextProps.font_family");
+_Static_assert(offsetof(UITextProps, font_weight) == 28, "UITextProps.font_weight");
+_Static_assert(offsetof(UITextProps, font_style) == 36, "UITextProps.font_style");
+_Static_assert(offsetof(UITextProps, font_size) == 44, "UITextProps.font_size");
+_Static_assert(offsetof(UITextProps, color) == 48, "UITextProps.color");
+_Static_assert(sizeof(UITextProps) == 64, "UITextProps");
+
+_Static_assert(offsetof(UIElementProps, name) == 0, "UIElementProps.name");
+_Static_assert(offsetof(UIElementProps, extensions) == 4, "UIElementProps.extensions");
+_Static_assert(offsetof(UIElementProps, extras) == 12, "UIElementProps.extras");
+_Static_assert(offsetof(UIElementProps, type) == 16, "UIElementProps.type");
+_Static_assert(offsetof(UIElementProps, position) == 20, "UIElementProps.position");
+_Static_assert(offsetof(UIElementProps, position_type) == 36, "UIElementProps.position_type");
+_Static_assert(offsetof(UIElementProps, align_content) == 40, "UIElementProps.align_content");
+_Static_assert(offsetof(UIElementProps, align_items) == 44, "UIElementProps.align_items");
+_Static_assert(offsetof(UIElementProps, align_self) == 48, "UIElementProps.align_self");
+_Static_assert(offsetof(UIElementProps, flex_direction) == 52, "UIElementProps.flex_direction");
+_Static_assert(offsetof(UIElementProps, flex_wrap) == 56, "UIElementProps.flex_wrap");
+_Static_assert(offsetof(UIElementProps, flex_basis) == 60, "UIElementProps.flex_basis");
+_Static_assert(offsetof(UIElementProps, flex_grow) == 64, "UIElementProps.flex_grow");
+_Static_assert(offsetof(UIElementProps, flex_shrink) == 68, "UIElementProps.flex_shrink");
+_Static_assert(offsetof(UIElementProps, justify_content) == 72, "UIElementProps.justify_content");
+_Static_assert(offsetof(UIElementProps, width) == 76, "UIElementProps.width");
+_Static_assert(offsetof(UIElementProps, height) == 80, "UIElementProps.height");
+_Static_assert(offsetof(UIElementProps, min_width) == 84, "UIElementProps.min_width");
+_Static_assert(offsetof(UIElementProps, min_height) == 88, "UIElementProps.min_height");
+_Static_assert(offsetof(UIElementProps, max_width) == 92, "UIElementProps.max_width");
+_Static_assert(offsetof(UIElementProps, max_height) == 96, "UIElementProps.max_height");
+_Static_assert(offsetof(UIElementProps, background_color) == 100, "UIElementProps.background_color");
+_Static_assert(offsetof(UIElementProps, border_color) == 116, "UIElementProps.border_color");
+_Static_assert(offsetof(UIElementProps, padding) == 132, "UIElementProps.padding");
+_Static_assert(offsetof(UIElementProps, margin) == 148, "UIElementProps.margin");
+_Static_assert(offsetof(UIElementProps, border_width) == 164, "UIElementProps.border_width");
+_Static_assert(offsetof(UIElementProps, border_radius) == 180, "UIElementProps.border_radius");
+_Static_assert(offsetof(UIElementProps, button) == 196, "UIElementProps.button");
+_Static_assert(offsetof(UIElementProps, text) == 200, "UIElementProps.text");
+_Static_assert(sizeof(UIElementProps) == 204, "UIElementProps");
+
+_Static_assert(offsetof(UIPropertyUpdate, element_id) == 0, "UIPropertyUpdate.element_id");
+_Static_assert(offsetof(UIPropertyUpdate, property) == 4, "UIPropertyUpdate.property");
+_Static_assert(offsetof(UIPropertyUpdate, index) == 8, "UIPropertyUpdate.index");
+_Static_assert(offsetof(UIPropertyUpdate, value) == 12, "UIPropertyUpdate.value");
+_Static_assert(offsetof(UIPropertyUpdate, string) == 16, "UIPropertyUpdate.string");
+_Static_assert(offsetof(UIPropertyUpdate, length) == 20, "UIPropertyUpdate.length");
+_Static_assert(sizeof(UIPropertyUpdate) == 24, "UIPropertyUpdate");
+
+#endif
+
+#endif
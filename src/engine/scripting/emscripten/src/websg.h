@@ -526,9 +526,13 @@ typedef struct ColliderProps {
   float_t radius;
   float_t height;
   mesh_id_t mesh;
+  // grid cell size that hull and trimesh vertices are snapped to and merged in, 0 uses the mesh as is
+  float_t simplify;
 } ColliderProps;
 
-import_websg(world_create_collider) collider_id_t websg_world_create_collider(ColliderProps *props);
+// ColliderProps gained simplify after world_create_collider shipped, so the import is versioned to keep old runtimes
+// working.
+import_websg(world_create_collider_with_simplify) collider_id_t websg_world_create_collider_with_simplify(ColliderProps *props);
 import_websg(world_find_collider_by_name) collider_id_t websg_world_find_collider_by_name(const char *name, uint32_t length);
 
 /**
@@ -555,15 +559,52 @@ import_websg(node_add_physics_body) int32_t websg_node_add_physics_body(node_id_
 import_websg(node_remove_physics_body) int32_t websg_node_remove_physics_body(node_id_t node_id);
 import_websg(node_has_physics_body) int32_t websg_node_has_physics_body(node_id_t node_id);
 import_websg(physics_body_apply_impulse) int32_t websg_physics_body_apply_impulse(node_id_t node_id, float_t *impulse);
+import_websg(physics_body_sleep) int32_t websg_physics_body_sleep(node_id_t node_id);
+import_websg(physics_body_wake_up) int32_t websg_physics_body_wake_up(node_id_t node_id);
+import_websg(physics_body_is_sleeping) int32_t websg_physics_body_is_sleeping(node_id_t node_id);
+// Writes the nodes whose physics bodies are awake into results, up to max_count.
+// Returns the total number of awake bodies, which can be more than max_count.
+import_websg(physics_get_active_bodies) int32_t websg_physics_get_active_bodies(node_id_t *results, uint32_t max_count);
+
+// Packed per body: impulses are xyz, velocities are linear xyz followed by angular xyz.
+// Nodes without a physics body are skipped, their velocities read as zero.
+import_websg(physics_bodies_apply_impulses) int32_t websg_physics_bodies_apply_impulses(node_id_t *node_ids, float_t *impulses, uint32_t count);
+import_websg(physics_bodies_get_velocities) int32_t websg_physics_bodies_get_velocities(node_id_t *node_ids, float_t *velocities, uint32_t count);
+import_websg(physics_bodies_set_velocities) int32_t websg_physics_bodies_set_velocities(node_id_t *node_ids, float_t *velocities, uint32_t count);
 
 /**
- * CollisionListener
+ * CharacterController
  **/
 
-import_websg(world_create_collision_listener) collision_listener_id_t websg_world_create_collision_listener();
-import_websg(collision_listener_dispose) int32_t websg_collision_listener_dispose(collision_listener_id_t listener_id);
+typedef struct CharacterControllerProps {
+  // gap kept between the character's collider and the world
+  float_t offset;
+  // angles in radians
+  float_t max_slope_climb_angle;
+  float_t min_slope_slide_angle;
+  // 0 disables climbing steps
+  float_t max_step_height;
+  float_t min_step_width;
+  // 0 disables snapping down to the ground
+  float_t snap_to_ground;
+  int32_t slide;
+} CharacterControllerProps;
+
+typedef struct CharacterControllerMoveResult {
+  // the world space translation applied after resolving collisions
+  float_t movement[3];
+  int32_t grounded;
+  uint32_t collision_count;
+} CharacterControllerMoveResult;
+
+// The node must have a kinematic physics body with a collider.
+import_websg(node_add_character_controller) int32_t websg_node_add_character_controller(node_id_t node_id, CharacterControllerProps *props);
+import_websg(node_remove_character_controller) int32_t websg_node_remove_character_controller(node_id_t node_id);
+import_websg(character_controller_move) int32_t websg_character_controller_move(node_id_t node_id, float_t *translation, CharacterControllerMoveResult *result);
 
-import_websg(collisions_listener_get_collision_count) int32_t websg_collisions_listener_get_collision_count(collision_listener_id_t listener_id);
+/**
+ * CollisionListener
+ **/
 
 typedef struct CollisionItem {
   node_id_t node_a;
@@ -571,31 +612,100 @@ typedef struct CollisionItem {
   int32_t started;
 } CollisionItem;
 
-import_websg(collisions_listener_get_collisions) int32_t websg_collisions_listener_get_collisions(
-  collision_listener_id_t listener_id,
-  CollisionItem *collisions,
-  uint32_t max_count
+// A ring buffer in script memory that the host writes collisions into as they happen.
+typedef struct CollisionRing {
+  CollisionItem *items;
+  // a power of two
+  uint32_t capacity;
+  // advanced by the host, wraps around at UINT32_MAX
+  uint32_t write_index;
+  // advanced by the script, wraps around at UINT32_MAX
+  uint32_t read_index;
+  // collisions dropped because the ring was full
+  uint32_t dropped_count;
+} CollisionRing;
+
+typedef struct CollisionListenerProps {
+  // only collisions involving at least one of these nodes are recorded, every collision if node_count is 0
+  node_id_t *nodes;
+  uint32_t node_count;
+  // must stay allocated until the listener is disposed
+  CollisionRing *ring;
+} CollisionListenerProps;
+
+import_websg(world_create_collision_ring_listener) collision_listener_id_t websg_world_create_collision_ring_listener(
+  CollisionListenerProps *props
 );
+import_websg(collision_listener_dispose) int32_t websg_collision_listener_dispose(collision_listener_id_t listener_id);
 
 /**
- * UI Canvas
+ * Physics Queries
  **/
 
-typedef struct UIExtensionNodeCanvasRef {
-  Extensions extensions;
-  void *extras;
-  ui_canvas_id_t canvas;
-} UIExtensionNodeCanvasRef;
-
-typedef struct UICanvasProps {
-  const char *name;
-  Extensions extensions;
-  void *extras;
-  ui_element_id_t root;
-  float_t size[2];
-  float_t width;
+// Matches RAPIER.QueryFilterFlags
+typedef enum PhysicsQueryFilterFlags {
+  PhysicsQueryFilterFlags_ExcludeStatic = 1 << 0,
+  PhysicsQueryFilterFlags_ExcludeKinematic = 1 << 1,
+  PhysicsQueryFilterFlags_ExcludeRigid = 1 << 2,
+  PhysicsQueryFilterFlags_ExcludeTriggers = 1 << 3,
+} PhysicsQueryFilterFlags;
+
+typedef struct PhysicsQueryFilter {
+  uint32_t flags;
+  // colliders attached to this node's physics body are ignored, 0 to ignore nothing
+  node_id_t exclude_node;
+} PhysicsQueryFilter;
+
+typedef struct PhysicsHit {
+  int32_t hit;
+  // 0 if the hit collider's node isn't accessible to the script
+  node_id_t node;
+  float_t distance;
+  float_t position[3];
+  float_t normal[3];
+} PhysicsHit;
+
+typedef struct PhysicsShapeProps {
+  // Box, Sphere, Capsule or Cylinder
+  ColliderType type;
+  float_t size[3];
+  float_t radius;
   float_t height;
-} UICanvasProps;
+  float_t rotation[4];
+} PhysicsShapeProps;
+
+// Each ray or cast is 7 floats: origin xyz, direction xyz and max distance. Writes one PhysicsHit per ray or cast.
+// Returns the number of rays or casts that hit something or -1 if there was an error.
+import_websg(physics_cast_rays) int32_t websg_physics_cast_rays(
+  const float_t *rays,
+  uint32_t count,
+  PhysicsQueryFilter *filter,
+  PhysicsHit *hits
+);
+import_websg(physics_cast_shapes) int32_t websg_physics_cast_shapes(
+  PhysicsShapeProps *shape,
+  const float_t *casts,
+  uint32_t count,
+  PhysicsQueryFilter *filter,
+  PhysicsHit *hits
+);
+
+// Writes the nodes with a collider overlapping shape at position into results, up to max_count.
+// Returns the total number of overlapping nodes, which can be more than max_count, or -1 if there was an error.
+import_websg(physics_overlap_shape) int32_t websg_physics_overlap_shape(
+  PhysicsShapeProps *shape,
+  const float_t *position,
+  PhysicsQueryFilter *filter,
+  node_id_t *results,
+  uint32_t max_count
+);
+
+// UI enums and props structs are generated from src/engine/scripting/idl/websg-ui.idl.ts
+#include "./websg-ui.h"
+
+/**
+ * UI Canvas
+ **/
 
 import_websg(world_create_ui_canvas) ui_canvas_id_t websg_world_create_ui_canvas(UICanvasProps *props);
 import_websg(world_find_ui_canvas_by_name) light_id_t websg_world_find_ui_canvas_by_name(const char *name, uint32_t length);
@@ -617,102 +727,15 @@ import_websg(ui_canvas_redraw) int32_t websg_ui_canvas_redraw(ui_canvas_id_t can
  * UI Element *
  **************/
 
-typedef enum ElementType {
-  ElementType_FLEX,
-  ElementType_TEXT,
-  ElementType_BUTTON,
-  ElementType_IMAGE,
-} ElementType;
-
-typedef enum FlexDirection {
-  FlexDirection_COLUMN,
-  FlexDirection_COLUMN_REVERSE,
-  FlexDirection_ROW,
-  FlexDirection_ROW_REVERSE,
-} FlexDirection;
-
-typedef enum ElementPositionType {
-  ElementPositionType_STATIC,
-  ElementPositionType_RELATIVE,
-  ElementPositionType_ABSOLUTE,
-} ElementPositionType;
-
-typedef enum FlexAlign {
-  FlexAlign_AUTO,
-  FlexAlign_FLEX_START,
-  FlexAlign_CENTER,
-  FlexAlign_FLEX_END,
-  FlexAlign_STRETCH,
-  FlexAlign_BASELINE,
-  FlexAlign_SPACE_BETWEEN,
-  FlexAlign_SPACE_AROUND,
-} FlexAlign;
-
-typedef enum FlexJustify {
-  FlexJustify_FLEX_START,
-  FlexJustify_CENTER,
-  FlexJustify_FLEX_END,
-  FlexJustify_SPACE_BETWEEN,
-  FlexJustify_SPACE_AROUND,
-  FlexJustify_SPACE_EVENLY,
-} FlexJustify;
-
-typedef enum FlexWrap {
-  FlexWrap_NO_WRAP,
-  FlexWrap_WRAP,
-  FlexWrap_WRAP_REVERSE,
-} FlexWrap;
-
-typedef struct UIButtonProps {
-  Extensions extensions;
-  void *extras;
-  WebSGString label;
-} UIButtonProps;
-
-typedef struct UITextProps {
-  Extensions extensions;
-  void *extras;
-  WebSGString value;
-  WebSGString font_family;
-  WebSGString font_weight;
-  WebSGString font_style;
-  float_t font_size;
-  float_t color[4];
-} UITextProps;
-
-typedef struct UIElementProps {
-  const char *name;
-  Extensions extensions;
-  void *extras;
-  ElementType type;
-  float_t position[4];
-  ElementPositionType position_type;
-  FlexAlign align_content;
-  FlexAlign align_items;
-  FlexAlign align_self;
-  FlexDirection flex_direction;
-  FlexWrap flex_wrap;
-  float_t flex_basis;
-  float_t flex_grow;
-  float_t flex_shrink;
-  FlexJustify justify_content;
-  float_t width;
-  float_t height;
-  float_t min_width;
-  float_t min_height;
-  float_t max_width;
-  float_t max_height;
-  float_t background_color[4];
-  float_t border_color[4];
-  float_t padding[4];
-  float_t margin[4];
-  float_t border_width[4];
-  float_t border_radius[4];
-  UIButtonProps *button;
-  UITextProps *text;
-} UIElementProps;
-
 import_websg(world_create_ui_element) ui_element_id_t websg_world_create_ui_element(UIElementProps *props);
+// data is a CBOR encoded element description with nested children. Writes the created elements into elements in
+// depth first order, starting with the root. Returns the number of elements created or -1 if there was an error.
+import_websg(world_create_ui_tree) int32_t websg_world_create_ui_tree(
+  const uint8_t *data,
+  uint32_t byte_length,
+  ui_element_id_t *elements,
+  uint32_t max_count
+);
 import_websg(world_find_ui_element_by_name) light_id_t websg_world_find_ui_element_by_name(const char *name, uint32_t length);
 import_websg(ui_element_get_position_element) float_t websg_ui_element_get_position_element(ui_element_id_t ui_element_id, uint32_t index);
 import_websg(ui_element_set_position_element) int32_t websg_ui_element_set_position_element(ui_element_id_t ui_element_id, uint32_t index, float_t value);
@@ -816,6 +839,29 @@ import_websg(ui_text_set_color) int32_t websg_ui_text_set_color(ui_element_id_t
 import_websg(ui_text_get_color_element) float_t websg_ui_text_get_color_element(ui_element_id_t ui_element_id, uint32_t index);
 import_websg(ui_text_set_color_element) int32_t websg_ui_text_set_color_element(ui_element_id_t ui_element_id, uint32_t index, float_t value);
 
+/**************
+ * UI Batches *
+ **************/
+
+// Applies the updates in order and redraws the canvas once. Updates for missing elements are skipped.
+// Returns the number of updates that failed or -1 if the canvas doesn't exist.
+import_websg(ui_canvas_commit) int32_t websg_ui_canvas_commit(
+  ui_canvas_id_t canvas_id,
+  UIPropertyUpdate *updates,
+  uint32_t count
+);
+
+/******************
+ * Command Buffer *
+ ******************/
+
+// Command types and the command struct are generated from src/engine/scripting/idl/websg-commands.idl.ts
+#include "./websg-commands.h"
+
+// Executes fire-and-forget setters recorded by the script runtime in the order they were recorded.
+// Returns the number of commands that failed.
+import_websg(commands_flush) int32_t websg_commands_flush(WebSGCommand *commands, uint32_t count);
+
 
 import_websg(get_primary_input_source_origin_element) float_t websg_get_primary_input_source_origin_element(uint32_t index);
 import_websg(get_primary_input_source_direction_element) float_t websg_get_primary_input_source_direction_element(uint32_t index);
@@ -0,0 +1,53 @@
+import { strictEqual } from "assert";
+import { readFileSync } from "fs";
+import { resolve } from "path";
+
+import * as schema from "../../resource/schema";
+import { generateCHeader, generateTSModule, modules, upperSnakeToPascalCase } from "./generate";
+import { getIDLStructLayout } from "./idl";
+
+describe("WebSG IDL", () => {
+  test("generated files are up to date", () => {
+    for (const module of modules) {
+      strictEqual(readFileSync(resolve(module.headerPath), "utf8"), generateCHeader(module));
+      strictEqual(readFileSync(resolve(module.modulePath), "utf8"), generateTSModule(module));
+    }
+  });
+
+  test("re-exported enums match the C values", () => {
+    for (const module of modules) {
+      for (const { name, values, source } of module.enums) {
+        if (!source) {
+          continue;
+        }
+
+        strictEqual(source, "../resource/schema", `${name} is re-exported from an unchecked module`);
+
+        const schemaEnum: { [key: string]: string | number } = (schema as any)[name];
+        const names = values.map(upperSnakeToPascalCase);
+
+        for (const [key, value] of Object.entries(schemaEnum)) {
+          // numeric enums also map values back to their names
+          if (typeof value === "number") {
+            strictEqual(names.indexOf(key), value, `${name}.${key}`);
+          }
+        }
+      }
+    }
+  });
+
+  test("lay out fields in order", () => {
+    const { fields, byteLength } = getIDLStructLayout({
+      name: "Test",
+      fields: [
+        { name: "name", type: "string" },
+        { name: "label", type: "stringLen" },
+        { name: "color", type: "f32", length: 4 },
+        { name: "type", type: { enum: "ElementType" } },
+      ],
+    });
+
+    strictEqual(fields.map(({ byteOffset }) => byteOffset).join(), "0,4,12,28");
+    strictEqual(byteLength, 32);
+  });
+});
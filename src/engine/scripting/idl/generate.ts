@@ -0,0 +1,274 @@
+/**
+ * Generates the C typedefs and TypeScript decoders for each IDL module. Run from the repository root with
+ * `npm run generate:websg-bindings` after changing an .idl.ts file and commit the output.
+ */
+import { writeFileSync } from "fs";
+import { resolve } from "path";
+import { pathToFileURL } from "url";
+
+import { getIDLStructLayout, IDLField, IDLModule, IDLPrimitiveType, IDLPrimitiveTypes, IDLStruct } from "./idl";
+import { WebSGCommandsModule } from "./websg-commands.idl";
+import { WebSGUIModule } from "./websg-ui.idl";
+
+export const modules: IDLModule[] = [WebSGUIModule, WebSGCommandsModule];
+
+const snakeToCamelCase = (name: string) => name.replace(/_([a-z])/g, (_, char: string) => char.toUpperCase());
+
+export const upperSnakeToPascalCase = (name: string) =>
+  name.toLowerCase().replace(/(^|_)([a-z0-9])/g, (_, __, char: string) => char.toUpperCase());
+
+const generatedComment = (module: IDLModule) =>
+  `Generated from the ${module.name} IDL module by src/engine/scripting/idl/generate.ts. Do not edit.`;
+
+function getCFieldDeclaration(field: IDLField): string {
+  const type = field.type;
+  const arraySuffix = field.length ? `[${field.length}]` : "";
+
+  if (typeof type === "object") {
+    return "enum" in type ? `${type.enum} ${field.name}` : `${type.pointer} *${field.name}`;
+  }
+
+  switch (type) {
+    case "string":
+      return `const char *${field.name}`;
+    case "stringLen":
+      return `WebSGString ${field.name}`;
+    case "extensions":
+      return `Extensions ${field.name}`;
+    case "extras":
+      return `void *${field.name}`;
+    default:
+      return `${IDLPrimitiveTypes[type]} ${field.name}${arraySuffix}`;
+  }
+}
+
+export function generateCHeader(module: IDLModule): string {
+  const guard = `__websg_${module.name.toLowerCase()}_generated_h`;
+  const lines = [`// ${generatedComment(module)}`, `#ifndef ${guard}`, `#define ${guard}`, ""];
+
+  for (const idlEnum of module.enums) {
+    lines.push(`typedef enum ${idlEnum.name} {`);
+
+    for (const value of idlEnum.values) {
+      lines.push(`  ${idlEnum.name}_${value},`);
+    }
+
+    lines.push(`} ${idlEnum.name};`, "");
+  }
+
+  for (const struct of module.structs) {
+    lines.push(`typedef struct ${struct.name} {`);
+
+    for (const field of struct.fields) {
+      if (field.doc) {
+        lines.push(`  // ${field.doc}`);
+      }
+
+      lines.push(`  ${getCFieldDeclaration(field)};`);
+    }
+
+    lines.push(`} ${struct.name};`, "");
+  }
+
+  // the TypeScript decoders read fixed offsets, fail the script runtime build if the compiler disagrees with them
+  lines.push("#if defined(__wasm32__)", "#include <stddef.h>", "");
+
+  for (const struct of module.structs) {
+    const { fields, byteLength } = getIDLStructLayout(struct);
+
+    for (const { field, byteOffset } of fields) {
+      lines.push(
+        `_Static_assert(offsetof(${struct.name}, ${field.name}) == ${byteOffset}, "${struct.name}.${field.name}");`
+      );
+    }
+
+    lines.push(`_Static_assert(sizeof(${struct.name}) == ${byteLength}, "${struct.name}");`, "");
+  }
+
+  lines.push("#endif", "", "#endif", "");
+
+  return lines.join("\n");
+}
+
+function getTSFieldName(field: IDLField): string {
+  const name = snakeToCamelCase(field.name);
+  return typeof field.type === "object" && "pointer" in field.type ? `${name}Ptr` : name;
+}
+
+function isDecodedField(field: IDLField) {
+  return field.type !== "extensions" && field.type !== "extras";
+}
+
+function getTSFieldType(field: IDLField): string {
+  const type = field.type;
+
+  if (type === "string" || type === "stringLen") {
+    return "string";
+  }
+
+  if (!field.length) {
+    return "number";
+  }
+
+  return type === "f32" ? "Float32Array" : type === "i32" ? "Int32Array" : "Uint32Array";
+}
+
+const heapForType = (type: IDLPrimitiveType) => (type === "f32" ? "F32Heap" : type === "i32" ? "I32Heap" : "U32Heap");
+
+function getTSFieldDecoder(field: IDLField, index: number): { heap: string; expression: string } {
+  const type = field.type;
+
+  if (typeof type === "object") {
+    if ("enum" in type) {
+      return {
+        heap: "U32Heap",
+        expression: `readEnumValue(U32Heap[offset + ${index}], ${type.enum}Count, "${type.enum}")`,
+      };
+    }
+
+    return { heap: "U32Heap", expression: `U32Heap[offset + ${index}]` };
+  }
+
+  switch (type) {
+    case "string":
+      return { heap: "U32Heap", expression: `readString(wasmCtx, U32Heap[offset + ${index}], 255)` };
+    case "stringLen":
+      return {
+        heap: "U32Heap",
+        expression: `readString(wasmCtx, U32Heap[offset + ${index}], U32Heap[offset + ${index + 1}])`,
+      };
+    case "extensions":
+    case "extras":
+      throw new Error(`${field.name} is not decoded`);
+    default: {
+      const heap = heapForType(type);
+
+      if (field.length) {
+        return { heap, expression: `${heap}.slice(offset + ${index}, offset + ${index + field.length})` };
+      }
+
+      return { heap, expression: `${heap}[offset + ${index}]` };
+    }
+  }
+}
+
+function generateTSStruct(struct: IDLStruct): string[] {
+  const { fields, byteLength } = getIDLStructLayout(struct);
+  const lines = [`export const ${struct.name}Layout = {`];
+
+  for (const { field, byteOffset } of fields) {
+    lines.push(`  ${snakeToCamelCase(field.name)}: ${byteOffset},`);
+  }
+
+  lines.push(`  byteLength: ${byteLength},`, "};", "");
+
+  if (struct.decoder === false) {
+    return lines;
+  }
+
+  lines.push(`export interface ${struct.name}Data {`);
+
+  for (const { field } of fields) {
+    if (isDecodedField(field)) {
+      lines.push(`  ${getTSFieldName(field)}: ${getTSFieldType(field)};`);
+    }
+  }
+
+  lines.push("}", "");
+
+  const decoders = fields
+    .filter(({ field }) => isDecodedField(field))
+    .map(({ field, byteOffset }) => ({ field, ...getTSFieldDecoder(field, byteOffset / 4) }));
+  const heaps = [...new Set(decoders.map(({ heap }) => heap))].sort();
+
+  lines.push(
+    `export function read${struct.name}(wasmCtx: WASMModuleContext, ptr: number): ${struct.name}Data {`,
+    `  const { ${heaps.join(", ")} } = wasmCtx;`,
+    "  const offset = ptr / 4;",
+    "",
+    "  return {"
+  );
+
+  for (const { field, expression } of decoders) {
+    lines.push(`    ${getTSFieldName(field)}: ${expression},`);
+  }
+
+  lines.push("  };", "}", "");
+
+  return lines;
+}
+
+export function generateTSModule(module: IDLModule): string {
+  const readsStrings = module.structs.some(
+    (struct) =>
+      struct.decoder !== false && struct.fields.some((field) => field.type === "string" || field.type === "stringLen")
+  );
+  const lines = [
+    `// ${generatedComment(module)}`,
+    `import { ${readsStrings ? "readString, " : ""}WASMModuleContext } from "./WASMModuleContext";`,
+    "",
+  ];
+
+  const sourceEnums = new Map<string, string[]>();
+
+  for (const idlEnum of module.enums) {
+    if (idlEnum.source) {
+      sourceEnums.set(idlEnum.source, [...(sourceEnums.get(idlEnum.source) || []), idlEnum.name]);
+    }
+  }
+
+  for (const [source, names] of sourceEnums) {
+    const line = `export { ${names.join(", ")} } from "${source}";`;
+
+    // wrapped the way prettier would
+    if (line.length > 120) {
+      lines.push("export {", ...names.map((name) => `  ${name},`), `} from "${source}";`, "");
+    } else {
+      lines.push(line, "");
+    }
+  }
+
+  for (const idlEnum of module.enums) {
+    if (idlEnum.source) {
+      continue;
+    }
+
+    lines.push(`export enum ${idlEnum.name} {`);
+
+    for (const value of idlEnum.values) {
+      lines.push(`  ${upperSnakeToPascalCase(value)},`);
+    }
+
+    lines.push("}", "");
+  }
+
+  for (const idlEnum of module.enums) {
+    lines.push(`export const ${idlEnum.name}Count = ${idlEnum.values.length};`);
+  }
+
+  lines.push(
+    "",
+    "function readEnumValue(value: number, count: number, enumName: string): number {",
+    "  if (value < count) {",
+    "    return value;",
+    "  }",
+    "",
+    "  throw new Error(`WebSG: ${value} is not a valid ${enumName}`);",
+    "}",
+    ""
+  );
+
+  for (const struct of module.structs) {
+    lines.push(...generateTSStruct(struct));
+  }
+
+  return lines.join("\n");
+}
+
+if (process.argv[1] && import.meta.url === pathToFileURL(resolve(process.argv[1])).href) {
+  for (const module of modules) {
+    writeFileSync(resolve(module.headerPath), generateCHeader(module));
+    writeFileSync(resolve(module.modulePath), generateTSModule(module));
+    console.log(`Generated ${module.headerPath} and ${module.modulePath}`);
+  }
+}
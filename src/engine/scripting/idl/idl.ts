@@ -0,0 +1,98 @@
+/**
+ * Describes the enums and structs shared between the WebSG host and scripts. generate.ts turns a module of these
+ * into the C typedefs included by websg.h and the matching TypeScript layouts and decoders used by websg.ts, so
+ * both sides are derived from the same description instead of being kept in sync by hand.
+ *
+ * All field types are 4 byte aligned on wasm32, so a field's byte offset is the sum of the sizes before it.
+ */
+
+// Primitive field types and the C type they're declared as. Id types are uint32_t typedefs from websg.h.
+export const IDLPrimitiveTypes = {
+  u32: "uint32_t",
+  i32: "int32_t",
+  f32: "float_t",
+  node_id_t: "node_id_t",
+  ui_canvas_id_t: "ui_canvas_id_t",
+  ui_element_id_t: "ui_element_id_t",
+};
+
+export type IDLPrimitiveType = keyof typeof IDLPrimitiveTypes;
+
+export type IDLFieldType =
+  | IDLPrimitiveType
+  // const char *, null terminated
+  | "string"
+  // WebSGString
+  | "stringLen"
+  // Extensions, ignored by the decoders
+  | "extensions"
+  // void *, ignored by the decoders
+  | "extras"
+  // name of an enum in the same module
+  | { enum: string }
+  // pointer to a struct in the same module
+  | { pointer: string };
+
+export interface IDLField {
+  name: string;
+  type: IDLFieldType;
+  // fixed length array of the type, only supported for primitives
+  length?: number;
+  doc?: string;
+}
+
+export interface IDLStruct {
+  name: string;
+  fields: IDLField[];
+  // false for structs the host only reads through the generated layout, skips generating a decoder
+  decoder?: boolean;
+}
+
+export interface IDLEnum {
+  name: string;
+  values: string[];
+  // module, relative to the generated TypeScript module, of an existing TypeScript enum with the same name and
+  // values that is re-exported instead of declaring a copy. generate.test.ts checks that the values match.
+  source?: string;
+}
+
+export interface IDLModule {
+  name: string;
+  // the generated C header, relative to the repository root
+  headerPath: string;
+  // the generated TypeScript module, relative to the repository root
+  modulePath: string;
+  enums: IDLEnum[];
+  structs: IDLStruct[];
+}
+
+export function getIDLFieldSize(field: IDLField): number {
+  const type = field.type;
+
+  if (type === "stringLen" || type === "extensions") {
+    return 8;
+  }
+
+  return 4 * (field.length || 1);
+}
+
+export interface IDLFieldLayout {
+  field: IDLField;
+  byteOffset: number;
+}
+
+export function getIDLStructLayout(struct: IDLStruct): { fields: IDLFieldLayout[]; byteLength: number } {
+  const fields: IDLFieldLayout[] = [];
+  let byteOffset = 0;
+
+  for (const field of struct.fields) {
+    if (field.length !== undefined && !(typeof field.type === "string" && field.type in IDLPrimitiveTypes)) {
+      throw new Error(`${struct.name}.${field.name}: only arrays of primitives are supported`);
+    }
+
+    fields.push({ field, byteOffset });
+    byteOffset += getIDLFieldSize(field);
+  }
+
+  return { fields, byteLength: byteOffset };
+}
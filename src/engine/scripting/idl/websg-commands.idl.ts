@@ -0,0 +1,38 @@
+import { IDLModule } from "./idl";
+
+export const WebSGCommandsModule: IDLModule = {
+  name: "Commands",
+  headerPath: "src/engine/scripting/emscripten/src/websg-commands.h",
+  modulePath: "src/engine/scripting/websg-commands.ts",
+  enums: [
+    {
+      name: "WebSGCommandType",
+      values: [
+        "NODE_SET_TRANSLATION",
+        "NODE_SET_TRANSLATION_ELEMENT",
+        "NODE_SET_ROTATION",
+        "NODE_SET_ROTATION_ELEMENT",
+        "NODE_SET_SCALE",
+        "NODE_SET_SCALE_ELEMENT",
+        "NODE_SET_VISIBLE",
+        "MATERIAL_SET_BASE_COLOR_FACTOR",
+        "MATERIAL_SET_BASE_COLOR_FACTOR_ELEMENT",
+        "LIGHT_SET_COLOR",
+        "LIGHT_SET_COLOR_ELEMENT",
+        "LIGHT_SET_INTENSITY",
+        "PHYSICS_BODY_APPLY_IMPULSE",
+      ],
+    },
+  ],
+  structs: [
+    {
+      name: "WebSGCommand",
+      fields: [
+        { name: "type", type: { enum: "WebSGCommandType" } },
+        { name: "resource_id", type: "u32" },
+        { name: "index", type: "u32", doc: "component of _ELEMENT commands" },
+        { name: "value", type: "f32", length: 4, doc: "the whole vector, or the element or scalar in value[0]" },
+      ],
+    },
+  ],
+};
@@ -0,0 +1,168 @@
+import { IDLModule } from "./idl";
+
+const FlexAlign = { enum: "FlexAlign" };
+
+export const WebSGUIModule: IDLModule = {
+  name: "UI",
+  headerPath: "src/engine/scripting/emscripten/src/websg-ui.h",
+  modulePath: "src/engine/scripting/websg-ui.ts",
+  // declared in resource/schema.ts, where most of their values are yoga constants
+  enums: [
+    {
+      name: "ElementType",
+      source: "../resource/schema",
+      values: ["FLEX", "TEXT", "BUTTON", "IMAGE"],
+    },
+    {
+      name: "FlexDirection",
+      source: "../resource/schema",
+      values: ["COLUMN", "COLUMN_REVERSE", "ROW", "ROW_REVERSE"],
+    },
+    {
+      name: "ElementPositionType",
+      source: "../resource/schema",
+      values: ["STATIC", "RELATIVE", "ABSOLUTE"],
+    },
+    {
+      name: "FlexAlign",
+      source: "../resource/schema",
+      values: ["AUTO", "FLEX_START", "CENTER", "FLEX_END", "STRETCH", "BASELINE", "SPACE_BETWEEN", "SPACE_AROUND"],
+    },
+    {
+      name: "FlexJustify",
+      source: "../resource/schema",
+      values: ["FLEX_START", "CENTER", "FLEX_END", "SPACE_BETWEEN", "SPACE_AROUND", "SPACE_EVENLY"],
+    },
+    {
+      name: "FlexWrap",
+      source: "../resource/schema",
+      values: ["NO_WRAP", "WRAP", "WRAP_REVERSE"],
+    },
+    {
+      name: "UIProperty",
+      source: "../resource/schema",
+      values: [
+        "POSITION_TYPE",
+        "POSITION",
+        "ALIGN_CONTENT",
+        "ALIGN_ITEMS",
+        "ALIGN_SELF",
+        "FLEX_DIRECTION",
+        "FLEX_WRAP",
+        "FLEX_BASIS",
+        "FLEX_GROW",
+        "FLEX_SHRINK",
+        "JUSTIFY_CONTENT",
+        "WIDTH",
+        "HEIGHT",
+        "MIN_WIDTH",
+        "MIN_HEIGHT",
+        "MAX_WIDTH",
+        "MAX_HEIGHT",
+        "BACKGROUND_COLOR",
+        "BORDER_COLOR",
+        "PADDING",
+        "MARGIN",
+        "BORDER_WIDTH",
+        "BORDER_RADIUS",
+        "BUTTON_LABEL",
+        "TEXT_VALUE",
+        "TEXT_FONT_FAMILY",
+        "TEXT_FONT_STYLE",
+        "TEXT_FONT_WEIGHT",
+        "TEXT_FONT_SIZE",
+        "TEXT_COLOR",
+      ],
+    },
+  ],
+  structs: [
+    {
+      name: "UIExtensionNodeCanvasRef",
+      fields: [
+        { name: "extensions", type: "extensions" },
+        { name: "extras", type: "extras" },
+        { name: "canvas", type: "ui_canvas_id_t" },
+      ],
+    },
+    {
+      name: "UICanvasProps",
+      fields: [
+        { name: "name", type: "string" },
+        { name: "extensions", type: "extensions" },
+        { name: "extras", type: "extras" },
+        { name: "root", type: "ui_element_id_t" },
+        { name: "size", type: "f32", length: 2 },
+        { name: "width", type: "f32" },
+        { name: "height", type: "f32" },
+      ],
+    },
+    {
+      name: "UIButtonProps",
+      fields: [
+        { name: "extensions", type: "extensions" },
+        { name: "extras", type: "extras" },
+        { name: "label", type: "stringLen" },
+      ],
+    },
+    {
+      name: "UITextProps",
+      fields: [
+        { name: "extensions", type: "extensions" },
+        { name: "extras", type: "extras" },
+        { name: "value", type: "stringLen" },
+        { name: "font_family", type: "stringLen" },
+        { name: "font_weight", type: "stringLen" },
+        { name: "font_style", type: "stringLen" },
+        { name: "font_size", type: "f32" },
+        { name: "color", type: "f32", length: 4 },
+      ],
+    },
+    {
+      name: "UIElementProps",
+      fields: [
+        { name: "name", type: "string" },
+        { name: "extensions", type: "extensions" },
+        { name: "extras", type: "extras" },
+        { name: "type", type: { enum: "ElementType" } },
+        { name: "position", type: "f32", length: 4 },
+        { name: "position_type", type: { enum: "ElementPositionType" } },
+        { name: "align_content", type: FlexAlign },
+        { name: "align_items", type: FlexAlign },
+        { name: "align_self", type: FlexAlign },
+        { name: "flex_direction", type: { enum: "FlexDirection" } },
+        { name: "flex_wrap", type: { enum: "FlexWrap" } },
+        { name: "flex_basis", type: "f32" },
+        { name: "flex_grow", type: "f32" },
+        { name: "flex_shrink", type: "f32" },
+        { name: "justify_content", type: { enum: "FlexJustify" } },
+        { name: "width", type: "f32" },
+        { name: "height", type: "f32" },
+        { name: "min_width", type: "f32" },
+        { name: "min_height", type: "f32" },
+        { name: "max_width", type: "f32" },
+        { name: "max_height", type: "f32" },
+        { name: "background_color", type: "f32", length: 4 },
+        { name: "border_color", type: "f32", length: 4 },
+        { name: "padding", type: "f32", length: 4 },
+        { name: "margin", type: "f32", length: 4 },
+        { name: "border_width", type: "f32", length: 4 },
+        { name: "border_radius", type: "f32", length: 4 },
+        { name: "button", type: { pointer: "UIButtonProps" } },
+        { name: "text", type: { pointer: "UITextProps" } },
+      ],
+    },
+    {
+      // ui_canvas_commit reads batches of these straight from the heap, string is read with its length
+      name: "UIPropertyUpdate",
+      decoder: false,
+      fields: [
+        { name: "element_id", type: "ui_element_id_t" },
+        { name: "property", type: { enum: "UIProperty" } },
+        { name: "index", type: "u32", doc: "component of vector and color properties" },
+        { name: "value", type: "f32", doc: "value of number and enum properties" },
+        { name: "string", type: "string", doc: "value of string properties" },
+        { name: "length", type: "u32", doc: "byte length of string" },
+      ],
+    },
+  ],
+};
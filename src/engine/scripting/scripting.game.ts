@@ -1,6 +1,5 @@
 import { addComponent, defineQuery, exitQuery } from "bitecs";
 
-import scriptingRuntimeWASMUrl from "./emscripten/build/scripting-runtime.wasm?url";
 import { createCursorView } from "../allocator/CursorView";
 import { GameContext, RemoteResourceManager } from "../GameTypes";
 import { createMatrixWASMModule } from "../matrix/matrix.game";
@@ -8,7 +7,7 @@ import { createWebSGNetworkModule } from "../network/scripting.game";
 import { RemoteScene } from "../resource/RemoteResources";
 import { createThirdroomModule } from "./thirdroom";
 import { createWASIModule } from "./wasi";
-import { WASMModuleContext } from "./WASMModuleContext";
+import { createWASMStringCache, WASMModuleContext } from "./WASMModuleContext";
 import { createWebSGModule } from "./websg";
 
 export enum ScriptState {
@@ -31,6 +30,33 @@ export interface Script {
   peerExited: (peerIndex: number) => void;
 }
 
+/**
+ * The script runtime builds JavaScript scripts can run on. The lite runtime leaves out the QuickJS features that
+ * build.sh strips from it, which makes it smaller and faster to start.
+ */
+export type ScriptRuntime = "full" | "lite";
+
+const SCRIPT_RUNTIME_FILES: { [runtime in ScriptRuntime]: string } = {
+  full: "./emscripten/build/scripting-runtime.wasm",
+  lite: "./emscripten/build/scripting-runtime-lite.wasm",
+};
+
+// globbed rather than imported so the app still builds before the lite runtime has been built
+const scriptRuntimeWASMUrls = import.meta.glob("./emscripten/build/scripting-runtime*.wasm", {
+  as: "url",
+  eager: true,
+});
+
+export function getScriptRuntimeWASMUrl(runtime: ScriptRuntime): string {
+  const url = scriptRuntimeWASMUrls[SCRIPT_RUNTIME_FILES[runtime]];
+
+  if (!url) {
+    throw new Error(`The "${runtime}" script runtime hasn't been built.`);
+  }
+
+  return url;
+}
+
 export const ScriptComponent = new Map<number, Script>();
 
 export const scriptQuery = defineQuery([ScriptComponent]);
@@ -70,23 +96,11 @@ export async function loadScript(
   ctx: GameContext,
   resourceManager: RemoteResourceManager,
   scriptUrl: string,
-  signal?: AbortSignal
+  signal?: AbortSignal,
+  runtime: ScriptRuntime = "full"
 ): Promise<Script> {
-  const memory = new WebAssembly.Memory({ initial: 1024, maximum: 1024 });
-
-  const wasmCtx: WASMModuleContext = {
-    resourceManager,
-    memory,
-    U8Heap: new Uint8Array(memory.buffer),
-    I32Heap: new Int32Array(memory.buffer),
-    U32Heap: new Uint32Array(memory.buffer),
-    F32Heap: new Float32Array(memory.buffer),
-    cursorView: createCursorView(memory.buffer, true),
-    textDecoder: new TextDecoder(),
-    textEncoder: new TextEncoder(),
-  };
-
   let wasmBuffer: ArrayBuffer | undefined;
+  let scriptSource: string | undefined;
 
   const response = await fetch(scriptUrl, { signal });
 
@@ -98,10 +112,9 @@ export async function loadScript(
       contentType === "application/x-javascript" ||
       contentType.startsWith("text/javascript")
     ) {
-      const scriptSource = await response.text();
-      const jsWASMResponse = await fetch(scriptingRuntimeWASMUrl, { signal });
+      scriptSource = await response.text();
+      const jsWASMResponse = await fetch(getScriptRuntimeWASMUrl(runtime), { signal });
       wasmBuffer = await jsWASMResponse.arrayBuffer();
-      wasmCtx.encodedJSSource = wasmCtx.textEncoder.encode(scriptSource);
     } else if (contentType === "application/wasm") {
       wasmBuffer = await response.arrayBuffer();
     } else {
@@ -111,6 +124,39 @@ export async function loadScript(
     throw new Error(`Content type header not set for script "${scriptUrl}"`);
   }
 
+  return createScript(ctx, resourceManager, await WebAssembly.compile(wasmBuffer), scriptSource);
+}
+
+/**
+ * Instantiates a script from a compiled WASM module. JavaScript scripts pass the script runtime as the module and
+ * their source as scriptSource. A module can be instantiated any number of times.
+ */
+export async function createScript(
+  ctx: GameContext,
+  resourceManager: RemoteResourceManager,
+  wasmModule: WebAssembly.Module,
+  scriptSource?: string
+): Promise<Script> {
+  const memory = new WebAssembly.Memory({ initial: 1024, maximum: 1024 });
+
+  const wasmCtx: WASMModuleContext = {
+    resourceManager,
+    memory,
+    U8Heap: new Uint8Array(memory.buffer),
+    I32Heap: new Int32Array(memory.buffer),
+    U32Heap: new Uint32Array(memory.buffer),
+    F32Heap: new Float32Array(memory.buffer),
+    cursorView: createCursorView(memory.buffer, true),
+    textDecoder: new TextDecoder(),
+    textEncoder: new TextEncoder(),
+    strings: createWASMStringCache(),
+    failedCommands: 0,
+  };
+
+  if (scriptSource !== undefined) {
+    wasmCtx.encodedJSSource = wasmCtx.textEncoder.encode(scriptSource);
+  }
+
   const [thirdroomModule, disposeThirdroomModule] = createThirdroomModule(ctx, wasmCtx);
   const [websgModule, disposeWebSGModule] = createWebSGModule(ctx, wasmCtx);
   const [matrixModule, disposeMatrixModule] = createMatrixWASMModule(ctx, wasmCtx);
@@ -127,7 +173,7 @@ export async function loadScript(
     thirdroom: thirdroomModule,
   };
 
-  const { instance } = await WebAssembly.instantiate(wasmBuffer, imports);
+  const instance = await WebAssembly.instantiate(wasmModule, imports);
 
   const exports = instance.exports;
 
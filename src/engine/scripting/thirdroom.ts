@@ -11,6 +11,7 @@ import { getXRMode } from "../renderer/renderer.game";
 import { RemoteImage } from "../resource/RemoteResources";
 import { getRemoteImageUrl } from "../utils/getRemoteImageUrl";
 import {
+  getStringByteLength,
   readList,
   readResourceRef,
   readStringFromCursorView,
@@ -133,7 +134,7 @@ export function createThirdroomModule(ctx: GameContext, wasmCtx: WASMModuleConte
 
       const action = listener.actions[0];
 
-      return action.length;
+      return getStringByteLength(wasmCtx, action);
     },
     action_bar_listener_get_next_action(listenerId: number, idPtr: number) {
       const listener = wasmCtx.resourceManager.actionBarListeners.find((l) => l.id === listenerId);
@@ -0,0 +1,55 @@
+// Generated from the Commands IDL module by src/engine/scripting/idl/generate.ts. Do not edit.
+import { WASMModuleContext } from "./WASMModuleContext";
+
+export enum WebSGCommandType {
+  NodeSetTranslation,
+  NodeSetTranslationElement,
+  NodeSetRotation,
+  NodeSetRotationElement,
+  NodeSetScale,
+  NodeSetScaleElement,
+  NodeSetVisible,
+  MaterialSetBaseColorFactor,
+  MaterialSetBaseColorFactorElement,
+  LightSetColor,
+  LightSetColorElement,
+  LightSetIntensity,
+  PhysicsBodyApplyImpulse,
+}
+
+export const WebSGCommandTypeCount = 13;
+
+function readEnumValue(value: number, count: number, enumName: string): number {
+  if (value < count) {
+    return value;
+  }
+
+  throw new Error(`WebSG: ${value} is not a valid ${enumName}`);
+}
+
+export const WebSGCommandLayout = {
+  type: 0,
+  resourceId: 4,
+  index: 8,
+  value: 12,
+  byteLength: 28,
+};
+
+export interface WebSGCommandData {
+  type: number;
+  resourceId: number;
+  index: number;
+  value: Float32Array;
+}
+
+export function readWebSGCommand(wasmCtx: WASMModuleContext, ptr: number): WebSGCommandData {
+  const { F32Heap, U32Heap } = wasmCtx;
+  const offset = ptr / 4;
+
+  return {
+    type: readEnumValue(U32Heap[offset + 0], WebSGCommandTypeCount, "WebSGCommandType"),
+    resourceId: U32Heap[offset + 1],
+    index: U32Heap[offset + 2],
+    value: F32Heap.slice(offset + 3, offset + 7),
+  };
+}
@@ -0,0 +1,243 @@
+// Generated from the UI IDL module by src/engine/scripting/idl/generate.ts. Do not edit.
+import { readString, WASMModuleContext } from "./WASMModuleContext";
+
+export {
+  ElementType,
+  FlexDirection,
+  ElementPositionType,
+  FlexAlign,
+  FlexJustify,
+  FlexWrap,
+  UIProperty,
+} from "../resource/schema";
+
+export const ElementTypeCount = 4;
+export const FlexDirectionCount = 4;
+export const ElementPositionTypeCount = 3;
+export const FlexAlignCount = 8;
+export const FlexJustifyCount = 6;
+export const FlexWrapCount = 3;
+export const UIPropertyCount = 30;
+
+function readEnumValue(value: number, count: number, enumName: string): number {
+  if (value < count) {
+    return value;
+  }
+
+  throw new Error(`WebSG: ${value} is not a valid ${enumName}`);
+}
+
+export const UIExtensionNodeCanvasRefLayout = {
+  extensions: 0,
+  extras: 8,
+  canvas: 12,
+  byteLength: 16,
+};
+
+export interface UIExtensionNodeCanvasRefData {
+  canvas: number;
+}
+
+export function readUIExtensionNodeCanvasRef(wasmCtx: WASMModuleContext, ptr: number): UIExtensionNodeCanvasRefData {
+  const { U32Heap } = wasmCtx;
+  const offset = ptr / 4;
+
+  return {
+    canvas: U32Heap[offset + 3],
+  };
+}
+
+export const UICanvasPropsLayout = {
+  name: 0,
+  extensions: 4,
+  extras: 12,
+  root: 16,
+  size: 20,
+  width: 28,
+  height: 32,
+  byteLength: 36,
+};
+
+export interface UICanvasPropsData {
+  name: string;
+  root: number;
+  size: Float32Array;
+  width: number;
+  height: number;
+}
+
+export function readUICanvasProps(wasmCtx: WASMModuleContext, ptr: number): UICanvasPropsData {
+  const { F32Heap, U32Heap } = wasmCtx;
+  const offset = ptr / 4;
+
+  return {
+    name: readString(wasmCtx, U32Heap[offset + 0], 255),
+    root: U32Heap[offset + 4],
+    size: F32Heap.slice(offset + 5, offset + 7),
+    width: F32Heap[offset + 7],
+    height: F32Heap[offset + 8],
+  };
+}
+
+export const UIButtonPropsLayout = {
+  extensions: 0,
+  extras: 8,
+  label: 12,
+  byteLength: 20,
+};
+
+export interface UIButtonPropsData {
+  label: string;
+}
+
+export function readUIButtonProps(wasmCtx: WASMModuleContext, ptr: number): UIButtonPropsData {
+  const { U32Heap } = wasmCtx;
+  const offset = ptr / 4;
+
+  return {
+    label: readString(wasmCtx, U32Heap[offset + 3], U32Heap[offset + 4]),
+  };
+}
+
+export const UITextPropsLayout = {
+  extensions: 0,
+  extras: 8,
+  value: 12,
+  fontFamily: 20,
+  fontWeight: 28,
+  fontStyle: 36,
+  fontSize: 44,
+  color: 48,
+  byteLength: 64,
+};
+
+export interface UITextPropsData {
+  value: string;
+  fontFamily: string;
+  fontWeight: string;
+  fontStyle: string;
+  fontSize: number;
+  color: Float32Array;
+}
+
+export function readUITextProps(wasmCtx: WASMModuleContext, ptr: number): UITextPropsData {
+  const { F32Heap, U32Heap } = wasmCtx;
+  const offset = ptr / 4;
+
+  return {
+    value: readString(wasmCtx, U32Heap[offset + 3], U32Heap[offset + 4]),
+    fontFamily: readString(wasmCtx, U32Heap[offset + 5], U32Heap[offset + 6]),
+    fontWeight: readString(wasmCtx, U32Heap[offset + 7], U32Heap[offset + 8]),
+    fontStyle: readString(wasmCtx, U32Heap[offset + 9], U32Heap[offset + 10]),
+    fontSize: F32Heap[offset + 11],
+    color: F32Heap.slice(offset + 12, offset + 16),
+  };
+}
+
+export const UIElementPropsLayout = {
+  name: 0,
+  extensions: 4,
+  extras: 12,
+  type: 16,
+  position: 20,
+  positionType: 36,
+  alignContent: 40,
+  alignItems: 44,
+  alignSelf: 48,
+  flexDirection: 52,
+  flexWrap: 56,
+  flexBasis: 60,
+  flexGrow: 64,
+  flexShrink: 68,
+  justifyContent: 72,
+  width: 76,
+  height: 80,
+  minWidth: 84,
+  minHeight: 88,
+  maxWidth: 92,
+  maxHeight: 96,
+  backgroundColor: 100,
+  borderColor: 116,
+  padding: 132,
+  margin: 148,
+  borderWidth: 164,
+  borderRadius: 180,
+  button: 196,
+  text: 200,
+  byteLength: 204,
+};
+
+export interface UIElementPropsData {
+  name: string;
+  type: number;
+  position: Float32Array;
+  positionType: number;
+  alignContent: number;
+  alignItems: number;
+  alignSelf: number;
+  flexDirection: number;
+  flexWrap: number;
+  flexBasis: number;
+  flexGrow: number;
+  flexShrink: number;
+  justifyContent: number;
+  width: number;
+  height: number;
+  minWidth: number;
+  minHeight: number;
+  maxWidth: number;
+  maxHeight: number;
+  backgroundColor: Float32Array;
+  borderColor: Float32Array;
+  padding: Float32Array;
+  margin: Float32Array;
+  borderWidth: Float32Array;
+  borderRadius: Float32Array;
+  buttonPtr: number;
+  textPtr: number;
+}
+
+export function readUIElementProps(wasmCtx: WASMModuleContext, ptr: number): UIElementPropsData {
+  const { F32Heap, U32Heap } = wasmCtx;
+  const offset = ptr / 4;
+
+  return {
+    name: readString(wasmCtx, U32Heap[offset + 0], 255),
+    type: readEnumValue(U32Heap[offset + 4], ElementTypeCount, "ElementType"),
+    position: F32Heap.slice(offset + 5, offset + 9),
+    positionType: readEnumValue(U32Heap[offset + 9], ElementPositionTypeCount, "ElementPositionType"),
+    alignContent: readEnumValue(U32Heap[offset + 10], FlexAlignCount, "FlexAlign"),
+    alignItems: readEnumValue(U32Heap[offset + 11], FlexAlignCount, "FlexAlign"),
+    alignSelf: readEnumValue(U32Heap[offset + 12], FlexAlignCount, "FlexAlign"),
+    flexDirection: readEnumValue(U32Heap[offset + 13], FlexDirectionCount, "FlexDirection"),
+    flexWrap: readEnumValue(U32Heap[offset + 14], FlexWrapCount, "FlexWrap"),
+    flexBasis: F32Heap[offset + 15],
+    flexGrow: F32Heap[offset + 16],
+    flexShrink: F32Heap[offset + 17],
+    justifyContent: readEnumValue(U32Heap[offset + 18], FlexJustifyCount, "FlexJustify"),
+    width: F32Heap[offset + 19],
+    height: F32Heap[offset + 20],
+    minWidth: F32Heap[offset + 21],
+    minHeight: F32Heap[offset + 22],
+    maxWidth: F32Heap[offset + 23],
+    maxHeight: F32Heap[offset + 24],
+    backgroundColor: F32Heap.slice(offset + 25, offset + 29),
+    borderColor: F32Heap.slice(offset + 29, offset + 33),
+    padding: F32Heap.slice(offset + 33, offset + 37),
+    margin: F32Heap.slice(offset + 37, offset + 41),
+    borderWidth: F32Heap.slice(offset + 41, offset + 45),
+    borderRadius: F32Heap.slice(offset + 45, offset + 49),
+    buttonPtr: U32Heap[offset + 49],
+    textPtr: U32Heap[offset + 50],
+  };
+}
+
+export const UIPropertyUpdateLayout = {
+  elementId: 0,
+  property: 4,
+  index: 8,
+  value: 12,
+  string: 16,
+  length: 20,
+  byteLength: 24,
+};
@@ -8,14 +8,15 @@ import {
   removeQuery,
 } from "bitecs";
 import { BoxGeometry } from "three";
-import { mat4, vec2, vec3, vec4, quat } from "gl-matrix";
+import { mat3, mat4, vec2, vec3, vec4, quat } from "gl-matrix";
 import RAPIER from "@dimforge/rapier3d-compat";
 
-import { Collision, GameContext } from "../GameTypes";
+import { GameContext } from "../GameTypes";
 import {
   getScriptResource,
   getScriptResourceByNamePtr,
   getScriptResourceRef,
+  getStringByteLength,
   readEnum,
   readExtensionsAndExtras,
   readFloat32ArrayInto,
@@ -26,7 +27,6 @@ import {
   readSharedArrayBuffer,
   readString,
   readStringFromCursorView,
-  readStringLen,
   readUint8Array,
   WASMModuleContext,
   writeFloat32Array,
@@ -75,6 +75,7 @@ import {
   FlexWrap,
   FlexJustify,
   QueryModifier,
+  UIProperty,
 } from "../resource/schema";
 import {
   moveCursorView,
@@ -89,25 +90,51 @@ import {
   writeUint32,
 } from "../allocator/CursorView";
 import { AccessorComponentTypeToTypedArray, AccessorTypeToElementSize } from "../common/accessor";
-import { addPhysicsBody, PhysicsModule, registerCollisionHandler, removePhysicsBody } from "../physics/physics.game";
+import {
+  addCharacterController,
+  addPhysicsBody,
+  PhysicsModule,
+  registerCollisionHandler,
+  removeCharacterController,
+  removePhysicsBody,
+} from "../physics/physics.game";
+import {
+  castPhysicsRay,
+  castPhysicsShape,
+  createPhysicsQueryHit,
+  createPhysicsQueryShape,
+  overlapPhysicsShape,
+  PhysicsQueryFilter,
+  PhysicsQueryHit,
+} from "../physics/PhysicsQueries";
 import { getModule } from "../module/module.common";
 import { createMesh } from "../mesh/mesh.game";
 import { addInteractableComponent } from "../../plugins/interaction/interaction.game";
-import { addUIElementChild, initNodeUICanvas, removeUIElementChild } from "../ui/ui.game";
+import { addUIElementChild, createUITree, initNodeUICanvas, removeUIElementChild } from "../ui/ui.game";
+import { decodeCBOR } from "../utils/cbor";
+import {
+  readUIButtonProps,
+  readUICanvasProps,
+  readUIElementProps,
+  readUITextProps,
+  UIPropertyUpdateLayout,
+} from "./websg-ui";
+import { WebSGCommandLayout, WebSGCommandType } from "./websg-commands";
 import { startOrbit, stopOrbit } from "../player/CameraRig";
 import { GLTFComponentPropertyStorageTypeToEnum, setComponentStore } from "../resource/ComponentStore";
+import { ownsResource } from "../resource/ResourceOwnership";
 import { getPrimaryInputSourceNode } from "../input/input.game";
 import { getRotationNoAlloc } from "../utils/getRotationNoAlloc";
 
 function getScriptChildCount(wasmCtx: WASMModuleContext, node: RemoteNode | RemoteScene): number {
-  const resourceIds = wasmCtx.resourceManager.resourceIds;
+  const ownership = wasmCtx.resourceManager.ownership;
 
   let count = 0;
   let cursor = node.resourceType === ResourceType.Node ? node.firstChild : node.firstNode;
 
   while (cursor) {
     // Only count the resources owned by the script.
-    if (resourceIds.has(cursor.eid)) {
+    if (ownsResource(ownership, cursor.eid)) {
       count++;
     }
 
@@ -123,7 +150,7 @@ function getScriptChildren(
   nodeArrPtr: number,
   maxCount: number
 ): number {
-  const resourceIds = wasmCtx.resourceManager.resourceIds;
+  const ownership = wasmCtx.resourceManager.ownership;
   const U32Heap = wasmCtx.U32Heap;
 
   let i = 0;
@@ -131,7 +158,7 @@ function getScriptChildren(
 
   while (cursor && i < maxCount) {
     // Only write the resources owned by the script.
-    if (resourceIds.has(cursor.eid)) {
+    if (ownsResource(ownership, cursor.eid)) {
       U32Heap[nodeArrPtr / 4 + i] = cursor.eid;
       i++;
     }
@@ -144,21 +171,21 @@ function getScriptChildren(
 }
 
 function scriptGetChildAt(wasmCtx: WASMModuleContext, parent: RemoteNode | RemoteScene, index: number): number {
-  const resourceIds = wasmCtx.resourceManager.resourceIds;
+  const ownership = wasmCtx.resourceManager.ownership;
 
   let i = 0;
   let cursor = parent.resourceType === ResourceType.Node ? parent.firstChild : parent.firstNode;
 
   while (cursor && i < index) {
     // Only count the resources owned by the script.
-    if (resourceIds.has(cursor.eid)) {
+    if (ownsResource(ownership, cursor.eid)) {
       i++;
     }
 
     cursor = cursor.nextSibling;
   }
 
-  if (i === index && cursor && resourceIds.has(cursor.eid)) {
+  if (i === index && cursor && ownsResource(ownership, cursor.eid)) {
     return cursor.eid;
   }
 
@@ -166,14 +193,14 @@ function scriptGetChildAt(wasmCtx: WASMModuleContext, parent: RemoteNode | Remot
 }
 
 function getScriptUIElementChildCount(wasmCtx: WASMModuleContext, element: RemoteUIElement): number {
-  const resourceIds = wasmCtx.resourceManager.resourceIds;
+  const ownership = wasmCtx.resourceManager.ownership;
 
   let count = 0;
   let cursor = element.firstChild;
 
   while (cursor) {
     // Only count the resources owned by the script.
-    if (resourceIds.has(cursor.eid)) {
+    if (ownsResource(ownership, cursor.eid)) {
       count++;
     }
 
@@ -189,7 +216,7 @@ function getScriptUIElementChildren(
   elArrPtr: number,
   maxCount: number
 ): number {
-  const resourceIds = wasmCtx.resourceManager.resourceIds;
+  const ownership = wasmCtx.resourceManager.ownership;
   const U32Heap = wasmCtx.U32Heap;
 
   let i = 0;
@@ -197,7 +224,7 @@ function getScriptUIElementChildren(
 
   while (cursor && i < maxCount) {
     // Only write the resources owned by the script.
-    if (resourceIds.has(cursor.eid)) {
+    if (ownsResource(ownership, cursor.eid)) {
       U32Heap[elArrPtr / 4 + i] = cursor.eid;
       i++;
     }
@@ -210,21 +237,21 @@ function getScriptUIElementChildren(
 }
 
 function scriptGetUIElementChildAt(wasmCtx: WASMModuleContext, parent: RemoteUIElement, index: number): number {
-  const resourceIds = wasmCtx.resourceManager.resourceIds;
+  const ownership = wasmCtx.resourceManager.ownership;
 
   let i = 0;
   let cursor = parent.firstChild;
 
   while (cursor && i < index) {
     // Only count the resources owned by the script.
-    if (resourceIds.has(cursor.eid)) {
+    if (ownsResource(ownership, cursor.eid)) {
       i++;
     }
 
     cursor = cursor.nextSibling;
   }
 
-  if (i === index && cursor && resourceIds.has(cursor.eid)) {
+  if (i === index && cursor && ownsResource(ownership, cursor.eid)) {
     return cursor.eid;
   }
 
@@ -369,9 +396,21 @@ interface MeshPrimitiveProps {
 
 const tempRapierVec3 = new RAPIER.Vector3(0, 0, 0);
 
+// origin xyz, direction xyz, max distance
+const PHYSICS_CAST_STRIDE = 7;
+// hit, node, distance, position xyz, normal xyz
+const PHYSICS_HIT_STRIDE = 9;
+
+const tempQueryHit = createPhysicsQueryHit();
+const tempQueryFilter: PhysicsQueryFilter = { flags: 0 };
+const tempCastOrigin = vec3.create();
+const tempCastDirection = vec3.create();
+
 const tempVec3 = vec3.create();
 const tempDirection = vec3.create();
 const tempQuat = quat.create();
+const tempParentInverse = mat4.create();
+const tempParentRotationScale = mat3.create();
 
 // TODO: ResourceManager should have a resourceMap that corresponds to just its owned resources
 // TODO: ResourceManager should have a resourceByType that corresponds to just its owned resources
@@ -379,31 +418,170 @@ const tempQuat = quat.create();
 // TODO: When do we update local / world matrices?
 // TODO: the mesh.primitives array is allocated whenever we request it but it's now immutable
 
+function readPhysicsQueryFilter(wasmCtx: WASMModuleContext, filterPtr: number): PhysicsQueryFilter {
+  moveCursorView(wasmCtx.cursorView, filterPtr);
+  tempQueryFilter.flags = readUint32(wasmCtx.cursorView);
+  const excludeNode = readResourceRef(wasmCtx, RemoteNode);
+  tempQueryFilter.excludeRigidBody = excludeNode?.physicsBody?.body;
+  return tempQueryFilter;
+}
+
+function readPhysicsQueryShape(wasmCtx: WASMModuleContext, shapePtr: number) {
+  moveCursorView(wasmCtx.cursorView, shapePtr);
+  const type = readEnum(wasmCtx, ColliderType, "ColliderType");
+  const size = readFloat32Array(wasmCtx.cursorView, 3);
+  const radius = readFloat32(wasmCtx.cursorView);
+  const height = readFloat32(wasmCtx.cursorView);
+  const rotation = readFloat32Array(wasmCtx.cursorView, 4);
+
+  return { shape: createPhysicsQueryShape({ type, size, radius, height }), rotation };
+}
+
+const overlapResults: number[] = [];
+
+function writePhysicsHit(wasmCtx: WASMModuleContext, hitPtr: number, hit: PhysicsQueryHit | undefined) {
+  const index = hitPtr / 4;
+  const { I32Heap, U32Heap, F32Heap } = wasmCtx;
+
+  if (!hit) {
+    I32Heap.fill(0, index, index + PHYSICS_HIT_STRIDE);
+    return;
+  }
+
+  I32Heap[index] = 1;
+  // scripts only get nodes they have access to
+  U32Heap[index + 1] = ownsResource(wasmCtx.resourceManager.ownership, hit.eid) ? hit.eid : 0;
+  F32Heap[index + 2] = hit.distance;
+  F32Heap.set(hit.position, index + 3);
+  F32Heap.set(hit.normal, index + 6);
+}
+
+// Runs cast for every origin, direction and max distance tuple in the script's buffer and writes a hit for each one
+function castPhysicsBatch(
+  wasmCtx: WASMModuleContext,
+  castsPtr: number,
+  count: number,
+  hitsPtr: number,
+  cast: (origin: vec3, direction: vec3, maxDistance: number, out: PhysicsQueryHit) => boolean
+) {
+  const F32Heap = wasmCtx.F32Heap;
+  let hitCount = 0;
+
+  for (let i = 0; i < count; i++) {
+    const index = castsPtr / 4 + i * PHYSICS_CAST_STRIDE;
+    vec3.set(tempCastOrigin, F32Heap[index], F32Heap[index + 1], F32Heap[index + 2]);
+    vec3.set(tempCastDirection, F32Heap[index + 3], F32Heap[index + 4], F32Heap[index + 5]);
+    const maxDistance = F32Heap[index + 6];
+
+    const hit = cast(tempCastOrigin, tempCastDirection, maxDistance, tempQueryHit);
+    writePhysicsHit(wasmCtx, hitsPtr + i * PHYSICS_HIT_STRIDE * 4, hit ? tempQueryHit : undefined);
+
+    if (hit) {
+      hitCount++;
+    }
+  }
+
+  return hitCount;
+}
+
+// CollisionRing field offsets in 32 bit words
+const COLLISION_RING_ITEMS = 0;
+const COLLISION_RING_CAPACITY = 1;
+const COLLISION_RING_WRITE_INDEX = 2;
+const COLLISION_RING_READ_INDEX = 3;
+const COLLISION_RING_DROPPED_COUNT = 4;
+// node_a, node_b, started
+const COLLISION_ITEM_STRIDE = 3;
+
+function writeCollision(
+  wasmCtx: WASMModuleContext,
+  ringPtr: number,
+  nodeA: number,
+  nodeB: number,
+  started: boolean
+) {
+  const { U32Heap, I32Heap } = wasmCtx;
+  const ring = ringPtr / 4;
+  const capacity = U32Heap[ring + COLLISION_RING_CAPACITY];
+  const writeIndex = U32Heap[ring + COLLISION_RING_WRITE_INDEX];
+  const readIndex = U32Heap[ring + COLLISION_RING_READ_INDEX];
+
+  // indices are free running and wrap at 2^32, so the distance between them is the number of unread items
+  if ((writeIndex - readIndex) >>> 0 >= capacity) {
+    U32Heap[ring + COLLISION_RING_DROPPED_COUNT]++;
+    return;
+  }
+
+  const item = U32Heap[ring + COLLISION_RING_ITEMS] / 4 + (writeIndex & (capacity - 1)) * COLLISION_ITEM_STRIDE;
+  U32Heap[item] = nodeA;
+  U32Heap[item + 1] = nodeB;
+  I32Heap[item + 2] = started ? 1 : 0;
+  U32Heap[ring + COLLISION_RING_WRITE_INDEX] = (writeIndex + 1) >>> 0;
+}
+
 export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext) {
   const physics = getModule(ctx, PhysicsModule);
 
+  const uiTreeElements: RemoteUIElement[] = [];
+
   const disposeCollisionHandler = registerCollisionHandler(
     ctx,
     (nodeA: number, nodeB: number, _handleA: number, _handleB: number, started: boolean) => {
       const resourceManager = wasmCtx.resourceManager;
-      const resourceIds = resourceManager.resourceIds;
+      const ownership = resourceManager.ownership;
       const collisionListeners = resourceManager.collisionListeners;
 
-      if (resourceIds.has(nodeA) && resourceIds.has(nodeB)) {
-        const collision: Collision = {
-          nodeA,
-          nodeB,
-          started,
-        };
-
+      if (ownsResource(ownership, nodeA) && ownsResource(ownership, nodeB)) {
         for (let i = 0; i < collisionListeners.length; i++) {
           const listener = collisionListeners[i];
-          listener.collisions.push(collision);
+
+          if (listener.nodes && !listener.nodes.has(nodeA) && !listener.nodes.has(nodeB)) {
+            continue;
+          }
+
+          if (listener.ringPtr) {
+            writeCollision(wasmCtx, listener.ringPtr, nodeA, nodeB, started);
+          } else {
+            listener.collisions?.push({ nodeA, nodeB, started });
+          }
         }
       }
     }
   );
 
+  function createCollider(propsPtr: number, hasSimplify: boolean) {
+    try {
+      moveCursorView(wasmCtx.cursorView, propsPtr);
+      const name = readStringFromCursorView(wasmCtx);
+      readExtensionsAndExtras(wasmCtx);
+      const type = readEnum(wasmCtx, ColliderType, "ColliderType");
+
+      // TODO: Add more checks for valid props per type
+      const isTrigger = !!readUint32(wasmCtx.cursorView);
+      const size = readFloat32Array(wasmCtx.cursorView, 3);
+      const radius = readFloat32(wasmCtx.cursorView);
+      const height = readFloat32(wasmCtx.cursorView);
+      const mesh = readResourceRef(wasmCtx, RemoteMesh);
+      const simplify = hasSimplify ? readFloat32(wasmCtx.cursorView) : 0;
+
+      const collider = new RemoteCollider(wasmCtx.resourceManager, {
+        name,
+        type,
+        isTrigger,
+        size,
+        radius,
+        height,
+        mesh,
+        simplify,
+      });
+
+      return collider.eid;
+    } catch (error) {
+      console.error(`WebSG: error creating collider:`, error);
+      return -1;
+    }
+  }
+
   const websgWASMModule = {
     world_get_environment() {
       return ctx.worldResource.environment?.publicScene.eid || 0;
@@ -501,7 +679,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
       const component = wasmCtx.resourceManager.componentDefinitions.get(componentId);
 
       if (component) {
-        return component.name.length;
+        return getStringByteLength(wasmCtx, component.name);
       } else {
         console.error(`WebSG: component not registered`);
         return -1;
@@ -538,7 +716,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
           return -1;
         }
 
-        return prop.name.length;
+        return getStringByteLength(wasmCtx, prop.name);
       } else {
         console.error(`WebSG: component not registered`);
         return -1;
@@ -577,7 +755,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
           return -1;
         }
 
-        return prop.type.length;
+        return getStringByteLength(wasmCtx, prop.type);
       } else {
         console.error(`WebSG: component not registered`);
         return -1;
@@ -616,7 +794,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
           return -1;
         }
 
-        return prop.refType ? prop.refType.length : 0;
+        return prop.refType ? getStringByteLength(wasmCtx, prop.refType) : 0;
       } else {
         console.error(`WebSG: component not registered`);
         return -1;
@@ -1001,7 +1179,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return 0;
       }
 
-      if (!wasmCtx.resourceManager.resourceIds.has(parent.eid)) {
+      if (!ownsResource(wasmCtx.resourceManager.ownership, parent.eid)) {
         return 0;
       }
 
@@ -1020,7 +1198,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return 0;
       }
 
-      if (!wasmCtx.resourceManager.resourceIds.has(parentScene.eid)) {
+      if (!ownsResource(wasmCtx.resourceManager.ownership, parentScene.eid)) {
         return 0;
       }
 
@@ -2025,35 +2203,12 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
 
       return interactable.released ? 1 : 0;
     },
+    // Used by runtimes built before ColliderProps gained simplify, their props end after mesh.
     world_create_collider(propsPtr: number) {
-      try {
-        moveCursorView(wasmCtx.cursorView, propsPtr);
-        const name = readStringFromCursorView(wasmCtx);
-        readExtensionsAndExtras(wasmCtx);
-        const type = readEnum(wasmCtx, ColliderType, "ColliderType");
-
-        // TODO: Add more checks for valid props per type
-        const isTrigger = !!readUint32(wasmCtx.cursorView);
-        const size = readFloat32Array(wasmCtx.cursorView, 3);
-        const radius = readFloat32(wasmCtx.cursorView);
-        const height = readFloat32(wasmCtx.cursorView);
-        const mesh = readResourceRef(wasmCtx, RemoteMesh);
-
-        const collider = new RemoteCollider(wasmCtx.resourceManager, {
-          name,
-          type,
-          isTrigger,
-          size,
-          radius,
-          height,
-          mesh,
-        });
-
-        return collider.eid;
-      } catch (error) {
-        console.error(`WebSG: error creating collider:`, error);
-        return -1;
-      }
+      return createCollider(propsPtr, false);
+    },
+    world_create_collider_with_simplify(propsPtr: number) {
+      return createCollider(propsPtr, true);
     },
     world_find_collider_by_name(namePtr: number, byteLength: number) {
       const collider = getScriptResourceByNamePtr(ctx, wasmCtx, RemoteCollider, namePtr, byteLength);
@@ -2136,14 +2291,326 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
 
       return 0;
     },
-    world_create_collision_listener() {
-      const resourceManager = wasmCtx.resourceManager;
-      const id = resourceManager.nextCollisionListenerId++;
-      resourceManager.collisionListeners.push({
-        id,
-        collisions: [],
+    node_add_character_controller(nodeId: number, propsPtr: number) {
+      try {
+        const node = getScriptResource(wasmCtx, RemoteNode, nodeId);
+
+        if (!node) {
+          return -1;
+        }
+
+        if (!node.physicsBody?.body?.isKinematic()) {
+          throw new Error("node must have a kinematic physics body.");
+        }
+
+        moveCursorView(wasmCtx.cursorView, propsPtr);
+        const offset = readFloat32(wasmCtx.cursorView);
+        const maxSlopeClimbAngle = readFloat32(wasmCtx.cursorView);
+        const minSlopeSlideAngle = readFloat32(wasmCtx.cursorView);
+        const maxStepHeight = readFloat32(wasmCtx.cursorView);
+        const minStepWidth = readFloat32(wasmCtx.cursorView);
+        const snapToGround = readFloat32(wasmCtx.cursorView);
+        const slide = !!readUint32(wasmCtx.cursorView);
+
+        const characterController = addCharacterController(physics, node.eid, offset);
+        characterController.setMaxSlopeClimbAngle(maxSlopeClimbAngle);
+        characterController.setMinSlopeSlideAngle(minSlopeSlideAngle);
+        characterController.setSlideEnabled(slide);
+        characterController.setApplyImpulsesToDynamicBodies(true);
+
+        if (maxStepHeight > 0) {
+          characterController.enableAutostep(maxStepHeight, minStepWidth, true);
+        }
+
+        if (snapToGround > 0) {
+          characterController.enableSnapToGround(snapToGround);
+        }
+
+        return 0;
+      } catch (error) {
+        console.error(`WebSG: error adding character controller:`, error);
+        return -1;
+      }
+    },
+    node_remove_character_controller(nodeId: number) {
+      const node = getScriptResource(wasmCtx, RemoteNode, nodeId);
+
+      if (!node) {
+        return -1;
+      }
+
+      removeCharacterController(physics, node.eid);
+
+      return 0;
+    },
+    character_controller_move(nodeId: number, translationPtr: number, resultPtr: number) {
+      try {
+        const node = getScriptResource(wasmCtx, RemoteNode, nodeId);
+
+        if (!node) {
+          return -1;
+        }
+
+        const characterController = physics.eidTocharacterController.get(node.eid);
+        const collider = node.physicsBody?.body?.numColliders() ? node.physicsBody.body.collider(0) : undefined;
+
+        if (!characterController || !collider) {
+          throw new Error("node needs a character controller and a physics body with a collider.");
+        }
+
+        const { F32Heap, I32Heap, U32Heap } = wasmCtx;
+        const translation = translationPtr / 4;
+        tempRapierVec3.x = F32Heap[translation];
+        tempRapierVec3.y = F32Heap[translation + 1];
+        tempRapierVec3.z = F32Heap[translation + 2];
+
+        characterController.computeColliderMovement(collider, tempRapierVec3);
+
+        const movement = characterController.computedMovement();
+        vec3.set(tempVec3, movement.x, movement.y, movement.z);
+
+        // kinematic bodies follow their node, so apply the world space movement to the node's local position
+        if (node.parent) {
+          mat4.invert(tempParentInverse, node.parent.worldMatrix);
+          mat3.fromMat4(tempParentRotationScale, tempParentInverse);
+          vec3.transformMat3(tempDirection, tempVec3, tempParentRotationScale);
+          vec3.add(node.position, node.position, tempDirection);
+        } else {
+          vec3.add(node.position, node.position, tempVec3);
+        }
+
+        const result = resultPtr / 4;
+        F32Heap.set(tempVec3, result);
+        I32Heap[result + 3] = characterController.computedGrounded() ? 1 : 0;
+        U32Heap[result + 4] = characterController.numComputedCollisions();
+
+        return 0;
+      } catch (error) {
+        console.error(`WebSG: error moving character controller:`, error);
+        return -1;
+      }
+    },
+    physics_body_sleep(nodeId: number) {
+      const body = getScriptResource(wasmCtx, RemoteNode, nodeId)?.physicsBody?.body;
+
+      if (!body) {
+        return -1;
+      }
+
+      body.sleep();
+
+      return 0;
+    },
+    physics_body_wake_up(nodeId: number) {
+      const body = getScriptResource(wasmCtx, RemoteNode, nodeId)?.physicsBody?.body;
+
+      if (!body) {
+        return -1;
+      }
+
+      body.wakeUp();
+
+      return 0;
+    },
+    physics_body_is_sleeping(nodeId: number) {
+      const body = getScriptResource(wasmCtx, RemoteNode, nodeId)?.physicsBody?.body;
+
+      if (!body) {
+        return -1;
+      }
+
+      return body.isSleeping() ? 1 : 0;
+    },
+    physics_get_active_bodies(resultsPtr: number, maxCount: number) {
+      const { U32Heap } = wasmCtx;
+      const { ownership } = wasmCtx.resourceManager;
+      const results = resultsPtr / 4;
+      let count = 0;
+
+      // only visits the bodies in awake islands, settled bodies cost nothing
+      physics.physicsWorld.forEachActiveRigidBody((body) => {
+        const eid = physics.bodyHandleToEid.get(body.handle);
+
+        // scripts only get nodes they have access to
+        if (eid === undefined || !ownsResource(ownership, eid)) {
+          return;
+        }
+
+        if (count < maxCount) {
+          U32Heap[results + count] = eid;
+        }
+
+        count++;
       });
-      return id;
+
+      return count;
+    },
+    physics_bodies_apply_impulses(nodeIdsPtr: number, impulsesPtr: number, count: number) {
+      const { U32Heap, F32Heap } = wasmCtx;
+      const nodeIds = nodeIdsPtr / 4;
+      const impulses = impulsesPtr / 4;
+
+      for (let i = 0; i < count; i++) {
+        const body = getScriptResource(wasmCtx, RemoteNode, U32Heap[nodeIds + i])?.physicsBody?.body;
+
+        if (!body) {
+          continue;
+        }
+
+        tempRapierVec3.x = F32Heap[impulses + i * 3];
+        tempRapierVec3.y = F32Heap[impulses + i * 3 + 1];
+        tempRapierVec3.z = F32Heap[impulses + i * 3 + 2];
+        body.applyImpulse(tempRapierVec3, true);
+      }
+
+      return 0;
+    },
+    physics_bodies_get_velocities(nodeIdsPtr: number, velocitiesPtr: number, count: number) {
+      const { U32Heap, F32Heap } = wasmCtx;
+      const nodeIds = nodeIdsPtr / 4;
+      const velocities = velocitiesPtr / 4;
+
+      for (let i = 0; i < count; i++) {
+        const body = getScriptResource(wasmCtx, RemoteNode, U32Heap[nodeIds + i])?.physicsBody?.body;
+        const index = velocities + i * 6;
+
+        if (!body) {
+          F32Heap.fill(0, index, index + 6);
+          continue;
+        }
+
+        const linvel = body.linvel();
+        const angvel = body.angvel();
+        F32Heap[index] = linvel.x;
+        F32Heap[index + 1] = linvel.y;
+        F32Heap[index + 2] = linvel.z;
+        F32Heap[index + 3] = angvel.x;
+        F32Heap[index + 4] = angvel.y;
+        F32Heap[index + 5] = angvel.z;
+      }
+
+      return 0;
+    },
+    physics_bodies_set_velocities(nodeIdsPtr: number, velocitiesPtr: number, count: number) {
+      const { U32Heap, F32Heap } = wasmCtx;
+      const nodeIds = nodeIdsPtr / 4;
+      const velocities = velocitiesPtr / 4;
+
+      for (let i = 0; i < count; i++) {
+        const body = getScriptResource(wasmCtx, RemoteNode, U32Heap[nodeIds + i])?.physicsBody?.body;
+        const index = velocities + i * 6;
+
+        if (!body) {
+          continue;
+        }
+
+        tempRapierVec3.x = F32Heap[index];
+        tempRapierVec3.y = F32Heap[index + 1];
+        tempRapierVec3.z = F32Heap[index + 2];
+        body.setLinvel(tempRapierVec3, true);
+        tempRapierVec3.x = F32Heap[index + 3];
+        tempRapierVec3.y = F32Heap[index + 4];
+        tempRapierVec3.z = F32Heap[index + 5];
+        body.setAngvel(tempRapierVec3, true);
+      }
+
+      return 0;
+    },
+    physics_cast_rays(raysPtr: number, count: number, filterPtr: number, hitsPtr: number) {
+      try {
+        const filter = readPhysicsQueryFilter(wasmCtx, filterPtr);
+
+        return castPhysicsBatch(wasmCtx, raysPtr, count, hitsPtr, (origin, direction, maxDistance, out) =>
+          castPhysicsRay(physics, origin, direction, maxDistance, filter, out)
+        );
+      } catch (error) {
+        console.error(`WebSG: error casting rays:`, error);
+        return -1;
+      }
+    },
+    physics_cast_shapes(shapePtr: number, castsPtr: number, count: number, filterPtr: number, hitsPtr: number) {
+      try {
+        // one shape for the whole batch
+        const { shape, rotation } = readPhysicsQueryShape(wasmCtx, shapePtr);
+        const filter = readPhysicsQueryFilter(wasmCtx, filterPtr);
+
+        return castPhysicsBatch(wasmCtx, castsPtr, count, hitsPtr, (origin, direction, maxDistance, out) =>
+          castPhysicsShape(physics, shape, rotation, origin, direction, maxDistance, filter, out)
+        );
+      } catch (error) {
+        console.error(`WebSG: error casting shapes:`, error);
+        return -1;
+      }
+    },
+    physics_overlap_shape(
+      shapePtr: number,
+      positionPtr: number,
+      filterPtr: number,
+      resultsPtr: number,
+      maxCount: number
+    ) {
+      try {
+        const { shape, rotation } = readPhysicsQueryShape(wasmCtx, shapePtr);
+        const filter = readPhysicsQueryFilter(wasmCtx, filterPtr);
+        const position = wasmCtx.F32Heap.subarray(positionPtr / 4, positionPtr / 4 + 3);
+
+        overlapPhysicsShape(physics, shape, position, rotation, filter, overlapResults);
+
+        const { U32Heap } = wasmCtx;
+        const { ownership } = wasmCtx.resourceManager;
+        const results = resultsPtr / 4;
+        let count = 0;
+
+        for (let i = 0; i < overlapResults.length; i++) {
+          const eid = overlapResults[i];
+
+          // scripts only get nodes they have access to
+          if (!ownsResource(ownership, eid)) {
+            continue;
+          }
+
+          if (count < maxCount) {
+            U32Heap[results + count] = eid;
+          }
+
+          count++;
+        }
+
+        return count;
+      } catch (error) {
+        console.error(`WebSG: error finding overlapping nodes:`, error);
+        return -1;
+      }
+    },
+    world_create_collision_ring_listener(propsPtr: number) {
+      try {
+        moveCursorView(wasmCtx.cursorView, propsPtr);
+        const nodeIds = readUint32List(wasmCtx.cursorView);
+        const ringPtr = readUint32(wasmCtx.cursorView);
+
+        if (!ringPtr) {
+          throw new Error("missing collision ring.");
+        }
+
+        const capacity = wasmCtx.U32Heap[ringPtr / 4 + COLLISION_RING_CAPACITY];
+
+        // slots are masked out of the free running indices
+        if (capacity === 0 || (capacity & (capacity - 1)) !== 0) {
+          throw new Error("collision ring capacity must be a power of two.");
+        }
+
+        const resourceManager = wasmCtx.resourceManager;
+        const id = resourceManager.nextCollisionListenerId++;
+        resourceManager.collisionListeners.push({
+          id,
+          nodes: nodeIds.length > 0 ? new Set(nodeIds) : undefined,
+          ringPtr,
+        });
+        return id;
+      } catch (error) {
+        console.error(`WebSG: error creating collision listener:`, error);
+        return 0;
+      }
     },
     collision_listener_dispose(listenerId: number) {
       const resourceManager = wasmCtx.resourceManager;
@@ -2155,10 +2622,21 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
       resourceManager.collisionListeners.splice(index, 1);
       return 0;
     },
+    // Queue based collision listeners used by runtimes built before collision rings. Kept so that scripts using an
+    // older scripting-runtime.wasm still link.
+    world_create_collision_listener() {
+      const resourceManager = wasmCtx.resourceManager;
+      const id = resourceManager.nextCollisionListenerId++;
+      resourceManager.collisionListeners.push({
+        id,
+        collisions: [],
+      });
+      return id;
+    },
     collisions_listener_get_collision_count(listenerId: number) {
       const resourceManager = wasmCtx.resourceManager;
       const listener = resourceManager.collisionListeners.find((l) => l.id === listenerId);
-      if (!listener) {
+      if (!listener || !listener.collisions) {
         console.error(`WebSG: collision listener ${listenerId} not found.`);
         return -1;
       }
@@ -2168,7 +2646,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
       const resourceManager = wasmCtx.resourceManager;
       const listener = resourceManager.collisionListeners.find((l) => l.id === listenerId);
 
-      if (!listener) {
+      if (!listener || !listener.collisions) {
         console.error(`WebSG: collision listener ${listenerId} not found.`);
         return -1;
       }
@@ -2198,13 +2676,8 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
     // UI Canvas
     world_create_ui_canvas(propsPtr: number) {
       try {
-        moveCursorView(wasmCtx.cursorView, propsPtr);
-        const name = readStringFromCursorView(wasmCtx);
-        readExtensionsAndExtras(wasmCtx);
-        const root = readResourceRef(wasmCtx, RemoteUIElement);
-        const size = readFloat32Array(wasmCtx.cursorView, 2);
-        const width = readFloat32(wasmCtx.cursorView);
-        const height = readFloat32(wasmCtx.cursorView);
+        const { name, root: rootId, size, width, height } = readUICanvasProps(wasmCtx, propsPtr);
+        const root = rootId ? getScriptResource(wasmCtx, RemoteUIElement, rootId) : undefined;
 
         const uiCanvas = new RemoteUICanvas(wasmCtx.resourceManager, {
           name,
@@ -2254,7 +2727,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return 0;
       }
 
-      if (!wasmCtx.resourceManager.resourceIds.has(root.eid)) {
+      if (!ownsResource(wasmCtx.resourceManager.ownership, root.eid)) {
         return 0;
       }
 
@@ -2370,112 +2843,63 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
 
       return 0;
     },
+    ui_canvas_commit(canvasId: number, updatesPtr: number, count: number) {
+      const canvas = getScriptResource(wasmCtx, RemoteUICanvas, canvasId);
 
-    // UI Element
+      if (!canvas) {
+        return -1;
+      }
 
-    world_create_ui_element(propsPtr: number) {
-      moveCursorView(wasmCtx.cursorView, propsPtr);
-      const name = readStringFromCursorView(wasmCtx);
-      readExtensionsAndExtras(wasmCtx);
-      const type = readEnum(wasmCtx, ElementType, "ElementType");
-      const position = readFloat32Array(wasmCtx.cursorView, 4);
-      const positionType = readEnum(wasmCtx, ElementPositionType, "PositionType");
-      const alignContent = readEnum(wasmCtx, FlexAlign, "FlexAlign");
-      const alignItems = readEnum(wasmCtx, FlexAlign, "FlexAlign");
-      const alignSelf = readEnum(wasmCtx, FlexAlign, "FlexAlign");
-      const flexDirection = readEnum(wasmCtx, FlexDirection, "FlexDirection");
-      const flexWrap = readEnum(wasmCtx, FlexWrap, "FlexWrap");
-      const flexBasis = readFloat32(wasmCtx.cursorView);
-      const flexGrow = readFloat32(wasmCtx.cursorView);
-      const flexShrink = readFloat32(wasmCtx.cursorView);
-      const justifyContent = readEnum(wasmCtx, FlexJustify, "FlexJustify");
-      const width = readFloat32(wasmCtx.cursorView);
-      const height = readFloat32(wasmCtx.cursorView);
-      const minWidth = readFloat32(wasmCtx.cursorView);
-      const minHeight = readFloat32(wasmCtx.cursorView);
-      const maxWidth = readFloat32(wasmCtx.cursorView);
-      const maxHeight = readFloat32(wasmCtx.cursorView);
-      const backgroundColor = readFloat32Array(wasmCtx.cursorView, 4);
-      const borderColor = readFloat32Array(wasmCtx.cursorView, 4);
-      const padding = readFloat32Array(wasmCtx.cursorView, 4);
-      const margin = readFloat32Array(wasmCtx.cursorView, 4);
-      const borderWidth = readFloat32Array(wasmCtx.cursorView, 4);
-      const borderRadius = readFloat32Array(wasmCtx.cursorView, 4);
-      const buttonPtr = readUint32(wasmCtx.cursorView);
-      const textPtr = readUint32(wasmCtx.cursorView);
-
-      let button: RemoteUIButton | undefined = undefined;
-
-      if (type === ElementType.Button) {
-        const rewind = rewindCursorView(wasmCtx.cursorView);
-        moveCursorView(wasmCtx.cursorView, buttonPtr);
+      const U32Heap = wasmCtx.U32Heap;
+      const F32Heap = wasmCtx.F32Heap;
+      const { elementId, property, index, value, string, length, byteLength } = UIPropertyUpdateLayout;
+      let failed = 0;
 
-        readExtensionsAndExtras(wasmCtx);
-        const label = readStringLen(wasmCtx);
+      // read the fields in place rather than allocating an object per update
+      for (let i = 0; i < count; i++) {
+        const ptr = updatesPtr + i * byteLength;
 
-        button = new RemoteUIButton(wasmCtx.resourceManager, {
-          label,
-        });
+        if (
+          applyUIPropertyUpdate(
+            U32Heap[(ptr + elementId) / 4],
+            U32Heap[(ptr + property) / 4],
+            U32Heap[(ptr + index) / 4],
+            F32Heap[(ptr + value) / 4],
+            U32Heap[(ptr + string) / 4],
+            U32Heap[(ptr + length) / 4]
+          ) === -1
+        ) {
+          failed++;
+        }
+      }
 
-        addInteractableComponent(ctx, physics, button, InteractableType.UI);
+      canvas.redraw++;
 
-        rewind();
-      }
+      return failed;
+    },
 
-      skipUint32(wasmCtx.cursorView); // Button ptr
+    // UI Element
 
-      let text: RemoteUIText | undefined = undefined;
+    world_create_ui_element(propsPtr: number) {
+      try {
+        const { type, buttonPtr, textPtr, ...elementProps } = readUIElementProps(wasmCtx, propsPtr);
 
-      if (type === ElementType.Text || type === ElementType.Button) {
-        const rewind = rewindCursorView(wasmCtx.cursorView);
-        moveCursorView(wasmCtx.cursorView, textPtr);
-        readExtensionsAndExtras(wasmCtx);
-        const value = readStringLen(wasmCtx);
-        const fontFamily = readStringLen(wasmCtx);
-        const fontWeight = readStringLen(wasmCtx);
-        const fontStyle = readStringLen(wasmCtx);
-        const fontSize = readFloat32(wasmCtx.cursorView);
-        const color = readFloat32Array(wasmCtx.cursorView, 4);
-
-        text = new RemoteUIText(wasmCtx.resourceManager, {
-          value,
-          fontFamily,
-          fontWeight,
-          fontStyle,
-          fontSize,
-          color,
-        });
+        let button: RemoteUIButton | undefined = undefined;
 
-        rewind();
-      }
+        if (type === ElementType.Button) {
+          button = new RemoteUIButton(wasmCtx.resourceManager, readUIButtonProps(wasmCtx, buttonPtr));
+          addInteractableComponent(ctx, physics, button, InteractableType.UI);
+        }
+
+        let text: RemoteUIText | undefined = undefined;
+
+        if (type === ElementType.Text || type === ElementType.Button) {
+          text = new RemoteUIText(wasmCtx.resourceManager, readUITextProps(wasmCtx, textPtr));
+        }
 
-      try {
         const uiElement = new RemoteUIElement(wasmCtx.resourceManager, {
-          name,
+          ...elementProps,
           type,
-          position,
-          positionType,
-          alignContent,
-          alignItems,
-          alignSelf,
-          flexDirection,
-          flexWrap,
-          flexBasis,
-          flexGrow,
-          flexShrink,
-          justifyContent,
-          width,
-          height,
-          minWidth,
-          minHeight,
-          maxWidth,
-          maxHeight,
-          backgroundColor,
-          borderColor,
-          padding,
-          margin,
-          borderWidth,
-          borderRadius,
           button,
           text,
         });
@@ -2485,6 +2909,27 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return -1;
       }
     },
+    world_create_ui_tree(dataPtr: number, byteLength: number, elementsPtr: number, maxCount: number) {
+      try {
+        const description = decodeCBOR(readUint8Array(wasmCtx, dataPtr, byteLength));
+        createUITree(ctx, physics, wasmCtx.resourceManager, description, uiTreeElements);
+      } catch (e) {
+        console.error("WebSG: error creating ui tree", e);
+        return -1;
+      }
+
+      const U32Heap = wasmCtx.U32Heap;
+      const count = Math.min(uiTreeElements.length, maxCount);
+
+      for (let i = 0; i < count; i++) {
+        U32Heap[elementsPtr / 4 + i] = uiTreeElements[i].eid;
+      }
+
+      const total = uiTreeElements.length;
+      uiTreeElements.length = 0;
+
+      return total;
+    },
     world_find_ui_element_by_name(namePtr: number, byteLength: number) {
       const uiElement = getScriptResourceByNamePtr(ctx, wasmCtx, RemoteUIElement, namePtr, byteLength);
       return uiElement ? uiElement.eid : 0;
@@ -3221,7 +3666,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return 0;
       }
 
-      if (!wasmCtx.resourceManager.resourceIds.has(parent.eid)) {
+      if (!ownsResource(wasmCtx.resourceManager.ownership, parent.eid)) {
         return 0;
       }
 
@@ -3240,7 +3685,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return -1;
       }
 
-      return el.button.label.length;
+      return getStringByteLength(wasmCtx, el.button.label);
     },
     ui_button_get_label(uiElementId: number, labelPtr: number, length: number) {
       const el = getScriptResource(wasmCtx, RemoteUIElement, uiElementId);
@@ -3343,7 +3788,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return -1;
       }
 
-      return el.text.value.length;
+      return getStringByteLength(wasmCtx, el.text.value);
     },
     ui_text_get_value(uiElementId: number, valuePtr: number, length: number) {
       const el = getScriptResource(wasmCtx, RemoteUIElement, uiElementId);
@@ -3388,7 +3833,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return -1;
       }
 
-      return el.text.fontFamily.length;
+      return getStringByteLength(wasmCtx, el.text.fontFamily);
     },
     ui_text_get_font_family(uiElementId: number, fontFamilyPtr: number, length: number) {
       const el = getScriptResource(wasmCtx, RemoteUIElement, uiElementId);
@@ -3437,7 +3882,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return -1;
       }
 
-      return el.text.fontStyle.length;
+      return getStringByteLength(wasmCtx, el.text.fontStyle);
     },
     ui_text_get_font_style(uiElementId: number, fontStylePtr: number, length: number) {
       const el = getScriptResource(wasmCtx, RemoteUIElement, uiElementId);
@@ -3486,7 +3931,7 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
         return -1;
       }
 
-      return el.text.fontWeight.length;
+      return getStringByteLength(wasmCtx, el.text.fontWeight);
     },
     ui_text_get_font_weight(uiElementId: number, fontWeightPtr: number, length: number) {
       const el = getScriptResource(wasmCtx, RemoteUIElement, uiElementId);
@@ -3610,6 +4055,33 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
 
       return 0;
     },
+    commands_flush(commandsPtr: number, count: number) {
+      const U32Heap = wasmCtx.U32Heap;
+      const F32Heap = wasmCtx.F32Heap;
+      const { type, resourceId, index, value, byteLength } = WebSGCommandLayout;
+      let failed = 0;
+
+      // read the fields in place rather than allocating an object per command
+      for (let i = 0; i < count; i++) {
+        const ptr = commandsPtr + i * byteLength;
+
+        if (
+          applyWebSGCommand(
+            U32Heap[(ptr + type) / 4],
+            U32Heap[(ptr + resourceId) / 4],
+            U32Heap[(ptr + index) / 4],
+            ptr + value
+          ) === -1
+        ) {
+          failed++;
+        }
+      }
+
+      // the script runtime flushes from getters and host calls that can't report failures, so keep a total
+      wasmCtx.failedCommands += failed;
+
+      return failed;
+    },
     get_primary_input_source_origin_element(index: number) {
       const node = getPrimaryInputSourceNode(ctx);
       mat4.getTranslation(tempVec3, node.worldMatrix);
@@ -3624,12 +4096,136 @@ export function createWebSGModule(ctx: GameContext, wasmCtx: WASMModuleContext)
     },
   };
 
+  // Applies one UIPropertyUpdate recorded by a script UI batch through the matching setter
+  function applyUIPropertyUpdate(
+    elementId: number,
+    property: UIProperty,
+    index: number,
+    value: number,
+    stringPtr: number,
+    length: number
+  ): number {
+    const m = websgWASMModule;
+
+    switch (property) {
+      case UIProperty.PositionType:
+        return m.ui_element_set_position_type(elementId, value);
+      case UIProperty.Position:
+        return m.ui_element_set_position_element(elementId, index, value);
+      case UIProperty.AlignContent:
+        return m.ui_element_set_align_content(elementId, value);
+      case UIProperty.AlignItems:
+        return m.ui_element_set_align_items(elementId, value);
+      case UIProperty.AlignSelf:
+        return m.ui_element_set_align_self(elementId, value);
+      case UIProperty.FlexDirection:
+        return m.ui_element_set_flex_direction(elementId, value);
+      case UIProperty.FlexWrap:
+        return m.ui_element_set_flex_wrap(elementId, value);
+      case UIProperty.FlexBasis:
+        return m.ui_element_set_flex_basis(elementId, value);
+      case UIProperty.FlexGrow:
+        return m.ui_element_set_flex_grow(elementId, value);
+      case UIProperty.FlexShrink:
+        return m.ui_element_set_flex_shrink(elementId, value);
+      case UIProperty.JustifyContent:
+        return m.ui_element_set_justify_content(elementId, value);
+      case UIProperty.Width:
+        return m.ui_element_set_width(elementId, value);
+      case UIProperty.Height:
+        return m.ui_element_set_height(elementId, value);
+      case UIProperty.MinWidth:
+        return m.ui_element_set_min_width(elementId, value);
+      case UIProperty.MinHeight:
+        return m.ui_element_set_min_height(elementId, value);
+      case UIProperty.MaxWidth:
+        return m.ui_element_set_max_width(elementId, value);
+      case UIProperty.MaxHeight:
+        return m.ui_element_set_max_height(elementId, value);
+      case UIProperty.BackgroundColor:
+        return m.ui_element_set_background_color_element(elementId, index, value);
+      case UIProperty.BorderColor:
+        return m.ui_element_set_border_color_element(elementId, index, value);
+      case UIProperty.Padding:
+        return m.ui_element_set_padding_element(elementId, index, value);
+      case UIProperty.Margin:
+        return m.ui_element_set_margin_element(elementId, index, value);
+      case UIProperty.BorderWidth:
+        return m.ui_element_set_border_width_element(elementId, index, value);
+      case UIProperty.BorderRadius:
+        return m.ui_element_set_border_radius_element(elementId, index, value);
+      case UIProperty.ButtonLabel:
+        return m.ui_button_set_label(elementId, stringPtr, length);
+      case UIProperty.TextValue:
+        return m.ui_text_set_value(elementId, stringPtr, length);
+      case UIProperty.TextFontFamily:
+        return m.ui_text_set_font_family(elementId, stringPtr, length);
+      case UIProperty.TextFontStyle:
+        return m.ui_text_set_font_style(elementId, stringPtr, length);
+      case UIProperty.TextFontWeight:
+        return m.ui_text_set_font_weight(elementId, stringPtr, length);
+      case UIProperty.TextFontSize:
+        return m.ui_text_set_font_size(elementId, value);
+      case UIProperty.TextColor:
+        return m.ui_text_set_color_element(elementId, index, value);
+      default:
+        console.error(`WebSG: invalid UI property ${property}`);
+        return -1;
+    }
+  }
+
+  // Executes one command recorded by the script runtime's command buffer through the matching setter.
+  // valuePtr points at the command's values so that vector setters can read them in place.
+  function applyWebSGCommand(type: WebSGCommandType, resourceId: number, index: number, valuePtr: number): number {
+    const m = websgWASMModule;
+    const value = wasmCtx.F32Heap[valuePtr / 4];
+
+    switch (type) {
+      case WebSGCommandType.NodeSetTranslation:
+        return m.node_set_translation(resourceId, valuePtr);
+      case WebSGCommandType.NodeSetTranslationElement:
+        return m.node_set_translation_element(resourceId, index, value);
+      case WebSGCommandType.NodeSetRotation:
+        return m.node_set_rotation(resourceId, valuePtr);
+      case WebSGCommandType.NodeSetRotationElement:
+        return m.node_set_rotation_element(resourceId, index, value);
+      case WebSGCommandType.NodeSetScale:
+        return m.node_set_scale(resourceId, valuePtr);
+      case WebSGCommandType.NodeSetScaleElement:
+        return m.node_set_scale_element(resourceId, index, value);
+      case WebSGCommandType.NodeSetVisible:
+        return m.node_set_visible(resourceId, value);
+      case WebSGCommandType.MaterialSetBaseColorFactor:
+        return m.material_set_base_color_factor(resourceId, valuePtr);
+      case WebSGCommandType.MaterialSetBaseColorFactorElement:
+        return m.material_set_base_color_factor_element(resourceId, index, value);
+      case WebSGCommandType.LightSetColor:
+        return m.light_set_color(resourceId, valuePtr);
+      case WebSGCommandType.LightSetColorElement:
+        return m.light_set_color_element(resourceId, index, value);
+      case WebSGCommandType.LightSetIntensity:
+        return m.light_set_intensity(resourceId, value);
+      case WebSGCommandType.PhysicsBodyApplyImpulse:
+        return m.physics_body_apply_impulse(resourceId, valuePtr);
+      default:
+        console.error(`WebSG: invalid command type ${type}`);
+        return -1;
+    }
+  }
+
   const disposeWebSGWASMModule = () => {
     for (const query of wasmCtx.resourceManager.registeredQueries.values()) {
       removeQuery(ctx.world, query);
     }
 
     disposeCollisionHandler();
+
+    // the physics module also holds the player's controller, only remove the ones on the script's nodes
+    for (const eid of physics.eidTocharacterController.keys()) {
+      if (ownsResource(wasmCtx.resourceManager.ownership, eid)) {
+        removeCharacterController(physics, eid);
+      }
+    }
   };
 
   return [websgWASMModule, disposeWebSGWASMModule] as const;
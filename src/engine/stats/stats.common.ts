@@ -1,6 +1,12 @@
 export enum Stats {
   gameTime,
   gameDuration,
+  networkBytesSent,
+  networkMessagesSent,
+  networkBytesReceived,
+  networkMessagesReceived,
+  networkRTT,
+  networkPacketLoss,
 }
 
 export interface StatsBuffer {
@@ -1,6 +1,8 @@
 import { GameContext } from "../GameTypes";
 import { defineModule, getModule, Thread } from "../module/module.common";
 import { InitializeStatsBufferMessage, Stats, StatsBuffer, StatsMessageType } from "./stats.common";
+import { NetworkModule } from "../network/network.game";
+import { getAveragePeerLatency } from "../network/NetworkStats";
 
 interface StatsModuleState {
   statsBuffer: StatsBuffer;
@@ -21,9 +23,20 @@ export const StatsModule = defineModule<GameContext, StatsModuleState>({
   init() {},
 });
 
+const latency = { rtt: 0, packetLoss: 0 };
+
 export function GameWorkerStatsSystem(ctx: GameContext) {
   const stats = getModule(ctx, StatsModule);
   const frameDuration = performance.now() - ctx.elapsed;
   stats.statsBuffer.f32[Stats.gameTime] = ctx.dt;
   stats.statsBuffer.f32[Stats.gameDuration] = frameDuration;
+
+  const network = getModule(ctx, NetworkModule);
+  const { rtt, packetLoss } = getAveragePeerLatency(network, latency);
+  stats.statsBuffer.u32[Stats.networkBytesSent] = network.stats.bytesSent;
+  stats.statsBuffer.u32[Stats.networkMessagesSent] = network.stats.messagesSent;
+  stats.statsBuffer.u32[Stats.networkBytesReceived] = network.stats.bytesReceived;
+  stats.statsBuffer.u32[Stats.networkMessagesReceived] = network.stats.messagesReceived;
+  stats.statsBuffer.f32[Stats.networkRTT] = rtt;
+  stats.statsBuffer.f32[Stats.networkPacketLoss] = packetLoss;
 }
@@ -60,6 +60,12 @@ export function getStats(ctx: MainContext): StatsObject {
   stats.frameDuration = (renderStatsBuffer.f32[RenderStats.frameDuration] * 1000).toFixed(2);
   stats.gameTime = (buffer.f32[Stats.gameTime] * 1000).toFixed(2);
   stats.gameDuration = buffer.f32[Stats.gameDuration].toFixed(2);
+  stats.networkBytesSent = buffer.u32[Stats.networkBytesSent];
+  stats.networkMessagesSent = buffer.u32[Stats.networkMessagesSent];
+  stats.networkBytesReceived = buffer.u32[Stats.networkBytesReceived];
+  stats.networkMessagesReceived = buffer.u32[Stats.networkMessagesReceived];
+  stats.networkRTT = buffer.f32[Stats.networkRTT].toFixed(2);
+  stats.networkPacketLoss = (buffer.f32[Stats.networkPacketLoss] * 100).toFixed(1);
   stats.frame = renderStatsBuffer.u32[RenderStats.frame];
   stats.staleFrames = renderStatsBuffer.u32[RenderStats.staleFrames];
   stats.drawCalls = renderStatsBuffer.u32[RenderStats.drawCalls];
@@ -0,0 +1,71 @@
+import { deepStrictEqual, strictEqual, throws } from "assert";
+
+import { ElementPositionType, ElementType, FlexAlign, FlexDirection, FlexJustify, FlexWrap } from "../resource/schema";
+import { decodeCBOR, encodeCBOR } from "../utils/cbor";
+import { readUITree } from "./ui.game";
+
+// scripts send descriptions as CBOR
+const readEncodedUITree = (description: any) => readUITree(decodeCBOR(encodeCBOR(description)));
+
+describe("readUITree", () => {
+  test("flatten nested children in depth first order", () => {
+    const entries = readEncodedUITree({
+      name: "root",
+      children: [
+        { name: "a", children: [{ name: "a1" }, { name: "a2", type: "text" }] },
+        { name: "b", type: "button", label: "OK" },
+      ],
+    });
+
+    deepStrictEqual(entries.map(({ props }) => props.name), ["root", "a", "a1", "a2", "b"]);
+    deepStrictEqual(entries.map(({ parentIndex }) => parentIndex), [-1, 0, 1, 1, 0]);
+    deepStrictEqual(
+      entries.map(({ type }) => type),
+      [ElementType.Flex, ElementType.Flex, ElementType.Flex, ElementType.Text, ElementType.Button]
+    );
+  });
+
+  test("map layout props onto the schema enums", () => {
+    const [{ props }] = readEncodedUITree({
+      position: "absolute",
+      top: 10,
+      left: 5,
+      flexDirection: "column",
+      flexWrap: "wrap",
+      alignItems: "center",
+      justifyContent: "space-between",
+      backgroundColor: [1, 0, 0, 1],
+    });
+
+    strictEqual(props.positionType, ElementPositionType.Absolute);
+    deepStrictEqual(Array.from(props.position), [10, 0, 0, 5]);
+    strictEqual(props.flexDirection, FlexDirection.Column);
+    strictEqual(props.flexWrap, FlexWrap.Wrap);
+    strictEqual(props.alignItems, FlexAlign.Center);
+    strictEqual(props.justifyContent, FlexJustify.SpaceBetween);
+    deepStrictEqual(Array.from(props.backgroundColor), [1, 0, 0, 1]);
+
+    // unset props keep the createUIElement defaults
+    strictEqual(props.alignSelf, FlexAlign.Auto);
+    strictEqual(props.width, -1);
+  });
+
+  test("reject invalid descriptions", () => {
+    throws(() => readEncodedUITree({ type: "image" }), /invalid type "image"/);
+    throws(() => readEncodedUITree({ children: [{ flexDirection: "diagonal" }] }), /invalid flexDirection/);
+    throws(() => readEncodedUITree({ width: "100px" }), /width must be a number/);
+    throws(() => readEncodedUITree({ margin: [0, "1", 0, 0] }), /margin must be an array of numbers/);
+    throws(() => readEncodedUITree({ type: "text", fontSize: "big" }), /fontSize must be a number/);
+    throws(() => readEncodedUITree({ children: {} }), /children must be an array/);
+    throws(() => readEncodedUITree({ children: [1] }), /must be objects/);
+    throws(() => readEncodedUITree([]), /must be objects/);
+
+    let deep: any = {};
+
+    for (let i = 0; i < 65; i++) {
+      deep = { children: [deep] };
+    }
+
+    throws(() => readUITree(deep), /nested too deeply/);
+  });
+});
@@ -6,7 +6,7 @@ import {
   InteractionModule,
   sendInteractionMessage,
 } from "../../plugins/interaction/interaction.game";
-import { GameContext } from "../GameTypes";
+import { GameContext, RemoteResourceManager } from "../GameTypes";
 import { defineModule, getModule, registerMessageHandler } from "../module/module.common";
 import { dynamicObjectCollisionGroups } from "../physics/CollisionGroups";
 import { addPhysicsBody, addPhysicsCollider, PhysicsModuleState } from "../physics/physics.game";
@@ -17,10 +17,21 @@ import {
   RemoteUIButton,
   RemoteUICanvas,
   RemoteUIElement,
+  RemoteUIText,
   RemotePhysicsBody,
 } from "../resource/RemoteResources";
 import { tryGetRemoteResource } from "../resource/resource.game";
-import { ColliderType, InteractableType, PhysicsBodyType } from "../resource/schema";
+import {
+  ColliderType,
+  ElementPositionType,
+  ElementType,
+  FlexAlign,
+  FlexDirection,
+  FlexJustify,
+  FlexWrap,
+  InteractableType,
+  PhysicsBodyType,
+} from "../resource/schema";
 import { createDisposables } from "../utils/createDisposables";
 import { InteractableAction } from "../../plugins/interaction/interaction.common";
 import { playOneShotAudio } from "../audio/audio.game";
@@ -199,3 +210,269 @@ export function removeUIElementChild(parent: RemoteUIElement, child: RemoteUIEle
   child.firstChild = undefined;
   child.removeRef();
 }
+
+/**
+ * UI Trees
+ *
+ * A UI tree description is a nested object with the same keys as the props of createUIElement, createUIText and
+ * createUIButton, plus a type ("flex", "text" or "button") and an array of child descriptions.
+ */
+
+const elementTypes: { [key: string]: ElementType } = {
+  flex: ElementType.Flex,
+  text: ElementType.Text,
+  button: ElementType.Button,
+};
+
+const flexDirections: { [key: string]: FlexDirection } = {
+  column: FlexDirection.Column,
+  "column-reverse": FlexDirection.ColumnReverse,
+  row: FlexDirection.Row,
+  "row-reverse": FlexDirection.RowReverse,
+};
+
+const positionTypes: { [key: string]: ElementPositionType } = {
+  relative: ElementPositionType.Relative,
+  absolute: ElementPositionType.Absolute,
+};
+
+const flexAligns: { [key: string]: FlexAlign } = {
+  auto: FlexAlign.Auto,
+  "flex-start": FlexAlign.FlexStart,
+  center: FlexAlign.Center,
+  "flex-end": FlexAlign.FlexEnd,
+  stretch: FlexAlign.Stretch,
+  baseline: FlexAlign.Baseline,
+  "space-between": FlexAlign.SpaceBetween,
+  "space-around": FlexAlign.SpaceAround,
+};
+
+const flexJustifies: { [key: string]: FlexJustify } = {
+  "flex-start": FlexJustify.FlexStart,
+  center: FlexJustify.Center,
+  "flex-end": FlexJustify.FlexEnd,
+  "space-between": FlexJustify.SpaceBetween,
+  "space-around": FlexJustify.SpaceAround,
+  "space-evenly": FlexJustify.SpaceEvenly,
+};
+
+const flexWraps: { [key: string]: FlexWrap } = {
+  "no-wrap": FlexWrap.NoWrap,
+  nowrap: FlexWrap.NoWrap,
+  wrap: FlexWrap.Wrap,
+  "wrap-reverse": FlexWrap.WrapReverse,
+};
+
+// descriptions nested deeper than this are most likely a mistake
+const MAX_UI_TREE_DEPTH = 64;
+
+export interface UITreeEntry {
+  parentIndex: number;
+  description: any;
+  type: ElementType;
+  props: { [key: string]: any };
+}
+
+function readUITreeEnum<T>(description: any, key: string, values: { [key: string]: T }, defaultValue: T): T {
+  const value = description[key];
+
+  if (value === undefined || value === null) {
+    return defaultValue;
+  }
+
+  const result = values[value];
+
+  if (result === undefined) {
+    throw new Error(`invalid ${key} "${value}"`);
+  }
+
+  return result;
+}
+
+function readUITreeNumber(description: any, key: string, defaultValue: number): number {
+  const value = description[key];
+
+  if (value === undefined || value === null) {
+    return defaultValue;
+  }
+
+  if (typeof value !== "number") {
+    throw new Error(`${key} must be a number`);
+  }
+
+  return value;
+}
+
+function readUITreeString(description: any, key: string): string {
+  const value = description[key];
+
+  if (value === undefined || value === null) {
+    return "";
+  }
+
+  return String(value);
+}
+
+// accepts arrays and typed arrays encoded as objects with index keys
+function readUITreeVec4(description: any, key: string, defaultValue: ArrayLike<number>): Float32Array {
+  const value = description[key] || defaultValue;
+  const out = new Float32Array(4);
+
+  for (let i = 0; i < 4; i++) {
+    const element = value[i];
+
+    if (element !== undefined && typeof element !== "number") {
+      throw new Error(`${key} must be an array of numbers`);
+    }
+
+    out[i] = element || 0;
+  }
+
+  return out;
+}
+
+const zeroVec4 = [0, 0, 0, 0];
+const defaultTextColor = [0, 0, 0, 1];
+
+function readUITreeEntries(description: any, parentIndex: number, depth: number, entries: UITreeEntry[]) {
+  if (depth > MAX_UI_TREE_DEPTH) {
+    throw new Error("UI tree nested too deeply");
+  }
+
+  if (typeof description !== "object" || description === null || Array.isArray(description)) {
+    throw new Error("UI tree elements must be objects");
+  }
+
+  const type = readUITreeEnum(description, "type", elementTypes, ElementType.Flex);
+
+  const props = {
+    name: description.name === undefined ? undefined : String(description.name),
+    type,
+    position: new Float32Array([
+      readUITreeNumber(description, "top", 0),
+      readUITreeNumber(description, "right", 0),
+      readUITreeNumber(description, "bottom", 0),
+      readUITreeNumber(description, "left", 0),
+    ]),
+    positionType: readUITreeEnum(description, "position", positionTypes, ElementPositionType.Relative),
+    alignContent: readUITreeEnum(description, "alignContent", flexAligns, FlexAlign.FlexStart),
+    alignItems: readUITreeEnum(description, "alignItems", flexAligns, FlexAlign.Stretch),
+    alignSelf: readUITreeEnum(description, "alignSelf", flexAligns, FlexAlign.Auto),
+    flexDirection: readUITreeEnum(description, "flexDirection", flexDirections, FlexDirection.Row),
+    flexWrap: readUITreeEnum(description, "flexWrap", flexWraps, FlexWrap.NoWrap),
+    flexBasis: readUITreeNumber(description, "flexBasis", -1),
+    flexGrow: readUITreeNumber(description, "flexGrow", 0),
+    flexShrink: readUITreeNumber(description, "flexShrink", 1),
+    justifyContent: readUITreeEnum(description, "justifyContent", flexJustifies, FlexJustify.FlexStart),
+    width: readUITreeNumber(description, "width", -1),
+    height: readUITreeNumber(description, "height", -1),
+    minWidth: readUITreeNumber(description, "minWidth", -1),
+    minHeight: readUITreeNumber(description, "minHeight", -1),
+    maxWidth: readUITreeNumber(description, "maxWidth", -1),
+    maxHeight: readUITreeNumber(description, "maxHeight", -1),
+    backgroundColor: readUITreeVec4(description, "backgroundColor", zeroVec4),
+    borderColor: readUITreeVec4(description, "borderColor", zeroVec4),
+    padding: readUITreeVec4(description, "padding", zeroVec4),
+    margin: readUITreeVec4(description, "margin", zeroVec4),
+    borderWidth: readUITreeVec4(description, "borderWidth", zeroVec4),
+    borderRadius: readUITreeVec4(description, "borderRadius", zeroVec4),
+  };
+
+  const index = entries.push({ parentIndex, description, type, props }) - 1;
+
+  if (type === ElementType.Text || type === ElementType.Button) {
+    // validate text props before anything is created
+    readUITreeNumber(description, "fontSize", 16);
+    readUITreeVec4(description, "color", defaultTextColor);
+  }
+
+  const children = description.children;
+
+  if (children === undefined || children === null) {
+    return;
+  }
+
+  if (!Array.isArray(children)) {
+    throw new Error("children must be an array");
+  }
+
+  for (let i = 0; i < children.length; i++) {
+    readUITreeEntries(children[i], index, depth + 1, entries);
+  }
+}
+
+/**
+ * Validates a UI tree description and flattens it in depth first order. Each entry holds the index of its parent's
+ * entry, -1 for the root.
+ */
+export function readUITree(description: any): UITreeEntry[] {
+  const entries: UITreeEntry[] = [];
+  readUITreeEntries(description, -1, 0, entries);
+  return entries;
+}
+
+/**
+ * Creates every element in a UI tree description and appends them to out in depth first order, starting with the
+ * root. The whole description is validated first so that nothing is created if it is invalid.
+ */
+export function createUITree(
+  ctx: GameContext,
+  physics: PhysicsModuleState,
+  resourceManager: RemoteResourceManager,
+  description: any,
+  out: RemoteUIElement[]
+) {
+  const entries = readUITree(description);
+
+  out.length = 0;
+
+  // the last child of each element, children are linked directly instead of walking the sibling list per child
+  const lastChildren: (RemoteUIElement | undefined)[] = [];
+
+  for (let i = 0; i < entries.length; i++) {
+    const { parentIndex, description, type, props } = entries[i];
+
+    let button: RemoteUIButton | undefined = undefined;
+    let text: RemoteUIText | undefined = undefined;
+
+    if (type === ElementType.Button) {
+      button = new RemoteUIButton(resourceManager, {
+        label: readUITreeString(description, "label"),
+      });
+
+      addInteractableComponent(ctx, physics, button, InteractableType.UI);
+    }
+
+    if (type === ElementType.Text || type === ElementType.Button) {
+      text = new RemoteUIText(resourceManager, {
+        value: readUITreeString(description, "value"),
+        fontFamily: readUITreeString(description, "fontFamily"),
+        fontWeight: readUITreeString(description, "fontWeight"),
+        fontStyle: readUITreeString(description, "fontStyle"),
+        fontSize: readUITreeNumber(description, "fontSize", 16),
+        color: readUITreeVec4(description, "color", defaultTextColor),
+      });
+    }
+
+    const element = new RemoteUIElement(resourceManager, { ...props, button, text });
+
+    if (parentIndex !== -1) {
+      const parent = out[parentIndex];
+      const lastChild = lastChildren[parentIndex];
+
+      element.parent = parent;
+
+      if (lastChild) {
+        lastChild.nextSibling = element;
+        element.prevSibling = lastChild;
+      } else {
+        parent.firstChild = element;
+      }
+
+      lastChildren[parentIndex] = element;
+    }
+
+    out.push(element);
+    lastChildren.push(undefined);
+  }
+}
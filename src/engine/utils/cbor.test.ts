@@ -0,0 +1,72 @@
+import { deepStrictEqual, strictEqual, throws } from "assert";
+
+import { decodeCBOR, encodeCBOR } from "./cbor";
+
+const hex = (bytes: Uint8Array) => Array.from(bytes, (b) => b.toString(16).padStart(2, "0")).join("");
+
+describe("cbor", () => {
+  test("encode canonical values", () => {
+    // examples from RFC 8949 Appendix A
+    strictEqual(hex(encodeCBOR(0)), "00");
+    strictEqual(hex(encodeCBOR(-0)), "00");
+    strictEqual(hex(encodeCBOR(24)), "1818");
+    strictEqual(hex(encodeCBOR(1000)), "1903e8");
+    strictEqual(hex(encodeCBOR(1000000)), "1a000f4240");
+    strictEqual(hex(encodeCBOR(-1000)), "3903e7");
+    strictEqual(hex(encodeCBOR(1.1)), "fb3ff199999999999a");
+    strictEqual(hex(encodeCBOR(true)), "f5");
+    strictEqual(hex(encodeCBOR(null)), "f6");
+    strictEqual(hex(encodeCBOR("IETF")), "6449455446");
+    strictEqual(hex(encodeCBOR("ü")), "62c3bc");
+    strictEqual(hex(encodeCBOR([1, [2, 3]])), "8201820203");
+    strictEqual(hex(encodeCBOR({ a: 1, b: [2, 3] })), "a26161016162820203");
+  });
+
+  test("round trip a widget event", () => {
+    const event = {
+      api: "toWidget",
+      requestId: "request1",
+      action: "send_event",
+      widgetId: "test",
+      data: {
+        type: "m.room.message",
+        sender: "@bob:example.org",
+        origin_server_ts: 1680000000000,
+        content: { msgtype: "m.text", body: "héllo 👋".repeat(20) },
+      },
+    };
+
+    deepStrictEqual(decodeCBOR(encodeCBOR(event)), event);
+  });
+
+  test("follow JSON.stringify semantics", () => {
+    const value = {
+      a: undefined,
+      b: () => {},
+      c: [undefined, 1],
+      d: { toJSON: () => "d" },
+      e: [NaN, Infinity, -Infinity, 0.5],
+      f: -0,
+    };
+    deepStrictEqual(decodeCBOR(encodeCBOR(value)), JSON.parse(JSON.stringify(value)));
+  });
+
+  test("decode floats", () => {
+    strictEqual(decodeCBOR(new Uint8Array([0xf9, 0x3c, 0x00])), 1);
+    strictEqual(decodeCBOR(new Uint8Array([0xf9, 0xc4, 0x00])), -4);
+    strictEqual(decodeCBOR(new Uint8Array([0xfa, 0x47, 0xc3, 0x50, 0x00])), 100000);
+  });
+
+  test("reject malformed data", () => {
+    const circular: any = {};
+    circular.circular = circular;
+    throws(() => encodeCBOR(circular), /circular reference/);
+
+    // truncated string
+    throws(() => decodeCBOR(new Uint8Array([0x64, 0x49, 0x45])));
+    // indefinite length array
+    throws(() => decodeCBOR(new Uint8Array([0x9f, 0x01, 0xff])));
+    // trailing bytes
+    throws(() => decodeCBOR(new Uint8Array([0x01, 0x02])));
+  });
+});
@@ -0,0 +1,423 @@
+/**
+ * A CBOR (RFC 8949) codec for JSON compatible values, used to pass structured data to and from scripts without
+ * going through JSON strings. The script runtime has a matching C implementation in js-runtime/utils/cbor.c.
+ *
+ * Values are encoded with JSON.stringify semantics: toJSON() is respected, object properties that are undefined
+ * or functions are skipped, undefined or function array elements become null, and so do NaN and ±Infinity. -0 is
+ * encoded as 0.
+ */
+
+export enum CBORMajorType {
+  UnsignedInteger = 0,
+  NegativeInteger = 1,
+  ByteString = 2,
+  TextString = 3,
+  Array = 4,
+  Map = 5,
+  Tag = 6,
+  Simple = 7,
+}
+
+const FALSE = 0xf4;
+const TRUE = 0xf5;
+const NULL = 0xf6;
+const UNDEFINED = 0xf7;
+const FLOAT16 = 0xf9;
+const FLOAT32 = 0xfa;
+const FLOAT64 = 0xfb;
+
+// guards against circular references
+const MAX_DEPTH = 64;
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder();
+
+/**
+ * Returns the number of bytes needed to encode a data item head with the given argument.
+ */
+export function getCBORHeadByteLength(value: number) {
+  if (value < 24) return 1;
+  if (value <= 0xff) return 2;
+  if (value <= 0xffff) return 3;
+  if (value <= 0xffffffff) return 5;
+  return 9;
+}
+
+/**
+ * Writes a data item head into target at offset and returns the number of bytes written.
+ */
+export function writeCBORHead(target: Uint8Array, offset: number, major: CBORMajorType, value: number) {
+  const type = major << 5;
+
+  if (value < 24) {
+    target[offset] = type | value;
+    return 1;
+  } else if (value <= 0xff) {
+    target[offset] = type | 24;
+    target[offset + 1] = value;
+    return 2;
+  } else if (value <= 0xffff) {
+    target[offset] = type | 25;
+    target[offset + 1] = value >> 8;
+    target[offset + 2] = value & 0xff;
+    return 3;
+  } else if (value <= 0xffffffff) {
+    target[offset] = type | 26;
+    target[offset + 1] = value >>> 24;
+    target[offset + 2] = (value >> 16) & 0xff;
+    target[offset + 3] = (value >> 8) & 0xff;
+    target[offset + 4] = value & 0xff;
+    return 5;
+  }
+
+  target[offset] = type | 27;
+  const high = Math.floor(value / 0x1_0000_0000);
+  const low = value >>> 0;
+  target[offset + 1] = high >>> 24;
+  target[offset + 2] = (high >> 16) & 0xff;
+  target[offset + 3] = (high >> 8) & 0xff;
+  target[offset + 4] = high & 0xff;
+  target[offset + 5] = low >>> 24;
+  target[offset + 6] = (low >> 16) & 0xff;
+  target[offset + 7] = (low >> 8) & 0xff;
+  target[offset + 8] = low & 0xff;
+  return 9;
+}
+
+/* Encoding */
+
+interface CBOREncoder {
+  bytes: Uint8Array;
+  view: DataView;
+  offset: number;
+}
+
+const encoder: CBOREncoder = {
+  bytes: new Uint8Array(1024),
+  view: new DataView(new ArrayBuffer(0)),
+  offset: 0,
+};
+
+encoder.view = new DataView(encoder.bytes.buffer);
+
+function reserve(e: CBOREncoder, byteLength: number) {
+  const required = e.offset + byteLength;
+
+  if (required <= e.bytes.byteLength) {
+    return;
+  }
+
+  let capacity = e.bytes.byteLength * 2;
+
+  while (capacity < required) {
+    capacity *= 2;
+  }
+
+  const bytes = new Uint8Array(capacity);
+  bytes.set(e.bytes.subarray(0, e.offset));
+  e.bytes = bytes;
+  e.view = new DataView(bytes.buffer);
+}
+
+function encodeHead(e: CBOREncoder, major: CBORMajorType, value: number) {
+  reserve(e, 9);
+  e.offset += writeCBORHead(e.bytes, e.offset, major, value);
+}
+
+function encodeString(e: CBOREncoder, value: string) {
+  // utf-8 never needs more than 3 bytes per utf-16 code unit
+  const maxByteLength = value.length * 3;
+  const maxHeadByteLength = getCBORHeadByteLength(maxByteLength);
+  reserve(e, maxHeadByteLength + maxByteLength);
+
+  const start = e.offset + maxHeadByteLength;
+  const { written } = textEncoder.encodeInto(value, e.bytes.subarray(start));
+  const headByteLength = getCBORHeadByteLength(written);
+
+  if (headByteLength !== maxHeadByteLength) {
+    e.bytes.copyWithin(e.offset + headByteLength, start, start + written);
+  }
+
+  e.offset += writeCBORHead(e.bytes, e.offset, CBORMajorType.TextString, written);
+  e.offset += written;
+}
+
+function isSkipped(value: unknown) {
+  return value === undefined || typeof value === "function" || typeof value === "symbol";
+}
+
+function encodeValue(e: CBOREncoder, value: any, depth: number) {
+  if (depth > MAX_DEPTH) {
+    throw new TypeError("CBOR: circular reference or object nested too deeply.");
+  }
+
+  if (value !== null && typeof value === "object" && typeof value.toJSON === "function") {
+    value = value.toJSON();
+  }
+
+  switch (typeof value) {
+    case "number":
+      if (!Number.isFinite(value)) {
+        reserve(e, 1);
+        e.bytes[e.offset++] = NULL;
+      } else if (Number.isSafeInteger(value)) {
+        // -0 >= 0, so it's written as 0 like JSON.stringify does
+        if (value >= 0) {
+          encodeHead(e, CBORMajorType.UnsignedInteger, value);
+        } else {
+          encodeHead(e, CBORMajorType.NegativeInteger, -1 - value);
+        }
+      } else {
+        reserve(e, 9);
+        e.bytes[e.offset] = FLOAT64;
+        e.view.setFloat64(e.offset + 1, value);
+        e.offset += 9;
+      }
+      return;
+    case "string":
+      encodeString(e, value);
+      return;
+    case "boolean":
+      reserve(e, 1);
+      e.bytes[e.offset++] = value ? TRUE : FALSE;
+      return;
+    case "object":
+      break;
+    default:
+      reserve(e, 1);
+      e.bytes[e.offset++] = NULL;
+      return;
+  }
+
+  if (value === null) {
+    reserve(e, 1);
+    e.bytes[e.offset++] = NULL;
+    return;
+  }
+
+  if (Array.isArray(value)) {
+    encodeHead(e, CBORMajorType.Array, value.length);
+
+    for (let i = 0; i < value.length; i++) {
+      const item = value[i];
+
+      if (isSkipped(item)) {
+        reserve(e, 1);
+        e.bytes[e.offset++] = NULL;
+      } else {
+        encodeValue(e, item, depth + 1);
+      }
+    }
+
+    return;
+  }
+
+  let count = 0;
+
+  for (const key in value) {
+    if (Object.prototype.hasOwnProperty.call(value, key) && !isSkipped(value[key])) {
+      count++;
+    }
+  }
+
+  encodeHead(e, CBORMajorType.Map, count);
+
+  for (const key in value) {
+    const item = value[key];
+
+    if (Object.prototype.hasOwnProperty.call(value, key) && !isSkipped(item)) {
+      encodeString(e, key);
+      encodeValue(e, item, depth + 1);
+    }
+  }
+}
+
+/**
+ * Encodes a JSON compatible value as CBOR.
+ */
+export function encodeCBOR(value: unknown): Uint8Array {
+  encoder.offset = 0;
+  encodeValue(encoder, value, 0);
+  return encoder.bytes.slice(0, encoder.offset);
+}
+
+/* Decoding */
+
+interface CBORDecoder {
+  bytes: Uint8Array;
+  view: DataView;
+  offset: number;
+  shared: boolean;
+}
+
+function decodeError(message: string): never {
+  throw new Error(`CBOR: ${message}`);
+}
+
+function readArgument(d: CBORDecoder, info: number) {
+  if (info < 24) {
+    return info;
+  }
+
+  const { view, offset } = d;
+
+  switch (info) {
+    case 24:
+      if (offset + 1 > view.byteLength) decodeError("Unexpected end of data.");
+      d.offset += 1;
+      return view.getUint8(offset);
+    case 25:
+      if (offset + 2 > view.byteLength) decodeError("Unexpected end of data.");
+      d.offset += 2;
+      return view.getUint16(offset);
+    case 26:
+      if (offset + 4 > view.byteLength) decodeError("Unexpected end of data.");
+      d.offset += 4;
+      return view.getUint32(offset);
+    case 27:
+      if (offset + 8 > view.byteLength) decodeError("Unexpected end of data.");
+      d.offset += 8;
+      return view.getUint32(offset) * 0x1_0000_0000 + view.getUint32(offset + 4);
+    default:
+      return decodeError("Indefinite lengths are not supported.");
+  }
+}
+
+function readFloat16(bits: number) {
+  const exponent = (bits >> 10) & 0x1f;
+  const fraction = bits & 0x3ff;
+  const sign = bits & 0x8000 ? -1 : 1;
+
+  if (exponent === 0) {
+    return sign * fraction * 2 ** -24;
+  } else if (exponent === 0x1f) {
+    return fraction ? NaN : sign * Infinity;
+  }
+
+  return sign * (1 + fraction / 1024) * 2 ** (exponent - 15);
+}
+
+function decodeValue(d: CBORDecoder, depth: number): any {
+  if (depth > MAX_DEPTH) {
+    decodeError("Data nested too deeply.");
+  }
+
+  if (d.offset >= d.bytes.byteLength) {
+    decodeError("Unexpected end of data.");
+  }
+
+  const initialByte = d.bytes[d.offset++];
+  const major = initialByte >> 5;
+  const info = initialByte & 0x1f;
+
+  if (major === CBORMajorType.Simple) {
+    switch (initialByte) {
+      case FALSE:
+        return false;
+      case TRUE:
+        return true;
+      case NULL:
+      case UNDEFINED:
+        return null;
+      case FLOAT16:
+        return readFloat16(readArgument(d, 25));
+      case FLOAT32: {
+        const offset = d.offset;
+        readArgument(d, 26);
+        return d.view.getFloat32(offset);
+      }
+      case FLOAT64: {
+        const offset = d.offset;
+        readArgument(d, 27);
+        return d.view.getFloat64(offset);
+      }
+      default:
+        return decodeError(`Unsupported simple value ${initialByte}.`);
+    }
+  }
+
+  const argument = readArgument(d, info);
+
+  switch (major) {
+    case CBORMajorType.UnsignedInteger:
+      return argument;
+    case CBORMajorType.NegativeInteger:
+      return -1 - argument;
+    case CBORMajorType.ByteString:
+    case CBORMajorType.TextString: {
+      const end = d.offset + argument;
+
+      if (end > d.bytes.byteLength) {
+        decodeError("Unexpected end of data.");
+      }
+
+      // TextDecoder can't read views of a SharedArrayBuffer
+      const bytes =
+        d.shared || major === CBORMajorType.ByteString ? d.bytes.slice(d.offset, end) : d.bytes.subarray(d.offset, end);
+      d.offset = end;
+
+      return major === CBORMajorType.TextString ? textDecoder.decode(bytes) : bytes.buffer;
+    }
+    case CBORMajorType.Array: {
+      // every item takes at least one byte
+      if (argument > d.bytes.byteLength - d.offset) {
+        decodeError("Array length exceeds data.");
+      }
+
+      const array = new Array(argument);
+
+      for (let i = 0; i < argument; i++) {
+        array[i] = decodeValue(d, depth + 1);
+      }
+
+      return array;
+    }
+    case CBORMajorType.Map: {
+      if (argument > d.bytes.byteLength - d.offset) {
+        decodeError("Map length exceeds data.");
+      }
+
+      const object: { [key: string]: any } = {};
+
+      for (let i = 0; i < argument; i++) {
+        const key = decodeValue(d, depth + 1);
+
+        if (typeof key !== "string") {
+          decodeError("Map keys must be strings.");
+        }
+
+        Object.defineProperty(object, key, {
+          value: decodeValue(d, depth + 1),
+          writable: true,
+          enumerable: true,
+          configurable: true,
+        });
+      }
+
+      return object;
+    }
+    default:
+      // tags carry no meaning for JSON data, decode the tagged value
+      return decodeValue(d, depth + 1);
+  }
+}
+
+/**
+ * Decodes a single CBOR data item.
+ */
+export function decodeCBOR(bytes: Uint8Array): any {
+  const d: CBORDecoder = {
+    bytes,
+    view: new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength),
+    offset: 0,
+    shared: typeof SharedArrayBuffer !== "undefined" && bytes.buffer instanceof SharedArrayBuffer,
+  };
+
+  const value = decodeValue(d, 0);
+
+  if (d.offset !== bytes.byteLength) {
+    decodeError("Unexpected data after value.");
+  }
+
+  return value;
+}
@@ -0,0 +1,47 @@
+import { bench, describe } from "vitest";
+
+import { lz4Compress, lz4CompressBound, lz4Decompress } from "./lz4";
+
+// Payloads shaped like what scripts send: JSON level state, chat history and incompressible binary data.
+const encoder = new TextEncoder();
+
+const levelState = encoder.encode(
+  JSON.stringify(
+    Array.from({ length: 400 }, (_, i) => ({
+      id: i,
+      type: ["crate", "barrel", "lamp"][i % 3],
+      position: [i % 20, 0, Math.floor(i / 20)],
+      rotation: [0, 0, 0, 1],
+    }))
+  )
+);
+
+const chatHistory = encoder.encode(
+  Array.from({ length: 200 }, (_, i) => `@user${i % 5}:example.org: message number ${i}, hello everyone!`).join("\n")
+);
+
+const randomData = new Uint8Array(16000);
+
+for (let i = 0; i < randomData.length; i++) {
+  randomData[i] = (Math.random() * 256) | 0;
+}
+
+for (const [name, src] of [
+  ["level state", levelState],
+  ["chat history", chatHistory],
+  ["random", randomData],
+] as const) {
+  const compressed = new Uint8Array(lz4CompressBound(src.byteLength));
+  const compressedLength = lz4Compress(src, compressed);
+  const decompressed = new Uint8Array(src.byteLength);
+
+  describe(`lz4 ${name} (${src.byteLength} -> ${compressedLength} bytes)`, () => {
+    bench("compress", () => {
+      lz4Compress(src, compressed);
+    });
+
+    bench("decompress", () => {
+      lz4Decompress(compressed.subarray(0, compressedLength), decompressed);
+    });
+  });
+}
@@ -0,0 +1,58 @@
+import { strictEqual, ok, throws } from "assert";
+
+import { lz4Compress, lz4CompressBound, lz4Decompress } from "./lz4";
+
+const roundTrip = (src: Uint8Array) => {
+  const compressed = new Uint8Array(lz4CompressBound(src.byteLength));
+  const compressedLength = lz4Compress(src, compressed);
+  const out = new Uint8Array(src.byteLength);
+  const decompressedLength = lz4Decompress(compressed.subarray(0, compressedLength), out);
+
+  strictEqual(decompressedLength, src.byteLength);
+
+  for (let i = 0; i < src.byteLength; i++) {
+    strictEqual(out[i], src[i]);
+  }
+
+  return compressedLength;
+};
+
+describe("lz4", () => {
+  test("round trip small inputs", () => {
+    roundTrip(new Uint8Array(0));
+    roundTrip(new TextEncoder().encode("hello"));
+    roundTrip(new TextEncoder().encode("abcdefghijklmnopqrstuvwxyz"));
+  });
+
+  test("compress repetitive data", () => {
+    const text = JSON.stringify(Array.from({ length: 200 }, (_, i) => ({ id: i, name: `player${i % 7}` })));
+    const src = new TextEncoder().encode(text);
+    ok(roundTrip(src) < src.byteLength / 2);
+
+    // long runs exercise overlapping matches and extended lengths
+    ok(roundTrip(new Uint8Array(100000).fill(7)) < 1000);
+  });
+
+  test("reject output that doesn't fit", () => {
+    const src = new Uint8Array(4096);
+    let x = 1;
+
+    // xorshift noise doesn't compress
+    for (let i = 0; i < src.length; i++) {
+      x ^= x << 13;
+      x ^= x >>> 17;
+      x ^= x << 5;
+      src[i] = x & 0xff;
+    }
+
+    strictEqual(lz4Compress(src, new Uint8Array(src.byteLength - 1)), 0);
+    roundTrip(src);
+  });
+
+  test("throw on malformed input", () => {
+    // a match with an offset pointing before the start of the output
+    throws(() => lz4Decompress(new Uint8Array([0x10, 0x61, 0x05, 0x00]), new Uint8Array(100)));
+    // literals longer than the output buffer
+    throws(() => lz4Decompress(new Uint8Array([0x50, 1, 2, 3, 4, 5]), new Uint8Array(2)));
+  });
+});
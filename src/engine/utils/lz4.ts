@@ -0,0 +1,221 @@
+/**
+ * LZ4 block format compression. Favors speed over ratio so it can run on every large network message.
+ * https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+ */
+
+const MIN_MATCH = 4;
+// the last match must start at least 12 bytes before the end of the block
+const MF_LIMIT = 12;
+// the last 5 bytes of a block are always literals
+const LAST_LITERALS = 5;
+const MAX_OFFSET = 0xffff;
+const HASH_LOG = 12;
+// start skipping ahead faster after this many bytes without a match
+const SKIP_TRIGGER = 6;
+
+// positions + 1 of recently seen 4 byte sequences, 0 means empty
+const hashTable = new Int32Array(1 << HASH_LOG);
+
+const read32 = (src: Uint8Array, i: number) => src[i] | (src[i + 1] << 8) | (src[i + 2] << 16) | (src[i + 3] << 24);
+
+const hash32 = (sequence: number) => Math.imul(sequence, 2654435761) >>> (32 - HASH_LOG);
+
+/**
+ * Returns the largest possible compressed size for an input of the given length.
+ */
+export const lz4CompressBound = (byteLength: number) => byteLength + Math.ceil(byteLength / 255) + 16;
+
+function writeLength(dst: Uint8Array, dIdx: number, length: number) {
+  while (length >= 255) {
+    dst[dIdx++] = 255;
+    length -= 255;
+  }
+
+  dst[dIdx++] = length;
+
+  return dIdx;
+}
+
+/**
+ * Compresses src into dst and returns the compressed byte length, or 0 if the compressed data would not fit in dst.
+ * Pass a dst shorter than src to only accept output that is actually smaller.
+ */
+export function lz4Compress(src: Uint8Array, dst: Uint8Array): number {
+  const srcLength = src.length;
+  const dstLength = dst.length;
+  const matchLimit = srcLength - MF_LIMIT;
+  const matchEndLimit = srcLength - LAST_LITERALS;
+
+  let sIdx = 0;
+  let dIdx = 0;
+  let anchor = 0;
+
+  hashTable.fill(0);
+
+  while (sIdx < matchLimit) {
+    const sequence = read32(src, sIdx);
+    const h = hash32(sequence);
+    const ref = hashTable[h] - 1;
+    hashTable[h] = sIdx + 1;
+
+    if (ref < 0 || sIdx - ref > MAX_OFFSET || read32(src, ref) !== sequence) {
+      sIdx += 1 + ((sIdx - anchor) >> SKIP_TRIGGER);
+      continue;
+    }
+
+    let matchLength = MIN_MATCH;
+
+    while (sIdx + matchLength < matchEndLimit && src[sIdx + matchLength] === src[ref + matchLength]) {
+      matchLength++;
+    }
+
+    const literalLength = sIdx - anchor;
+
+    // token + literal length bytes + literals + offset + match length bytes
+    if (dIdx + 1 + ((literalLength / 255) | 0) + 1 + literalLength + 2 + ((matchLength / 255) | 0) + 1 > dstLength) {
+      return 0;
+    }
+
+    const tokenIdx = dIdx++;
+    let token: number;
+
+    if (literalLength >= 15) {
+      token = 15 << 4;
+      dIdx = writeLength(dst, dIdx, literalLength - 15);
+    } else {
+      token = literalLength << 4;
+    }
+
+    dst.set(src.subarray(anchor, sIdx), dIdx);
+    dIdx += literalLength;
+
+    const offset = sIdx - ref;
+    dst[dIdx++] = offset & 0xff;
+    dst[dIdx++] = offset >> 8;
+
+    const extraMatchLength = matchLength - MIN_MATCH;
+
+    if (extraMatchLength >= 15) {
+      token |= 15;
+      dIdx = writeLength(dst, dIdx, extraMatchLength - 15);
+    } else {
+      token |= extraMatchLength;
+    }
+
+    dst[tokenIdx] = token;
+
+    sIdx += matchLength;
+    anchor = sIdx;
+  }
+
+  const literalLength = srcLength - anchor;
+
+  if (dIdx + 1 + ((literalLength / 255) | 0) + 1 + literalLength > dstLength) {
+    return 0;
+  }
+
+  if (literalLength >= 15) {
+    dst[dIdx++] = 15 << 4;
+    dIdx = writeLength(dst, dIdx, literalLength - 15);
+  } else {
+    dst[dIdx++] = literalLength << 4;
+  }
+
+  dst.set(src.subarray(anchor, srcLength), dIdx);
+  dIdx += literalLength;
+
+  return dIdx;
+}
+
+function readLength(src: Uint8Array, sIdx: number, out: { length: number }) {
+  let b: number;
+
+  do {
+    if (sIdx >= src.length) {
+      throw new Error("LZ4: Unexpected end of compressed data.");
+    }
+
+    b = src[sIdx++];
+    out.length += b;
+  } while (b === 255);
+
+  return sIdx;
+}
+
+const lengthOut = { length: 0 };
+
+/**
+ * Decompresses src into dst and returns the decompressed byte length. Throws on malformed input or if the output
+ * does not fit in dst.
+ */
+export function lz4Decompress(src: Uint8Array, dst: Uint8Array): number {
+  const srcLength = src.length;
+  const dstLength = dst.length;
+
+  let sIdx = 0;
+  let dIdx = 0;
+
+  while (sIdx < srcLength) {
+    const token = src[sIdx++];
+
+    lengthOut.length = token >> 4;
+
+    if (lengthOut.length === 15) {
+      sIdx = readLength(src, sIdx, lengthOut);
+    }
+
+    const literalLength = lengthOut.length;
+
+    if (sIdx + literalLength > srcLength || dIdx + literalLength > dstLength) {
+      throw new Error("LZ4: Literals out of bounds.");
+    }
+
+    dst.set(src.subarray(sIdx, sIdx + literalLength), dIdx);
+    sIdx += literalLength;
+    dIdx += literalLength;
+
+    // the last sequence has no match
+    if (sIdx >= srcLength) {
+      break;
+    }
+
+    if (sIdx + 2 > srcLength) {
+      throw new Error("LZ4: Unexpected end of compressed data.");
+    }
+
+    const offset = src[sIdx] | (src[sIdx + 1] << 8);
+    sIdx += 2;
+
+    if (offset === 0 || offset > dIdx) {
+      throw new Error("LZ4: Invalid match offset.");
+    }
+
+    lengthOut.length = token & 15;
+
+    if (lengthOut.length === 15) {
+      sIdx = readLength(src, sIdx, lengthOut);
+    }
+
+    const matchLength = lengthOut.length + MIN_MATCH;
+
+    if (dIdx + matchLength > dstLength) {
+      throw new Error("LZ4: Match out of bounds.");
+    }
+
+    let ref = dIdx - offset;
+
+    if (offset >= matchLength) {
+      dst.copyWithin(dIdx, ref, ref + matchLength);
+      dIdx += matchLength;
+    } else {
+      // overlapping matches repeat the last offset bytes and must be copied forwards one byte at a time
+      const end = dIdx + matchLength;
+
+      while (dIdx < end) {
+        dst[dIdx++] = dst[ref++];
+      }
+    }
+  }
+
+  return dIdx;
+}
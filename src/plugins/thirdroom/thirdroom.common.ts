@@ -64,6 +64,8 @@ export interface ExitedWorldMessage {
 
 export interface LoadWorldOptions {
   environmentScriptUrl?: string;
+  // script runtime build the environment script runs on if it's JavaScript, defaults to full
+  environmentScriptRuntime?: "full" | "lite";
   maxObjectCap?: number;
   fileMap?: Map<string, string>;
 }
@@ -320,7 +320,13 @@ async function loadWorld(ctx: GameContext, environmentUrl: string, options: Load
   });
 
   if (options.environmentScriptUrl) {
-    thirdroom.environmentScript = await loadScript(ctx, resourceManager, options.environmentScriptUrl, signal);
+    thirdroom.environmentScript = await loadScript(
+      ctx,
+      resourceManager,
+      options.environmentScriptUrl,
+      signal,
+      options.environmentScriptRuntime
+    );
 
     thirdroom.environmentScript.initialize();
   }
@@ -27,6 +27,11 @@ export interface WorldLoader {
   exitWorld: () => void;
 }
 
+// Worlds opt in to the lite script runtime with "script_runtime": "lite" next to their script_url.
+function getScriptRuntime(content: Content): "full" | "lite" {
+  return content.script_runtime === "lite" ? "lite" : "full";
+}
+
 export function useWorldLoader(): WorldLoader {
   const { session, platform, client } = useHydrogen(true);
   const mainThread = useMainThreadContext();
@@ -71,6 +76,7 @@ export function useWorldLoader(): WorldLoader {
           createMatrixNetworkInterface(mainThread, client, platform, world),
           loadWorld(mainThread, environmentUrl, {
             environmentScriptUrl,
+            environmentScriptRuntime: getScriptRuntime(content),
             maxObjectCap,
           }),
         ]);
@@ -116,6 +122,7 @@ export function useWorldLoader(): WorldLoader {
 
       await reloadWorld(mainThread, environmentUrl, {
         environmentScriptUrl,
+        environmentScriptRuntime: getScriptRuntime(content),
         maxObjectCap,
       });
 
@@ -11,6 +11,8 @@ import { RemoteNode, RemoteScene, RemoteWorld, RemoteEnvironment } from "../../s
 import { addChild } from "../../src/engine/component/transform";
 import { MatrixModule } from "../../src/engine/matrix/matrix.game";
 import { WebSGNetworkModule } from "../../src/engine/network/scripting.game";
+import { createResourceGenerations } from "../../src/engine/resource/ResourceOwnership";
+import { maxEntities } from "../../src/engine/config.common";
 
 export function registerDefaultPrefabs(ctx: GameContext) {
   registerPrefab(ctx, {
@@ -71,6 +73,8 @@ export const mockRenderState = () => ({
 export const mockNetworkState = () => ({
   networkIdToEntityId: new Map(),
   prefabToReplicator: new Map(),
+  entityPriority: new Map(),
+  peerIdToUpdateScheduler: new Map(),
 });
 
 export const mockResourceModule = () => ({
@@ -79,6 +83,8 @@ export const mockResourceModule = () => ({
   resourceInfos: new Map(),
   resourceMap: new Map(),
   resourcesByType: new Map(),
+  resourceNamesByType: new Map(),
+  resourceGenerations: createResourceGenerations(maxEntities),
   disposedResourcesQueue: [],
   disposeRefCounts: new Map(),
   deferredRemovals: [],
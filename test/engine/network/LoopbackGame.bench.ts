@@ -0,0 +1,60 @@
+import { bench, describe } from "vitest";
+
+import {
+  createLoopbackGame,
+  disposeLoopbackGame,
+  getLoopbackGameReport,
+  joinLoopbackGame,
+  LoopbackGame,
+  stepLoopbackGame,
+} from "./LoopbackGame";
+
+// Run with `yarn bench`. Each iteration is one frame of every client in the room running its script, so unlike
+// the LoopbackTransport benchmark the reported time includes script execution. The per-frame script time is
+// logged with the transport throughput after each run.
+
+const PEER_COUNTS = [2, 4, 8, 16];
+
+// Reads every message received this frame and broadcasts its own state each frame.
+const scriptSource = `
+const listener = network.listen();
+const state = new Float32Array(16);
+
+world.onupdate = (dt, time) => {
+  let checksum = 0;
+
+  for (const message of listener.receive()) {
+    checksum += message.bytesWritten;
+  }
+
+  state[0] = time;
+  state[1] = checksum;
+  network.broadcast(state.buffer, true);
+};
+`;
+
+describe("LoopbackGame", () => {
+  for (const peerCount of PEER_COUNTS) {
+    let game: LoopbackGame;
+
+    bench(
+      `${peerCount} peers`,
+      () => {
+        stepLoopbackGame(game);
+      },
+      {
+        async setup() {
+          game = createLoopbackGame(scriptSource, { latency: 50, jitter: 20 });
+
+          for (let i = 0; i < peerCount; i++) {
+            await joinLoopbackGame(game, `@peer${i}:loopback`);
+          }
+        },
+        teardown() {
+          console.table([getLoopbackGameReport(game)]);
+          disposeLoopbackGame(game);
+        },
+      }
+    );
+  }
+});
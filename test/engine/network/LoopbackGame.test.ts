@@ -0,0 +1,234 @@
+import { afterEach, describe, it } from "vitest";
+import { deepStrictEqual, ok, strictEqual } from "assert";
+
+import {
+  createLoopbackGame,
+  disposeLoopbackGame,
+  getLoopbackGameReport,
+  joinLoopbackGame,
+  leaveLoopbackGame,
+  LoopbackGame,
+  readLoopbackClientEvents,
+  stepLoopbackGame,
+} from "./LoopbackGame";
+import { removeLoopbackPeer } from "../../../src/engine/network/LoopbackTransport";
+
+// Logs what it sees as one JSON object per line. Every client broadcasts a small reliable binary message each
+// frame, which keeps it connected for host election the way the client's real traffic would.
+const scriptSource = `
+const log = (event) => console.log(JSON.stringify(event));
+const listener = network.listen();
+const keepAlive = new Uint8Array([1]).buffer;
+const replicator = network.defineReplicator(() => world.createNode());
+
+let hostId;
+let greeted = false;
+let spawned = false;
+
+network.onpeerentered = (peer) => {
+  log({ type: "entered", peerId: peer.id, isLocal: peer.isLocal });
+  peer.send("hello from " + network.local.id, true);
+};
+
+network.onpeerexited = (peer) => {
+  log({ type: "exited", peerId: peer.id });
+};
+
+world.onupdate = (dt, time) => {
+  network.broadcast(keepAlive, true);
+
+  if (!greeted) {
+    network.broadcast("broadcast from " + network.local.id, true);
+    greeted = true;
+  }
+
+  for (const message of listener.receive()) {
+    if (!message.isBinary) {
+      log({ type: "message", peerId: message.peer.id, data: message.data, isString: typeof message.data === "string" });
+    }
+  }
+
+  const host = network.host;
+  const nextHostId = host ? host.id : "";
+
+  if (nextHostId !== hostId) {
+    hostId = nextHostId;
+    log({ type: "host", hostId, isHost: !!host && host.isHost, isLocalHost: !!host && host.isLocal });
+  }
+
+  if (!spawned) {
+    replicator.spawn(new Uint8Array([4, 2]).buffer);
+    spawned = true;
+  }
+
+  for (const replication of replicator.spawned()) {
+    log({ type: "spawned", peerId: replication.peer.id, data: Array.from(new Uint8Array(replication.data)) });
+  }
+};
+`;
+
+// host election gathers peers for five seconds before it picks a host
+const ELECTION_FRAMES = 6 * 60;
+
+function step(game: LoopbackGame, frames: number) {
+  for (let i = 0; i < frames; i++) {
+    stepLoopbackGame(game);
+  }
+}
+
+function getEvents(game: LoopbackGame, peerId: string, type: string) {
+  return readLoopbackClientEvents(game.peerIdToClient.get(peerId)!).filter((event) => event.type === type);
+}
+
+function getLastHostId(game: LoopbackGame, peerId: string) {
+  const hostEvents = getEvents(game, peerId, "host");
+  return hostEvents.length ? hostEvents[hostEvents.length - 1].hostId : undefined;
+}
+
+describe("LoopbackGame", () => {
+  let game: LoopbackGame | undefined;
+
+  afterEach(() => {
+    if (game) {
+      disposeLoopbackGame(game);
+      game = undefined;
+    }
+  });
+
+  it("should tell each script when peers enter and exit", async () => {
+    game = createLoopbackGame(scriptSource);
+
+    const alice = await joinLoopbackGame(game, "@alice:loopback");
+    const bob = await joinLoopbackGame(game, "@bob:loopback");
+    const carol = await joinLoopbackGame(game, "@carol:loopback");
+
+    step(game, 2);
+
+    deepStrictEqual(
+      getEvents(game, alice.peerId, "entered").map((event) => event.peerId),
+      [bob.peerId, carol.peerId]
+    );
+    deepStrictEqual(
+      getEvents(game, carol.peerId, "entered").map((event) => event.peerId),
+      [alice.peerId, bob.peerId]
+    );
+    ok(getEvents(game, alice.peerId, "entered").every((event) => event.isLocal === false));
+
+    leaveLoopbackGame(game, bob.peerId);
+    step(game, 2);
+
+    deepStrictEqual(
+      getEvents(game, alice.peerId, "exited").map((event) => event.peerId),
+      [bob.peerId]
+    );
+    deepStrictEqual(
+      getEvents(game, carol.peerId, "exited").map((event) => event.peerId),
+      [bob.peerId]
+    );
+  });
+
+  it("should deliver string messages between scripts as strings", async () => {
+    game = createLoopbackGame(scriptSource, { latency: 50, jitter: 20 });
+
+    const alice = await joinLoopbackGame(game, "@alice:loopback");
+    const bob = await joinLoopbackGame(game, "@bob:loopback");
+
+    step(game, 10);
+
+    const aliceMessages = getEvents(game, alice.peerId, "message");
+    const bobMessages = getEvents(game, bob.peerId, "message");
+
+    ok(aliceMessages.every((message) => message.isString && message.peerId === bob.peerId));
+    ok(bobMessages.every((message) => message.isString && message.peerId === alice.peerId));
+
+    ok(aliceMessages.some((message) => message.data === `broadcast from ${bob.peerId}`));
+    ok(bobMessages.some((message) => message.data === `hello from ${alice.peerId}`));
+    ok(bobMessages.some((message) => message.data === `broadcast from ${alice.peerId}`));
+  });
+
+  it("should elect the same host on every client and reelect when it leaves", async () => {
+    game = createLoopbackGame(scriptSource, { latency: 30 });
+
+    const alice = await joinLoopbackGame(game, "@alice:loopback");
+    const bob = await joinLoopbackGame(game, "@bob:loopback");
+    const carol = await joinLoopbackGame(game, "@carol:loopback");
+
+    step(game, 60);
+
+    // still gathering peers, no client has picked a host yet
+    for (const client of game.clients) {
+      strictEqual(client.hostElection.currentHost, undefined);
+    }
+
+    step(game, ELECTION_FRAMES);
+
+    for (const client of game.clients) {
+      strictEqual(client.hostElection.currentHost?.peerId, alice.peerId);
+      strictEqual(client.network.hostId, alice.peerId);
+      strictEqual(getLastHostId(game, client.peerId), alice.peerId);
+    }
+
+    const aliceHostEvents = getEvents(game, alice.peerId, "host");
+    ok(aliceHostEvents[aliceHostEvents.length - 1].isLocalHost);
+    ok(aliceHostEvents[aliceHostEvents.length - 1].isHost);
+    ok(!getEvents(game, bob.peerId, "host").pop().isLocalHost);
+
+    leaveLoopbackGame(game, alice.peerId);
+    step(game, 2);
+
+    for (const client of [bob, carol]) {
+      strictEqual(client.hostElection.currentHost?.peerId, bob.peerId);
+      strictEqual(getLastHostId(game, client.peerId), bob.peerId);
+    }
+
+    ok(getEvents(game, bob.peerId, "host").pop().isLocalHost);
+  });
+
+  it("should reelect a host when the host stops sending messages", async () => {
+    game = createLoopbackGame(scriptSource);
+
+    const alice = await joinLoopbackGame(game, "@alice:loopback");
+    const bob = await joinLoopbackGame(game, "@bob:loopback");
+
+    step(game, ELECTION_FRAMES);
+
+    strictEqual(bob.hostElection.currentHost?.peerId, alice.peerId);
+
+    // alice's connection drops but alice is still a member of the room
+    removeLoopbackPeer(game.simulation.loopback, alice.peerId);
+
+    step(game, 6 * 60);
+
+    strictEqual(bob.hostElection.currentHost?.peerId, bob.peerId);
+    strictEqual(getLastHostId(game, bob.peerId), bob.peerId);
+  });
+
+  it("should spawn replicated nodes locally", async () => {
+    game = createLoopbackGame(scriptSource);
+
+    const alice = await joinLoopbackGame(game, "@alice:loopback");
+
+    step(game, 2);
+
+    deepStrictEqual(getEvents(game, alice.peerId, "spawned"), [
+      { type: "spawned", peerId: alice.peerId, data: [4, 2] },
+    ]);
+  });
+
+  it("should report the time spent in scripts", async () => {
+    game = createLoopbackGame(scriptSource);
+
+    await joinLoopbackGame(game, "@alice:loopback");
+    await joinLoopbackGame(game, "@bob:loopback");
+
+    step(game, 30);
+
+    const report = getLoopbackGameReport(game);
+
+    strictEqual(report.peers, 2);
+    strictEqual(report.frames, 30);
+    ok(report.meanFrameScriptTime > 0);
+    ok(report.maxFrameScriptTime >= report.meanFrameScriptTime);
+    ok(report.meanFrameUpdateTime >= report.meanFrameScriptTime);
+  });
+});
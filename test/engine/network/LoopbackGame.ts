@@ -0,0 +1,335 @@
+import { addComponent, addEntity } from "bitecs";
+import { readFile } from "fs/promises";
+import { resolve } from "path";
+
+import { mockGameState } from "../mocks";
+import { GameContext } from "../../../src/engine/GameTypes";
+import { Message, Thread } from "../../../src/engine/module/module.common";
+import { GameNetworkState, NetworkModule, setLocalPeerId } from "../../../src/engine/network/network.game";
+import {
+  AddPeerIdMessage,
+  NetworkMessageType,
+  RemovePeerIdMessage,
+  SetHostMessage,
+} from "../../../src/engine/network/network.common";
+import { InboundNetworkSystem } from "../../../src/engine/network/inbound.game";
+import { Owned } from "../../../src/engine/network/NetworkComponents";
+import { WebSGNetworkModule } from "../../../src/engine/network/scripting.game";
+import {
+  createNetworkModuleState,
+  getPeerId,
+  Member,
+  NetworkModuleState as HostElectionState,
+  onConnect,
+  onDisconnect,
+  onMembersChanged,
+  onPeerMessageReceived,
+  updateConnectionStates,
+} from "../../../src/engine/network/HostElection";
+import {
+  addLoopbackPeer,
+  createLoopbackSimulation,
+  getLoopbackSimulationReport,
+  LoopbackPeer,
+  LoopbackSimulation,
+  LoopbackSimulationReport,
+  LoopbackTransportOptions,
+  removeLoopbackPeer,
+  stepLoopbackSimulation,
+} from "../../../src/engine/network/LoopbackTransport";
+import { Player } from "../../../src/engine/player/Player";
+import { createRemoteResourceManager } from "../../../src/engine/resource/resource.game";
+import { addScriptComponent, createScript, Script, ScriptingSystem } from "../../../src/engine/scripting/scripting.game";
+
+/**
+ * Runs a room of simulated clients in one process on top of LoopbackTransport. Each client has its own game
+ * context with the real network module state, the host election state from HostElection.ts and a script instance
+ * running the committed script runtime, so script traffic goes through network.c, peer.c and replicator.c, the
+ * WebSG networking imports and the inbound network system.
+ *
+ * Each frame steps the transport, then for every client: processes its incoming messages, updates its host
+ * election and runs its script. The harness plays the main thread's part: it reports delivered packets to host
+ * election, forwards the elected host to the game context and adds or removes peers as clients join and leave.
+ *
+ * Cross-client replication of spawned nodes isn't simulated. It needs the outbound and inbound entity
+ * serialization systems, which depend on the renderer and physics modules.
+ */
+
+const SCRIPT_RUNTIME_PATH = resolve(__dirname, "../../../src/engine/scripting/emscripten/build/scripting-runtime.wasm");
+
+let scriptRuntime: Promise<WebAssembly.Module> | undefined;
+
+// compiled once and instantiated for every client
+export function getScriptRuntime() {
+  if (!scriptRuntime) {
+    scriptRuntime = readFile(SCRIPT_RUNTIME_PATH).then((buffer) => WebAssembly.compile(buffer));
+  }
+
+  return scriptRuntime;
+}
+
+export interface LoopbackClient {
+  member: Member;
+  peerId: string;
+  peer: LoopbackPeer;
+  ctx: GameContext;
+  network: GameNetworkState;
+  hostElection: HostElectionState;
+  script: Script;
+  // output the script wrote with console.log, each argument is written as its own line
+  logs: string[];
+  // messages sent to the main thread, e.g. host election state changes
+  mainThreadMessages: Message<any>[];
+}
+
+export interface LoopbackGame {
+  roomId: string;
+  simulation: LoopbackSimulation;
+  scriptSource: string;
+  clients: LoopbackClient[];
+  peerIdToClient: Map<string, LoopbackClient>;
+  // wall clock time spent in scripts across all frames and clients, in milliseconds
+  scriptTime: number;
+  frameScriptTime: number;
+  maxFrameScriptTime: number;
+}
+
+export interface LoopbackGameReport extends LoopbackSimulationReport {
+  // mean and worst wall clock time to run every client's script for one frame, in milliseconds
+  meanFrameScriptTime: number;
+  maxFrameScriptTime: number;
+}
+
+export function createLoopbackGame(
+  scriptSource: string,
+  options: Partial<LoopbackTransportOptions> & { frameRate?: number } = {}
+): LoopbackGame {
+  const game: LoopbackGame = {
+    roomId: "!loopback:loopback",
+    simulation: createLoopbackSimulation(0, (peer, loopback, dt, time) => updateClient(game, peer, dt, time), options),
+    scriptSource,
+    clients: [],
+    peerIdToClient: new Map(),
+    scriptTime: 0,
+    frameScriptTime: 0,
+    maxFrameScriptTime: 0,
+  };
+
+  // every packet counts as a sign of life for host election, like a WebRTC data channel message would
+  game.simulation.loopback.onDelivered = (from, to) => {
+    const client = game.peerIdToClient.get(to);
+
+    if (client) {
+      onPeerMessageReceived(client.ctx, client.hostElection, from);
+    }
+  };
+
+  return game;
+}
+
+function createClientContext(game: LoopbackGame, client: Omit<LoopbackClient, "ctx">) {
+  const ctx = mockGameState();
+
+  ctx.thread = Thread.Game;
+  ctx.elapsed = game.simulation.time;
+  ctx.dt = 0;
+  ctx.tick = 0;
+  ctx.sendMessage = <M extends Message<any>>(thread: Thread, message: M) => {
+    if (thread === Thread.Game) {
+      const handlers = ctx.messageHandlers.get(message.type);
+
+      if (handlers) {
+        for (let i = 0; i < handlers.length; i++) {
+          handlers[i](ctx, message);
+        }
+      }
+    } else if (thread === Thread.Main) {
+      client.mainThreadMessages.push(message);
+    }
+  };
+
+  return ctx;
+}
+
+// captures the script's console.log output, scripts log through WASI fd_write which calls console.log with the
+// raw chunks it was given
+function runScript<T>(client: LoopbackClient, callback: () => T): T {
+  const log = console.log;
+
+  console.log = (...args: any[]) => {
+    client.logs.push(args.join(""));
+  };
+
+  try {
+    return callback();
+  } finally {
+    console.log = log;
+  }
+}
+
+/**
+ * Adds a client to the room. It connects to every client already in the room, which all see it enter, and
+ * joins host election with the room's current members.
+ */
+export async function joinLoopbackGame(
+  game: LoopbackGame,
+  userId: string,
+  deviceId = "LOOPBACK",
+  powerLevel = 0
+): Promise<LoopbackClient> {
+  const member: Member = {
+    userId,
+    deviceId,
+    displayName: userId,
+    powerLevel,
+    memberEventTimestamp: game.simulation.time,
+  };
+  const peerId = getPeerId(userId, deviceId);
+  const peer = addLoopbackPeer(game.simulation.loopback, peerId);
+
+  const partialClient = {
+    member,
+    peerId,
+    peer,
+    hostElection: createNetworkModuleState(),
+    logs: [],
+    mainThreadMessages: [],
+  } as unknown as LoopbackClient;
+
+  const ctx = createClientContext(game, partialClient);
+  const client = partialClient;
+  client.ctx = ctx;
+
+  // the main thread creates the ring buffers and sends them in InitializeNetworkState
+  client.network = await NetworkModule.create(ctx, {
+    sendMessage: () => {},
+    waitForMessage: async () => peer as any,
+  });
+  ctx.modules.set(NetworkModule, client.network);
+  await NetworkModule.init(ctx);
+  await WebSGNetworkModule.init(ctx);
+
+  setLocalPeerId(ctx, peerId);
+
+  // inbound messages are only processed once the local player rig has spawned
+  const playerRig = addEntity(ctx.world);
+  addComponent(ctx.world, Player, playerRig);
+  addComponent(ctx.world, Owned, playerRig);
+
+  // like the environment script, the script gets its own resource manager
+  const resourceManager = createRemoteResourceManager(ctx, "environment");
+  client.script = await createScript(ctx, resourceManager, await getScriptRuntime(), game.scriptSource);
+
+  runScript(client, () => {
+    client.script.initialize();
+    addScriptComponent(ctx, ctx.worldResource.environment!.publicScene, client.script);
+    client.script.entered();
+  });
+
+  const existingClients = game.clients.slice();
+
+  game.clients.push(client);
+  game.peerIdToClient.set(peerId, client);
+
+  onConnect(ctx, client.hostElection, game.roomId, userId, deviceId);
+  onMembersChanged(
+    client.hostElection,
+    game.roomId,
+    [...existingClients.map((existing) => existing.member), member],
+    []
+  );
+
+  for (const existing of existingClients) {
+    onMembersChanged(existing.hostElection, game.roomId, [member], []);
+
+    runScript(existing, () =>
+      existing.ctx.sendMessage<AddPeerIdMessage>(Thread.Game, { type: NetworkMessageType.AddPeerId, peerId })
+    );
+    runScript(client, () =>
+      ctx.sendMessage<AddPeerIdMessage>(Thread.Game, { type: NetworkMessageType.AddPeerId, peerId: existing.peerId })
+    );
+  }
+
+  return client;
+}
+
+/**
+ * Removes a client from the room. Every other client sees it exit and reelects a host if it was the host.
+ */
+export function leaveLoopbackGame(game: LoopbackGame, peerId: string) {
+  const client = game.peerIdToClient.get(peerId);
+
+  if (!client) {
+    return;
+  }
+
+  game.clients.splice(game.clients.indexOf(client), 1);
+  game.peerIdToClient.delete(peerId);
+  removeLoopbackPeer(game.simulation.loopback, peerId);
+
+  runScript(client, () => client.script.dispose());
+  onDisconnect(client.ctx, client.hostElection);
+
+  for (const other of game.clients) {
+    onMembersChanged(other.hostElection, game.roomId, [], [client.member]);
+
+    runScript(other, () =>
+      other.ctx.sendMessage<RemovePeerIdMessage>(Thread.Game, { type: NetworkMessageType.RemovePeerId, peerId })
+    );
+  }
+}
+
+function updateClient(game: LoopbackGame, peer: LoopbackPeer, dt: number, time: number) {
+  const client = game.peerIdToClient.get(peer.peerId)!;
+  const { ctx, network, hostElection } = client;
+
+  ctx.dt = dt;
+  ctx.elapsed = time * 1000;
+  ctx.tick++;
+
+  InboundNetworkSystem(ctx);
+
+  updateConnectionStates(ctx, hostElection);
+
+  const hostId = hostElection.currentHost?.peerId || "";
+
+  if (hostId !== network.hostId) {
+    ctx.sendMessage<SetHostMessage>(Thread.Game, { type: NetworkMessageType.SetHost, hostId });
+  }
+
+  const start = performance.now();
+  runScript(client, () => ScriptingSystem(ctx));
+  game.frameScriptTime += performance.now() - start;
+}
+
+export function stepLoopbackGame(game: LoopbackGame) {
+  game.frameScriptTime = 0;
+  stepLoopbackSimulation(game.simulation);
+  game.scriptTime += game.frameScriptTime;
+  game.maxFrameScriptTime = Math.max(game.maxFrameScriptTime, game.frameScriptTime);
+}
+
+export function getLoopbackGameReport(game: LoopbackGame): LoopbackGameReport {
+  const { frame } = game.simulation;
+
+  return {
+    ...getLoopbackSimulationReport(game.simulation),
+    meanFrameScriptTime: frame ? game.scriptTime / frame : 0,
+    maxFrameScriptTime: game.maxFrameScriptTime,
+  };
+}
+
+// parses the JSON objects the script logged, for scripts that log one JSON.stringify() string per call
+export function readLoopbackClientEvents<T = any>(client: LoopbackClient): T[] {
+  return client.logs
+    .join("")
+    .split("\n")
+    .filter((line) => line.startsWith("{"))
+    .map((line) => JSON.parse(line));
+}
+
+export function disposeLoopbackGame(game: LoopbackGame) {
+  for (const client of game.clients.slice()) {
+    leaveLoopbackGame(game, client.peerId);
+  }
+}